@@ -0,0 +1,91 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#ifndef __CRVK_BARRIER_BATCH_HPP__
+#define __CRVK_BARRIER_BATCH_HPP__
+
+typedef struct crvkBarrierBatchHandle_t crvkBarrierBatchHandle_t;
+
+/// @brief barrier counters since the batch creation 
+typedef struct crvkBarrierBatchStats_t
+{
+    uint64_t    requested = 0;  // barriers recorded in the batch
+    uint64_t    dropped = 0;    // read to read transitions already covered by the earlier readers 
+    uint64_t    merged = 0;     // barriers folded or grown in a pending barrier of the same resource
+    uint64_t    flushes = 0;    // vkCmdPipelineBarrier2 calls 
+} crvkBarrierBatchStats_t;
+
+///
+/// @brief Collect the buffer and image barriers of a command buffer and send then as a single 
+/// vkCmdPipelineBarrier2. Transitions of the same resource are folded in one barrier, the same transition of 
+/// overlapping or adjacent ranges grow a single barrier, and read to read transitions without layout or queue 
+/// change are ignored when the earlier stages and accesses already cover the new ones. Flush must be called
+/// before the next draw, dispatch or copy that depend on the pending barriers.
+///
+class crvkBarrierBatch
+{
+public:
+    crvkBarrierBatch( void );
+    ~crvkBarrierBatch( void );
+
+    /// @brief Start recording barriers for a command buffer, the pending barriers are discarded  
+    /// @param in_commandBuffer the command buffer that receive the barriers on Flush 
+    void            Begin( const VkCommandBuffer in_commandBuffer );
+
+    /// @brief Record a buffer barrier 
+    /// @param in_barrier the barrier, copied 
+    /// @return false if the transition don't need a barrier 
+    bool            Buffer( const VkBufferMemoryBarrier2* in_barrier );
+
+    /// @brief Record a image barrier 
+    /// @param in_barrier the barrier, copied 
+    /// @return false if the transition don't need a barrier 
+    bool            Image( const VkImageMemoryBarrier2* in_barrier );
+
+    /// @brief Send the pending barriers to the command buffer in a single dependency 
+    void            Flush( void );
+
+    /// @brief Number of barriers waiting the flush 
+    uint32_t        Pending( void ) const;
+
+    /// @brief The pending buffer barriers, valid until the next record, Flush or Begin  
+    /// @param out_count number of barriers 
+    const VkBufferMemoryBarrier2*   BufferBarriers( uint32_t* out_count ) const;
+
+    /// @brief The pending image barriers, valid until the next record, Flush or Begin  
+    /// @param out_count number of barriers 
+    const VkImageMemoryBarrier2*    ImageBarriers( uint32_t* out_count ) const;
+
+    /// @brief The command buffer given to Begin 
+    VkCommandBuffer CommandBuffer( void ) const;
+
+    /// @brief Get the batch counters 
+    void            Stats( crvkBarrierBatchStats_t* out_stats ) const;
+
+private:
+    crvkBarrierBatchHandle_t*   m_handle;
+
+    crvkBarrierBatch( const crvkBarrierBatch & ) = delete;
+    crvkBarrierBatch operator=( const crvkBarrierBatch & ) = delete;
+};
+
+#endif //!__CRVK_BARRIER_BATCH_HPP__
@@ -72,6 +72,33 @@ public:
     /// @param  
     virtual void        Destroy( void );
 
+    /// @brief Create the buffer without memory, use Bind to place it in memory owned by other, so buffers with 
+    /// lifetimes that don't overlap can share the same memory 
+    bool                CreateUnbound(  const crvkDevice* in_device,
+                                        const crvkDeviceQueue* in_graphic,
+                                        const crvkDeviceQueue* in_tranfer,
+                                        const size_t in_size, 
+                                        const VkBufferUsageFlags in_usage );
+
+    /// @brief Bind a buffer made with CreateUnbound to a allocation, the allocation is not released by Destroy
+    /// @param in_memory the memory owner allocation 
+    /// @param in_offset offset inside the allocation 
+    bool                Bind( const crvkMemoryAllocation_t* in_memory, const VkDeviceSize in_offset );
+    void                MemoryRequirements( VkMemoryRequirements* out_requirements ) const;
+
+    /// @brief Forget the buffer content, the next transitions wait the given stages and access,
+    /// without queue ownership, used when the memory was used by a other resource 
+    void                DiscardContent( const VkPipelineStageFlags2 in_stages, const VkAccessFlags2 in_access );
+
+    /// @brief All the pipeline stages of the ranges current state  
+    VkPipelineStageFlags2   Stages( void ) const;
+
+    /// @brief Set the timeline value of the buffer last use by the application, Destroy send the buffer 
+    /// to the device deletion queue to be released after it, without wait the GPU 
+    /// @param in_semaphore the timeline semaphore signaled by the last submit that use the buffer 
+    /// @param in_value the value signaled 
+    void                SetLastUse( const VkSemaphore in_semaphore, const uint64_t in_value );
+
     /// @brief 
     /// @param srcBuffer 
     virtual void        CopyFromBuffer( const VkBuffer in_srcBuffer, const VkBufferCopy2* in_regions, const uint32_t in_count ) {};
@@ -114,6 +141,19 @@ public:
     /// @param in_dstQueue 
     virtual void        StateTransition( const VkCommandBuffer in_commandBuffer, const crvkBufferState_t in_state, const uint32_t in_dstQueueFamily );
 
+    /// @brief Record the state change in a barrier batch, the barrier is only in the command buffer after the batch flush
+    /// @param in_batch 
+    /// @param in_state 
+    /// @param in_dstQueueFamily 
+    virtual void        StateTransition( crvkBarrierBatch* in_batch, const crvkBufferState_t in_state, const uint32_t in_dstQueueFamily );
+
+    /// @brief Change the state of a byte range only, the state is tracked by range so the other ranges keep 
+    /// their current use, and a barrier is made only for the parts of the range that change state  
+    /// @param in_offset 
+    /// @param in_size can be VK_WHOLE_SIZE 
+    virtual void        StateTransition( const VkCommandBuffer in_commandBuffer, const crvkBufferState_t in_state, const VkDeviceSize in_offset, const VkDeviceSize in_size, const uint32_t in_dstQueueFamily );
+    virtual void        StateTransition( crvkBarrierBatch* in_batch, const crvkBufferState_t in_state, const VkDeviceSize in_offset, const VkDeviceSize in_size, const uint32_t in_dstQueueFamily );
+
     /// @brief 
     /// @param  
     /// @return 
@@ -121,6 +161,14 @@ public:
 
 protected:
     crvkBufferHandler_t*    m_bufferHandler;
+
+    bool                BindMemory( const VkDeviceMemory in_memory, const VkDeviceSize in_offset );
+
+    /// @brief The timeline values the buffer wait before be released, return the count 
+    uint32_t            LastUse( crvkTimelinePoint_t* out_points ) const;
+
+    /// @brief Release the buffer and his memory, deferred to the device deletion queue when there are timeline values to wait 
+    void                Release( const crvkTimelinePoint_t* in_lastUse, const uint32_t in_count );
 private:
     crvkBuffer( const crvkBuffer & ) = delete;
     crvkBuffer operator=( const crvkBuffer & ) = delete;
@@ -151,22 +199,32 @@ public:
     /// @param srcBuffer 
     virtual void        CopyFromBuffer( const VkBuffer in_srcBuffer, const VkBufferCopy2* in_regions, const uint32_t in_count ) override;
     virtual void        CopyToBuffer( const VkBuffer in_dstBuffer, const VkBufferCopy2* in_regions, const uint32_t in_count ) override;
+    using               crvkBuffer::StateTransition;
     virtual void        StateTransition( const crvkBufferState_t in_state, const uint32_t in_dstQueue );
     virtual void*       Map( const uintptr_t in_offset, const size_t in_size, const crvkBufferMapAccess_t in_acces ) override;
     virtual void        Unmap( const crvkBufferState_t in_state );
 
 protected:
+    static const uint32_t   k_copyCommandBuffers = 4;   // copies in flight before the CPU wait a command buffer 
+
     uint32_t            m_transferFamily; //
     uintptr_t           m_mapOffset;
     size_t              m_mapSize;
     uint64_t            m_useValue;
     uint64_t            m_copyValue;
+    uint64_t            m_lastCopyValue;        // value of the last copy 
     VkSemaphore         m_copySemaphore;
     VkSemaphore         m_useSemaphore;
+    VkSemaphore         m_lastCopySemaphore;    // semaphore of the last copy, our own or from a upload batch
     VkCommandPool       m_commandPool;
     VkCommandBuffer     m_commandBuffer;
+    uint32_t            m_copyCommand;                                  // current copy command buffer 
+    VkCommandBuffer     m_copyCommandBuffers[k_copyCommandBuffers];     // the copies ring, so a pending copy is never reset 
+    uint64_t            m_copyCommandValues[k_copyCommandBuffers];      // copy value signaled by the last submit of each 
     crvkDevice*         m_device;
 
+    friend class crvkUploadBatch;
+
     /// @brief 
     /// @param  
     /// @return 
@@ -181,11 +239,41 @@ protected:
     VkSemaphoreSubmitInfo   SignalLastCopy( void );
     VkSemaphoreSubmitInfo   WaitLastUse( void );
     VkSemaphoreSubmitInfo   WaitLastCopy( void );
+
+    /// @brief Set the semaphore and value that signal the end of the last copy 
+    void                    SetLastCopy( const VkSemaphore in_semaphore, const uint64_t in_value );
+
+    /// @brief Take the next copy command buffer of the ring, the CPU only wait when his last copy is still pending 
+    VkResult                NextCopyCommand( void );
+
+    /// @brief Record a copy between this buffer and another into the next copy command buffer, a copy 
+    /// from this buffer make the written range visible to the host 
+    /// @param in_buffer the other buffer 
+    /// @param in_regions copy regions 
+    /// @param in_count regions count 
+    /// @param in_upload true to copy into this buffer, false to copy from it 
+    bool                    RecordCopy( const VkBuffer in_buffer, const VkBufferCopy2* in_regions, const uint32_t in_count, const bool in_upload );
+
+    /// @brief Submit the recorded copy 
+    /// @param in_ranges staging ranges consumed by the copy, given back to the ring when it finish 
+    /// @param in_count ranges count 
+    /// @param out_readback if not NULL, the copy also signal the device read back ring timeline of the queue, 
+    /// receive the signaled point, it outlive this buffer 
+    bool                    SubmitCopy( const crvkStagingRange_t* in_ranges, const uint32_t in_count, crvkTimelinePoint_t* out_readback = nullptr );
+
+    /// @brief CPU wait for the last copy to finish 
+    VkResult                WaitCopy( void ) const;
+
+    /// @brief The application last use plus the last use and copy of the internal semaphores 
+    uint32_t                LastUse( crvkTimelinePoint_t* out_points ) const;
 };
 
 ///
 /// @brief crvkBufferStaging works like OpenGL buffers, create a two stage buffer,    
-/// a GPU memory bufer and a CPU side buffer and perform the buffer and sincronization
+/// a GPU memory bufer and a CPU side buffer and perform the buffer and sincronization.
+/// Buffers up to crvkDevice::DirectWriteLimit are placed in device local host visible memory
+/// and written directly, without the staging copy, a write while the GPU still use the buffer go
+/// through the staging ring instead of wait it
 ///
 class crvkBufferStaging : public crvkBufferStatic
 {
@@ -205,17 +293,48 @@ public:
     virtual void    SubData( const void* in_data, const uintptr_t in_offset, const size_t in_size ) const override;
     
     virtual void    GetSubData( void* in_data, const uintptr_t in_offset, const size_t in_size ) const override;
+
+    /// @brief Read back without wait the GPU, the copy go to the device read back ring and the content is delivered
+    /// by crvkReadbackQueue::Poll to the callback, or by crvkReadbackQueue::Wait. A new copy of the buffer still
+    /// wait the previous one, the ring range is held until delivered, so the size must fit in the read back ring 
+    /// @param in_offset buffer offset 
+    /// @param in_size content size 
+    /// @param in_callback called with the content, can be nullptr to only use Wait 
+    /// @param in_userData given to the callback 
+    /// @return the device read back queue ticket, zero on fail 
+    crvkReadbackTicket_t    GetSubDataAsync( const uintptr_t in_offset, const size_t in_size, crvkReadbackCallback_t in_callback, void* in_userData ) const;
     
+    /// @brief Map a range, on staging memory the range get his own staging buffer until Unmap, so a map of any 
+    /// size don't hold the device staging rings. A read map is loaded with the buffer content, a write map is not, 
+    /// its content is undefined until written 
     virtual void*   Map( const uintptr_t in_offset, const size_t in_size, const crvkBufferMapAccess_t in_acces ) override;
     
+    /// @brief End the map, a write map send to the GPU buffer only the ranges given to Flush, a write map 
+    /// without flushed ranges send nothing and report a error 
     virtual void    Unmap( void ) override;
     
+    /// @brief On a write map, mark a written range, it must be called for every written range, the overlapping 
+    /// and touching ranges are merged and sent to the GPU buffer by Unmap with one copy region by range.
+    /// On a read map, reload the range from the GPU buffer 
     virtual void    Flush( const uintptr_t in_offset, const size_t in_size ) const override;
+
+    /// @brief True if the CPU write the buffer memory directly 
+    bool            DirectWrite( void ) const { return m_direct; }
     
 private:
+    bool                    m_direct;       // device local host visible memory, no staging copy 
     crvkBufferMapAccess_t   m_mapacess;
-    VkBuffer                m_stagingBuffer;
-    VkDeviceMemory          m_stagingMemory;
+    crvkBuffer              m_mapStaging;   // staging buffer held while mapped, out of the shared staging rings 
+    crvkDirtyRangeSet       m_dirty;        // written ranges while write mapped 
+
+    /// @brief Create the staging buffer of a map, cached memory for the reads when the device have it 
+    bool            CreateMapStaging( const VkDeviceSize in_size, const crvkBufferMapAccess_t in_acces );
+
+    /// @brief True while a copy or the last use set by the application is not finished, without wait 
+    bool            InFlight( void ) const;
+
+    /// @brief CPU wait the copies and the last use set by the application, before a direct access 
+    VkResult        WaitIdle( void ) const;
 };
 
 #endif //!__CRVK_BUFFER_HPP__
\ No newline at end of file
@@ -38,6 +38,12 @@ public:
     VkCommandBuffer     GetCommandBuffer( const uint32_t in_index ) const;
     VkCommandBuffer     GetCurrentCommandBuffer( void ) const;
     VkCommandBuffer*    GetCommandBufferArray( void ) const;
+    /// @brief fence signaled by the last submit of the buffer, nullptr if created without fences  
+    VkFence             GetFence( const uint32_t in_index ) const;
+    /// @brief Attach a barrier batch, it's pending barriers are flushed before each draw, dispatch, copy and End,
+    /// and the batch is rebound to the current buffer on Begin. nullptr to detach 
+    void                SetBarrierBatch( crvkBarrierBatch* in_batch );
+    crvkBarrierBatch*   BarrierBatch( void ) const;
     VkResult            Reset( const VkCommandBufferResetFlags in_flags ) const;
     VkResult            Begin( const VkCommandBufferUsageFlags in_flags ) const;
     VkResult            End( void ) const;
@@ -260,8 +266,59 @@ public:
 
     
 
-private:
+protected:
     crvkCommandBufferHandler_t* m_handler;
 };
 
+///
+/// @brief A ring of command buffers gated by one timeline semaphore. Each submit signal the next value, 
+/// and Begin only wait when the buffer about to be reused is still in flight, so the CPU record the 
+/// next frame while the GPU execute the last ones. See doc/crvkCommandBuffer.md 
+///
+class crvkCommandBufferRoundRobin : public crvkCommandBuffer
+{
+public:
+    crvkCommandBufferRoundRobin( void );
+    ~crvkCommandBufferRoundRobin( void );
+
+    /// @brief Create the ring 
+    /// @param in_device 
+    /// @param in_queue the queue to submit 
+    /// @param in_count number of buffers, the frames the CPU can be ahead of the GPU 
+    /// @param in_level 
+    /// @return true on success 
+    bool            Create( const crvkDevice* in_device, const crvkDeviceQueue* in_queue, const uint32_t in_count, const VkCommandBufferLevel in_level = VK_COMMAND_BUFFER_LEVEL_PRIMARY );
+    void            Destroy( void );
+
+    /// @brief Select the next buffer of the ring, wait the GPU release it if needed, reset and begin it 
+    VkResult        Begin( const VkCommandBufferUsageFlags in_flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT );
+
+    /// @brief End and submit the current buffer, signaling the next timeline value 
+    VkResult        Submit( const VkSemaphoreSubmitInfo* in_semaphoresToWait, 
+                            const uint32_t in_semaphoresToWaitCount, 
+                            const VkSemaphoreSubmitInfo* in_semaphoresToSignal, 
+                            const uint32_t in_semaphoresToSingalCount );
+
+    /// @brief Wait the GPU finish all the submitted buffers 
+    VkResult        WaitIdle( void ) const;
+
+    /// @brief The timeline semaphore signaled by the submits 
+    VkSemaphore     DoneSemaphore( void ) const { return m_doneSemaphore; }
+
+    /// @brief The value signaled by the last submit 
+    uint64_t        TimelineValue( void ) const { return m_timelineValue; }
+
+private:
+    uint32_t            m_numBuffers;
+    uint32_t            m_currentBuffer;
+    uint64_t            m_timelineValue;
+    uint64_t*           m_bufferValues;     // value signaled by the last submit of each buffer 
+    VkSemaphore         m_doneSemaphore;
+    VkDevice            m_device;
+    crvkDeviceQueue*    m_queue;
+
+    crvkCommandBufferRoundRobin( const crvkCommandBufferRoundRobin & ) = delete;
+    crvkCommandBufferRoundRobin operator=( const crvkCommandBufferRoundRobin & ) = delete;
+};
+
 #endif //__CRVK_COMMAND_BUFFER_HPP__
\ No newline at end of file
@@ -0,0 +1,79 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#ifndef __CRVK_COMMAND_POOL_MANAGER_HPP__
+#define __CRVK_COMMAND_POOL_MANAGER_HPP__
+
+typedef struct crvkCommandPoolManagerHandle_t crvkCommandPoolManagerHandle_t;
+
+///
+/// @brief Hand out command pools keyed by queue family and recording thread, one per frame in flight.
+/// Each thread record in his own pools without locking, the manager is only locked the first time a thread 
+/// use a family, later the thread find his pools in a thread local cache. The pools of a frame are reset as a whole 
+/// with vkResetCommandPool when the frame come back, the command buffers are recycled not freed.
+///
+class crvkCommandPoolManager
+{
+public:
+    crvkCommandPoolManager( void );
+    ~crvkCommandPoolManager( void );
+
+    /// @brief Create the manager, the pools are created on the first use of each thread  
+    /// @param in_device 
+    /// @param in_frames number of frames in flight 
+    /// @return true on success 
+    bool            Create( const crvkDevice* in_device, const uint32_t in_frames );
+
+    /// @brief Destroy all the pools, the GPU must be done with them 
+    void            Destroy( void );
+
+    /// @brief Get the calling thread pool for the current frame 
+    /// @param in_family the queue family 
+    /// @return nullptr on error 
+    VkCommandPool   Pool( const uint32_t in_family );
+
+    /// @brief Get a command buffer from the calling thread pool for the current frame, 
+    /// valid until the frame pools are reset 
+    /// @param in_family the queue family 
+    /// @param in_level primary or secondary 
+    /// @return nullptr on error 
+    VkCommandBuffer Allocate( const uint32_t in_family, const VkCommandBufferLevel in_level );
+
+    /// @brief Move to the next frame and reset all his pools, the GPU must be done with that frame
+    /// and no thread can be recording 
+    /// @return the first vkResetCommandPool error 
+    VkResult        NextFrame( void );
+
+    /// @brief Current frame index 
+    uint32_t        Frame( void ) const;
+
+    /// @brief Number of frames in flight 
+    uint32_t        FrameCount( void ) const;
+
+private:
+    crvkCommandPoolManagerHandle_t* m_handle;
+
+    crvkCommandPoolManager( const crvkCommandPoolManager & ) = delete;
+    crvkCommandPoolManager operator=( const crvkCommandPoolManager & ) = delete;
+};
+
+#endif //!__CRVK_COMMAND_POOL_MANAGER_HPP__
@@ -31,6 +31,13 @@ public:
     crvkContext( void );
     ~crvkContext( void );
 
+    /// @brief Create the vulkan instance and the window surface 
+    /// @param in_whdn the window to present to, pass nullptr to create a headless context, with no surface 
+    /// @param in_applicationName 
+    /// @param in_engineName 
+    /// @param in_layers the validation layers, nullptr to disable validation
+    /// @param in_layersCount 
+    /// @return true on sucess, false on error 
     bool    Create( 
         const SDL_Window *in_whdn, 
         const char* in_applicationName, 
@@ -44,9 +51,13 @@ public:
     bool                        GetDevices( uint32_t *in_count, crvkDevice** in_devices ) const;
     VkInstance                  Instance( void ) const { return m_instance; }
     VkSurfaceKHR                Surface( void ) const { return m_surface; }
+    
+    /// @brief Return true if the context was created without a window, we don't have a surface to present 
+    bool                        Headless( void ) const { return m_headless; }
 
 private:
     bool                                m_enableValidationLayers;
+    bool                                m_headless;
     VkInstance                          m_instance;
     VkDebugUtilsMessengerEXT            m_debugMessenger;
     VkSurfaceKHR                        m_surface;
@@ -91,15 +91,31 @@ class crvkPointer;
 #include "crvkException.hpp"
 #include "crvkContext.hpp"
 #include "crvkFormat.hpp"
+#include "crvkQueue.hpp"
 #include "crvkDevice.hpp"
+#include "crvkRangeAllocator.hpp"
+#include "crvkMemoryAllocator.hpp"
+#include "crvkDeletionQueue.hpp"
+#include "crvkUploadManager.hpp"
+#include "crvkReadbackQueue.hpp"
+#include "crvkPipelineCache.hpp"
 #include "crvkFence.hpp"
 #include "crvkSemaphore.hpp"
+#include "crvkBarrierBatch.hpp"
+#include "crvkDirtyRangeSet.hpp"
 #include "crvkBuffer.hpp"
 #include "crvkImage.hpp"
+#include "crvkUploadBatch.hpp"
 #include "crvkFrameBuffer.hpp"
 #include "crvkCommandBuffer.hpp"
+#include "crvkCommandPoolManager.hpp"
+#include "crvkParallelRecorder.hpp"
+#include "crvkRenderGraph.hpp"
 #include "crvkSwapchain.hpp"
+#include "crvkFrameArena.hpp"
+#include "crvkShaderCache.hpp"
 #include "crvkShaderStage.hpp"
+#include "crvkShaderCompiler.hpp"
 #include "crvkPipeline.hpp"
 
 #endif //__CRVK_IMPLEMENTATION_HPP__
\ No newline at end of file
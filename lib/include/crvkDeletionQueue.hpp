@@ -0,0 +1,84 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#ifndef __CRVK_DELETION_QUEUE_HPP__
+#define __CRVK_DELETION_QUEUE_HPP__
+
+/// @brief a value of a timeline semaphore 
+typedef struct crvkTimelinePoint_t
+{
+    VkSemaphore semaphore = nullptr;
+    uint64_t    value = 0;
+} crvkTimelinePoint_t;
+
+typedef struct crvkDeletionQueueHandle_t crvkDeletionQueueHandle_t;
+
+///
+/// @brief Device deferred deletion queue. The objects are queued with the timeline values of 
+/// his last use, and Collect destroy the ones the GPU have passed, so a object can be released 
+/// while the GPU still use it without wait the device idle. Collect should be called once a frame.
+///
+class crvkDeletionQueue
+{
+public:
+    static const uint32_t k_maxPoints = 4;  // max timeline values a object wait 
+
+    crvkDeletionQueue( void );
+    ~crvkDeletionQueue( void );
+
+    /// @brief Initialize the queue 
+    /// @param in_device the owner device 
+    /// @return true on success 
+    bool        Create( const crvkDevice* in_device );
+
+    /// @brief Destroy all the queued objects now, the GPU must be done with them 
+    void        Destroy( void );
+
+    /// @brief Queue a object to be destroyed when the GPU reach all the timeline values 
+    /// @param in_type the object type, buffers, images, views, semaphores, fences, samplers, memory, 
+    /// command buffers and pools, pipelines, descriptor pools, query pools, frame buffers, render passes and swapchains
+    /// @param in_handle the object handle, reinterpret_cast<uint64_t>( handle ) 
+    /// @param in_lastUse the timeline values of the object last use, nullptr or zero count to destroy on the next Collect 
+    /// @param in_count number of timeline values, up to k_maxPoints with semaphore 
+    /// @param in_parent the command pool of a command buffer 
+    /// @return false if there are more than k_maxPoints values, the object is not queued 
+    bool        Enqueue( const VkObjectType in_type, const uint64_t in_handle, const crvkTimelinePoint_t* in_lastUse, const uint32_t in_count, const uint64_t in_parent = 0 );
+
+    /// @brief Queue a device allocator range to be returned when the GPU reach all the timeline values
+    /// @return false if there are more than k_maxPoints values, the range is not queued 
+    bool        EnqueueFree( const crvkMemoryAllocation_t* in_allocation, const crvkTimelinePoint_t* in_lastUse, const uint32_t in_count );
+
+    /// @brief Destroy the objects the GPU is done with, only one counter query by semaphore 
+    /// @return number of objects destroyed 
+    uint32_t    Collect( void );
+
+    /// @brief Number of objects waiting the GPU 
+    uint32_t    Pending( void ) const;
+
+private:
+    crvkDeletionQueueHandle_t*  m_handle;
+
+    crvkDeletionQueue( const crvkDeletionQueue & ) = delete;
+    crvkDeletionQueue operator=( const crvkDeletionQueue & ) = delete;
+};
+
+#endif //!__CRVK_DELETION_QUEUE_HPP__
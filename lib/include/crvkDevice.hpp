@@ -30,13 +30,27 @@ typedef struct crvkDeviceSuportedFeatures_t
 
 typedef struct crvkDeviceHandle_t crvkDeviceHandle_t;
 typedef struct glslang_resource_s glslang_resource_t;
+class crvkMemoryAllocator;
+class crvkUploadManager;
+class crvkReadbackQueue;
+class crvkDeletionQueue;
+class crvkPipelineCache;
+class crvkShaderCache;
 class crvkDevice
 {
 public:
     crvkDevice( void );
     ~crvkDevice( void );
 
-    bool    Create( const char** in_layers, const uint32_t in_layersCount, const char** in_deviceExtensions, const uint32_t in_deviceExtensionsCount );
+    /// @brief Create the logical device 
+    /// @param in_layers 
+    /// @param in_layersCount 
+    /// @param in_deviceExtensions 
+    /// @param in_deviceExtensionsCount 
+    /// @param in_pipelineCachePath the pipeline cache file, loaded now and written back on Destroy, nullptr to keep it in memory 
+    /// @param in_shaderCachePath the SPIR-V cache directory, nullptr to keep it in memory 
+    /// @return true on sucess, false on error 
+    bool    Create( const char** in_layers, const uint32_t in_layersCount, const char** in_deviceExtensions, const uint32_t in_deviceExtensionsCount, const char* in_pipelineCachePath = nullptr, const char* in_shaderCachePath = nullptr );
     void    Destroy( void );
 
     VkPhysicalDevice            PhysicalDevice( void ) const;    
@@ -57,9 +71,49 @@ public:
 
     VkExtent2D                  FindExtent( const uint32_t in_width, const uint32_t in_height ) const;
     uint32_t                    FindMemoryType( uint32_t typeFilter, VkMemoryPropertyFlags properties ) const;
+
+    /// @brief The physical device limits, like the buffer offset alignments 
+    const VkPhysicalDeviceLimits*   Limits( void ) const;
     const bool                  CheckExtensionSupport( const char* in_extension );
     const glslang_resource_t*   BuiltInShaderResource( void ) const;     
 
+    /// @brief Device memory sub allocator, used by buffers and images 
+    /// @return nullptr if the device are not created
+    crvkMemoryAllocator*        MemoryAllocator( void ) const;
+
+    /// @brief Device shared staging ring, used by the staging buffers to upload and read back
+    /// @return nullptr if the device are not created
+    crvkUploadManager*          UploadManager( void ) const;
+
+    /// @brief Device read back staging ring, in CPU cached memory when available, used by the staging buffers and images to read back
+    /// @return nullptr if the device are not created
+    crvkUploadManager*          ReadbackManager( void ) const;
+
+    /// @brief Device asynchronous read back queue, deliver the GetSubDataAsync results from his Poll
+    /// @return nullptr if the device are not created
+    crvkReadbackQueue*          ReadbackQueue( void ) const;
+
+    /// @brief Biggest crvkBufferStaging that is placed in device local host visible memory and written 
+    /// directly by the CPU, without staging copy. Zero when the device have no such memory, VK_WHOLE_SIZE when
+    /// the CPU see the whole device memory ( integrated, software and resizable BAR devices )
+    VkDeviceSize                DirectWriteLimit( void ) const;
+
+    /// @brief Change the direct write limit, zero disable it, ignored if the device have no such memory.
+    /// Only affect the staging buffers created after it
+    void                        SetDirectWriteLimit( const VkDeviceSize in_size );
+
+    /// @brief Device deferred deletion queue, the buffers and images destroyed with a last use are released by his Collect
+    /// @return nullptr if the device are not created
+    crvkDeletionQueue*          DeletionQueue( void ) const;
+
+    /// @brief Device pipeline cache, used by all the pipeline creation 
+    /// @return nullptr if the device are not created
+    crvkPipelineCache*          PipelineCache( void ) const;
+
+    /// @brief Device SPIR-V cache, used by the GLSL programs 
+    /// @return nullptr if the device are not created
+    crvkShaderCache*            ShaderCache( void ) const;
+
 protected:
     friend class crvkContext;
     friend class crvkBufferStaging;
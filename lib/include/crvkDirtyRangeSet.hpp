@@ -0,0 +1,68 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#ifndef __CRVK_DIRTY_RANGE_SET_HPP__
+#define __CRVK_DIRTY_RANGE_SET_HPP__
+
+/// @brief a written range of a mapped buffer, in buffer offsets 
+typedef struct crvkDirtyRange_t
+{
+    VkDeviceSize    begin = 0;
+    VkDeviceSize    end = 0;
+} crvkDirtyRange_t;
+
+typedef struct crvkDirtyRangeSetHandle_t crvkDirtyRangeSetHandle_t;
+
+///
+/// @brief Sorted and disjoint set of written ranges, the overlapping and touching ranges are merged, 
+/// the bytes between two ranges are never included, so the staging buffer copy only the written bytes,  
+/// with one copy region by range. It work without a device.
+///
+class crvkDirtyRangeSet
+{
+public:
+    crvkDirtyRangeSet( void );
+    ~crvkDirtyRangeSet( void );
+
+    /// @brief Forget all the ranges 
+    void                    Clear( void );
+
+    /// @brief Add a range, merging the overlapping and touching ones 
+    /// @param in_offset range start 
+    /// @param in_size range size, a empty range is ignored 
+    void                    Add( const VkDeviceSize in_offset, const VkDeviceSize in_size );
+
+    /// @brief Number of ranges 
+    uint32_t                Count( void ) const;
+
+    /// @brief The ranges, sorted by offset, valid until the next Add or Clear 
+    /// @param out_count number of ranges 
+    const crvkDirtyRange_t* Ranges( uint32_t* out_count ) const;
+
+private:
+    crvkDirtyRangeSetHandle_t*  m_handle;
+
+    crvkDirtyRangeSet( const crvkDirtyRangeSet & ) = delete;
+    crvkDirtyRangeSet operator=( const crvkDirtyRangeSet & ) = delete;
+};
+
+#endif //!__CRVK_DIRTY_RANGE_SET_HPP__
@@ -0,0 +1,106 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#ifndef __CRVK_FRAME_ARENA_HPP__
+#define __CRVK_FRAME_ARENA_HPP__
+
+/// @brief a transient allocation of the frame arena, valid until the frame GPU work retire 
+typedef struct crvkFrameAllocation_t
+{
+    VkBuffer        buffer = nullptr;   // arena buffer handle 
+    VkDeviceSize    offset = 0;         // offset in the arena buffer, for binds and dynamic offsets 
+    void*           pointer = nullptr;  // CPU address of the allocation 
+} crvkFrameAllocation_t;
+
+typedef struct crvkFrameArenaHandle_t crvkFrameArenaHandle_t;
+
+///
+/// @brief Per frame linear allocator for transient GPU data, like per draw uniforms and dynamic vertices.
+/// Own one persistently mapped host visible buffer split in a region per frame, the allocations are a 
+/// pointer bump in the current frame region, and the whole region is reset when his frame GPU work retire.
+/// It is not thread safe, use one arena per recording thread.
+///
+class crvkFrameArena
+{
+public:
+    crvkFrameArena( void );
+    ~crvkFrameArena( void );
+
+    /// @brief Create the arena buffer 
+    /// @param in_device the owner device 
+    /// @param in_frames number of frame regions, usually crvkSwapchain::FrameCount 
+    /// @param in_frameSize size of each frame region 
+    /// @param in_usage buffer usage of the allocations 
+    /// @return true on success 
+    bool            Create( const crvkDevice* in_device, 
+                            const uint32_t in_frames, 
+                            const VkDeviceSize in_frameSize, 
+                            const VkBufferUsageFlags in_usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT );
+    
+    /// @brief Wait the GPU finish the submitted frames still using the arena and release it, 
+    /// a frame started but never ended is not waited 
+    void            Destroy( void );
+
+    /// @brief Start a frame in the next region, wait the GPU retire the last frame that used it. 
+    /// The previous frame is ended, see EndFrame 
+    /// @param in_semaphore timeline semaphore signaled when the GPU finish the frame 
+    /// @param in_value the value the frame signal 
+    /// @return the wait result 
+    VkResult        BeginFrame( const VkSemaphore in_semaphore, const uint64_t in_value );
+
+    /// @brief Start a frame paced by the swapchain frame timeline 
+    VkResult        BeginFrame( const crvkSwapchain* in_swapchain );
+
+    /// @brief Mark the current frame as submitted, his retire value is going to be signaled. 
+    /// Call it after submit the last frame before Destroy, BeginFrame already end the previous frames 
+    void            EndFrame( void );
+
+    /// @brief Get a range of the current frame region 
+    /// @param in_size allocation size 
+    /// @param in_alignment offset alignment ( power of two ), the device uniform and storage alignment are always respected 
+    /// @param out_allocation the allocation 
+    /// @return false if the frame region is full 
+    bool            Allocate( const VkDeviceSize in_size, const VkDeviceSize in_alignment, crvkFrameAllocation_t* out_allocation );
+
+    /// @brief Allocate and copy the data 
+    bool            Push( const void* in_data, const VkDeviceSize in_size, const VkDeviceSize in_alignment, crvkFrameAllocation_t* out_allocation );
+
+    /// @brief The arena buffer 
+    VkBuffer        Buffer( void ) const;
+
+    /// @brief Size of each frame region 
+    VkDeviceSize    FrameSize( void ) const;
+
+    /// @brief Bytes allocated in the current frame 
+    VkDeviceSize    Used( void ) const;
+
+    /// @brief Most bytes allocated in a frame, to tune the frame size 
+    VkDeviceSize    Peak( void ) const;
+
+private:
+    crvkFrameArenaHandle_t* m_handle;
+
+    crvkFrameArena( const crvkFrameArena & ) = delete;
+    crvkFrameArena operator=( const crvkFrameArena & ) = delete;
+};
+
+#endif //!__CRVK_FRAME_ARENA_HPP__
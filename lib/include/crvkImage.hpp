@@ -63,21 +63,75 @@ public:
         const uint32_t in_width,
         const uint32_t in_height,
         const uint32_t in_depth,
-        const VkSampleCountFlagBits in_samples = VK_SAMPLE_COUNT_1_BIT );
+        const VkSampleCountFlagBits in_samples = VK_SAMPLE_COUNT_1_BIT,
+        const VkImageUsageFlags in_usage = 0 ); // extra usage, like VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT for render targets 
         
     virtual void    Destroy( void );
+
+    /// @brief Create the image without memory, use Bind to place it in memory owned by other, so images with 
+    /// lifetimes that don't overlap can share the same memory 
+    bool            CreateUnbound(
+        const crvkDevice* in_device, 
+        const VkImageViewType in_type, 
+        const VkFormat in_format,
+        const uint16_t in_levels,
+        const uint16_t in_layers,
+        const uint32_t in_width,
+        const uint32_t in_height,
+        const uint32_t in_depth,
+        const VkSampleCountFlagBits in_samples = VK_SAMPLE_COUNT_1_BIT,
+        const VkImageUsageFlags in_usage = 0 );
+
+    /// @brief Bind a image made with CreateUnbound to a allocation and create the view, the allocation is not released by Destroy
+    /// @param in_memory the memory owner allocation 
+    /// @param in_offset offset inside the allocation 
+    bool            Bind( const crvkMemoryAllocation_t* in_memory, const VkDeviceSize in_offset );
+    void            MemoryRequirements( VkMemoryRequirements* out_requirements ) const;
+
+    /// @brief Forget the image content, the next transitions start from undefined layout and wait the given stages and access,
+    /// without queue ownership, used when the memory was used by a other resource 
+    void            DiscardContent( const VkPipelineStageFlags2 in_stages, const VkAccessFlags2 in_access );
+
+    /// @brief All the pipeline stages of the subresources current state  
+    VkPipelineStageFlags2   Stages( void ) const;
+
+    /// @brief Set the timeline value of the image last use by the application, Destroy send the image 
+    /// to the device deletion queue to be released after it, without wait the GPU 
+    void            SetLastUse( const VkSemaphore in_semaphore, const uint64_t in_value );
+
     virtual bool    CopyFromBuffer( const VkBuffer in_srcBuffer, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count ) { return false; };
-    virtual bool    CopyToBuffer( const VkBuffer in_dstBuffer, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count ) { return false; };
+    virtual bool    CopyToBuffer( const VkBuffer in_dstBuffer, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count, crvkTimelinePoint_t* out_readback = nullptr ) { return false; };
     virtual bool    SubData( const void* in_data, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count ) { return false; };
     virtual bool    GetSubData( void* in_data, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count ) { return false; }; 
     virtual void    StateTransition( const VkCommandBuffer in_commandBuffer, const crvkImageState_t in_state, const VkImageAspectFlags in_aspect, const uint32_t in_dstQueue );
     
+    /// @brief Record the state change in a barrier batch, the barrier is only in the command buffer after the batch flush
+    virtual void    StateTransition( crvkBarrierBatch* in_batch, const crvkImageState_t in_state, const VkImageAspectFlags in_aspect, const uint32_t in_dstQueue );
+
+    /// @brief Change the state of a range of mips and layers only, the state is tracked by subresource and a barrier 
+    /// is made for each block of the range that share the same state. The counts accept VK_REMAINING_MIP_LEVELS 
+    /// and VK_REMAINING_ARRAY_LAYERS, a aspect of VK_IMAGE_ASPECT_NONE use the image aspect
+    virtual void    StateTransition( const VkCommandBuffer in_commandBuffer, const crvkImageState_t in_state, const VkImageSubresourceRange* in_range, const uint32_t in_dstQueue );
+    virtual void    StateTransition( crvkBarrierBatch* in_batch, const crvkImageState_t in_state, const VkImageSubresourceRange* in_range, const uint32_t in_dstQueue );
+    
+    /// @brief Current layout of a subresource 
+    VkImageLayout   Layout( const uint32_t in_level, const uint32_t in_layer ) const;
+
     VkImage         Handle( void ) const;
     VkImageView     View( void ) const;
     VkDeviceMemory  Memory( void ) const;
+    VkDeviceSize    MemoryOffset( void ) const;
 
 protected:
     crvkImageHandle_t* m_imageHandle;  
+
+    bool            BindMemory( const VkDeviceMemory in_memory, const VkDeviceSize in_offset );
+
+    /// @brief The timeline values the image wait before be released, return the count 
+    uint32_t        LastUse( crvkTimelinePoint_t* out_points ) const;
+
+    /// @brief Release the view, image and memory, deferred to the device deletion queue when there are timeline values to wait 
+    void            Release( const crvkTimelinePoint_t* in_lastUse, const uint32_t in_count );
 };
 
 class crvkImageStatic : public crvkImage 
@@ -95,11 +149,16 @@ public:
         const uint32_t in_width,
         const uint32_t in_height,
         const uint32_t in_depth, 
-        const VkSampleCountFlagBits in_samples = VK_SAMPLE_COUNT_1_BIT ) override;
+        const VkSampleCountFlagBits in_samples = VK_SAMPLE_COUNT_1_BIT,
+        const VkImageUsageFlags in_usage = 0 ) override;
         
     virtual void    Destroy( void ) override;
     virtual bool    CopyFromBuffer( const VkBuffer in_srcBuffer, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count ) override;
-    virtual bool    CopyToBuffer( const VkBuffer in_dstBuffer, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count ) override;
+    /// @brief Copy the regions to a buffer 
+    /// @param out_readback if not NULL, the copy also signal the device read back ring timeline of the queue, 
+    /// receive the signaled point, it outlive this image 
+    virtual bool    CopyToBuffer( const VkBuffer in_dstBuffer, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count, crvkTimelinePoint_t* out_readback = nullptr ) override;
+    using           crvkImage::StateTransition;
     virtual void    StateTransition( const VkCommandBuffer in_commandBuffer, const crvkImageState_t in_state, const VkImageAspectFlags in_aspect, const uint32_t in_dstQueue );
 
 protected:
@@ -108,14 +167,33 @@ protected:
     VkSemaphoreSubmitInfo   WaitLastUse( void );
     VkSemaphoreSubmitInfo   WaitLastCopy( void );
 
+    /// @brief Set the semaphore and value that signal the end of the last copy 
+    void                    SetLastCopy( const VkSemaphore in_semaphore, const uint64_t in_value );
+
+    /// @brief The application last use plus the last use and copy of the internal semaphores 
+    uint32_t                LastUse( crvkTimelinePoint_t* out_points ) const;
+
+    /// @brief Take the next copy command buffer of the ring, the CPU only wait when his last copy is still pending 
+    /// @param in_queue the copy queue, flushed before the wait 
+    VkResult                NextCopyCommand( crvkDeviceQueue* in_queue );
+
 protected:
+    static const uint32_t   k_copyCommandBuffers = 4;   // copies in flight before the CPU wait a command buffer 
+
     uint64_t            m_useValue;
     uint64_t            m_copyValue;
+    uint64_t            m_lastCopyValue;        // value of the last copy 
     VkSemaphore         m_copySemaphore;
     VkSemaphore         m_useSemaphore;
+    VkSemaphore         m_lastCopySemaphore;    // semaphore of the last copy, our own or from a upload batch
     VkCommandPool       m_commandPool;
     VkCommandBuffer     m_commandBuffer;
+    uint32_t            m_copyCommand;                                  // current copy command buffer 
+    VkCommandBuffer     m_copyCommandBuffers[k_copyCommandBuffers];     // the copies ring, so a pending copy is never reset 
+    uint64_t            m_copyCommandValues[k_copyCommandBuffers];      // copy value signaled by the last submit of each 
     crvkDevice*         m_device;  
+
+    friend class crvkUploadBatch;
 };
 
 class crvkImageStaging : public crvkImageStatic 
@@ -137,10 +215,23 @@ public:
     virtual void    Destroy( void ) override;
     virtual bool    SubData( const void* in_data, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count ) override;
     virtual bool    GetSubData( void* in_data, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count ) override;
+
+    /// @brief Read back without wait the GPU, the content is delivered by crvkReadbackQueue::Poll to the callback, 
+    /// or by crvkReadbackQueue::Wait. The content start at the smallest bufferOffset of the regions 
+    /// @return the device read back queue ticket, zero on fail 
+    crvkReadbackTicket_t    GetSubDataAsync( const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count, crvkReadbackCallback_t in_callback, void* in_userData );
     
 private:
     VkBuffer        m_staging;
     VkDeviceMemory  m_memoryStaging;
+
+    /// @brief Copy the regions to a range of the device read back ring 
+    /// @param out_range the range, held until released 
+    /// @param out_begin smallest bufferOffset of the regions 
+    /// @param out_offset offset of the content in the range 
+    /// @param out_size content size 
+    /// @param out_readback if not NULL, receive the copy point on the read back ring timeline 
+    bool            ReadbackCopy( const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count, crvkStagingRange_t* out_range, VkDeviceSize* out_begin, VkDeviceSize* out_offset, VkDeviceSize* out_size, crvkTimelinePoint_t* out_readback = nullptr );
 };
 
 #endif // __CRVK_IMAGE_HPP__
\ No newline at end of file
@@ -0,0 +1,126 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+#ifndef __CRVK_MEMORY_ALLOCATOR_HPP__
+#define __CRVK_MEMORY_ALLOCATOR_HPP__
+
+typedef struct crvkMemoryBlock_t crvkMemoryBlock_t;
+typedef struct crvkMemoryAllocatorHandle_t crvkMemoryAllocatorHandle_t;
+
+/// @brief a range of device memory handed by the allocator 
+typedef struct crvkMemoryAllocation_t
+{
+    VkDeviceMemory      memory = nullptr;       // memory block handle, shared with other allocations
+    VkDeviceSize        offset = 0;             // offset of the allocation inside the block 
+    VkDeviceSize        size = 0;               // allocation size 
+    uint32_t            type = UINT32_MAX;      // memory type index 
+    uint32_t            node = UINT32_MAX;      // block internal node
+    void*               mapped = nullptr;       // CPU address of the allocation, host visible memory only
+    crvkMemoryBlock_t*  block = nullptr;        // owner block 
+} crvkMemoryAllocation_t;
+
+/// @brief allocator usage report 
+typedef struct crvkMemoryStatistics_t
+{
+    uint32_t        blockCount = 0;             // device memory blocks alive 
+    uint32_t        dedicatedBlockCount = 0;    // blocks that hold a single big allocation
+    uint32_t        allocationCount = 0;        // sub allocations alive
+    uint32_t        freeRangeCount = 0;         // free ranges inside the blocks ( fragmentation )
+    VkDeviceSize    blockBytes = 0;             // total device memory allocated 
+    VkDeviceSize    usedBytes = 0;              // bytes handed to the resources 
+    VkDeviceSize    largestFreeRange = 0;       // biggest allocation that fit without a new block
+    uint64_t        totalAllocations = 0;       // Allocate calls since creation 
+    uint64_t        totalFrees = 0;             // Free calls since creation
+} crvkMemoryStatistics_t;
+
+///
+/// @brief Device memory sub allocator, allocate big memory blocks per memory type,
+/// and hand aligned ranges of it using a two level segregated fit ( TLSF ) free list,
+/// with constant time allocation and release.
+///
+class crvkMemoryAllocator
+{
+public:
+    crvkMemoryAllocator( void );
+    ~crvkMemoryAllocator( void );
+
+    /// @brief Initialize the allocator 
+    /// @param in_device the logical device that own the memory 
+    /// @param in_memoryProperties device memory types and heaps 
+    /// @param in_nonCoherentAtomSize device nonCoherentAtomSize limit, used to align flush and invalidate ranges 
+    /// @param in_blockSize the preferred memory block size, 0 to use the default  
+    /// @return true on success
+    bool            Create( const VkDevice in_device, const VkPhysicalDeviceMemoryProperties* in_memoryProperties, const VkDeviceSize in_nonCoherentAtomSize, const VkDeviceSize in_blockSize = 0 );
+    
+    /// @brief Release all the memory blocks
+    void            Destroy( void );
+
+    /// @brief Allocate a range of memory, when the heap of a memory type is full the next type 
+    /// with the required properties is tried 
+    /// @param in_requirements resource memory requirements 
+    /// @param in_flags required memory properties 
+    /// @param in_linear true for buffers and linear images, false for optimal tiling images
+    /// @param out_allocation the allocated range 
+    /// @return true on success 
+    bool            Allocate( const VkMemoryRequirements &in_requirements, const VkMemoryPropertyFlags in_flags, const bool in_linear, crvkMemoryAllocation_t* out_allocation );
+    
+    /// @brief Return a range to the allocator 
+    /// @param in_allocation allocation to release, reset on return
+    void            Free( crvkMemoryAllocation_t* in_allocation );
+
+    /// @brief Get the allocation CPU address, host visible blocks stay mapped for their whole life 
+    /// @param in_allocation the allocation 
+    /// @return the pointer to the begin of the allocation, nullptr if not host visible 
+    void*           Map( const crvkMemoryAllocation_t* in_allocation ) const;
+    
+    /// @brief Release a pointer returned by Map, the block mapping is kept 
+    void            Unmap( const crvkMemoryAllocation_t* in_allocation ) const;
+
+    /// @brief Make CPU writes visible to the device, does nothing on coherent memory
+    /// @param in_allocation the allocation 
+    /// @param in_offset offset inside the allocation 
+    /// @param in_size range size, VK_WHOLE_SIZE to the allocation end 
+    VkResult        Flush( const crvkMemoryAllocation_t* in_allocation, const VkDeviceSize in_offset, const VkDeviceSize in_size ) const;
+
+    /// @brief Make device writes visible to the CPU, does nothing on coherent memory
+    /// @param in_allocation the allocation 
+    /// @param in_offset offset inside the allocation 
+    /// @param in_size range size, VK_WHOLE_SIZE to the allocation end 
+    VkResult        Invalidate( const crvkMemoryAllocation_t* in_allocation, const VkDeviceSize in_offset, const VkDeviceSize in_size ) const;
+
+    /// @brief Return the memory type property flags 
+    VkMemoryPropertyFlags   MemoryTypeFlags( const uint32_t in_type ) const;
+
+    /// @brief Retrieve the allocator usage 
+    /// @param out_statistics the usage report 
+    /// @param in_type memory type to report, UINT32_MAX for all 
+    void            Statistics( crvkMemoryStatistics_t* out_statistics, const uint32_t in_type = UINT32_MAX ) const;
+
+private:
+    crvkMemoryAllocatorHandle_t*    m_handle;
+
+    void            MappedRange( const crvkMemoryAllocation_t* in_allocation, const VkDeviceSize in_offset, const VkDeviceSize in_size, VkMappedMemoryRange* out_range ) const;
+
+    crvkMemoryAllocator( const crvkMemoryAllocator & ) = delete;
+    crvkMemoryAllocator operator=( const crvkMemoryAllocator & ) = delete;
+};
+
+#endif //!__CRVK_MEMORY_ALLOCATOR_HPP__
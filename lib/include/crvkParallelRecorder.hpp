@@ -0,0 +1,84 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#ifndef __CRVK_PARALLEL_RECORDER_HPP__
+#define __CRVK_PARALLEL_RECORDER_HPP__
+
+/// @brief record the draws [ in_first, in_first + in_count ) into a secondary command buffer, 
+/// called from a worker thread, the dynamic state is not inherited and must be set again 
+typedef void ( *crvkRecordChunk_t )( const VkCommandBuffer in_commandBuffer, const uint32_t in_first, const uint32_t in_count, void* in_userData );
+
+typedef struct crvkParallelRecorderHandle_t crvkParallelRecorderHandle_t;
+
+///
+/// @brief Split a draw list in chunks, record each chunk in a secondary command buffer on the 
+/// worker threads, and execute them in the primary command buffer in the draw list order. 
+/// The secondary buffers come from the calling thread pools of a crvkCommandPoolManager, so they 
+/// live until the manager frame come back.
+///
+class crvkParallelRecorder
+{
+public:
+    crvkParallelRecorder( void );
+    ~crvkParallelRecorder( void );
+
+    /// @brief Start the workers 
+    /// @param in_pools the per thread command pools 
+    /// @param in_family queue family of the primary command buffers 
+    /// @param in_threads worker count, 0 to use one per logical core, the caller thread also record 
+    /// @return true on success 
+    bool        Create( crvkCommandPoolManager* in_pools, const uint32_t in_family, const uint32_t in_threads = 0 );
+
+    /// @brief Stop the workers 
+    void        Destroy( void );
+
+    /// @brief Record the draw list and execute the chunks in the primary command buffer, 
+    /// the render pass must be begin with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS or 
+    /// VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT 
+    /// @param in_commandBuffer the primary command buffer 
+    /// @param in_inheritance render pass, subpass and frame buffer, or a VkCommandBufferInheritanceRenderingInfo 
+    /// @param in_drawCount draw list size 
+    /// @param in_record record function 
+    /// @param in_userData passed to the record function 
+    /// @param in_minChunk minimum draws per chunk, small chunks don't pay the secondary buffer cost 
+    /// @return the first error of the secondary buffers 
+    VkResult    Record( const crvkCommandBuffer* in_commandBuffer,
+                        const VkCommandBufferInheritanceInfo* in_inheritance,
+                        const uint32_t in_drawCount,
+                        crvkRecordChunk_t in_record,
+                        void* in_userData,
+                        const uint32_t in_minChunk = 256 );
+
+    /// @brief Number of worker threads 
+    uint32_t    ThreadCount( void ) const;
+
+private:
+    crvkParallelRecorderHandle_t*   m_handle;
+
+    void        Worker( void );
+    void        RecordChunks( void );
+
+    crvkParallelRecorder( const crvkParallelRecorder & ) = delete;
+    crvkParallelRecorder operator=( const crvkParallelRecorder & ) = delete;
+};
+
+#endif //!__CRVK_PARALLEL_RECORDER_HPP__
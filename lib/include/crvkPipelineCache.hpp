@@ -0,0 +1,71 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#ifndef __CRVK_PIPELINE_CACHE_HPP__
+#define __CRVK_PIPELINE_CACHE_HPP__
+
+///
+/// @brief Device pipeline cache, loaded from disk at creation and written back on destruction.
+/// The file is only used if his header match the device vendor, device id and cache UUID.
+///
+class crvkPipelineCache
+{
+public:
+    crvkPipelineCache( void );
+    ~crvkPipelineCache( void );
+
+    /// @brief Create the pipeline cache 
+    /// @param in_device the logical device 
+    /// @param in_properties the physical device properties, used to validate the cache file 
+    /// @param in_path the cache file path, nullptr to keep the cache only in memory 
+    /// @return true on success, a missing or invalid file is not a error 
+    bool            Create( const VkDevice in_device, const VkPhysicalDeviceProperties* in_properties, const char* in_path );
+    
+    /// @brief Write the cache back to the file and release it 
+    void            Destroy( void );
+
+    /// @brief Write the cache data to the file, we write to a temporary file and rename it over the old one 
+    /// @return false if we fail to write the file
+    bool            Save( void ) const;
+
+    /// @brief the cache handle, to be used in the pipeline creation 
+    VkPipelineCache Cache( void ) const { return m_cache; }
+
+    /// @brief true if the cache was created from a valid file 
+    bool            Loaded( void ) const { return m_loaded; }
+
+private:
+    bool            m_loaded;
+    uint32_t        m_vendorID;
+    uint32_t        m_deviceID;
+    uint8_t         m_uuid[VK_UUID_SIZE];
+    char*           m_path;
+    VkPipelineCache m_cache;
+    VkDevice        m_device;
+
+    bool            ValidateHeader( const void* in_data, const size_t in_size ) const;
+
+    crvkPipelineCache( const crvkPipelineCache & ) = delete;
+    crvkPipelineCache operator=( const crvkPipelineCache & ) = delete;
+};
+
+#endif //!__CRVK_PIPELINE_CACHE_HPP__
@@ -43,6 +43,16 @@ typedef struct crvkQueueInfo_t
     uint32_t    index = UINT32_MAX;
 } crvkQueueInfo_t;
 
+/// @brief submission thread statistics, times in nanoseconds 
+typedef struct crvkQueueSubmitStats_t
+{
+    uint64_t    entries = 0;        // submits and presents sent 
+    uint64_t    batches = 0;        // vkQueueSubmit2 calls 
+    uint64_t    lastLatency = 0;    // from the enqueue to the driver call, of the last entry 
+    uint64_t    maxLatency = 0;
+    uint64_t    totalLatency = 0;   // divide by entries to get the average 
+} crvkQueueSubmitStats_t;
+
 class crvkDeviceQueue
 {
 public:
@@ -61,6 +71,70 @@ public:
                     const uint32_t in_signalSemaphoreInfoCount, 
                     const VkFence in_fence );
 
+    /// @brief Submit a batch, in deferred mode the batch is copied and queued until the next flush. Safe from
+    /// any thread, a batch with pNext chains can't be copied, so it is sent at once after the queued ones 
+    /// @param in_submits submit infos 
+    /// @param in_count number of submit infos 
+    /// @param in_fence signaled when the work finish, a fence flush the queued batches with this one 
+    /// @return the vkQueueSubmit2 result, VK_SUCCESS when queued 
+    VkResult    Submit( const VkSubmitInfo2* in_submits, const uint32_t in_count, const VkFence in_fence = nullptr );
+
+    /// @brief Send all the queued batches in a single vkQueueSubmit2, with the submission thread 
+    /// wait it send everything pushed before 
+    /// @param in_fence signaled when all the batches finish 
+    /// @return the vkQueueSubmit2 result, with the submission thread the first failed submit since the last Flush 
+    VkResult    Flush( const VkFence in_fence = nullptr );
+
+    /// @brief In deferred mode the submits are queued until Flush, Present or WaitIdle, 
+    /// leaving the deferred mode flush the queue 
+    void        SetDeferred( const bool in_deferred );
+    bool        Deferred( void ) const;
+
+    /// @brief Number of queued batches 
+    uint32_t    PendingCount( void ) const;
+
+    /// @brief Start a thread that own the VkQueue, the producers push submits and presents in 
+    /// a lock free ring and never wait the queue. While it run Submit, Present, Flush and WaitIdle 
+    /// go through the ring, Present and WaitIdle wait the thread 
+    /// @param in_capacity ring entries, rounded to power of two 
+    /// @return true on success 
+    bool        StartSubmitThread( const uint32_t in_capacity = 64 );
+
+    /// @brief Send the remaining entries and stop the thread, no producer can be pushing 
+    void        StopSubmitThread( void );
+
+    /// @brief true if the submission thread run 
+    bool        SubmitThread( void ) const;
+
+    /// @brief Push a batch to the submission thread, safe from any thread 
+    /// @param in_submits submit infos, copied, a batch with pNext chains is not copied and the call wait the thread send it 
+    /// @param in_count number of submit infos 
+    /// @param in_fence signaled when the work finish 
+    /// @return the Timeline value signaled when the work finish, 0 if the thread don't run. When the submit fail 
+    /// the value and the fence are still signaled, so the waits never hang, and the error is kept for LastSubmitResult 
+    uint64_t    SubmitAsync( const VkSubmitInfo2* in_submits, const uint32_t in_count, const VkFence in_fence = nullptr );
+
+    /// @brief Push a present to the submission thread, without wait the result, see LastPresentResult 
+    void        PresentAsync( 
+        const VkSwapchainKHR* in_swapchains,
+        const uint32_t* in_imageIndices,
+        const uint32_t in_swapchainCount,
+        const VkSemaphore* in_waitSemaphores,
+        const uint32_t in_waitSemaphoresCount );
+
+    /// @brief Timeline semaphore of the SubmitAsync values 
+    VkSemaphore Timeline( void ) const;
+
+    /// @brief Result of the last present sent by the submission thread 
+    VkResult    LastPresentResult( void ) const;
+
+    /// @brief First failed submit of the submission thread not reported yet by Flush or WaitIdle 
+    VkResult    LastSubmitResult( void ) const;
+
+    /// @brief Submission thread latency and batching statistics 
+    void        SubmitStats( crvkQueueSubmitStats_t* out_stats ) const;
+
+    /// @brief Present the swapchain images, flush the queued batches first 
     VkResult    Present( 
         const VkSwapchainKHR* in_swapchains,
         const uint32_t* in_imageIndices,
@@ -68,7 +142,8 @@ public:
         const VkSemaphore* in_waitSemaphores,
         const uint32_t in_waitSemaphoresCount );
 
-    VkResult    WaitIdle( void ) const;
+    /// @brief Flush the queued batches and wait the queue finish 
+    VkResult    WaitIdle( void );
 
     /// @brief Queue family index
     /// @return UINT32_MAX if not valid
@@ -93,6 +168,8 @@ protected:
 private:
     crvkQueueHandle_t*  m_handle;
 
+    void    SubmitWorker( void );
+
     crvkDeviceQueue( const crvkDeviceQueue & ) = delete;
     crvkDeviceQueue operator=( const crvkDeviceQueue & ) = delete;
 };
@@ -0,0 +1,94 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#ifndef __CRVK_RANGE_ALLOCATOR_HPP__
+#define __CRVK_RANGE_ALLOCATOR_HPP__
+
+typedef struct crvkRangeAllocatorHandle_t crvkRangeAllocatorHandle_t;
+
+///
+/// @brief Two level segregated fit ( TLSF ) range allocator, hand aligned ranges of a fixed size
+/// space with constant time allocation and release. It only manage offsets, the memory allocator 
+/// use one for each device memory block, and it work without a device.
+///
+class crvkRangeAllocator
+{
+public:
+    static const uint32_t       k_invalidRange = UINT32_MAX;
+    static const VkDeviceSize   k_minAlignment = 16;    // every range start aligned to this, and the sizes rounded to it 
+
+    crvkRangeAllocator( void );
+    ~crvkRangeAllocator( void );
+
+    /// @brief Initialize the space with a single free range 
+    /// @param in_size the space size 
+    /// @return true on success 
+    bool            Create( const VkDeviceSize in_size );
+
+    /// @brief Forget all the ranges 
+    void            Destroy( void );
+
+    /// @brief Get a aligned range 
+    /// @param in_size range size 
+    /// @param in_alignment range offset alignment ( power of two )
+    /// @param out_range the range index, used by Free, Offset and Size 
+    /// @return false if no free range fit 
+    bool            Allocate( const VkDeviceSize in_size, const VkDeviceSize in_alignment, uint32_t* out_range );
+
+    /// @brief Return a range, merging it with the free neighbors 
+    void            Free( const uint32_t in_range );
+
+    VkDeviceSize    Offset( const uint32_t in_range ) const;
+    VkDeviceSize    Size( const uint32_t in_range ) const;
+
+    /// @brief The space size 
+    VkDeviceSize    Capacity( void ) const;
+
+    /// @brief Bytes handed to live ranges, alignment padding excluded 
+    VkDeviceSize    Used( void ) const;
+
+    /// @brief Live ranges 
+    uint32_t        AllocationCount( void ) const;
+
+    /// @brief Ranges on the free lists ( fragmentation )
+    uint32_t        FreeRangeCount( void ) const;
+
+    /// @brief Biggest free range 
+    VkDeviceSize    LargestFree( void ) const;
+
+    /// @brief Walk the ranges and check the links, free lists and counters, for debug and tests 
+    /// @return true if the allocator is consistent 
+    bool            Validate( void ) const;
+
+private:
+    crvkRangeAllocatorHandle_t* m_handle;
+
+    uint32_t        NewNode( void );
+    void            ReleaseNode( const uint32_t in_node );
+    void            InsertFree( const uint32_t in_node );
+    void            RemoveFree( const uint32_t in_node );
+
+    crvkRangeAllocator( const crvkRangeAllocator & ) = delete;
+    crvkRangeAllocator operator=( const crvkRangeAllocator & ) = delete;
+};
+
+#endif //!__CRVK_RANGE_ALLOCATOR_HPP__
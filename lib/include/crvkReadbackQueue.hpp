@@ -0,0 +1,98 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#ifndef __CRVK_READBACK_QUEUE_HPP__
+#define __CRVK_READBACK_QUEUE_HPP__
+
+/// @brief Identify a asynchronous read back, zero is never a valid ticket 
+typedef uint64_t crvkReadbackTicket_t;
+
+/// @brief Called when a read back finish 
+/// @param in_data the read content, point to the mapped read back ring and is only valid during the call 
+/// @param in_size the content size 
+/// @param in_userData the pointer given with the read back 
+typedef void (*crvkReadbackCallback_t)( const void* in_data, const VkDeviceSize in_size, void* in_userData );
+
+typedef struct crvkReadbackQueueHandle_t crvkReadbackQueueHandle_t;
+
+///
+/// @brief Device asynchronous read back queue. Holds the read back ring ranges of the copies in 
+/// flight with the timeline value that end them, Poll read the semaphores once and call the callbacks 
+/// of the finished ones, so the CPU never stall waiting the GPU. Poll should be called once a frame.
+///
+class crvkReadbackQueue
+{
+public:
+    crvkReadbackQueue( void );
+    ~crvkReadbackQueue( void );
+
+    /// @brief Initialize the queue, the device read back ring must exist 
+    /// @param in_device the owner device 
+    /// @return true on success 
+    bool                    Create( const crvkDevice* in_device );
+
+    /// @brief Wait the GPU end the pending copies and give back his ranges, without call the callbacks 
+    void                    Destroy( void );
+
+    /// @brief Track a read back ring range written by a submitted copy, the range is released after the callback
+    /// @param in_range the range, allocated from the device read back ring and never submitted by it 
+    /// @param in_offset offset of the content inside the range 
+    /// @param in_size the content size 
+    /// @param in_copy the timeline value signaled by the copy, on a semaphore that outlive the entry, 
+    /// like the read back ring timeline, never the copied object own semaphore 
+    /// @param in_queue the queue of the copy, flushed before wait a deferred submit, can be nullptr 
+    /// @param in_callback called when the copy finish, can be nullptr to only use Wait 
+    /// @param in_userData given to the callback 
+    /// @return the read back ticket 
+    crvkReadbackTicket_t    Enqueue( 
+        const crvkStagingRange_t* in_range, 
+        const VkDeviceSize in_offset, 
+        const VkDeviceSize in_size, 
+        const crvkTimelinePoint_t* in_copy, 
+        crvkDeviceQueue* in_queue, 
+        crvkReadbackCallback_t in_callback, 
+        void* in_userData );
+
+    /// @brief Call the callbacks of the finished read backs, in the order they are made, only one counter query by semaphore 
+    /// @return number of read backs finished 
+    uint32_t                Poll( void );
+
+    /// @brief True if the read back content is available, or was already delivered 
+    bool                    IsReady( const crvkReadbackTicket_t in_ticket ) const;
+
+    /// @brief CPU wait a read back, copy the content to out_data and call his callback 
+    /// @param in_ticket the read back ticket 
+    /// @param out_data if not NULL, receive the content 
+    /// @return false if the ticket was already delivered by Poll, or the wait fail 
+    bool                    Wait( const crvkReadbackTicket_t in_ticket, void* out_data = nullptr );
+
+    /// @brief Number of read backs waiting the GPU 
+    uint32_t                Pending( void ) const;
+
+private:
+    crvkReadbackQueueHandle_t*  m_handle;
+
+    crvkReadbackQueue( const crvkReadbackQueue & ) = delete;
+    crvkReadbackQueue operator=( const crvkReadbackQueue & ) = delete;
+};
+
+#endif //!__CRVK_READBACK_QUEUE_HPP__
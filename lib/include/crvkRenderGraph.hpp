@@ -0,0 +1,166 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#ifndef __CRVK_RENDER_GRAPH_HPP__
+#define __CRVK_RENDER_GRAPH_HPP__
+
+/// @brief record the pass commands, the pass resources are already in the declared state 
+typedef void ( *crvkRenderPassRecord_t )( const VkCommandBuffer in_commandBuffer, void* in_userData );
+
+/// @brief a transient image, created and placed in memory by the graph 
+typedef struct crvkRenderGraphImageDesc_t
+{
+    VkImageViewType         type = VK_IMAGE_VIEW_TYPE_2D;
+    VkFormat                format = VK_FORMAT_UNDEFINED;
+    uint16_t                levels = 1;
+    uint16_t                layers = 1;
+    uint32_t                width = 0;
+    uint32_t                height = 0;
+    uint32_t                depth = 1;
+    VkSampleCountFlagBits   samples = VK_SAMPLE_COUNT_1_BIT;
+    VkImageUsageFlags       usage = 0;  // extra usage, like VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT 
+} crvkRenderGraphImageDesc_t;
+
+/// @brief a transient buffer, created and placed in memory by the graph 
+typedef struct crvkRenderGraphBufferDesc_t
+{
+    VkDeviceSize            size = 0;
+    VkBufferUsageFlags      usage = 0;
+} crvkRenderGraphBufferDesc_t;
+
+typedef struct crvkRenderGraphHandle_t crvkRenderGraphHandle_t;
+
+///
+/// @brief A frame graph. The passes declare the state they need from each resource, and Compile 
+/// remove the passes that don't contribute to a imported resource, order the rest, and place the 
+/// transient resources with lifetimes that don't overlap in the same memory. Execute record the 
+/// state transitions of each pass as a single barrier before his record callback.
+/// 
+/// The compiled passes are split in batches at each change of queue family, each batch is recorded in 
+/// his own command buffer and submitted to the queue of his family, waiting the previous batch on the 
+/// graph timeline semaphore. When a resource change of family the release barrier go at the end of the 
+/// last batch of the old family, and the acquire in the batch of the pass.
+///
+class crvkRenderGraph
+{
+public:
+    static const uint32_t k_invalid = UINT32_MAX;
+
+    crvkRenderGraph( void );
+    ~crvkRenderGraph( void );
+
+    /// @brief Initialize the graph 
+    /// @param in_device the device of the transient resources 
+    /// @param in_queue the queue of the transient buffers and the passes without family 
+    /// @return true on success 
+    bool        Create( const crvkDevice* in_device, const crvkDeviceQueue* in_queue );
+
+    /// @brief Release the transient resources and the graph timeline, they go to the device deletion 
+    /// queue and are destroyed when the GPU finish the last Execute 
+    void        Destroy( void );
+
+    /// @brief Remove the passes and resources, the transient resources go to the device deletion queue 
+    void        Reset( void );
+
+    /// @brief Use a image owned by the application, imported resources are the graph outputs
+    /// @param in_image the image 
+    /// @param in_exclusive true if the image is used with a exclusive sharing and need queue ownership transfers
+    /// @return the resource id 
+    uint32_t    ImportImage( crvkImage* in_image, const bool in_exclusive = false );
+
+    /// @brief Use a buffer owned by the application, imported resources are the graph outputs
+    /// @param in_buffer the buffer 
+    /// @param in_exclusive true if the buffer is used with a exclusive sharing and need queue ownership transfers
+    /// @return the resource id 
+    uint32_t    ImportBuffer( crvkBuffer* in_buffer, const bool in_exclusive = false );
+
+    /// @brief Declare a image that only live inside the graph 
+    /// @return the resource id 
+    uint32_t    CreateImage( const char* in_name, const crvkRenderGraphImageDesc_t* in_desc );
+
+    /// @brief Declare a buffer that only live inside the graph 
+    /// @return the resource id 
+    uint32_t    CreateBuffer( const char* in_name, const crvkRenderGraphBufferDesc_t* in_desc );
+
+    /// @brief Add a pass, the passes are ordered by the resource use, the declaration order is 
+    /// the order the reads see the writes 
+    /// @param in_name pass name, used by Dump 
+    /// @param in_family the queue family of the pass, k_invalid for the graph queue 
+    /// @param in_record record function 
+    /// @param in_userData passed to the record function 
+    /// @return the pass id 
+    uint32_t    AddPass( const char* in_name, const uint32_t in_family, crvkRenderPassRecord_t in_record, void* in_userData );
+
+    /// @brief Declare the state a pass need from a image, the write states make the pass a writer 
+    /// @param in_range a range of mips and layers, nullptr for the whole image 
+    void        UseImage( const uint32_t in_pass, const uint32_t in_image, const crvkImageState_t in_state, const VkImageSubresourceRange* in_range = nullptr );
+
+    /// @brief Declare the state a pass need from a buffer, the write states make the pass a writer 
+    /// @param in_size can be VK_WHOLE_SIZE 
+    void        UseBuffer( const uint32_t in_pass, const uint32_t in_buffer, const crvkBufferState_t in_state, const VkDeviceSize in_offset = 0, const VkDeviceSize in_size = VK_WHOLE_SIZE );
+
+    /// @brief Keep the passes that write a transient resource, like a resource read back by the application 
+    void        SetOutput( const uint32_t in_resource );
+
+    /// @brief Cull and order the passes and create the transient resources, the old transient resources 
+    /// go to the device deletion queue and are destroyed when the GPU finish the last Execute 
+    /// @return true on success 
+    bool        Compile( void );
+
+    /// @brief Record and submit the compiled passes, a batch for each run of passes of the same queue family. 
+    /// Each batch wait the previous one on the graph timeline, the first one wait the last batch of the 
+    /// previous Execute. The batches of deferred queues are sent on the queue next Flush 
+    /// @param in_pools give the batch command buffers, they must live until the GPU finish them 
+    /// @param in_count number of queues 
+    /// @param in_queues a queue for each queue family used by the passes 
+    /// @param in_wait a timeline value the first batch wait, like the frame begin, can be nullptr 
+    /// @param out_done if not NULL, receive the graph timeline value signaled by the last batch 
+    /// @return false if a pass family don't have a queue, or a batch fail to record or submit 
+    bool        Execute( crvkCommandPoolManager* in_pools, const uint32_t in_count, crvkDeviceQueue* const* in_queues, const crvkTimelinePoint_t* in_wait, crvkTimelinePoint_t* out_done );
+
+    /// @brief Get a graph image, transient images are only valid after Compile 
+    crvkImage*  Image( const uint32_t in_resource ) const;
+
+    /// @brief Get a graph buffer, transient buffers are only valid after Compile 
+    crvkBuffer* Buffer( const uint32_t in_resource ) const;
+
+    /// @brief Print the compiled graph: the pass order, the culled passes, the transient lifetimes,
+    /// the memory aliasing and the barrier counters 
+    void        Dump( void ) const;
+
+private:
+    crvkRenderGraphHandle_t*    m_handle;
+
+    void        Cull( void );
+    void        Sort( void );
+    bool        Alias( void );
+    void        ReleaseTransients( void );
+    uint32_t    OpenBatch( crvkCommandPoolManager* in_pools, crvkDeviceQueue* const* in_queues, const uint32_t in_count, const uint32_t in_family, const uint32_t in_position );
+    uint32_t    ReleaseBatch( crvkCommandPoolManager* in_pools, crvkDeviceQueue* const* in_queues, const uint32_t in_count, const uint32_t in_family, const uint32_t in_batch );
+    bool        SubmitBatches( crvkDeviceQueue* const* in_queues, const crvkTimelinePoint_t* in_wait );
+    void        Transition( const uint32_t in_access, const uint32_t in_batch, crvkCommandPoolManager* in_pools, crvkDeviceQueue* const* in_queues, const uint32_t in_count );
+
+    crvkRenderGraph( const crvkRenderGraph & ) = delete;
+    crvkRenderGraph operator=( const crvkRenderGraph & ) = delete;
+};
+
+#endif //!__CRVK_RENDER_GRAPH_HPP__
@@ -0,0 +1,78 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#ifndef __CRVK_SHADER_CACHE_HPP__
+#define __CRVK_SHADER_CACHE_HPP__
+
+typedef struct crvkShaderCacheHandle_t crvkShaderCacheHandle_t;
+
+///
+/// @brief Content addressed SPIR-V cache, the key is a hash of everything that change the compiler output
+/// ( source, stage, defines and target versions ). Entries are kept in memory, and in a directory on disk
+/// as "<key>.spv" files, so a hit skip glslang entirely.
+///
+class crvkShaderCache
+{
+public:
+    crvkShaderCache( void );
+    ~crvkShaderCache( void );
+
+    /// @brief Create the cache 
+    /// @param in_path the cache directory, created if missing, nullptr to keep the cache only in memory 
+    /// @return true on success 
+    bool            Create( const char* in_path );
+
+    /// @brief Release the memory entries, the disk entries are kept 
+    void            Destroy( void );
+
+    /// @brief Find a SPIR-V binary, in memory and then on disk 
+    /// @param in_key the entry key 
+    /// @param out_code receive the SPIR-V words 
+    /// @return true on a hit 
+    bool            Find( const uint64_t in_key, crvkDynamicVector<uint32_t> &out_code );
+
+    /// @brief Store a SPIR-V binary, in memory and on disk 
+    /// @param in_key the entry key 
+    /// @param in_code the SPIR-V words 
+    /// @param in_count the word count 
+    void            Store( const uint64_t in_key, const uint32_t* in_code, const uint32_t in_count );
+
+    /// @brief Number of lookups found in the cache 
+    uint64_t        Hits( void ) const;
+    
+    /// @brief Number of lookups that had to compile 
+    uint64_t        Misses( void ) const;
+
+    /// @brief 64 bit FNV-1a hash, used to build the cache keys 
+    /// @param in_data data to hash 
+    /// @param in_size data size in bytes 
+    /// @param in_seed previous hash to chain, or the default offset basis 
+    static uint64_t Hash( const void* in_data, const size_t in_size, const uint64_t in_seed = 0xcbf29ce484222325ull );
+
+private:
+    crvkShaderCacheHandle_t*    m_handle;
+
+    crvkShaderCache( const crvkShaderCache & ) = delete;
+    crvkShaderCache operator=( const crvkShaderCache & ) = delete;
+};
+
+#endif //!__CRVK_SHADER_CACHE_HPP__
@@ -0,0 +1,68 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#ifndef __CRVK_SHADER_COMPILER_HPP__
+#define __CRVK_SHADER_COMPILER_HPP__
+
+typedef struct crvkShaderCompilerHandle_t crvkShaderCompilerHandle_t;
+
+///
+/// @brief Shader compiler worker pool. The shaders of each program are parsed in parallel, 
+/// and the program is linked by the worker that finish the last parse, so many programs 
+/// are compiled at the same time. Use crvkGLSLProgram::LinkProgramAsync to feed it. 
+///
+class crvkShaderCompiler
+{
+public:
+    crvkShaderCompiler( void );
+    ~crvkShaderCompiler( void );
+
+    /// @brief Start the workers, glslang must be initialized ( crvkContext::Create ) 
+    /// @param in_threads worker count, 0 to use one per logical core 
+    /// @return true on success 
+    bool        Create( const uint32_t in_threads = 0 );
+
+    /// @brief Finish the queued work and stop the workers 
+    void        Destroy( void );
+
+    /// @brief Number of worker threads 
+    uint32_t    ThreadCount( void ) const;
+
+protected:
+    friend class crvkGLSLProgram;
+
+    /// @brief Queue the parse of the program shaders 
+    void        Enqueue( crvkGLSLProgram* in_program );
+
+    /// @brief Block until the program link finish 
+    void        Wait( const crvkGLSLProgram* in_program );
+
+private:
+    crvkShaderCompilerHandle_t* m_handle;
+
+    void        Worker( void );
+
+    crvkShaderCompiler( const crvkShaderCompiler & ) = delete;
+    crvkShaderCompiler operator=( const crvkShaderCompiler & ) = delete;
+};
+
+#endif //!__CRVK_SHADER_COMPILER_HPP__
@@ -25,6 +25,15 @@
 typedef struct glslang_shader_s glslang_shader_t;
 typedef struct glslang_program_s glslang_program_t;
 typedef struct glslang_input_s glslang_input_t;
+class crvkShaderCache;
+class crvkShaderCompiler;
+
+enum crvkShaderCompileStatus_t : uint8_t
+{
+    CRVK_SHADER_COMPILE_STATUS_READY = 0,   // stages created 
+    CRVK_SHADER_COMPILE_STATUS_PENDING,     // waiting the compiler workers 
+    CRVK_SHADER_COMPILE_STATUS_FAILED       // parse, link or module creation failed 
+};
 
 class crvkProgram
 {
@@ -40,12 +49,34 @@ class crvkGLSLShader : public crvkProgram
 public:
     crvkGLSLShader( void );
     ~crvkGLSLShader( void );
-    bool                            Create( const crvkDevice* in_device, const VkShaderStageFlagBits in_stage, const char * in_sources );
+
+    /// @brief Setup the shader, the source is only parsed when a program that use it miss the shader cache 
+    /// @param in_device 
+    /// @param in_stage 
+    /// @param in_sources the GLSL source 
+    /// @param in_defines preamble inserted before the source, like "#define FOO 1\n", can be nullptr 
+    /// @return true on sucess 
+    bool                            Create( const crvkDevice* in_device, const VkShaderStageFlagBits in_stage, const char * in_sources, const char* in_defines = nullptr );
     void                            Destroy( void );
     VkShaderStageFlagBits           ShaderStageFlag( void ) const { return m_stage; }
     glslang_shader_t*               Shader( void ) const { return m_shdhnd; }
+
+    /// @brief Hash of source, stage, defines and target versions 
+    uint64_t                        Key( void ) const { return m_key; }
+
+protected:
+    friend class crvkGLSLProgram;
+    friend class crvkShaderCompiler;
+
+    /// @brief Preprocess and parse the shader source
+    bool                            Parse( void );
+
 private:
+    bool                            m_parsed;
     VkShaderStageFlagBits           m_stage;
+    uint64_t                        m_key;
+    char*                           m_source;
+    char*                           m_defines;
     crvkDevice*                     m_device;
     crvkPointer<glslang_input_t>    m_shaderCI;
     glslang_shader_t*               m_shdhnd;  
@@ -59,14 +90,46 @@ public:
     void                                            Create( const crvkDevice* in_device );
     void                                            Destroy( void );
     void                                            AttachShader( const crvkGLSLShader* in_shader );
+
+    /// @brief Create the shader modules, from the device shader cache when we can, 
+    /// only the stages that miss the cache are compiled by glslang
     bool                                            LinkProgram( void );
+
+    /// @brief Same as LinkProgram, but the shaders are parsed and the program linked by the compiler workers.
+    /// The attached shaders must not be used by other program until this one is ready 
+    /// @param in_compiler the worker pool 
+    /// @return false if the cache lookup fail 
+    bool                                            LinkProgramAsync( crvkShaderCompiler* in_compiler );
+
+    /// @brief true when the async link finished, with success or not 
+    bool                                            IsReady( void ) const;
+    
+    /// @brief Wait the async link 
+    /// @return true if the shader stages are ready to be used 
+    bool                                            Wait( void );
+
     virtual const uint32_t                          PipelineShaderStagesCount( void ) const { return m_stages.Count(); }
     virtual const VkPipelineShaderStageCreateInfo*  PipelineShaderStages( void ) const; 
 
+protected:
+    friend class crvkShaderCompiler;
+
+    /// @brief Parse, link and generate the stages that are not in the cache 
+    bool                                            Compile( void );
+
 private:
+    std::atomic<uint8_t>                                m_status;   // crvkShaderCompileStatus_t 
+    std::atomic<uint32_t>                               m_pending;  // shaders left to parse 
     glslang_program_t*                                  m_program;
     VkDevice                                            m_device;
+    crvkShaderCache*                                    m_cache;
+    crvkShaderCompiler*                                 m_compiler;
+    crvkDynamicVector<crvkGLSLShader*>                  m_shaders;
+    crvkDynamicVector<uint64_t>                         m_stageKeys;
     crvkDynamicVector<VkPipelineShaderStageCreateInfo>  m_stages;
+
+    bool                                            LoadCached( uint32_t* out_missing );
+    bool                                            CreateModule( const uint32_t in_stage, const uint32_t* in_code, const uint32_t in_count );
 };
 
 class crvkSpirVProgram : public crvkProgram
@@ -24,8 +24,12 @@
 
 typedef struct crvkSwapchainHandle_t crvkSwapchainHandle_t;
 
+class crvkImage;
+
 ///
-/// @brief Basic swapchain implementation, based on frame counter and syncs
+/// @brief Basic swapchain implementation, based on frame counter and syncs.
+/// The frames are paced by a timeline semaphore, frame N signal N at present, 
+/// and the acquire of frame N wait N - FramesInFlight
 ///
 class crvkSwapchain
 {
@@ -37,7 +41,7 @@ public:
     /// @param in_device 
     /// @param in_graphic the device graphic queue
     /// @param in_present the device present queue
-    /// @param in_frames the number of concurrent frames that we can roll whit the swapchain
+    /// @param in_frames the number of concurrent frames that we can roll whit the swapchain, and the initial frames in flight
     /// @param in_extent the swapchain images proportion
     /// @param in_surfaceformat the image format of the swapchain 
     /// @param in_presentMode the presentation mode 
@@ -59,11 +63,28 @@ public:
     /// @param  
     virtual void    Destroy( void );
 
-    VkResult        AcquireImage( void );
+    /// @brief Wait the GPU finish the frame N - FramesInFlight and acquire the next image 
+    virtual VkResult    AcquireImage( void );
+
+    /// @brief This will present to screen, and swapbuffers, signal the frame value in the graphic queue 
+    /// after all the work submited in the frame 
+    /// @return the present result, VK_SUBOPTIMAL_KHR or VK_ERROR_OUT_OF_DATE_KHR when the swapchain must be recreated 
+    virtual VkResult    PresentImage( const VkSemaphore* in_waitSemaphores, const uint32_t in_waitSemaphoresCount );
+
+    /// @brief Change how many frames the CPU can record ahead of the GPU, without recreate the swapchain,
+    /// less frames lower the latency, more frames keep the GPU busy 
+    /// @param in_frames frames in flight, clamped between 1 and FrameCount 
+    void                SetFramesInFlight( const uint32_t in_frames );
+    uint32_t            FramesInFlight( void ) const;
 
-    /// @brief This will present to screen, and swapbuffers
-    /// @return 
-    VkResult    PresentImage( const VkSemaphore* in_waitSemaphores, const uint32_t in_waitSemaphoresCount );
+    /// @brief Timeline semaphore signaled with the frame number when the GPU finish a frame 
+    VkSemaphore         FrameSemaphore( void ) const;
+
+    /// @brief The value the current frame signal, to use with SetLastUse of the resources used in the frame 
+    uint64_t            FrameValue( void ) const;
+
+    /// @brief CPU time the last AcquireImage spent waiting the GPU, in nanoseconds 
+    uint64_t            FrameWaitTime( void ) const;
 
     /// @brief Return the swapchain frame buffer count 
     const VkImage*      Images( void ) const;
@@ -83,4 +104,52 @@ protected:
     crvkSwapchainHandle_t*          m_handle;
 };
 
+///
+/// @brief Offscreen swapchain stand-in, for headless contexts
+/// Keep the AcquireImage/PresentImage contract of the crvkSwapchain, but roll over a ring of crvkImage render targets,
+/// CurrentSemaphore is signaled when the image is ready to be rendered, and PresentImage consume the wait semaphores  
+///
+class crvkSwapchainOffscreen : public crvkSwapchain
+{
+public:
+    crvkSwapchainOffscreen( void );
+    ~crvkSwapchainOffscreen( void );
+
+    /// @brief Create the render target ring
+    /// @param in_device 
+    /// @param in_graphic the queue used to signal acquire and consume present semaphores
+    /// @param in_frames the number of concurrent frames, and render targets, in the ring 
+    /// @param in_extent the render targets size 
+    /// @param in_format the render targets format 
+    /// @return true on sucess, false on error 
+    bool    Create( const crvkDevice* in_device,
+                    const crvkDeviceQueue* in_graphic,
+                    const uint32_t in_frames, 
+                    const VkExtent2D in_extent, 
+                    const VkFormat in_format );
+
+    virtual void        Destroy( void ) override;
+
+    /// @brief Wait the next render target in the ring be released by his last present 
+    virtual VkResult    AcquireImage( void ) override;
+
+    /// @brief Consume the wait semaphores and release the render target, no screen involved 
+    virtual VkResult    PresentImage( const VkSemaphore* in_waitSemaphores, const uint32_t in_waitSemaphoresCount ) override;
+
+    /// @brief Return the current render target, to read back the rendered image 
+    const crvkImage*    CurrentTarget( void ) const;
+    
+    /// @brief Timeline semaphore signaled by each PresentImage, with the value returned by PresentValue, 
+    /// the same of FrameSemaphore 
+    VkSemaphore         PresentSemaphore( void ) const { return FrameSemaphore(); }
+    uint64_t            PresentValue( void ) const { return m_presentValue; }
+
+private:
+    uint64_t            m_presentValue;         // last value signaled by a present 
+    crvkImage*          m_targets;              // render targets ring 
+
+    crvkSwapchainOffscreen( const crvkSwapchainOffscreen & ) = delete;
+    crvkSwapchainOffscreen operator=( const crvkSwapchainOffscreen & ) = delete;
+};
+
 #endif //!__CRVK_SWAPCHAIN_HPP__
\ No newline at end of file
@@ -0,0 +1,92 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#ifndef __CRVK_UPLOAD_BATCH_HPP__
+#define __CRVK_UPLOAD_BATCH_HPP__
+
+typedef struct crvkUploadBatchHandle_t crvkUploadBatchHandle_t;
+class crvkBufferStatic;
+class crvkImageStatic;
+
+///
+/// @brief Gather the staging copies of many buffers and images, and record them 
+/// in a single command buffer. Every touched resource wait on the single timeline 
+/// value signaled by the batch submit. A batch must be used by one thread at time.
+///
+class crvkUploadBatch
+{
+public:
+    crvkUploadBatch( void );
+    ~crvkUploadBatch( void );
+
+    /// @brief Create the batch command buffers 
+    /// @param in_device the owner device 
+    /// @param in_queue the queue used to submit the copies 
+    /// @return true on success
+    bool        Create( const crvkDevice* in_device, const crvkDeviceQueue* in_queue );
+
+    /// @brief Release the command buffers, wait for the submited batches to finish
+    void        Destroy( void );
+
+    /// @brief Queue a buffer upload, the content is copied to the staging ring before return
+    /// @param in_buffer the destine buffer 
+    /// @param in_data source content 
+    /// @param in_offset destine offset 
+    /// @param in_size content size 
+    /// @return false if the content don't fit in the staging ring 
+    bool        BufferSubData( crvkBufferStatic* in_buffer, const void* in_data, const uintptr_t in_offset, const size_t in_size );
+
+    /// @brief Queue a image upload, the content is copied to the staging ring before return
+    /// @param in_image the destine image 
+    /// @param in_data source content 
+    /// @param in_size source content size 
+    /// @param in_regions copy regions, bufferOffset is relative to in_data 
+    /// @param in_count regions count 
+    /// @return false if the content don't fit in the staging ring 
+    bool        ImageSubData( crvkImageStatic* in_image, const void* in_data, const size_t in_size, const VkBufferImageCopy2* in_regions, const uint32_t in_count );
+
+    /// @brief Record all the queued copies and submit then 
+    /// @return the timeline value signaled by the batch, 0 if there was nothing to submit or on error 
+    uint64_t    Submit( void );
+
+    /// @brief CPU wait for a batch to finish 
+    /// @param in_value the value returned by Submit 
+    VkResult    Wait( const uint64_t in_value ) const;
+
+    /// @brief Timeline semaphore signaled by the batch submits 
+    VkSemaphore Semaphore( void ) const;
+    
+    /// @brief Number of copies waiting for the next submit 
+    uint32_t    PendingCount( void ) const;
+
+private:
+    crvkUploadBatchHandle_t*    m_handle;
+
+    void        RecordBuffers( const VkCommandBuffer in_commandBuffer );
+    void        RecordImages( const VkCommandBuffer in_commandBuffer );
+    void        Discard( void );
+
+    crvkUploadBatch( const crvkUploadBatch & ) = delete;
+    crvkUploadBatch operator=( const crvkUploadBatch & ) = delete;
+};
+
+#endif //!__CRVK_UPLOAD_BATCH_HPP__
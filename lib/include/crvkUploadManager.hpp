@@ -0,0 +1,105 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+#ifndef __CRVK_UPLOAD_MANAGER_HPP__
+#define __CRVK_UPLOAD_MANAGER_HPP__
+
+typedef struct crvkUploadManagerHandle_t crvkUploadManagerHandle_t;
+
+/// @brief a range of the device staging ring 
+typedef struct crvkStagingRange_t
+{
+    VkBuffer        buffer = nullptr;       // staging ring buffer handle 
+    VkDeviceSize    offset = 0;             // range offset in the staging buffer 
+    VkDeviceSize    size = 0;               // range size 
+    uint64_t        entry = UINT64_MAX;     // ring entry, used to release the range
+    void*           pointer = nullptr;      // CPU address of the range 
+} crvkStagingRange_t;
+
+///
+/// @brief Device upload manager, own a single persistently mapped staging ring buffer
+/// shared by all the staging resources. Ranges are handed in order, and returned to the
+/// ring when the GPU reach the timeline value of the submit that consumed them. Each submit
+/// queue have his own timeline, so the values of a timeline always complete in order.
+///
+class crvkUploadManager
+{
+public:
+    crvkUploadManager( void );
+    ~crvkUploadManager( void );
+
+    /// @brief Create the staging ring 
+    /// @param in_device the owner device 
+    /// @param in_size ring size in bytes, 0 to use the default
+    /// @param in_readback the ring is read by the CPU, prefer cached memory over the write combined one 
+    /// @return true on success
+    bool            Create( const crvkDevice* in_device, const VkDeviceSize in_size = 0, const bool in_readback = false );
+    
+    /// @brief Release the staging ring, the GPU must be done with it
+    void            Destroy( void );
+
+    /// @brief Get a range of the staging ring, wait for the GPU if the ring is full 
+    /// @param in_size range size 
+    /// @param in_alignment range offset alignment ( power of two )
+    /// @param out_range the range 
+    /// @return false if the range don't fit in the ring 
+    bool            Allocate( const VkDeviceSize in_size, const VkDeviceSize in_alignment, crvkStagingRange_t* out_range );
+
+    /// @brief Submit work that consume staging ranges, the ranges are reclaimed when the submit finish 
+    /// @param in_queue the queue to submit 
+    /// @param in_submit the submit info, the ring semaphore signal are appended to it 
+    /// @param in_ranges ranges used by the submit 
+    /// @param in_count ranges count 
+    /// @param out_value if not NULL, receive the value signaled by the submit, on the queue timeline, see Semaphore 
+    /// @return the vkQueueSubmit2 result 
+    VkResult        Submit( crvkDeviceQueue* in_queue, const VkSubmitInfo2* in_submit, const crvkStagingRange_t* in_ranges, const uint32_t in_count, uint64_t* out_value = nullptr );
+
+    /// @brief Return a range that the GPU are not using ( never submitted, or already waited )
+    void            Release( const crvkStagingRange_t* in_range );
+
+    /// @brief Return to the ring all the ranges that the GPU have consumed
+    void            Reclaim( void );
+
+    /// @brief Make the device writes to the range visible to the CPU, does nothing on coherent memory 
+    void            Invalidate( const crvkStagingRange_t* in_range ) const;
+
+    /// @brief The timeline semaphore signaled by the submits made on a queue, created on the first use 
+    VkSemaphore     Semaphore( crvkDeviceQueue* in_queue );
+    
+    /// @brief The last timeline value handed to a submit on the queue 
+    uint64_t        LastValue( const crvkDeviceQueue* in_queue ) const;
+
+    /// @brief The staging ring size 
+    VkDeviceSize    Capacity( void ) const;
+
+private:
+    crvkUploadManagerHandle_t*  m_handle;
+
+    void            ReclaimLocked( void );
+
+    /// @brief Index of the queue timeline, create it on the first use 
+    uint32_t        FindTimelineLocked( crvkDeviceQueue* in_queue );
+
+    crvkUploadManager( const crvkUploadManager & ) = delete;
+    crvkUploadManager operator=( const crvkUploadManager & ) = delete;
+};
+
+#endif //!__CRVK_UPLOAD_MANAGER_HPP__
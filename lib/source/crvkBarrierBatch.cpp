@@ -0,0 +1,544 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+
+#include "crvkPrecompiled.hpp"
+#include "crvkBarrierBatch.hpp"
+
+// access flags that make memory writes, any barrier with one of then in the source or destine need sync 
+static const VkAccessFlags2 k_writeAccess = VK_ACCESS_2_SHADER_WRITE_BIT |
+                                            VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT |
+                                            VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+                                            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                            VK_ACCESS_2_TRANSFER_WRITE_BIT |
+                                            VK_ACCESS_2_HOST_WRITE_BIT |
+                                            VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+// read access flags covered by the generic read bits 
+static const VkAccessFlags2 k_shaderReadAccess =    VK_ACCESS_2_SHADER_SAMPLED_READ_BIT |
+                                                    VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+
+// stage flags that are a alias of a group of stages 
+static const VkPipelineStageFlags2 k_vertexInputStages =    VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT |
+                                                            VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT;
+
+static const VkPipelineStageFlags2 k_preRasterStages =  VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT |
+                                                        VK_PIPELINE_STAGE_2_TESSELLATION_CONTROL_SHADER_BIT |
+                                                        VK_PIPELINE_STAGE_2_TESSELLATION_EVALUATION_SHADER_BIT |
+                                                        VK_PIPELINE_STAGE_2_GEOMETRY_SHADER_BIT;
+
+static const VkPipelineStageFlags2 k_transferStages =   VK_PIPELINE_STAGE_2_COPY_BIT |
+                                                        VK_PIPELINE_STAGE_2_BLIT_BIT |
+                                                        VK_PIPELINE_STAGE_2_RESOLVE_BIT |
+                                                        VK_PIPELINE_STAGE_2_CLEAR_BIT;
+
+static const VkPipelineStageFlags2 k_graphicStages =    VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT |
+                                                        k_vertexInputStages |
+                                                        k_preRasterStages |
+                                                        VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+                                                        VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+                                                        VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT |
+                                                        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+typedef struct crvkBarrierBatchHandle_t
+{
+    VkCommandBuffer                             commandBuffer = nullptr;
+    crvkBarrierBatchStats_t                     stats;
+    crvkDynamicVector<VkBufferMemoryBarrier2>   buffers;
+    crvkDynamicVector<VkImageMemoryBarrier2>    images;
+} crvkBarrierBatchHandle_t;
+
+/*
+==============================================
+IsOwnershipTransfer
+==============================================
+*/
+static bool IsOwnershipTransfer( const uint32_t in_srcFamily, const uint32_t in_dstFamily )
+{
+    return in_srcFamily != in_dstFamily;
+}
+
+/*
+==============================================
+ExpandStages
+==============================================
+*/
+static VkPipelineStageFlags2 ExpandStages( const VkPipelineStageFlags2 in_stages )
+{
+    VkPipelineStageFlags2 stages = in_stages;
+    if ( stages & VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT )
+        stages |= k_graphicStages;
+    
+    if ( stages & VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT )
+        stages |= k_vertexInputStages;
+
+    if ( stages & VK_PIPELINE_STAGE_2_PRE_RASTERIZATION_SHADERS_BIT )
+        stages |= k_preRasterStages;
+
+    if ( stages & VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT )
+        stages |= k_transferStages;
+
+    return stages & ~(  VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT | 
+                        VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT | 
+                        VK_PIPELINE_STAGE_2_PRE_RASTERIZATION_SHADERS_BIT | 
+                        VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT );
+}
+
+/*
+==============================================
+ReadCovered
+==============================================
+*/
+static bool ReadCovered( const VkPipelineStageFlags2 in_srcStage, const VkAccessFlags2 in_srcAccess, const VkPipelineStageFlags2 in_dstStage, const VkAccessFlags2 in_dstAccess )
+{
+    VkAccessFlags2 srcAccess = in_srcAccess;
+    VkAccessFlags2 dstAccess = in_dstAccess;
+
+    // all commands or all reads cover everything 
+    if ( ( in_srcStage & VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT ) == 0 && ( ExpandStages( in_dstStage ) & ~ExpandStages( in_srcStage ) ) != 0 )
+        return false;
+
+    if ( srcAccess & VK_ACCESS_2_MEMORY_READ_BIT )
+        return true;
+
+    if ( srcAccess & VK_ACCESS_2_SHADER_READ_BIT )
+        srcAccess |= k_shaderReadAccess;
+
+    if ( dstAccess & VK_ACCESS_2_SHADER_READ_BIT )
+        dstAccess = ( dstAccess & ~VK_ACCESS_2_SHADER_READ_BIT ) | k_shaderReadAccess;
+
+    return ( dstAccess & ~srcAccess ) == 0;
+}
+
+/*
+==============================================
+NeedBarrier
+==============================================
+*/
+static bool NeedBarrier( const VkPipelineStageFlags2 in_srcStage, const VkAccessFlags2 in_srcAccess, const VkPipelineStageFlags2 in_dstStage, const VkAccessFlags2 in_dstAccess, const uint32_t in_srcFamily, const uint32_t in_dstFamily )
+{
+    // queue ownership transfer
+    if ( IsOwnershipTransfer( in_srcFamily, in_dstFamily ) )
+        return true;
+
+    // read after write, write after read or write after write  
+    if ( ( ( in_srcAccess | in_dstAccess ) & k_writeAccess ) != 0 )
+        return true;
+
+    // nothing was accessed before, there is no write to make visible 
+    if ( in_srcAccess == 0 && ( in_srcStage == VK_PIPELINE_STAGE_2_NONE || in_srcStage == VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT ) )
+        return false;
+
+    // read after read, the earlier barrier made the writes visible only to his stages and accesses, 
+    // a new reader out of then must chain a other barrier 
+    return !ReadCovered( in_srcStage, in_srcAccess, in_dstStage, in_dstAccess );
+}
+
+/*
+==============================================
+SameBufferSync
+==============================================
+*/
+static bool SameBufferSync( const VkBufferMemoryBarrier2& in_a, const VkBufferMemoryBarrier2& in_b )
+{
+    return  in_a.srcStageMask == in_b.srcStageMask && in_a.srcAccessMask == in_b.srcAccessMask &&
+            in_a.dstStageMask == in_b.dstStageMask && in_a.dstAccessMask == in_b.dstAccessMask &&
+            in_a.srcQueueFamilyIndex == in_b.srcQueueFamilyIndex && in_a.dstQueueFamilyIndex == in_b.dstQueueFamilyIndex;
+}
+
+/*
+==============================================
+SameImageSync
+==============================================
+*/
+static bool SameImageSync( const VkImageMemoryBarrier2& in_a, const VkImageMemoryBarrier2& in_b )
+{
+    return  in_a.srcStageMask == in_b.srcStageMask && in_a.srcAccessMask == in_b.srcAccessMask &&
+            in_a.dstStageMask == in_b.dstStageMask && in_a.dstAccessMask == in_b.dstAccessMask &&
+            in_a.oldLayout == in_b.oldLayout && in_a.newLayout == in_b.newLayout &&
+            in_a.srcQueueFamilyIndex == in_b.srcQueueFamilyIndex && in_a.dstQueueFamilyIndex == in_b.dstQueueFamilyIndex;
+}
+
+/*
+==============================================
+BufferEnd
+==============================================
+*/
+static VkDeviceSize BufferEnd( const VkBufferMemoryBarrier2& in_barrier )
+{
+    return ( in_barrier.size == VK_WHOLE_SIZE ) ? std::numeric_limits<VkDeviceSize>::max() : in_barrier.offset + in_barrier.size;
+}
+
+/*
+==============================================
+BufferOverlap
+==============================================
+*/
+static bool BufferOverlap( const VkBufferMemoryBarrier2& in_a, const VkBufferMemoryBarrier2& in_b )
+{
+    return in_a.offset < BufferEnd( in_b ) && in_b.offset < BufferEnd( in_a );
+}
+
+/*
+==============================================
+BufferTouch
+==============================================
+*/
+static bool BufferTouch( const VkBufferMemoryBarrier2& in_a, const VkBufferMemoryBarrier2& in_b )
+{
+    // overlapping or adjacent, the union is a single range 
+    return in_a.offset <= BufferEnd( in_b ) && in_b.offset <= BufferEnd( in_a );
+}
+
+/*
+==============================================
+BufferUnion
+==============================================
+*/
+static void BufferUnion( VkBufferMemoryBarrier2& out_a, const VkBufferMemoryBarrier2& in_b )
+{
+    VkDeviceSize end = std::max( BufferEnd( out_a ), BufferEnd( in_b ) );
+    out_a.offset = std::min( out_a.offset, in_b.offset );
+    out_a.size = ( end == std::numeric_limits<VkDeviceSize>::max() ) ? VK_WHOLE_SIZE : end - out_a.offset;
+}
+
+/*
+==============================================
+ImageOverlap
+==============================================
+*/
+static bool ImageOverlap( const VkImageSubresourceRange& in_a, const VkImageSubresourceRange& in_b )
+{
+    uint32_t levelEndA = ( in_a.levelCount == VK_REMAINING_MIP_LEVELS ) ? UINT32_MAX : in_a.baseMipLevel + in_a.levelCount;
+    uint32_t levelEndB = ( in_b.levelCount == VK_REMAINING_MIP_LEVELS ) ? UINT32_MAX : in_b.baseMipLevel + in_b.levelCount;
+    uint32_t layerEndA = ( in_a.layerCount == VK_REMAINING_ARRAY_LAYERS ) ? UINT32_MAX : in_a.baseArrayLayer + in_a.layerCount;
+    uint32_t layerEndB = ( in_b.layerCount == VK_REMAINING_ARRAY_LAYERS ) ? UINT32_MAX : in_b.baseArrayLayer + in_b.layerCount;
+
+    return  ( in_a.aspectMask & in_b.aspectMask ) != 0 &&
+            in_a.baseMipLevel < levelEndB && in_b.baseMipLevel < levelEndA &&
+            in_a.baseArrayLayer < layerEndB && in_b.baseArrayLayer < layerEndA;
+}
+
+/*
+==============================================
+ImageUnion
+==============================================
+*/
+static bool ImageUnion( VkImageSubresourceRange& out_a, const VkImageSubresourceRange& in_b )
+{
+    uint32_t levelEndA = ( out_a.levelCount == VK_REMAINING_MIP_LEVELS ) ? UINT32_MAX : out_a.baseMipLevel + out_a.levelCount;
+    uint32_t levelEndB = ( in_b.levelCount == VK_REMAINING_MIP_LEVELS ) ? UINT32_MAX : in_b.baseMipLevel + in_b.levelCount;
+    uint32_t layerEndA = ( out_a.layerCount == VK_REMAINING_ARRAY_LAYERS ) ? UINT32_MAX : out_a.baseArrayLayer + out_a.layerCount;
+    uint32_t layerEndB = ( in_b.layerCount == VK_REMAINING_ARRAY_LAYERS ) ? UINT32_MAX : in_b.baseArrayLayer + in_b.layerCount;
+    bool sameLevels = out_a.baseMipLevel == in_b.baseMipLevel && levelEndA == levelEndB;
+    bool sameLayers = out_a.baseArrayLayer == in_b.baseArrayLayer && layerEndA == layerEndB;
+
+    // the union must be a single range, so the two must share the other dimensions 
+    if ( sameLevels && sameLayers )
+    {
+        out_a.aspectMask |= in_b.aspectMask;
+        return true;
+    }
+
+    if ( out_a.aspectMask != in_b.aspectMask )
+        return false;
+
+    if ( sameLevels && out_a.baseArrayLayer <= layerEndB && in_b.baseArrayLayer <= layerEndA )
+    {
+        uint32_t end = std::max( layerEndA, layerEndB );
+        out_a.baseArrayLayer = std::min( out_a.baseArrayLayer, in_b.baseArrayLayer );
+        out_a.layerCount = ( end == UINT32_MAX ) ? VK_REMAINING_ARRAY_LAYERS : end - out_a.baseArrayLayer;
+        return true;
+    }
+
+    if ( sameLayers && out_a.baseMipLevel <= levelEndB && in_b.baseMipLevel <= levelEndA )
+    {
+        uint32_t end = std::max( levelEndA, levelEndB );
+        out_a.baseMipLevel = std::min( out_a.baseMipLevel, in_b.baseMipLevel );
+        out_a.levelCount = ( end == UINT32_MAX ) ? VK_REMAINING_MIP_LEVELS : end - out_a.baseMipLevel;
+        return true;
+    }
+
+    return false;
+}
+
+/*
+==============================================
+ImageConflict
+==============================================
+*/
+static bool ImageConflict( const crvkBarrierBatchHandle_t* in_handle, const uint32_t in_merge, const VkImageSubresourceRange& in_range )
+{
+    const VkImageMemoryBarrier2& merge = in_handle->images[in_merge];
+    for ( uint32_t i = 0; i < in_handle->images.Count(); i++ )
+    {
+        const VkImageMemoryBarrier2& pending = in_handle->images[i];
+        if ( i != in_merge && pending.image == merge.image && ImageOverlap( pending.subresourceRange, in_range ) )
+            return true;
+    }
+
+    return false;
+}
+
+/*
+==============================================
+crvkBarrierBatch::crvkBarrierBatch
+==============================================
+*/
+crvkBarrierBatch::crvkBarrierBatch( void ) : m_handle( nullptr )
+{
+    m_handle = new crvkBarrierBatchHandle_t();
+}
+
+/*
+==============================================
+crvkBarrierBatch::~crvkBarrierBatch
+==============================================
+*/
+crvkBarrierBatch::~crvkBarrierBatch( void )
+{
+    if ( m_handle != nullptr )
+    {
+        delete m_handle;
+        m_handle = nullptr;
+    }
+}
+
+/*
+==============================================
+crvkBarrierBatch::Begin
+==============================================
+*/
+void crvkBarrierBatch::Begin( const VkCommandBuffer in_commandBuffer )
+{
+    m_handle->commandBuffer = in_commandBuffer;
+    m_handle->buffers.Reset();
+    m_handle->images.Reset();
+}
+
+/*
+==============================================
+crvkBarrierBatch::Buffer
+==============================================
+*/
+bool crvkBarrierBatch::Buffer( const VkBufferMemoryBarrier2* in_barrier )
+{
+    uint32_t merge = UINT32_MAX;
+    m_handle->stats.requested++;
+
+    if ( !NeedBarrier( in_barrier->srcStageMask, in_barrier->srcAccessMask, in_barrier->dstStageMask, in_barrier->dstAccessMask, in_barrier->srcQueueFamilyIndex, in_barrier->dstQueueFamilyIndex ) )
+    {
+        m_handle->stats.dropped++;
+        return false;
+    }
+
+    // the pending barriers of a buffer never overlap, so the new one conflict or merge with them 
+    for ( uint32_t i = 0; i < m_handle->buffers.Count(); i++ )
+    {
+        VkBufferMemoryBarrier2& pending = m_handle->buffers[i];
+        if ( pending.buffer != in_barrier->buffer || !BufferTouch( pending, *in_barrier ) )
+            continue;
+
+        // the same transition of a overlapping or adjacent range, grow the pending one 
+        if ( SameBufferSync( pending, *in_barrier ) )
+        {
+            if ( merge == UINT32_MAX )
+                merge = i;
+            continue;
+        }
+
+        if ( !BufferOverlap( pending, *in_barrier ) )
+            continue;
+
+        // no command run between the two barriers, so A -> B -> C is the same as A -> C, 
+        // but a read after read keep the B readers too 
+        if (    pending.offset == in_barrier->offset && pending.size == in_barrier->size &&
+                !IsOwnershipTransfer( pending.srcQueueFamilyIndex, pending.dstQueueFamilyIndex ) &&
+                !IsOwnershipTransfer( in_barrier->srcQueueFamilyIndex, in_barrier->dstQueueFamilyIndex ) )
+        {
+            bool readAfterRead = ( ( in_barrier->srcAccessMask | in_barrier->dstAccessMask ) & k_writeAccess ) == 0;
+            pending.dstStageMask = readAfterRead ? pending.dstStageMask | in_barrier->dstStageMask : in_barrier->dstStageMask;
+            pending.dstAccessMask = readAfterRead ? pending.dstAccessMask | in_barrier->dstAccessMask : in_barrier->dstAccessMask;
+            m_handle->stats.merged++;
+            return true;
+        }
+
+        // can't fold, the second barrier must wait the first 
+        Flush();
+        m_handle->buffers.Append( *in_barrier );
+        return true;
+    }
+
+    if ( merge != UINT32_MAX )
+    {
+        BufferUnion( m_handle->buffers[merge], *in_barrier );
+        m_handle->stats.merged++;
+        return true;
+    }
+
+    m_handle->buffers.Append( *in_barrier );
+    return true;
+}
+
+/*
+==============================================
+crvkBarrierBatch::Image
+==============================================
+*/
+bool crvkBarrierBatch::Image( const VkImageMemoryBarrier2* in_barrier )
+{
+    m_handle->stats.requested++;
+
+    // a layout change is a write 
+    if (    in_barrier->oldLayout == in_barrier->newLayout && 
+            !NeedBarrier( in_barrier->srcStageMask, in_barrier->srcAccessMask, in_barrier->dstStageMask, in_barrier->dstAccessMask, in_barrier->srcQueueFamilyIndex, in_barrier->dstQueueFamilyIndex ) )
+    {
+        m_handle->stats.dropped++;
+        return false;
+    }
+
+    // the pending barriers of a image never overlap, so the new one conflict or merge with them 
+    for ( uint32_t i = 0; i < m_handle->images.Count(); i++ )
+    {
+        VkImageMemoryBarrier2& pending = m_handle->images[i];
+        if ( pending.image != in_barrier->image )
+            continue;
+
+        // the same transition of a overlapping or adjacent range, grow the pending one 
+        if ( SameImageSync( pending, *in_barrier ) )
+        {
+            VkImageSubresourceRange range = pending.subresourceRange;
+            if ( ImageUnion( range, in_barrier->subresourceRange ) && !ImageConflict( m_handle, i, range ) )
+            {
+                pending.subresourceRange = range;
+                m_handle->stats.merged++;
+                return true;
+            }
+        }
+
+        if ( !ImageOverlap( pending.subresourceRange, in_barrier->subresourceRange ) )
+            continue;
+
+        const VkImageSubresourceRange& a = pending.subresourceRange;
+        const VkImageSubresourceRange& b = in_barrier->subresourceRange;
+        if (    a.aspectMask == b.aspectMask && 
+                a.baseMipLevel == b.baseMipLevel && a.levelCount == b.levelCount && 
+                a.baseArrayLayer == b.baseArrayLayer && a.layerCount == b.layerCount &&
+                pending.newLayout == in_barrier->oldLayout &&
+                !IsOwnershipTransfer( pending.srcQueueFamilyIndex, pending.dstQueueFamilyIndex ) &&
+                !IsOwnershipTransfer( in_barrier->srcQueueFamilyIndex, in_barrier->dstQueueFamilyIndex ) )
+        {
+            bool readAfterRead = pending.newLayout == in_barrier->newLayout && ( ( in_barrier->srcAccessMask | in_barrier->dstAccessMask ) & k_writeAccess ) == 0;
+            pending.dstStageMask = readAfterRead ? pending.dstStageMask | in_barrier->dstStageMask : in_barrier->dstStageMask;
+            pending.dstAccessMask = readAfterRead ? pending.dstAccessMask | in_barrier->dstAccessMask : in_barrier->dstAccessMask;
+            pending.newLayout = in_barrier->newLayout;
+            m_handle->stats.merged++;
+            return true;
+        }
+
+        // can't fold, the second barrier must wait the first 
+        Flush();
+        break;
+    }
+
+    m_handle->images.Append( *in_barrier );
+    return true;
+}
+
+/*
+==============================================
+crvkBarrierBatch::Flush
+==============================================
+*/
+void crvkBarrierBatch::Flush( void )
+{
+    if ( m_handle->buffers.Count() == 0 && m_handle->images.Count() == 0 )
+        return;
+
+    VkDependencyInfo depInfo{};
+    depInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    depInfo.pNext = nullptr;
+    depInfo.dependencyFlags = 0;
+    depInfo.memoryBarrierCount = 0;
+    depInfo.pMemoryBarriers = nullptr;
+    depInfo.bufferMemoryBarrierCount = m_handle->buffers.Count();
+    depInfo.pBufferMemoryBarriers = &m_handle->buffers;
+    depInfo.imageMemoryBarrierCount = m_handle->images.Count();
+    depInfo.pImageMemoryBarriers = &m_handle->images;
+    vkCmdPipelineBarrier2( m_handle->commandBuffer, &depInfo );
+
+    m_handle->stats.flushes++;
+    m_handle->buffers.Reset();
+    m_handle->images.Reset();
+}
+
+/*
+==============================================
+crvkBarrierBatch::Pending
+==============================================
+*/
+uint32_t crvkBarrierBatch::Pending( void ) const
+{
+    return m_handle->buffers.Count() + m_handle->images.Count();
+}
+
+/*
+==============================================
+crvkBarrierBatch::BufferBarriers
+==============================================
+*/
+const VkBufferMemoryBarrier2* crvkBarrierBatch::BufferBarriers( uint32_t* out_count ) const
+{
+    *out_count = m_handle->buffers.Count();
+    return &m_handle->buffers;
+}
+
+/*
+==============================================
+crvkBarrierBatch::ImageBarriers
+==============================================
+*/
+const VkImageMemoryBarrier2* crvkBarrierBatch::ImageBarriers( uint32_t* out_count ) const
+{
+    *out_count = m_handle->images.Count();
+    return &m_handle->images;
+}
+
+/*
+==============================================
+crvkBarrierBatch::CommandBuffer
+==============================================
+*/
+VkCommandBuffer crvkBarrierBatch::CommandBuffer( void ) const
+{
+    return m_handle->commandBuffer;
+}
+
+/*
+==============================================
+crvkBarrierBatch::Stats
+==============================================
+*/
+void crvkBarrierBatch::Stats( crvkBarrierBatchStats_t* out_stats ) const
+{
+    *out_stats = m_handle->stats;
+}
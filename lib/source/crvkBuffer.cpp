@@ -21,16 +21,33 @@
 #include "crvkPrecompiled.hpp"
 #include "crvkBuffer.hpp"
 
+/// @brief the state of a byte range of the buffer 
+typedef struct crvkBufferRange_t
+{
+    VkDeviceSize            offset;
+    VkDeviceSize            end;
+    VkPipelineStageFlags2   stage;
+    VkAccessFlags2          access;
+    uint32_t                family;
+    bool                    owned;      // false until a queue use it, or after a discard, the next queue take it without a ownership transfer 
+} crvkBufferRange_t;
+
 typedef struct crvkBufferHandler_t
 {
-    uint32_t                family;   // buffer current queue
+    uint32_t                family;   // buffer queue at creation
+    VkSharingMode           sharing = VK_SHARING_MODE_EXCLUSIVE;  // concurrent buffers have no queue family owner 
+    VkDeviceSize            size;           // buffer size 
     VkBufferUsageFlags      usage;          // buffer usage 
     VkMemoryPropertyFlags   property;       // memory properties 
-    VkPipelineStageFlags2   stage;          // current buffer pipeline stage
-    VkAccessFlags2          access;         // buffer acess flags
     VkBuffer                buffer;         // buffer handler 
-    VkDeviceMemory          memory;         // buffer memory acess 
-    VkQueue                 queue;          // current queue handle
+    crvkDynamicVector<crvkBufferRange_t> ranges;   // sorted ranges covering the whole buffer, neighbors never share the same state 
+    crvkDynamicVector<crvkBufferRange_t> scratch;  // ranges being rebuilt by a state transition 
+    crvkMemoryAllocation_t  allocation;     // buffer memory range 
+    bool                    aliased = false;    // bound to memory owned by other 
+    crvkMemoryAllocator*    allocator;      // device memory allocator 
+    crvkDeletionQueue*      deletion = nullptr; // device deferred deletion queue 
+    crvkTimelinePoint_t     lastUse;        // last use set by the application 
+    crvkDeviceQueue*        queue;          // current queue
     VkDevice                device;         // buffer device handler
 } crvkBufferHandler_t;
 
@@ -39,6 +56,30 @@ typedef struct crvkBufferStagingHandler_t : public crvkBufferHandler_t
     
 } crvkBufferStagingHandler_t;
 
+/*
+==============================================
+AppendRange
+==============================================
+*/
+static void AppendRange( crvkDynamicVector<crvkBufferRange_t>& in_ranges, const crvkBufferRange_t& in_range )
+{
+    if ( in_range.offset >= in_range.end )
+        return;
+
+    // merge with the previous range when they share the same state 
+    if ( in_ranges.Count() > 0 )
+    {
+        crvkBufferRange_t& last = in_ranges[in_ranges.Count() - 1];
+        if ( last.end == in_range.offset && last.stage == in_range.stage && last.access == in_range.access && last.family == in_range.family && last.owned == in_range.owned )
+        {
+            last.end = in_range.end;
+            return;
+        }
+    }
+
+    in_ranges.Append( in_range );
+}
+
 /*
 ==============================================
 crvkBuffer::crvkBuffer
@@ -46,7 +87,7 @@ crvkBuffer::crvkBuffer
 */
 crvkBuffer::crvkBuffer( void ) : m_bufferHandler( nullptr ) 
 {
-    m_bufferHandler = new crvkBufferHandler_t;
+    m_bufferHandler = new crvkBufferHandler_t();
 }
 
 /*
@@ -78,66 +119,163 @@ bool crvkBuffer::Create(    const crvkDevice* in_device,
                             const VkMemoryPropertyFlags in_flags )
 {
     VkMemoryRequirements memRequirements;
+    
+    if ( !CreateUnbound( in_device, in_graphic, in_tranfer, in_size, in_usage ) )
+        return false;
+
+    m_bufferHandler->property = in_flags;
+    vkGetBufferMemoryRequirements( m_bufferHandler->device, m_bufferHandler->buffer, &memRequirements );
+
+    // get a range from the device memory blocks 
+    if ( !m_bufferHandler->allocator->Allocate( memRequirements, in_flags, true, &m_bufferHandler->allocation ) )
+        return false;
+
+    return BindMemory( m_bufferHandler->allocation.memory, m_bufferHandler->allocation.offset );
+}
+
+/*
+==============================================
+crvkBuffer::CreateUnbound
+==============================================
+*/
+bool crvkBuffer::CreateUnbound( const crvkDevice* in_device,
+                                const crvkDeviceQueue* in_graphic,
+                                const crvkDeviceQueue* in_tranfer, 
+                                const size_t in_size, 
+                                const VkBufferUsageFlags in_usage )
+{
     VkResult result = VK_SUCCESS;
     
     m_bufferHandler->device = in_device->Device();
+    m_bufferHandler->allocator = in_device->MemoryAllocator();
+    m_bufferHandler->deletion = in_device->DeletionQueue();
+    m_bufferHandler->lastUse = crvkTimelinePoint_t{};
     m_bufferHandler->usage = in_usage;
-    m_bufferHandler->property = in_flags;
+    m_bufferHandler->property = 0;
+    m_bufferHandler->size = in_size;
     
     VkBufferCreateInfo bufferInfo{};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     bufferInfo.size = in_size;
     bufferInfo.usage = in_usage;
+    uint32_t families[2] = { 0, 0 };
     
     // we use tranfer queue for buffer content
     if( in_tranfer != nullptr )
     {
         m_bufferHandler->family = in_tranfer->Family();
-        m_bufferHandler->queue = in_tranfer->Queue();
+        m_bufferHandler->queue = const_cast<crvkDeviceQueue*>( in_tranfer );
 
         if( in_tranfer->Family() != in_graphic->Family() )
+        {
+            families[0] = in_tranfer->Family();
+            families[1] = in_graphic->Family();
             bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+            bufferInfo.queueFamilyIndexCount = 2;
+            bufferInfo.pQueueFamilyIndices = families;
+        }
         else
             bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
     }
     else
     {
-        m_bufferHandler->queue = in_graphic->Queue();
+        m_bufferHandler->queue = const_cast<crvkDeviceQueue*>( in_graphic );
         m_bufferHandler->family = in_graphic->Family();
         bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
     }
 
+    m_bufferHandler->sharing = bufferInfo.sharingMode;
+
     result = vkCreateBuffer( m_bufferHandler->device, &bufferInfo, k_allocationCallbacks, &m_bufferHandler->buffer );
     if ( result != VK_SUCCESS) 
     {
-        crvkAppendError( "crvkBufferStatic::Create::vkCreateBuffer", result );
+        crvkAppendError( "crvkBuffer::CreateUnbound::vkCreateBuffer", result );
         return false;
     }
 
-    vkGetBufferMemoryRequirements( m_bufferHandler->device, m_bufferHandler->buffer, &memRequirements );
+    // the whole buffer start unused 
+    crvkBufferRange_t range{ 0, m_bufferHandler->size, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, m_bufferHandler->family, false };
+    m_bufferHandler->ranges.Reset();
+    m_bufferHandler->ranges.Append( range );
 
-    // try find the required memory 
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = in_device->FindMemoryType( memRequirements.memoryTypeBits, in_flags );
-    result = vkAllocateMemory( m_bufferHandler->device, &allocInfo, k_allocationCallbacks, &m_bufferHandler->memory );
-    if ( result != VK_SUCCESS ) 
-    {
-        crvkAppendError( "crvkBufferStatic::Create::vkAllocateMemory", result );
+    return true;
+}
+
+/*
+==============================================
+crvkBuffer::Bind
+==============================================
+*/
+bool crvkBuffer::Bind( const crvkMemoryAllocation_t* in_memory, const VkDeviceSize in_offset )
+{
+    if ( m_bufferHandler == nullptr || m_bufferHandler->buffer == nullptr || m_bufferHandler->allocation.memory != nullptr )
         return false;
-    }
 
-    result = vkBindBufferMemory( m_bufferHandler->device, m_bufferHandler->buffer, m_bufferHandler->memory, 0 );
+    // the memory still belong to the caller, we just use a piece of it 
+    m_bufferHandler->allocation = *in_memory;
+    m_bufferHandler->allocation.offset += in_offset;
+    if ( m_bufferHandler->allocation.mapped != nullptr )
+        m_bufferHandler->allocation.mapped = static_cast<uint8_t*>( m_bufferHandler->allocation.mapped ) + in_offset;
+
+    m_bufferHandler->aliased = true;
+    return BindMemory( m_bufferHandler->allocation.memory, m_bufferHandler->allocation.offset );
+}
+
+/*
+==============================================
+crvkBuffer::BindMemory
+==============================================
+*/
+bool crvkBuffer::BindMemory( const VkDeviceMemory in_memory, const VkDeviceSize in_offset )
+{
+    VkResult result = vkBindBufferMemory( m_bufferHandler->device, m_bufferHandler->buffer, in_memory, in_offset );
     if ( result != VK_SUCCESS )
     {
-        crvkAppendError( "crvkBufferStatic::Create::vkBindBufferMemory", result );
+        crvkAppendError( "crvkBuffer::BindMemory::vkBindBufferMemory", result );
         return false;
     }
 
     return true;
 }
 
+/*
+==============================================
+crvkBuffer::MemoryRequirements
+==============================================
+*/
+void crvkBuffer::MemoryRequirements( VkMemoryRequirements* out_requirements ) const
+{
+    vkGetBufferMemoryRequirements( m_bufferHandler->device, m_bufferHandler->buffer, out_requirements );
+}
+
+/*
+==============================================
+crvkBuffer::DiscardContent
+==============================================
+*/
+void crvkBuffer::DiscardContent( const VkPipelineStageFlags2 in_stages, const VkAccessFlags2 in_access )
+{
+    // the whole buffer become a single range that wait the given work, 
+    // a discarded content have no owner, so the next queue don't need a ownership transfer 
+    crvkBufferRange_t range{ 0, m_bufferHandler->size, in_stages, in_access, VK_QUEUE_FAMILY_IGNORED, false };
+    m_bufferHandler->ranges.Reset();
+    m_bufferHandler->ranges.Append( range );
+}
+
+/*
+==============================================
+crvkBuffer::Stages
+==============================================
+*/
+VkPipelineStageFlags2 crvkBuffer::Stages( void ) const
+{
+    VkPipelineStageFlags2 stages = VK_PIPELINE_STAGE_2_NONE;
+    for ( uint32_t i = 0; i < m_bufferHandler->ranges.Count(); i++ )
+        stages |= m_bufferHandler->ranges[i].stage;
+
+    return stages;
+}
+
 /*
 ==============================================
 crvkBuffer::Destroy
@@ -148,18 +286,72 @@ void crvkBuffer::Destroy( void )
     if ( m_bufferHandler == nullptr )
         return;
 
-    if ( m_bufferHandler->memory != nullptr )
-    {
-        vkFreeMemory( m_bufferHandler->device, m_bufferHandler->memory, k_allocationCallbacks );
-        m_bufferHandler->memory = nullptr;
-    }
+    crvkTimelinePoint_t lastUse[crvkDeletionQueue::k_maxPoints];
+    Release( lastUse, LastUse( lastUse ) );
+}
+
+/*
+==============================================
+crvkBuffer::SetLastUse
+==============================================
+*/
+void crvkBuffer::SetLastUse( const VkSemaphore in_semaphore, const uint64_t in_value )
+{
+    m_bufferHandler->lastUse.semaphore = in_semaphore;
+    m_bufferHandler->lastUse.value = in_value;
+}
+
+/*
+==============================================
+crvkBuffer::LastUse
+==============================================
+*/
+uint32_t crvkBuffer::LastUse( crvkTimelinePoint_t* out_points ) const
+{
+    if ( m_bufferHandler->lastUse.semaphore == nullptr )
+        return 0;
+
+    out_points[0] = m_bufferHandler->lastUse;
+    return 1;
+}
+
+/*
+==============================================
+crvkBuffer::Release
+==============================================
+*/
+void crvkBuffer::Release( const crvkTimelinePoint_t* in_lastUse, const uint32_t in_count )
+{
+    // with a known last use, the buffer and his memory go to the device queue and are 
+    // destroyed when the GPU is done with them, without we destroy it now 
+    bool deferred = m_bufferHandler->deletion != nullptr && in_count > 0;
 
     if ( m_bufferHandler->buffer != nullptr )
     {
-        vkDestroyBuffer( m_bufferHandler->device, m_bufferHandler->buffer, k_allocationCallbacks );
+        if ( deferred )
+            m_bufferHandler->deletion->Enqueue( VK_OBJECT_TYPE_BUFFER, reinterpret_cast<uint64_t>( m_bufferHandler->buffer ), in_lastUse, in_count );
+        else
+            vkDestroyBuffer( m_bufferHandler->device, m_bufferHandler->buffer, k_allocationCallbacks );
+        
         m_bufferHandler->buffer = nullptr;
     }
+
+    // return the memory range to the device allocator, aliased memory belong to other 
+    if ( m_bufferHandler->aliased )
+        m_bufferHandler->allocation = crvkMemoryAllocation_t{};
+    else if ( m_bufferHandler->allocation.memory != nullptr )
+    {
+        if ( deferred )
+        {
+            m_bufferHandler->deletion->EnqueueFree( &m_bufferHandler->allocation, in_lastUse, in_count );
+            m_bufferHandler->allocation = crvkMemoryAllocation_t{};
+        }
+        else
+            m_bufferHandler->allocator->Free( &m_bufferHandler->allocation );
+    }
     
+    m_bufferHandler->aliased = false;
+    m_bufferHandler->lastUse = crvkTimelinePoint_t{};
     m_bufferHandler->device = nullptr;
 }
 
@@ -170,12 +362,20 @@ crvkBuffer::Map
 */
 void *crvkBuffer::Map( const uintptr_t in_offset, const size_t in_size, const crvkBufferMapAccess_t in_acces ) 
 {
-    void* poiter = nullptr;
-    if ( m_bufferHandler == nullptr || m_bufferHandler->memory == nullptr )
+    uint8_t* poiter = nullptr;
+    if ( m_bufferHandler == nullptr || m_bufferHandler->allocation.memory == nullptr )
+        return nullptr;
+
+    // host visible blocks stay mapped, we just get the address 
+    poiter = static_cast<uint8_t*>( m_bufferHandler->allocator->Map( &m_bufferHandler->allocation ) );
+    if ( poiter == nullptr )
         return nullptr;
 
-    vkMapMemory( m_bufferHandler->device, m_bufferHandler->memory, in_offset, in_size, 0, &poiter );
-    return poiter;    
+    // make the device writes visible, on non coherent memory 
+    if ( in_acces == CRVK_BUFFER_MAP_ACCESS_READ )
+        m_bufferHandler->allocator->Invalidate( &m_bufferHandler->allocation, in_offset, ( in_size == 0 ) ? VK_WHOLE_SIZE : in_size );
+
+    return poiter + in_offset;    
 }
 
 /*
@@ -185,10 +385,10 @@ crvkBuffer::Unmap
 */
 void crvkBuffer::Unmap( void )
 {
-    if ( m_bufferHandler == nullptr || m_bufferHandler->memory == nullptr )
+    if ( m_bufferHandler == nullptr || m_bufferHandler->allocation.memory == nullptr )
         return;
 
-    vkUnmapMemory( m_bufferHandler->device, m_bufferHandler->memory );
+    m_bufferHandler->allocator->Unmap( &m_bufferHandler->allocation );
 }
 
 /*
@@ -198,16 +398,11 @@ crvkBuffer::Flush
 */
 void crvkBuffer::Flush( const uintptr_t in_offset, const size_t in_size ) const
 {
-    VkMappedMemoryRange range{}; 
-    
-    if ( m_bufferHandler == nullptr || m_bufferHandler->memory == nullptr )
+    if ( m_bufferHandler == nullptr || m_bufferHandler->allocation.memory == nullptr )
         return;
     
-    range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-    range.memory = m_bufferHandler->memory;
-    range.offset = in_offset;
-    range.size = in_size;
-    vkFlushMappedMemoryRanges( m_bufferHandler->device, 1, &range );
+    // coherent memory don't need flush 
+    m_bufferHandler->allocator->Flush( &m_bufferHandler->allocation, in_offset, in_size );
 }
 
 /*
@@ -216,6 +411,39 @@ crvkBuffer::StateTransition
 ==============================================
 */
 void crvkBuffer::StateTransition( const VkCommandBuffer in_commandBuffer, const crvkBufferState_t in_state, const uint32_t in_dstQueueFamily )
+{
+    StateTransition( in_commandBuffer, in_state, 0, VK_WHOLE_SIZE, in_dstQueueFamily );
+}
+
+/*
+==============================================
+crvkBuffer::StateTransition
+==============================================
+*/
+void crvkBuffer::StateTransition( crvkBarrierBatch* in_batch, const crvkBufferState_t in_state, const uint32_t in_dstQueueFamily )
+{
+    StateTransition( in_batch, in_state, 0, VK_WHOLE_SIZE, in_dstQueueFamily );
+}
+
+/*
+==============================================
+crvkBuffer::StateTransition
+==============================================
+*/
+void crvkBuffer::StateTransition( const VkCommandBuffer in_commandBuffer, const crvkBufferState_t in_state, const VkDeviceSize in_offset, const VkDeviceSize in_size, const uint32_t in_dstQueueFamily )
+{
+    crvkBarrierBatch batch;
+    batch.Begin( in_commandBuffer );
+    StateTransition( &batch, in_state, in_offset, in_size, in_dstQueueFamily );
+    batch.Flush();
+}
+
+/*
+==============================================
+crvkBuffer::StateTransition
+==============================================
+*/
+void crvkBuffer::StateTransition( crvkBarrierBatch* in_batch, const crvkBufferState_t in_state, const VkDeviceSize in_offset, const VkDeviceSize in_size, const uint32_t in_dstQueueFamily )
 {
     uint32_t family = in_dstQueueFamily;
     VkPipelineStageFlags2   stage = VK_PIPELINE_STAGE_2_NONE;
@@ -229,13 +457,13 @@ void crvkBuffer::StateTransition( const VkCommandBuffer in_commandBuffer, const
         if( m_bufferHandler->usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT ) // we just read 
         {
             stage = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT;
-            access = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT;
+            access = VK_ACCESS_2_INDEX_READ_BIT;
         }
         // vertex input 
         else if ( m_bufferHandler->usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT ) // we just read 
         {
             stage = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT;
-            access = VK_ACCESS_2_INDEX_READ_BIT;
+            access = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT;
         }
         // indirect input
         else if( m_bufferHandler->usage & VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT )
@@ -301,45 +529,97 @@ void crvkBuffer::StateTransition( const VkCommandBuffer in_commandBuffer, const
     } break;
     }
 
-    // nothing to change
-    if (( stage == m_bufferHandler->stage ) && ( access == m_bufferHandler->access ) && ( family == m_bufferHandler->family ) )
+    // clamp the range to the buffer 
+    VkDeviceSize begin = std::min( in_offset, m_bufferHandler->size );
+    VkDeviceSize end = ( in_size == VK_WHOLE_SIZE ) ? m_bufferHandler->size : std::min( begin + in_size, m_bufferHandler->size );
+    if ( begin >= end )
         return;
 
-    VkBufferMemoryBarrier2 barrier{};
-    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
-    barrier.pNext = nullptr;
-
-    // source state
-    barrier.srcStageMask = m_bufferHandler->stage;
-    barrier.srcAccessMask = m_bufferHandler->access;
-    barrier.srcQueueFamilyIndex = m_bufferHandler->family;
-    
-    // destine state 
-    barrier.dstStageMask = stage;
-    barrier.dstAccessMask = access;
-    barrier.dstQueueFamilyIndex = family;
+    ///
+    /// Rebuild the range list, only the ranges inside [begin, end) change state
+    /// ==========================================================================
+    crvkDynamicVector<crvkBufferRange_t>& ranges = m_bufferHandler->ranges;
+    crvkDynamicVector<crvkBufferRange_t>& scratch = m_bufferHandler->scratch;
+    scratch.Reset();
     
-    // since we map the current buffer state, we change whole the buffer, not only some regions 
-    barrier.buffer = m_bufferHandler->buffer;
-    barrier.offset = 0;
-    barrier.size = VK_WHOLE_SIZE;
-
-    VkDependencyInfo depInfo{};
-    depInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
-    depInfo.pNext = nullptr;
-    depInfo.dependencyFlags = 0;
-    depInfo.memoryBarrierCount = 0;
-    depInfo.pMemoryBarriers = nullptr;
-    depInfo.bufferMemoryBarrierCount = 1;
-    depInfo.pBufferMemoryBarriers = &barrier;
-    depInfo.imageMemoryBarrierCount = 0;
-    depInfo.pImageMemoryBarriers = nullptr;
-    vkCmdPipelineBarrier2( in_commandBuffer, &depInfo );
-
-    // update buffer state
-    m_bufferHandler->family = family;
-    m_bufferHandler->stage = stage;
-    m_bufferHandler->access = access;
+    for ( uint32_t i = 0; i < ranges.Count(); i++ )
+    {
+        const crvkBufferRange_t& range = ranges[i];
+        if ( range.end <= begin || range.offset >= end )
+        {
+            AppendRange( scratch, range );
+            continue;
+        }
+
+        // part before the transition 
+        crvkBufferRange_t before = range;
+        before.end = begin;
+        AppendRange( scratch, before );
+        
+        crvkBufferRange_t changed{ std::max( range.offset, begin ), std::min( range.end, end ), stage, access, family, true };
+        uint32_t srcFamily = range.family;
+        uint32_t dstFamily = family;
+
+        // a ownership transfer only happen between two known families, a range without owner 
+        // is acquired by the new family, and a ignored destine keep the current owner. 
+        // A concurrent buffer is shared by his families, it never release or acquire 
+        bool concurrent = m_bufferHandler->sharing == VK_SHARING_MODE_CONCURRENT;
+        if ( concurrent || !range.owned || srcFamily == VK_QUEUE_FAMILY_IGNORED || dstFamily == VK_QUEUE_FAMILY_IGNORED || srcFamily == dstFamily )
+        {
+            if ( concurrent || dstFamily == VK_QUEUE_FAMILY_IGNORED )
+            {
+                changed.family = range.family;
+                changed.owned = range.owned;
+            }
+
+            srcFamily = VK_QUEUE_FAMILY_IGNORED;
+            dstFamily = VK_QUEUE_FAMILY_IGNORED;
+        }
+        
+        // nothing to change
+        if ( ( stage == range.stage ) && ( access == range.access ) && ( changed.family == range.family ) && ( changed.owned == range.owned ) )
+        {
+            AppendRange( scratch, changed );
+        }
+        else
+        {
+            VkBufferMemoryBarrier2 barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+            barrier.pNext = nullptr;
+
+            // source state
+            barrier.srcStageMask = range.stage;
+            barrier.srcAccessMask = range.access;
+            barrier.srcQueueFamilyIndex = srcFamily;
+            
+            // destine state 
+            barrier.dstStageMask = stage;
+            barrier.dstAccessMask = access;
+            barrier.dstQueueFamilyIndex = dstFamily;
+            
+            // only the bytes of this range
+            barrier.buffer = m_bufferHandler->buffer;
+            barrier.offset = changed.offset;
+            barrier.size = changed.end - changed.offset;
+
+            // a read covered by the earlier readers don't need a barrier, but a later write must still wait all the readers
+            if ( !in_batch->Buffer( &barrier ) )
+            {
+                changed.stage |= range.stage;
+                changed.access |= range.access;
+            }
+
+            AppendRange( scratch, changed );
+        }
+
+        // part after the transition 
+        crvkBufferRange_t after = range;
+        after.offset = end;
+        AppendRange( scratch, after );
+    }
+
+    // keep the range list memory 
+    ranges = scratch;
 }
 
 /*
@@ -365,9 +645,17 @@ crvkBufferStatic::crvkBufferStatic( void ) :
     crvkBuffer(),
     m_useValue( 1 ),
     m_copyValue( 1 ),
+    m_lastCopyValue( 1 ),
     m_copySemaphore( nullptr ),
-    m_useSemaphore( nullptr )
+    m_useSemaphore( nullptr ),
+    m_lastCopySemaphore( nullptr ),
+    m_commandPool( nullptr ),
+    m_commandBuffer( nullptr ),
+    m_copyCommand( 0 ),
+    m_device( nullptr )
 {
+    std::memset( m_copyCommandBuffers, 0, sizeof( m_copyCommandBuffers ) );
+    std::memset( m_copyCommandValues, 0, sizeof( m_copyCommandValues ) );
 }
 
 /*
@@ -411,7 +699,7 @@ bool crvkBufferStatic::Create(  const crvkDevice* in_device,
     VkSemaphoreTypeCreateInfo timelineCreateInfo{};
     timelineCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
     timelineCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
-    timelineCreateInfo.initialValue = 0;
+    timelineCreateInfo.initialValue = 1; // m_useValue and m_copyValue start at 1 
 
     VkSemaphoreCreateInfo copySemaphoreCI{};
     copySemaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
@@ -425,6 +713,8 @@ bool crvkBufferStatic::Create(  const crvkDevice* in_device,
         return false;
     }
 
+    SetLastCopy( m_copySemaphore, m_copyValue );
+
     VkSemaphoreCreateInfo drawSemaphoreCI{};
     drawSemaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
     drawSemaphoreCI.flags = 0;
@@ -459,6 +749,17 @@ bool crvkBufferStatic::Create(  const crvkDevice* in_device,
         return false;
     }
 
+    // the copies ring, the semaphore start at 1, so every command buffer start free 
+    allocInfo.commandBufferCount = k_copyCommandBuffers;
+    result = vkAllocateCommandBuffers( device, &allocInfo, m_copyCommandBuffers ); 
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkBufferStatic::Create::vkAllocateCommandBuffers::COPY", result );
+        return false;
+    }
+
+    std::memset( m_copyCommandValues, 0, sizeof( m_copyCommandValues ) );
+    m_copyCommand = 0;
     return true;
 }
 
@@ -469,7 +770,39 @@ crvkBufferStatic::Destroy
 */
 void crvkBufferStatic::Destroy( void )
 {
+    if ( m_device == nullptr )
+        return;
+
     VkDevice device = m_device->Device();
+    crvkDeletionQueue* deletion = m_device->DeletionQueue();
+    crvkTimelinePoint_t lastUse[crvkDeletionQueue::k_maxPoints];
+    uint32_t lastUseCount = LastUse( lastUse );
+
+    // the command buffer and semaphores can still be in use by the GPU, 
+    // send them to the deletion queue with the buffer 
+    if ( deletion != nullptr )
+    {
+        if ( m_commandBuffer != nullptr )
+            deletion->Enqueue( VK_OBJECT_TYPE_COMMAND_BUFFER, reinterpret_cast<uint64_t>( m_commandBuffer ), lastUse, lastUseCount, reinterpret_cast<uint64_t>( m_commandPool ) );
+
+        for ( uint32_t i = 0; i < k_copyCommandBuffers; i++ )
+        {
+            if ( m_copyCommandBuffers[i] != nullptr )
+                deletion->Enqueue( VK_OBJECT_TYPE_COMMAND_BUFFER, reinterpret_cast<uint64_t>( m_copyCommandBuffers[i] ), lastUse, lastUseCount, reinterpret_cast<uint64_t>( m_commandPool ) );
+            
+            m_copyCommandBuffers[i] = nullptr;
+        }
+
+        if ( m_useSemaphore != nullptr )
+            deletion->Enqueue( VK_OBJECT_TYPE_SEMAPHORE, reinterpret_cast<uint64_t>( m_useSemaphore ), lastUse, lastUseCount );
+        
+        if ( m_copySemaphore != nullptr )
+            deletion->Enqueue( VK_OBJECT_TYPE_SEMAPHORE, reinterpret_cast<uint64_t>( m_copySemaphore ), lastUse, lastUseCount );
+
+        m_commandBuffer = nullptr;
+        m_useSemaphore = nullptr;
+        m_copySemaphore = nullptr;
+    }
 
     // release the buffer operation command buffer 
     if ( m_commandBuffer != nullptr )
@@ -478,6 +811,12 @@ void crvkBufferStatic::Destroy( void )
         m_commandBuffer = nullptr;
     }
 
+    if ( m_copyCommandBuffers[0] != nullptr )
+    {
+        vkFreeCommandBuffers( device, m_commandPool, k_copyCommandBuffers, m_copyCommandBuffers );
+        std::memset( m_copyCommandBuffers, 0, sizeof( m_copyCommandBuffers ) );
+    }
+
     if( m_useSemaphore != nullptr )
     {
         vkDestroySemaphore( device, m_useSemaphore, k_allocationCallbacks );
@@ -490,7 +829,30 @@ void crvkBufferStatic::Destroy( void )
         m_copySemaphore = nullptr;
     }
     
-    crvkBuffer::Destroy();
+    m_lastCopySemaphore = nullptr;
+    crvkBuffer::Release( lastUse, lastUseCount );
+}
+
+/*
+==============================================
+crvkBufferStatic::LastUse
+==============================================
+*/
+uint32_t crvkBufferStatic::LastUse( crvkTimelinePoint_t* out_points ) const
+{
+    uint32_t count = crvkBuffer::LastUse( out_points );
+    
+    if ( m_useSemaphore != nullptr )
+        out_points[count++] = crvkTimelinePoint_t{ m_useSemaphore, m_useValue };
+
+    if ( m_copySemaphore != nullptr )
+        out_points[count++] = crvkTimelinePoint_t{ m_copySemaphore, m_copyValue };
+    
+    // the last copy can be from a upload batch semaphore 
+    if ( m_lastCopySemaphore != nullptr && m_lastCopySemaphore != m_copySemaphore )
+        out_points[count++] = crvkTimelinePoint_t{ m_lastCopySemaphore, m_lastCopyValue };
+    
+    return count;
 }
 
 /*
@@ -499,60 +861,130 @@ crvkBufferStatic::CopyFromBuffer
 ==============================================
 */
 void crvkBufferStatic::CopyFromBuffer( const VkBuffer in_srcBuffer, const VkBufferCopy2* in_regions, const uint32_t in_count ) 
+{
+    if ( !RecordCopy( in_srcBuffer, in_regions, in_count, true ) )
+        return;
+
+    SubmitCopy( nullptr, 0 );
+}
+
+/*
+==============================================
+crvkBufferStatic::CopyToBuffer
+==============================================
+*/
+void crvkBufferStatic::CopyToBuffer( const VkBuffer in_dstBuffer, const VkBufferCopy2 *in_regions, const uint32_t in_count )
+{
+    if ( !RecordCopy( in_dstBuffer, in_regions, in_count, false ) )
+        return;
+
+    SubmitCopy( nullptr, 0 );
+}
+
+/*
+==============================================
+crvkBufferStatic::RecordCopy
+==============================================
+*/
+bool crvkBufferStatic::RecordCopy( const VkBuffer in_buffer, const VkBufferCopy2* in_regions, const uint32_t in_count, const bool in_upload )
 {
     VkResult result = VK_SUCCESS;
 
+    // the command buffer can't be reset while his copy is pending, but the other copies can be 
+    result = NextCopyCommand();
+    if( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkBufferStatic::RecordCopy::vkWaitSemaphores", result );
+        return false;
+    }
+
+    VkCommandBuffer commandBuffer = m_copyCommandBuffers[m_copyCommand];
+
     // reset the command buffer before start using 
-    result = vkResetCommandBuffer( m_commandBuffer, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT );
+    result = vkResetCommandBuffer( commandBuffer, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT );
     if( result != VK_SUCCESS )
     {
-        crvkAppendError( "crvkBufferStatic::CopyFromBuffer::vkBeginCommandBuffer", result );
-        return; // todo: trow a error
+        crvkAppendError( "crvkBufferStatic::RecordCopy::vkResetCommandBuffer", result );
+        return false;
     }
 
     // begin registering command buffer 
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    result = vkBeginCommandBuffer( m_commandBuffer, &beginInfo );
+    result = vkBeginCommandBuffer( commandBuffer, &beginInfo );
     if( result != VK_SUCCESS )
     {
-        crvkAppendError( "crvkBufferStatic::CopyFromBuffer::CopyFromBuffer", result );
-        return;
+        crvkAppendError( "crvkBufferStatic::RecordCopy::vkBeginCommandBuffer", result );
+        return false;
     }
 
-    // change the buffer state to recive content
-    crvkBuffer::StateTransition( m_commandBuffer, CRVK_BUFFER_STATE_GPU_COPY_DST, m_transferFamily );
+    // change the state of the copied ranges to recive or send content
+    crvkBarrierBatch barriers;
+    barriers.Begin( commandBuffer );
+    for ( uint32_t i = 0; i < in_count; i++ )
+    {
+        VkDeviceSize offset = in_upload ? in_regions[i].dstOffset : in_regions[i].srcOffset;
+        crvkBuffer::StateTransition( &barriers, in_upload ? CRVK_BUFFER_STATE_GPU_COPY_DST : CRVK_BUFFER_STATE_GPU_COPY_SRC, offset, in_regions[i].size, m_transferFamily );
+    }
+    barriers.Flush();
 
     // perform the copy of the buffer conent 
     VkCopyBufferInfo2   copyBufferInfo{};
     copyBufferInfo.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2;
-    copyBufferInfo.srcBuffer = in_srcBuffer;
-    copyBufferInfo.dstBuffer = m_bufferHandler->buffer;
+    copyBufferInfo.srcBuffer = in_upload ? in_buffer : m_bufferHandler->buffer;
+    copyBufferInfo.dstBuffer = in_upload ? m_bufferHandler->buffer : in_buffer;
     copyBufferInfo.regionCount = in_count;
     copyBufferInfo.pRegions = in_regions;
     copyBufferInfo.pNext = nullptr;
-    vkCmdCopyBuffer2( m_commandBuffer, &copyBufferInfo );
+    vkCmdCopyBuffer2( commandBuffer, &copyBufferInfo );
+
+    // the other buffer is read by the CPU, the timeline wait alone don't make the copy visible to the host 
+    if ( !in_upload )
+    {
+        for ( uint32_t i = 0; i < in_count; i++ )
+        {
+            VkBufferMemoryBarrier2 hostBarrier{};
+            hostBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+            hostBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+            hostBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            hostBarrier.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+            hostBarrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+            hostBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            hostBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            hostBarrier.buffer = in_buffer;
+            hostBarrier.offset = in_regions[i].dstOffset;
+            hostBarrier.size = in_regions[i].size;
+            barriers.Buffer( &hostBarrier );
+        }
+        barriers.Flush();
+    }
 
     // End buffer recording 
-    result = vkEndCommandBuffer( m_commandBuffer );
+    result = vkEndCommandBuffer( commandBuffer );
     if( result != VK_SUCCESS )
     {
-        crvkAppendError( "crvkBufferStaging::SubData::vkEndCommandBuffer", result );
-        return;
+        crvkAppendError( "crvkBufferStatic::RecordCopy::vkEndCommandBuffer", result );
+        return false;
     }
 
+    return true;
+}
+
+/*
+==============================================
+crvkBufferStatic::SubmitCopy
+==============================================
+*/
+bool crvkBufferStatic::SubmitCopy( const crvkStagingRange_t* in_ranges, const uint32_t in_count, crvkTimelinePoint_t* out_readback )
+{
+    VkResult result = VK_SUCCESS;
+
     // submint the copy command to the device queue 
     VkCommandBufferSubmitInfo commandBufferSubmitInfo{};
     commandBufferSubmitInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
-    commandBufferSubmitInfo.commandBuffer = m_commandBuffer;
+    commandBufferSubmitInfo.commandBuffer = m_copyCommandBuffers[m_copyCommand];
     
-    // signal to GPU to wait for the copy end before use
-    VkSemaphoreSubmitInfo signalInfo[1] = 
-    {
-        SignalLastCopy()
-    };
-   
     // Wait for the last copy to finish, or buffer to be released  
     VkSemaphoreSubmitInfo waitInfo[2] = 
     {
@@ -560,7 +992,15 @@ void crvkBufferStatic::CopyFromBuffer( const VkBuffer in_srcBuffer, const VkBuff
         WaitLastUse(),
     };
 
-     // 
+    // signal to GPU to wait for the copy end before use
+    VkSemaphoreSubmitInfo signalInfo[1] = 
+    {
+        SignalLastCopy()
+    };
+
+    // the command buffer is free again once this value is reached 
+    m_copyCommandValues[m_copyCommand] = m_copyValue;
+
     VkSubmitInfo2 submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
     submitInfo.waitSemaphoreInfoCount = 2;
@@ -569,75 +1009,70 @@ void crvkBufferStatic::CopyFromBuffer( const VkBuffer in_srcBuffer, const VkBuff
     submitInfo.pCommandBufferInfos = &commandBufferSubmitInfo;
     submitInfo.signalSemaphoreInfoCount = 1;
     submitInfo.pSignalSemaphoreInfos = signalInfo;
-    result = vkQueueSubmit2( m_bufferHandler->queue, 1, &submitInfo, nullptr );
+
+    // staging ranges are given back to the ring when the copy finish 
+    if ( in_count > 0 )
+        result = m_device->UploadManager()->Submit( m_bufferHandler->queue, &submitInfo, in_ranges, in_count );
+    else if ( out_readback != nullptr )
+    {
+        // the read back queue wait on the ring timeline, this buffer can be released before the delivery 
+        out_readback->semaphore = m_device->ReadbackManager()->Semaphore( m_bufferHandler->queue );
+        result = m_device->ReadbackManager()->Submit( m_bufferHandler->queue, &submitInfo, nullptr, 0, &out_readback->value );
+    }
+    else
+        result = m_bufferHandler->queue->Submit( &submitInfo, 1 );
+    
     if( result != VK_SUCCESS )
     {
-        crvkAppendError( "crvkBufferStaging::SubData::vkQueueSubmit2", result );
-        return;
+        crvkAppendError( "crvkBufferStatic::SubmitCopy::vkQueueSubmit2", result );
+        return false;
     }
+
+    return true;
 }
 
 /*
 ==============================================
-crvkBufferStatic::CopyToBuffer
+crvkBufferStatic::NextCopyCommand
 ==============================================
 */
-void crvkBufferStatic::CopyToBuffer( const VkBuffer in_dstBuffer, const VkBufferCopy2 *in_regions, const uint32_t in_count )
+VkResult crvkBufferStatic::NextCopyCommand( void )
 {
+    uint64_t value = 0;
     VkResult result = VK_SUCCESS;
-    crvkDeviceQueue* queue = nullptr;
-    VkDevice device = m_device->Device();
+    m_copyCommand = ( m_copyCommand + 1 ) % k_copyCommandBuffers;
 
-    // reset the command buffer before start using 
-    result = vkResetCommandBuffer( m_commandBuffer, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT );
-    if( result != VK_SUCCESS )
-    {
-        crvkAppendError( "crvkBufferStatic::CopyFromBuffer::vkBeginCommandBuffer", result );
-        return; // todo: trow a error
-    }
+    result = vkGetSemaphoreCounterValue( m_device->Device(), m_copySemaphore, &value );
+    if ( result != VK_SUCCESS || value >= m_copyCommandValues[m_copyCommand] )
+        return result;
 
-    // begin a copy download comand 
-    VkCommandBufferBeginInfo beginInfo{};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer( m_commandBuffer, &beginInfo );
-    
-    // change the buffer state to recive content
-    crvkBuffer::StateTransition( m_commandBuffer, CRVK_BUFFER_STATE_GPU_COPY_SRC, queue->Family() );
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_copySemaphore;
+    waitInfo.pValues = &m_copyCommandValues[m_copyCommand];
 
-    // copy content from GPU buffer to the CPU buffer 
-    VkCopyBufferInfo2 copyBufferInfo{};
-    copyBufferInfo.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2;
-    copyBufferInfo.srcBuffer = m_bufferHandler->buffer;
-    copyBufferInfo.dstBuffer = in_dstBuffer;
-    copyBufferInfo.regionCount = in_count;
-    copyBufferInfo.pRegions = in_regions;
-    copyBufferInfo.pNext = nullptr;
-    vkCmdCopyBuffer2( m_commandBuffer, &copyBufferInfo );
-    
-    // submint the copy command to the device queue 
-    VkCommandBufferSubmitInfo commandBufferSubmitInfo{};
-    commandBufferSubmitInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
-    commandBufferSubmitInfo.commandBuffer = m_commandBuffer;
-    
-    // signal to GPU to wait for the copy end before use
-    VkSemaphoreSubmitInfo signalInfo = SignalLastCopy();
-
-    // Wait for the last copy to finish, or buffer to be released  
-    VkSemaphoreSubmitInfo waitInfo[2];
-    waitInfo[0] = WaitLastCopy(); // wait device release the buffer 
-    waitInfo[1] = WaitLastUse(); // wait for last copy end 
+    // the copy can be still queued in a deferred queue 
+    m_bufferHandler->queue->Flush();
+    return vkWaitSemaphores( m_device->Device(), &waitInfo, UINT64_MAX );
+}
 
-    // submit 
-    VkSubmitInfo2 submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
-    submitInfo.waitSemaphoreInfoCount = 2;
-    submitInfo.pWaitSemaphoreInfos = waitInfo;
-    submitInfo.commandBufferInfoCount = 1;
-    submitInfo.pCommandBufferInfos = &commandBufferSubmitInfo;
-    submitInfo.signalSemaphoreInfoCount = 1;
-    submitInfo.pSignalSemaphoreInfos = &signalInfo;
-    vkQueueSubmit2( m_bufferHandler->queue, 1, &submitInfo, nullptr );
+/*
+==============================================
+crvkBufferStatic::WaitCopy
+==============================================
+*/
+VkResult crvkBufferStatic::WaitCopy( void ) const
+{
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_lastCopySemaphore;
+    waitInfo.pValues = &m_lastCopyValue;
+
+    // the copy can be still queued in a deferred queue 
+    m_bufferHandler->queue->Flush();
+    return vkWaitSemaphores( m_device->Device(), &waitInfo, UINT64_MAX );
 }
 
 /*
@@ -659,7 +1094,6 @@ void *crvkBufferStatic::Map( const uintptr_t in_offset, const size_t in_size, co
 {
     VkResult result = VK_SUCCESS;
     crvkBufferState_t state = CRVK_BUFFER_STATE_CPU_COPY_SRC;
-    void* pointer = nullptr;
 
     // reset the command buffer before start using 
     result = vkResetCommandBuffer( m_commandBuffer, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT );
@@ -685,12 +1119,10 @@ void *crvkBufferStatic::Map( const uintptr_t in_offset, const size_t in_size, co
     else
         state = CRVK_BUFFER_STATE_CPU_COPY_DST;
 
-    // change the buffer state to recive content
-    crvkBuffer::StateTransition( m_commandBuffer, state, m_transferFamily );
+    // change the mapped range state to recive content
+    crvkBuffer::StateTransition( m_commandBuffer, state, in_offset, in_size, m_transferFamily );
 
-    vkMapMemory( m_device->Device(), m_bufferHandler->memory, in_offset, in_size, 0, &pointer );
-    
-    return pointer;    
+    return crvkBuffer::Map( in_offset, in_size, in_acces );
 }
 
 /*
@@ -701,7 +1133,7 @@ crvkBufferStatic::Unmap
 void crvkBufferStatic::Unmap( const crvkBufferState_t in_state )
 {
     // release memory acess
-    vkUnmapMemory( m_device->Device(), m_bufferHandler->memory );
+    crvkBuffer::Unmap();
     crvkBuffer::StateTransition( m_commandBuffer, in_state, m_transferFamily );
 
     //
@@ -712,13 +1144,13 @@ void crvkBufferStatic::Unmap( const crvkBufferState_t in_state )
     commandBufferSubmitInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
     commandBufferSubmitInfo.commandBuffer = m_commandBuffer;
     
-    // signal to GPU to wait for the copy end before use
-    VkSemaphoreSubmitInfo signalInfo = SignalLastCopy();
-
     // Wait for the last copy to finish, or buffer to be released  
     VkSemaphoreSubmitInfo waitInfo[2];
-    waitInfo[0] = WaitLastCopy(); // wait device release the buffer 
-    waitInfo[1] = WaitLastUse(); // wait for last copy end 
+    waitInfo[0] = WaitLastCopy(); // wait for last copy end 
+    waitInfo[1] = WaitLastUse(); // wait device release the buffer 
+
+    // signal to GPU to wait for the copy end before use
+    VkSemaphoreSubmitInfo signalInfo = SignalLastCopy();
 
     // submit 
     VkSubmitInfo2 submitInfo{};
@@ -729,7 +1161,7 @@ void crvkBufferStatic::Unmap( const crvkBufferState_t in_state )
     submitInfo.pCommandBufferInfos = &commandBufferSubmitInfo;
     submitInfo.signalSemaphoreInfoCount = 1;
     submitInfo.pSignalSemaphoreInfos = &signalInfo;
-    vkQueueSubmit2( m_bufferHandler->queue, 1, &submitInfo, nullptr );
+    m_bufferHandler->queue->Submit( &submitInfo, 1 );
 }
 
 /*
@@ -751,6 +1183,7 @@ crvkBufferStatic::SignalLastCopy
 VkSemaphoreSubmitInfo crvkBufferStatic::SignalLastCopy(void)
 {
     VkSemaphoreSubmitInfo copySignal{ VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, m_copySemaphore, ++m_copyValue, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0 };
+    SetLastCopy( m_copySemaphore, m_copyValue );
     return copySignal;
 }
 
@@ -772,18 +1205,30 @@ crvkBufferStatic::WaitLastCopy
 */
 VkSemaphoreSubmitInfo crvkBufferStatic::WaitLastCopy(void)
 {
-    VkSemaphoreSubmitInfo waitCopy{ VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, m_copySemaphore, m_copyValue -1, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0 }; // wait finish last copy
+    VkSemaphoreSubmitInfo waitCopy{ VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, m_lastCopySemaphore, m_lastCopyValue, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0 }; // wait finish last copy
     return waitCopy;
 }
 
+/*
+==============================================
+crvkBufferStatic::SetLastCopy
+==============================================
+*/
+void crvkBufferStatic::SetLastCopy( const VkSemaphore in_semaphore, const uint64_t in_value )
+{
+    m_lastCopySemaphore = in_semaphore;
+    m_lastCopyValue = in_value;
+}
+
 /*
 ==============================================
 crvkBufferStaging::crvkBufferStaging
 ==============================================
 */
 crvkBufferStaging::crvkBufferStaging( void ) : crvkBufferStatic(), 
-    m_stagingBuffer( nullptr ),
-    m_stagingMemory( nullptr )
+    m_direct( false ),
+    m_mapacess( CRVK_BUFFER_MAP_ACCESS_NONE ),
+    m_dirty()
 {
 }
 
@@ -808,60 +1253,25 @@ bool crvkBufferStaging::Create( const crvkDevice* in_device,
                                 const VkBufferUsageFlags in_usage, 
                                 const VkMemoryPropertyFlags in_flags )
 {
-    uint32_t queues[2]{ 0, 0 };
-    VkResult result = VK_SUCCESS;
-    VkDevice device = nullptr;
-    VkMemoryRequirements memRequirements;
-
-    if( !crvkBufferStatic::Create( in_device, in_graphic, in_tranfer, in_size, in_usage, in_flags | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT ) )
-        return false;
-
-    //
-    // Create the CPU side buffer 
-    // ==========================================================================
-    VkBufferCreateInfo cpuBufferCI{};
-    cpuBufferCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    cpuBufferCI.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT; // this is a staging buffer on CPU side
-    cpuBufferCI.size = in_size;
-
-    if ( in_tranfer != nullptr )
-        queues[0] = in_tranfer->Family();
-    else
-        queues[0] = in_graphic->Family();
-
-    cpuBufferCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE; // only graphic or only transfer use this buffer 
-    cpuBufferCI.queueFamilyIndexCount = 1;
-    cpuBufferCI.pQueueFamilyIndices = queues;
-    result = vkCreateBuffer( device, &cpuBufferCI, k_allocationCallbacks, &m_stagingBuffer );
-    if ( result != VK_SUCCESS ) 
-    {
-        crvkAppendError( "crvkBufferStaging::Create::CPU::vkCreateBuffer", result );
-        return false; 
-    }
-
-    vkGetBufferMemoryRequirements( device, m_stagingBuffer, &memRequirements );
-
-    VkMemoryAllocateInfo memoryAllocI{};
-    memoryAllocI.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    memoryAllocI.allocationSize = memRequirements.size;
-    memoryAllocI.memoryTypeIndex = m_device->FindMemoryType( memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
-
-    result = vkAllocateMemory( device, &memoryAllocI, k_allocationCallbacks, &m_stagingMemory ); 
-    if ( result != VK_SUCCESS ) 
-    {        
-        crvkAppendError( "crvkBufferStaging::Create::CPU::vkAllocateMemory", result );
-        return false;
-    }
-
-    // bind buffer handler to the memory
-    result = vkBindBufferMemory( device, m_stagingBuffer, m_stagingMemory, 0 );
-    if ( result != VK_SUCCESS )
+    // small buffers, or all on devices that share the memory with the CPU, are written in place 
+    m_direct = in_size <= in_device->DirectWriteLimit();
+    if ( m_direct )
     {
-        crvkAppendError( "crvkBufferStaging::Create::CPU::vkBindBufferMemory", result );
-        return false;
+        return crvkBufferStatic::Create(    in_device, 
+                                            in_graphic, 
+                                            in_tranfer, 
+                                            in_size, 
+                                            in_usage | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, 
+                                            in_flags | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT );
     }
 
-    return true;
+    // CPU side content go trough the device staging ring, we only need the GPU buffer 
+    return crvkBufferStatic::Create(    in_device, 
+                                        in_graphic, 
+                                        in_tranfer, 
+                                        in_size, 
+                                        in_usage | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, 
+                                        in_flags | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
 }
     
 /*
@@ -871,20 +1281,15 @@ crvkBufferStaging::Destroy
 */
 void crvkBufferStaging::Destroy( void )
 {
-    VkDevice device = m_device->Device();
-
-    // release CPU side buffer memory 
-    if ( m_stagingMemory != nullptr )
+    // release the map staging buffer, the GPU is not using it while mapped 
+    if ( m_mapacess != CRVK_BUFFER_MAP_ACCESS_NONE )
     {
-        vkFreeMemory( device, m_stagingMemory, k_allocationCallbacks );
-        m_stagingMemory = nullptr; 
-    }
-    
-    // release the CPU side buffer handler 
-    if ( m_stagingBuffer != nullptr )
-    {
-        vkDestroyBuffer( device, m_stagingBuffer, k_allocationCallbacks );
-        m_stagingBuffer = nullptr;
+        if ( m_direct )
+            crvkBuffer::Unmap();
+        else
+            m_mapStaging.Destroy();
+        
+        m_mapacess = CRVK_BUFFER_MAP_ACCESS_NONE;
     }
  
     // release fences and semaphores
@@ -898,29 +1303,50 @@ crvkBufferStaging::SubData
 */
 void crvkBufferStaging::SubData( const void* in_data, const uintptr_t in_offset, const size_t in_size ) const
 {
-    VkResult result = VK_SUCCESS;
-    void* data = nullptr;
-    VkDevice device = m_device->Device();
-
-    // copy data to our CPU buffer 
-    result = vkMapMemory( device, m_stagingMemory, in_offset, in_size, 0, &data );
-    std::memcpy( data, in_data, in_size );
-    vkUnmapMemory( device, m_stagingMemory );
-    if( result != VK_SUCCESS )
+    crvkBufferStaging* self = const_cast<crvkBufferStaging*>( this );
+    crvkUploadManager* upload = m_device->UploadManager();
+    const uint8_t* data = static_cast<const uint8_t*>( in_data );
+    VkDeviceSize chunkSize = upload->Capacity() / 4; // don't let a single upload hold the whole ring 
+
+    // write in place when the GPU is done with the buffer, else the ring copy is queued behind his work, 
+    // so the CPU never wait it 
+    if ( m_direct && !InFlight() )
     {
-        crvkAppendError( "crvkBufferStaging::SubData::vkMapMemory", result );
+        void* pointer = self->crvkBuffer::Map( in_offset, in_size, CRVK_BUFFER_MAP_ACCESS_WRITE );
+        if ( pointer == nullptr )
+            return;
+
+        std::memcpy( pointer, in_data, in_size );
+        crvkBuffer::Flush( in_offset, in_size );
+        self->crvkBuffer::Unmap();
         return;
     }
 
-    VkBufferCopy2 copy{};
-    copy.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
-    copy.srcOffset = in_offset;
-    copy.dstOffset = in_offset;
-    copy.size =  in_size;
-    copy.pNext = nullptr;
-
-    // now we copy to from CPU buffer size to GPU Buffer
-    const_cast<crvkBufferStaging*>( this )->CopyFromBuffer( m_stagingBuffer, &copy, 1 );
+    for ( VkDeviceSize done = 0; done < in_size; done += chunkSize )
+    {
+        crvkStagingRange_t range{};
+        VkDeviceSize size = std::min<VkDeviceSize>( chunkSize, in_size - done );
+
+        // copy data to the staging ring 
+        if ( !upload->Allocate( size, 4, &range ) )
+            return;
+        
+        std::memcpy( range.pointer, data + done, size );
+
+        VkBufferCopy2 copy{};
+        copy.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
+        copy.srcOffset = range.offset;
+        copy.dstOffset = in_offset + done;
+        copy.size = size;
+        copy.pNext = nullptr;
+
+        // now we copy to from staging ring to GPU Buffer
+        if ( !self->RecordCopy( range.buffer, &copy, 1, true ) || !self->SubmitCopy( &range, 1 ) )
+        {
+            upload->Release( &range );
+            return;
+        }
+    }
 }
 
 /*
@@ -930,27 +1356,90 @@ crvkBufferStaging::GetSubData
 */
 void crvkBufferStaging::GetSubData( void* in_data, const uintptr_t in_offset, const size_t in_size ) const 
 {
-    void* data = nullptr;
-    VkDevice device = m_device->Device();
+    crvkBufferStaging* self = const_cast<crvkBufferStaging*>( this );
+    crvkUploadManager* readback = m_device->ReadbackManager();
+    uint8_t* data = static_cast<uint8_t*>( in_data );
+    VkDeviceSize chunkSize = readback->Capacity() / 4;
+
+    // read in place, once the GPU finish write it 
+    if ( m_direct )
+    {
+        if ( InFlight() && WaitIdle() != VK_SUCCESS )
+            return;
+
+        const void* pointer = self->crvkBuffer::Map( in_offset, in_size, CRVK_BUFFER_MAP_ACCESS_READ );
+        if ( pointer == nullptr )
+            return;
+
+        std::memcpy( in_data, pointer, in_size );
+        self->crvkBuffer::Unmap();
+        return;
+    }
+
+    for ( VkDeviceSize done = 0; done < in_size; done += chunkSize )
+    {
+        crvkStagingRange_t range{};
+        VkDeviceSize size = std::min<VkDeviceSize>( chunkSize, in_size - done );
+
+        // a CPU cached range, read much faster than the upload ring 
+        if ( !readback->Allocate( size, 4, &range ) )
+            return;
+
+        VkBufferCopy2 copy{};
+        copy.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
+        copy.pNext = nullptr;
+        copy.srcOffset = in_offset + done;
+        copy.dstOffset = range.offset;
+        copy.size = size;
+    
+        // copy from GPU buffer to the read back ring, the range is ours until we release it 
+        if ( !self->RecordCopy( range.buffer, &copy, 1, false ) || !self->SubmitCopy( nullptr, 0 ) )
+        {
+            readback->Release( &range );
+            return;
+        }
+
+        // wait for device end copy the buffer 
+        WaitCopy();
+
+        // copy the content of the read back ring to the data pointer, non coherent memory need a invalidate 
+        readback->Invalidate( &range );
+        std::memcpy( data + done, range.pointer, size );
+        readback->Release( &range );
+    }
+}
+
+/*
+==============================================
+crvkBufferStaging::GetSubDataAsync
+==============================================
+*/
+crvkReadbackTicket_t crvkBufferStaging::GetSubDataAsync( const uintptr_t in_offset, const size_t in_size, crvkReadbackCallback_t in_callback, void* in_userData ) const
+{
+    crvkBufferStaging* self = const_cast<crvkBufferStaging*>( this );
+    crvkUploadManager* readback = m_device->ReadbackManager();
+    crvkStagingRange_t range{};
+
+    // the range stay ours until the read back is delivered, it can't be split 
+    if ( !readback->Allocate( in_size, 4, &range ) )
+        return 0;
 
     VkBufferCopy2 copy{};
     copy.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
     copy.pNext = nullptr;
     copy.srcOffset = in_offset;
-    copy.dstOffset = in_offset;
-    copy.size =  in_size;
-    
-    // copy from GPU buffer to CPU
-    const_cast<crvkBufferStaging*>( this )->CopyToBuffer( m_stagingBuffer, &copy, 1 );
+    copy.dstOffset = range.offset;
+    copy.size = in_size;
 
-    // wait for device end copy the buffer 
-    VkSemaphoreWaitInfo smWaitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO, nullptr, 0, 1, &m_copySemaphore }; 
-    vkWaitSemaphores( m_device->Device(), &smWaitInfo, UINT64_MAX );
+    // the direct write buffers also use the copy, so the CPU don't wait the GPU stop using it 
+    crvkTimelinePoint_t copyEnd{};
+    if ( !self->RecordCopy( range.buffer, &copy, 1, false ) || !self->SubmitCopy( nullptr, 0, &copyEnd ) )
+    {
+        readback->Release( &range );
+        return 0;
+    }
 
-    // copy the content of the CPU buffer to the data pointer
-    vkMapMemory( device, m_stagingMemory, in_offset, in_size, 0, &data );
-    std::memcpy( in_data, data, in_size );
-    vkUnmapMemory( device, m_stagingMemory );
+    return m_device->ReadbackQueue()->Enqueue( &range, 0, in_size, &copyEnd, m_bufferHandler->queue, in_callback, in_userData );
 }
 
 /*
@@ -960,35 +1449,61 @@ crvkBufferStaging::Map
 */
 void *crvkBufferStaging::Map(const uintptr_t in_offset, const size_t in_size, const crvkBufferMapAccess_t in_acces)
 {
-    m_mapacess = in_acces;
-    VkResult res = VK_SUCCESS;
-    VkDeviceSize bufferSize = VK_WHOLE_SIZE;
-    void* map = nullptr;
+    VkDeviceSize bufferSize = m_bufferHandler->size - in_offset;
 
     if ( in_size != 0 )
         bufferSize = in_size;
 
-    if( in_acces == CRVK_BUFFER_MAP_ACCESS_READ )
+    // give the buffer memory itself, once the GPU is done with it 
+    if ( m_direct )
     {
-        // TODO: inser a barrier, to sync staging buffer as copy destine 
-
-        // we copy the content of the GPU buffer to our CPU buffer, before map to acess
-        VkBufferCopy2 region{};
-        region.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
-        region.pNext = nullptr;
-        region.srcOffset = in_offset;
-        region.dstOffset = in_offset;
-        region.size = in_size;
-
-        // load content from GPU buffer
-        CopyToBuffer( m_stagingBuffer, &region, 1 ); 
+        if ( InFlight() && WaitIdle() != VK_SUCCESS )
+            throw std::runtime_error( "Map Error" );
+
+        void* pointer = crvkBuffer::Map( in_offset, bufferSize, in_acces );
+        if ( pointer == nullptr )
+            throw std::runtime_error( "Map Error" );
+
+        m_mapacess = in_acces;
+        m_mapOffset = in_offset;
+        m_mapSize = bufferSize;
+        m_dirty.Clear();
+        return pointer;
     }
 
-    res = vkMapMemory( m_device->Device(), m_stagingMemory, in_offset, bufferSize, 0, &map );
-    if ( res != VK_SUCCESS )
+    // the map is held by the application code for as long it want, a range of the shared staging rings 
+    // would block the other uploads of the device, and a big map would not fit, so it get his own staging buffer 
+    if ( !CreateMapStaging( bufferSize, in_acces ) )
         throw std::runtime_error( "Map Error" );
 
-    return map;
+    m_mapacess = in_acces;
+    m_mapOffset = in_offset;
+    m_mapSize = bufferSize;
+    m_dirty.Clear();
+
+    // Unmap copy only the flushed ranges, a write map never send the bytes it don't wrote, 
+    // so it don't need the buffer content 
+    if ( in_acces == CRVK_BUFFER_MAP_ACCESS_WRITE )
+        return m_mapStaging.Map( 0, bufferSize, in_acces );
+
+    // we copy the content of the GPU buffer to the staging buffer, before map to acess 
+    VkBufferCopy2 region{};
+    region.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
+    region.pNext = nullptr;
+    region.srcOffset = in_offset;
+    region.dstOffset = 0;
+    region.size = bufferSize;
+
+    // load content from GPU buffer
+    if ( !RecordCopy( m_mapStaging.Handle(), &region, 1, false ) || !SubmitCopy( nullptr, 0 ) || WaitCopy() != VK_SUCCESS )
+    {
+        m_mapStaging.Destroy();
+        m_mapacess = CRVK_BUFFER_MAP_ACCESS_NONE;
+        throw std::runtime_error( "Map Error" );
+    }
+    
+    // make the copy visible on non coherent memory 
+    return m_mapStaging.Map( 0, bufferSize, CRVK_BUFFER_MAP_ACCESS_READ );
 }
 
 /*
@@ -998,25 +1513,57 @@ crvkBufferStaging::Unmap
 */
 void crvkBufferStaging::Unmap( void ) 
 {
-    // release buffer memory map 
-    vkUnmapMemory( m_device->Device(), m_stagingMemory );
+    // buffer are not mapped
+    if ( m_mapacess == CRVK_BUFFER_MAP_ACCESS_NONE )
+        return;
+
+    // the written content is already in place, only non coherent memory need a flush 
+    if ( m_direct )
+    {
+        uint32_t count = 0;
+        const crvkDirtyRange_t* dirty = m_dirty.Ranges( &count );
+        if ( m_mapacess == CRVK_BUFFER_MAP_ACCESS_WRITE && count == 0 )
+            crvkAppendError( "crvkBufferStaging::Unmap::write map without flushed ranges", VK_INCOMPLETE );
+        
+        for ( uint32_t i = 0; i < count; i++ )
+            crvkBuffer::Flush( dirty[i].begin, dirty[i].end - dirty[i].begin );
+
+        crvkBuffer::Unmap();
+        m_dirty.Clear();
+        m_mapacess = CRVK_BUFFER_MAP_ACCESS_NONE;
+        return;
+    }
 
     // flush buffer content 
-    if ( m_mapacess == CRVK_BUFFER_STATE_COMPUTE_WRITE )
+    if ( m_mapacess == CRVK_BUFFER_MAP_ACCESS_WRITE )
     {
-        // flush the buffer content, before we use it
-        VkBufferCopy2 region{};
-        region.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
-        region.pNext = nullptr;
-        region.srcOffset = 0;
-        region.dstOffset = 0;
-        region.size = VK_WHOLE_SIZE; // worst case, scenario, we flush the whole buffer 
-
-        // load content from GPU buffer
-        CopyFromBuffer( m_stagingBuffer, &region, 1 ); 
+        crvkDynamicVector<VkBufferCopy2> regions;
+        uint32_t count = 0;
+
+        // one region by merged written range 
+        const crvkDirtyRange_t* dirty = m_dirty.Ranges( &count );
+        regions.Resize( count );
+        for ( uint32_t i = 0; i < count; i++ )
+        {
+            regions[i].sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
+            regions[i].pNext = nullptr;
+            regions[i].srcOffset = dirty[i].begin - m_mapOffset;
+            regions[i].dstOffset = dirty[i].begin;
+            regions[i].size = dirty[i].end - dirty[i].begin;
+            m_mapStaging.Flush( regions[i].srcOffset, regions[i].size );
+        }
+
+        // nothing was flushed, so nothing is sent, the written ranges must be given to Flush 
+        if ( count == 0 )
+            crvkAppendError( "crvkBufferStaging::Unmap::write map without flushed ranges", VK_INCOMPLETE );
+        else if ( RecordCopy( m_mapStaging.Handle(), regions.Pointer(), count, true ) && SubmitCopy( nullptr, 0 ) )
+            m_mapStaging.SetLastUse( m_copySemaphore, m_copyValue );   // released by the deletion queue when the copy finish 
     }
-    
+
+    // content already readed, the GPU are not using the read staging buffer 
+    m_mapStaging.Destroy();
     m_mapacess = CRVK_BUFFER_MAP_ACCESS_NONE;
+    m_dirty.Clear();
 }
 
 /*
@@ -1026,20 +1573,128 @@ crvkBufferStaging::Flush
 */
 void crvkBufferStaging::Flush( const uintptr_t in_offset, const size_t in_size ) const
 {
+    crvkBufferStaging* self = const_cast<crvkBufferStaging*>( this );
+
     /// buffer are not mapped
     if ( m_mapacess == CRVK_BUFFER_MAP_ACCESS_NONE )
         return;    
 
+    // the range must be inside the mapped range 
+    SDL_assert( in_offset >= m_mapOffset && in_offset + in_size <= m_mapOffset + m_mapSize );
+
+    // the written ranges are merged and sent by Unmap, a staging copy by Flush cost a submit and a CPU wait 
+    if ( m_mapacess == CRVK_BUFFER_MAP_ACCESS_WRITE )
+    {
+        self->m_dirty.Add( in_offset, in_size );
+        return;
+    }
+
+    // the mapped memory is the buffer memory 
+    if ( m_direct )
+    {
+        if ( m_mapacess == CRVK_BUFFER_MAP_ACCESS_READ && ( !InFlight() || WaitIdle() == VK_SUCCESS ) )
+            m_bufferHandler->allocator->Invalidate( &m_bufferHandler->allocation, in_offset, in_size );
+        
+        return;
+    }
+
     VkBufferCopy2 copyRegion{};
     copyRegion.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
     copyRegion.pNext = nullptr;
-    copyRegion.dstOffset = in_offset;
-    copyRegion.srcOffset = in_offset;
     copyRegion.size = in_size;
 
-    // perform a copy from buffer 
-    if ( m_mapacess == CRVK_BUFFER_MAP_ACCESS_WRITE ) // copy content from 
-        const_cast<crvkBufferStaging*>( this )->CopyToBuffer( m_stagingBuffer, &copyRegion, 1 );
-    else if ( m_mapacess == CRVK_BUFFER_MAP_ACCESS_READ )
-        const_cast<crvkBufferStaging*>( this )->CopyFromBuffer( m_stagingBuffer, &copyRegion, 1 );
+    // reload the content from the GPU buffer 
+    if ( m_mapacess == CRVK_BUFFER_MAP_ACCESS_READ )
+    {
+        copyRegion.srcOffset = in_offset;
+        copyRegion.dstOffset = in_offset - m_mapOffset;
+        if ( self->RecordCopy( m_mapStaging.Handle(), &copyRegion, 1, false ) && self->SubmitCopy( nullptr, 0 ) )
+            WaitCopy();
+
+        // make the copy visible on non coherent memory 
+        self->m_mapStaging.Map( copyRegion.dstOffset, in_size, CRVK_BUFFER_MAP_ACCESS_READ );
+    }
+}
+
+/*
+==============================================
+crvkBufferStaging::CreateMapStaging
+==============================================
+*/
+bool crvkBufferStaging::CreateMapStaging( const VkDeviceSize in_size, const crvkBufferMapAccess_t in_acces )
+{
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    VkMemoryPropertyFlags flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    // the CPU read from uncached memory is very slow, a cached one can be non coherent 
+    if ( in_acces == CRVK_BUFFER_MAP_ACCESS_READ )
+    {
+        if ( m_mapStaging.Create( m_device, m_bufferHandler->queue, nullptr, in_size, usage, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT ) )
+            return true;
+
+        m_mapStaging.Destroy();
+    }
+
+    if ( m_mapStaging.Create( m_device, m_bufferHandler->queue, nullptr, in_size, usage, flags ) )
+        return true;
+    
+    m_mapStaging.Destroy();
+    return false;
+}
+
+/*
+==============================================
+crvkBufferStaging::InFlight
+==============================================
+*/
+bool crvkBufferStaging::InFlight( void ) const
+{
+    crvkTimelinePoint_t points[crvkDeletionQueue::k_maxPoints];
+    uint32_t count = LastUse( points );
+
+    // a counter read don't flush the queue, a copy still queued is not reached yet 
+    for ( uint32_t i = 0; i < count; i++ )
+    {
+        uint64_t value = 0;
+        if ( vkGetSemaphoreCounterValue( m_device->Device(), points[i].semaphore, &value ) != VK_SUCCESS || value < points[i].value )
+            return true;
+    }
+
+    return false;
+}
+
+/*
+==============================================
+crvkBufferStaging::WaitIdle
+==============================================
+*/
+VkResult crvkBufferStaging::WaitIdle( void ) const
+{
+    crvkTimelinePoint_t points[crvkDeletionQueue::k_maxPoints];
+    VkSemaphore semaphores[crvkDeletionQueue::k_maxPoints];
+    uint64_t values[crvkDeletionQueue::k_maxPoints];
+    uint32_t count = LastUse( points );
+
+    for ( uint32_t i = 0; i < count; i++ )
+    {
+        semaphores[i] = points[i].semaphore;
+        values[i] = points[i].value;
+    }
+
+    // a copy can be still queued in a deferred queue 
+    m_bufferHandler->queue->Flush();
+    if ( count == 0 )
+        return VK_SUCCESS;
+
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = count;
+    waitInfo.pSemaphores = semaphores;
+    waitInfo.pValues = values;
+    
+    VkResult result = vkWaitSemaphores( m_device->Device(), &waitInfo, UINT64_MAX );
+    if ( result != VK_SUCCESS )
+        crvkAppendError( "crvkBufferStaging::WaitIdle::vkWaitSemaphores", result );
+    
+    return result;
 }
@@ -27,13 +27,25 @@ typedef struct crvkCommandBufferHandler_t
     uint32_t            count = 0;
     uint32_t            current = 0;
     VkDevice            device = nullptr;
-    VkQueue             queues = nullptr;
+    crvkDeviceQueue*    queue = nullptr;        // submit through it, it can be owned by the submission thread 
     VkCommandPool       commandPool = nullptr;
     VkFence*            fences = nullptr;
     VkSemaphore*        semaphores = nullptr;
     VkCommandBuffer*    commandBuffers = nullptr;
+    crvkBarrierBatch*   barriers = nullptr;     // flushed before each draw, dispatch and copy 
 } crvkCommandBufferHandler_t;
 
+/*
+==============================================
+FlushBarriers
+==============================================
+*/
+static void FlushBarriers( const crvkCommandBufferHandler_t* in_handler )
+{
+    if ( in_handler->barriers != nullptr )
+        in_handler->barriers->Flush();
+}
+
 /*
 ==============================================
 crvkCommandBuffer::crvkCommandBuffer
@@ -67,12 +79,13 @@ bool crvkCommandBuffer::Create( const crvkDevice* in_device, const crvkDeviceQue
         Destroy();
 
     // alloc handler structure
-    m_handler = static_cast<crvkCommandBufferHandler_t*>( SDL_malloc( sizeof( crvkCommandBufferHandler_t ) ) );
+    m_handler = new crvkCommandBufferHandler_t();
     m_handler->device = in_device->Device();
     m_handler->commandPool = in_queue->CommandPool();
-    m_handler->queues = in_queue->Queue();
+    m_handler->queue = const_cast<crvkDeviceQueue*>( in_queue );
     m_handler->count = in_count;
     m_handler->current = 0;
+    m_handler->commandBuffers = static_cast<VkCommandBuffer*>( SDL_malloc( sizeof( VkCommandBuffer ) * in_count ) );
 
     // allocate command buffers
     VkCommandBufferAllocateInfo commandBufferAllocateCI{};
@@ -84,15 +97,30 @@ bool crvkCommandBuffer::Create( const crvkDevice* in_device, const crvkDeviceQue
     result = vkAllocateCommandBuffers( m_handler->device, &commandBufferAllocateCI, m_handler->commandBuffers );
     if( result != VK_SUCCESS )
     {
+        SDL_free( m_handler->commandBuffers );
+        m_handler->commandBuffers = nullptr;
         crvkAppendError( "crvkCommandBuffer::Create::vkAllocateCommandBuffers", result );
         return false;
     }
 
     if ( in_createFences )
     {
-        // TODO:
+        // created signaled, the first wait of each buffer don't block 
+        VkFenceCreateInfo fenceCI{};
+        fenceCI.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceCI.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+        m_handler->fences = static_cast<VkFence*>( SDL_calloc( in_count, sizeof( VkFence ) ) );
+        for ( uint32_t i = 0; i < in_count; i++ )
+        {
+            result = vkCreateFence( m_handler->device, &fenceCI, k_allocationCallbacks, &m_handler->fences[i] );
+            if( result != VK_SUCCESS )
+            {
+                crvkAppendError( "crvkCommandBuffer::Create::vkCreateFence", result );
+                return false;
+            }
+        }
     }
-    
 
     return true;
 }
@@ -113,7 +141,8 @@ void crvkCommandBuffer::Destroy( void )
         // release fences
         for ( uint32_t i = 0; i < m_handler->count; i++)
         {
-            vkDestroyFence( m_handler->device, m_handler->fences[i], k_allocationCallbacks );
+            if ( m_handler->fences[i] != nullptr )
+                vkDestroyFence( m_handler->device, m_handler->fences[i], k_allocationCallbacks );
         }
         
         SDL_free( m_handler->fences );
@@ -124,6 +153,7 @@ void crvkCommandBuffer::Destroy( void )
     if( m_handler->commandBuffers != nullptr )
     {
         vkFreeCommandBuffers( m_handler->device, m_handler->commandPool, m_handler->count, m_handler->commandBuffers );
+        SDL_free( m_handler->commandBuffers );
         m_handler->commandBuffers = nullptr;
     }
     
@@ -131,7 +161,7 @@ void crvkCommandBuffer::Destroy( void )
     m_handler->device = nullptr;
     m_handler->commandPool = nullptr;
 
-    SDL_free( m_handler );
+    delete m_handler;
     m_handler = nullptr;
 }
 
@@ -149,6 +179,34 @@ void crvkCommandBuffer::SelectCurrentBuffer(const uint32_t in_index)
     m_handler->current = std::min( m_handler->count, in_index );
 }
 
+/*
+==============================================
+crvkCommandBuffer::SetBarrierBatch
+==============================================
+*/
+void crvkCommandBuffer::SetBarrierBatch( crvkBarrierBatch* in_batch )
+{
+    if ( m_handler == nullptr )
+        return;
+
+    m_handler->barriers = in_batch;
+    if ( in_batch != nullptr )
+        in_batch->Begin( m_handler->commandBuffers[m_handler->current] );
+}
+
+/*
+==============================================
+crvkCommandBuffer::BarrierBatch
+==============================================
+*/
+crvkBarrierBatch* crvkCommandBuffer::BarrierBatch( void ) const
+{
+    if ( m_handler == nullptr )
+        return nullptr;
+
+    return m_handler->barriers;
+}
+
 /*
 ==============================================
 crvkCommandBuffer::Reset
@@ -169,6 +227,11 @@ VkResult crvkCommandBuffer::Begin( const VkCommandBufferUsageFlags in_flags ) co
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     beginInfo.flags = in_flags;
+
+    // the pending barriers of the last recording are gone with the reset 
+    if ( m_handler->barriers != nullptr )
+        m_handler->barriers->Begin( m_handler->commandBuffers[m_handler->current] );
+
     return vkBeginCommandBuffer( m_handler->commandBuffers[m_handler->current], &beginInfo );   
 }
 
@@ -179,6 +242,7 @@ crvkCommandBuffer::End
 */
 VkResult crvkCommandBuffer::End( void ) const
 {
+    FlushBarriers( m_handler );
     return vkEndCommandBuffer( m_handler->commandBuffers[m_handler->current] );
 }
 
@@ -221,6 +285,19 @@ VkCommandBuffer* crvkCommandBuffer::GetCommandBufferArray( void ) const
     return m_handler->commandBuffers;
 }
 
+/*
+==============================================
+crvkCommandBuffer::GetFence
+==============================================
+*/
+VkFence crvkCommandBuffer::GetFence( const uint32_t in_index ) const
+{
+    if( m_handler == nullptr || m_handler->fences == nullptr || in_index >= m_handler->count )
+        return nullptr;
+
+    return m_handler->fences[in_index];
+}
+
 /*
 ==============================================
 crvkCommandBuffer::Submit
@@ -231,11 +308,15 @@ VkResult crvkCommandBuffer::Submit( const VkSemaphoreSubmitInfo* in_semaphoresTo
                                     const VkSemaphoreSubmitInfo* in_semaphoresToSignal, 
                                     const uint32_t in_semaphoresToSingalCount )
 {
-    uint32_t index = 0;
-    
     // invalid command buffer
-    if( m_handler == nullptr && m_handler->commandBuffers == nullptr )
+    if( m_handler == nullptr || m_handler->commandBuffers == nullptr )
         return VK_INCOMPLETE;
+
+    uint32_t index = m_handler->current;
+    
+    // the fence is signaled by the last submit of this buffer 
+    if ( m_handler->fences != nullptr )
+        vkResetFences( m_handler->device, 1, &m_handler->fences[index] );
     
     VkCommandBufferSubmitInfo commandBufferSI{};
     commandBufferSI.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
@@ -255,7 +336,7 @@ VkResult crvkCommandBuffer::Submit( const VkSemaphoreSubmitInfo* in_semaphoresTo
     submitInfo.signalSemaphoreInfoCount = in_semaphoresToSingalCount;
     submitInfo.pSignalSemaphoreInfos = in_semaphoresToSignal;
 
-    return vkQueueSubmit2( m_handler->queues, 1, &submitInfo, ( m_handler->fences != nullptr ) ? m_handler->fences[index] : nullptr );
+    return m_handler->queue->Submit( &submitInfo, 1, ( m_handler->fences != nullptr ) ? m_handler->fences[index] : nullptr );
 }
 
 /*
@@ -265,6 +346,7 @@ crvkCommandBuffer::Execute
 */
 void crvkCommandBuffer::Execute( const uint32_t in_commandBufferCount, const VkCommandBuffer* in_commandBuffers ) const
 {
+    FlushBarriers( m_handler );
     vkCmdExecuteCommands( m_handler->commandBuffers[m_handler->current], in_commandBufferCount, in_commandBuffers );
 }
 
@@ -417,6 +499,7 @@ void crvkCommandBuffer::Draw(   const uint32_t in_vertexCount,
                                 const uint32_t in_firstVertex, 
                                 const uint32_t in_firstInstance ) const
 {
+    FlushBarriers( m_handler );
     vkCmdDraw( m_handler->commandBuffers[m_handler->current], in_vertexCount, in_instanceCount, in_firstVertex, in_firstInstance );
 }
 
@@ -431,6 +514,7 @@ void crvkCommandBuffer::DrawIndexed( const uint32_t in_indexCount,
                                      const int32_t in_vertexOffset, 
                                      const uint32_t in_firstInstance ) const
 {
+    FlushBarriers( m_handler );
     vkCmdDrawIndexed( m_handler->commandBuffers[m_handler->current], in_indexCount, in_instanceCount, in_firstIndex, in_vertexOffset, in_firstInstance );
 }
 
@@ -444,6 +528,7 @@ void crvkCommandBuffer::DrawIndirect(   const VkBuffer in_buffer,
                                         const uint32_t in_drawCount, 
                                         const uint32_t in_stride )  const
 {
+    FlushBarriers( m_handler );
     vkCmdDrawIndirect( m_handler->commandBuffers[m_handler->current], in_buffer , in_offset, in_drawCount, in_stride );
 }
 
@@ -457,6 +542,7 @@ void crvkCommandBuffer::DrawIndexedIndirect(    const VkBuffer in_buffer,
                                                 const uint32_t in_drawCount, 
                                                 const uint32_t in_stride ) const
 {
+    FlushBarriers( m_handler );
     vkCmdDrawIndexedIndirect( m_handler->commandBuffers[m_handler->current], in_buffer, in_offset, in_drawCount, in_stride );
 }
 
@@ -469,6 +555,7 @@ void crvkCommandBuffer::Dispatch(   const uint32_t in_groupCountX,
                                     const uint32_t in_groupCountY, 
                                     const uint32_t in_groupCountZ ) const
 {
+    FlushBarriers( m_handler );
     vkCmdDispatch( m_handler->commandBuffers[m_handler->current], in_groupCountX, in_groupCountY, in_groupCountZ );
 }
 
@@ -480,6 +567,7 @@ crvkCommandBuffer::DispatchIndirect
 void crvkCommandBuffer::DispatchIndirect(   const VkBuffer in_buffer, 
                                             const VkDeviceSize in_offset )  const
 {
+    FlushBarriers( m_handler );
     vkCmdDispatchIndirect( m_handler->commandBuffers[m_handler->current], in_buffer, in_offset );
 }
 
@@ -494,6 +582,7 @@ void crvkCommandBuffer::CopyBuffer( const VkBuffer in_srcBuffer,
                                     const VkBufferCopy2 *in_regions, 
                                     const void* in_next ) const
 {
+    FlushBarriers( m_handler );
     VkCopyBufferInfo2   copyBufferInfo{};
     copyBufferInfo.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2;
     copyBufferInfo.srcBuffer = in_srcBuffer;
@@ -517,6 +606,7 @@ void crvkCommandBuffer::CopyImage(  const VkImage in_srcImage,
                                     const VkImageCopy2 *in_regions,
                                     const void* in_next ) const
 {
+    FlushBarriers( m_handler );
     VkCopyImageInfo2    copyImageInfo{};
     copyImageInfo.sType = VK_STRUCTURE_TYPE_COPY_IMAGE_INFO_2;
     copyImageInfo.srcImage = in_srcImage;
@@ -543,6 +633,7 @@ void crvkCommandBuffer::BlitImage(  const VkImage in_srcImage,
                                     const VkFilter in_filter, 
                                     const void* in_next ) const
 {
+    FlushBarriers( m_handler );
     VkBlitImageInfo2    blitImageInfo{};
     blitImageInfo.sType = VK_STRUCTURE_TYPE_BLIT_IMAGE_INFO_2;
     blitImageInfo.srcImage = in_srcImage;
@@ -568,6 +659,7 @@ void crvkCommandBuffer::CopyBufferToImage(  const VkBuffer in_srcBuffer,
                                             const VkBufferImageCopy2 *in_regions,
                                             const void* in_next ) const
 {
+    FlushBarriers( m_handler );
     VkCopyBufferToImageInfo2 copyBufferToImageInfo{};
     copyBufferToImageInfo.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2;
     copyBufferToImageInfo.srcBuffer = in_srcBuffer;
@@ -591,6 +683,7 @@ void crvkCommandBuffer::CopyImageToBuffer(  const VkImage in_srcImage,
                                             const VkBufferImageCopy2 *in_regions,
                                             const void* in_next ) const
 {
+    FlushBarriers( m_handler );
     VkCopyImageToBufferInfo2 copyImageToBufferInfo{};
     copyImageToBufferInfo.sType = VK_STRUCTURE_TYPE_COPY_IMAGE_TO_BUFFER_INFO_2;
     copyImageToBufferInfo.srcImage = in_srcImage;
@@ -612,6 +705,7 @@ void crvkCommandBuffer::UpdateBuffer(   const VkBuffer in_dstBuffer,
                                         const VkDeviceSize in_dataSize, 
                                         const void *in_data ) const
 {
+    FlushBarriers( m_handler );
     vkCmdUpdateBuffer( m_handler->commandBuffers[m_handler->current], in_dstBuffer, in_dstOffset, in_dataSize, in_data );
 }
 
@@ -625,6 +719,7 @@ void crvkCommandBuffer::FillBuffer( const VkBuffer in_dstBuffer,
                                     const VkDeviceSize in_size, 
                                     const uint32_t in_data ) const
 {
+    FlushBarriers( m_handler );
     vkCmdFillBuffer( m_handler->commandBuffers[m_handler->current], in_dstBuffer, in_dstOffset, in_size, in_data );
 }
 
@@ -639,6 +734,7 @@ void crvkCommandBuffer::ClearColorImage( const VkImage in_image,
                                          const uint32_t in_rangeCount, 
                                          const VkImageSubresourceRange *in_ranges ) const
 {
+    FlushBarriers( m_handler );
     vkCmdClearColorImage( m_handler->commandBuffers[m_handler->current], in_image, in_imageLayout, in_color, in_rangeCount, in_ranges );
 }
 
@@ -653,6 +749,7 @@ void crvkCommandBuffer::ClearDepthStencilImage( const VkImage in_image,
                                                 const uint32_t in_rangeCount, 
                                                 const VkImageSubresourceRange *in_ranges ) const
 {
+    FlushBarriers( m_handler );
     vkCmdClearDepthStencilImage( m_handler->commandBuffers[m_handler->current], in_image, in_imageLayout, in_depthStencil, in_rangeCount, in_ranges );
 }
 
@@ -669,6 +766,7 @@ void crvkCommandBuffer::ResolveImage(   const VkImage in_srcImage,
                                         const VkImageResolve2* in_regions, 
                                         const void* in_next ) const
 {
+    FlushBarriers( m_handler );
     VkResolveImageInfo2 resolveImageInfo{};
     resolveImageInfo.sType = VK_STRUCTURE_TYPE_RESOLVE_IMAGE_INFO_2;
     resolveImageInfo.srcImage = in_srcImage;
@@ -688,6 +786,7 @@ crvkCommandBuffer::ExecuteCommands
 */
 void crvkCommandBuffer::ExecuteCommands( const uint32_t in_commandBufferCount, const VkCommandBuffer *in_commandBuffers) const
 {
+    FlushBarriers( m_handler );
     vkCmdExecuteCommands( m_handler->commandBuffers[m_handler->current], in_commandBufferCount, in_commandBuffers );
 }
 
@@ -711,7 +810,7 @@ crvkCommandBuffer::BeginRenderPass
 */
 void crvkCommandBuffer::BeginRenderPass( const VkRenderPassBeginInfo* in_renderPassBegin, const VkSubpassBeginInfo* in_subpassBeginInfo ) const
 {
-
+    FlushBarriers( m_handler );
     vkCmdBeginRenderPass2( m_handler->commandBuffers[m_handler->current], in_renderPassBegin, in_subpassBeginInfo );
 }
 
@@ -749,6 +848,7 @@ void crvkCommandBuffer::PipelineBarrier(    const VkDependencyFlags in_dependenc
                                             const VkImageMemoryBarrier2 *in_imageMemoryBarriers, 
                                             const void *in_nex ) const
 {
+    FlushBarriers( m_handler );
     VkDependencyInfo dependencyInfo{};
     dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
     dependencyInfo.dependencyFlags = in_dependencyFlags;
@@ -838,6 +938,7 @@ crvkCommandBuffer::CopyQueryPoolResults
 */
 void crvkCommandBuffer::CopyQueryPoolResults( const VkQueryPool in_queryPool, const uint32_t in_firstQuery, const uint32_t in_queryCount, const VkBuffer in_dstBuffer, const VkDeviceSize in_dstOffset, const VkDeviceSize in_stride, const VkQueryResultFlags in_flags ) const
 {
+    FlushBarriers( m_handler );
     vkCmdCopyQueryPoolResults( m_handler->commandBuffers[m_handler->current], in_queryPool, in_firstQuery, in_queryCount, in_dstBuffer, in_dstOffset, in_stride, in_flags );
 }
 
@@ -880,3 +981,228 @@ void crvkCommandBuffer::EndQuery( const VkQueryPool in_queryPool, const uint32_t
 {
     vkCmdEndQuery( m_handler->commandBuffers[m_handler->current], in_queryPool,  in_query );
 }
+
+/*
+==============================================
+crvkCommandBufferRoundRobin::crvkCommandBufferRoundRobin
+==============================================
+*/
+crvkCommandBufferRoundRobin::crvkCommandBufferRoundRobin( void ) : crvkCommandBuffer(),
+    m_numBuffers( 0 ),
+    m_currentBuffer( 0 ),
+    m_timelineValue( 0 ),
+    m_bufferValues( nullptr ),
+    m_doneSemaphore( nullptr ),
+    m_device( nullptr ),
+    m_queue( nullptr )
+{
+}
+
+/*
+==============================================
+crvkCommandBufferRoundRobin::~crvkCommandBufferRoundRobin
+==============================================
+*/
+crvkCommandBufferRoundRobin::~crvkCommandBufferRoundRobin( void )
+{
+    Destroy();
+}
+
+/*
+==============================================
+crvkCommandBufferRoundRobin::Create
+==============================================
+*/
+bool crvkCommandBufferRoundRobin::Create( const crvkDevice* in_device, const crvkDeviceQueue* in_queue, const uint32_t in_count, const VkCommandBufferLevel in_level )
+{
+    VkResult result = VK_SUCCESS;
+
+    // the timeline replace the fences 
+    if ( !crvkCommandBuffer::Create( in_device, in_queue, in_count, in_level, false ) )
+        return false;
+
+    m_device = in_device->Device();
+    m_queue = const_cast<crvkDeviceQueue*>( in_queue );
+    m_numBuffers = in_count;
+    m_currentBuffer = in_count - 1; // the first Begin take the buffer 0 
+    m_timelineValue = 0;
+
+    // no buffer in flight yet 
+    m_bufferValues = static_cast<uint64_t*>( SDL_calloc( in_count, sizeof( uint64_t ) ) );
+
+    VkSemaphoreTypeCreateInfo timelineCreateInfo{};
+    timelineCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    timelineCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    timelineCreateInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo{};
+    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreCreateInfo.pNext = &timelineCreateInfo;
+    result = vkCreateSemaphore( m_device, &semaphoreCreateInfo, k_allocationCallbacks, &m_doneSemaphore );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkCommandBufferRoundRobin::Create::vkCreateSemaphore", result );
+        return false;
+    }
+
+    return true;
+}
+
+/*
+==============================================
+crvkCommandBufferRoundRobin::Destroy
+==============================================
+*/
+void crvkCommandBufferRoundRobin::Destroy( void )
+{
+    // the buffers can't be released while the GPU use them 
+    if ( m_doneSemaphore != nullptr )
+    {
+        WaitIdle();
+        vkDestroySemaphore( m_device, m_doneSemaphore, k_allocationCallbacks );
+        m_doneSemaphore = nullptr;
+    }
+
+    if ( m_bufferValues != nullptr )
+    {
+        SDL_free( m_bufferValues );
+        m_bufferValues = nullptr;
+    }
+
+    crvkCommandBuffer::Destroy();
+
+    m_numBuffers = 0;
+    m_currentBuffer = 0;
+    m_timelineValue = 0;
+    m_queue = nullptr;
+    m_device = nullptr;
+}
+
+/*
+==============================================
+crvkCommandBufferRoundRobin::Begin
+==============================================
+*/
+VkResult crvkCommandBufferRoundRobin::Begin( const VkCommandBufferUsageFlags in_flags )
+{
+    VkResult result = VK_SUCCESS;
+    uint64_t completed = 0;
+
+    m_currentBuffer = ( m_currentBuffer + 1 ) % m_numBuffers;
+    SelectCurrentBuffer( m_currentBuffer );
+
+    /// ==================================================================
+    /// Wait only if the GPU still use the buffer 
+    /// ==================================================================
+    uint64_t value = m_bufferValues[m_currentBuffer];
+    if ( value > 0 )
+    {
+        result = vkGetSemaphoreCounterValue( m_device, m_doneSemaphore, &completed );
+        if ( result != VK_SUCCESS )
+        {
+            crvkAppendError( "crvkCommandBufferRoundRobin::Begin::vkGetSemaphoreCounterValue", result );
+            return result;
+        }
+        
+        if ( completed < value )
+        {
+            // the submit can be still queued in a deferred queue 
+            m_queue->Flush();
+
+            VkSemaphoreWaitInfo waitInfo{};
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &m_doneSemaphore;
+            waitInfo.pValues = &value;
+            result = vkWaitSemaphores( m_device, &waitInfo, UINT64_MAX );
+            if ( result != VK_SUCCESS )
+            {
+                crvkAppendError( "crvkCommandBufferRoundRobin::Begin::vkWaitSemaphores", result );
+                return result;
+            }
+        }
+    }
+
+    result = crvkCommandBuffer::Reset( 0 );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkCommandBufferRoundRobin::Begin::vkResetCommandBuffer", result );
+        return result;
+    }
+
+    return crvkCommandBuffer::Begin( in_flags );
+}
+
+/*
+==============================================
+crvkCommandBufferRoundRobin::Submit
+==============================================
+*/
+VkResult crvkCommandBufferRoundRobin::Submit(   const VkSemaphoreSubmitInfo* in_semaphoresToWait, 
+                                                const uint32_t in_semaphoresToWaitCount, 
+                                                const VkSemaphoreSubmitInfo* in_semaphoresToSignal, 
+                                                const uint32_t in_semaphoresToSingalCount )
+{
+    VkResult result = VK_SUCCESS;
+    crvkDynamicVector<VkSemaphoreSubmitInfo> signals;
+
+    result = crvkCommandBuffer::End();
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkCommandBufferRoundRobin::Submit::vkEndCommandBuffer", result );
+        return result;
+    }
+
+    // the caller signals, and the ring value 
+    signals.Reserve( in_semaphoresToSingalCount + 1 );
+    for ( uint32_t i = 0; i < in_semaphoresToSingalCount; i++ )
+        signals.Append( in_semaphoresToSignal[i] );
+
+    uint64_t value = m_timelineValue + 1;
+    VkSemaphoreSubmitInfo doneSignal{ VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, m_doneSemaphore, value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, 0 };
+    signals.Append( doneSignal );
+
+    VkCommandBufferSubmitInfo commandBufferSI{};
+    commandBufferSI.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    commandBufferSI.commandBuffer = GetCurrentCommandBuffer();
+
+    VkSubmitInfo2 submitInfo{}; 
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+    submitInfo.waitSemaphoreInfoCount = in_semaphoresToWaitCount;
+    submitInfo.pWaitSemaphoreInfos = in_semaphoresToWait;
+    submitInfo.commandBufferInfoCount = 1;
+    submitInfo.pCommandBufferInfos = &commandBufferSI;
+    submitInfo.signalSemaphoreInfoCount = signals.Count();
+    submitInfo.pSignalSemaphoreInfos = &signals;
+    result = m_queue->Submit( &submitInfo, 1 );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkCommandBufferRoundRobin::Submit::vkQueueSubmit2", result );
+        return result;
+    }
+
+    // the buffer is free again when the GPU reach the value 
+    m_timelineValue = value;
+    m_bufferValues[m_currentBuffer] = value;
+    return result;
+}
+
+/*
+==============================================
+crvkCommandBufferRoundRobin::WaitIdle
+==============================================
+*/
+VkResult crvkCommandBufferRoundRobin::WaitIdle( void ) const
+{
+    if ( m_timelineValue == 0 )
+        return VK_SUCCESS;
+
+    m_queue->Flush();
+
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_doneSemaphore;
+    waitInfo.pValues = &m_timelineValue;
+    return vkWaitSemaphores( m_device, &waitInfo, UINT64_MAX );
+}
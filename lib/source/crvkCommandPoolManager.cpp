@@ -0,0 +1,283 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#include "crvkPrecompiled.hpp"
+#include "crvkCommandPoolManager.hpp"
+
+/// @brief a pool of a thread for a frame, and the command buffers allocated from it 
+typedef struct crvkFramePool_t
+{
+    uint32_t                            used[2] = { 0, 0 };     // buffers handed this frame, primary and secondary 
+    VkCommandPool                       pool = nullptr;
+    crvkDynamicVector<VkCommandBuffer>  buffers[2];             // allocated buffers, primary and secondary 
+} crvkFramePool_t;
+
+typedef std::pair<uint32_t, std::thread::id> crvkPoolKey_t;
+
+/// @brief a thread pools already found, so the thread only lock the map on his first use 
+typedef struct crvkPoolCacheEntry_t
+{
+    uint64_t            owner = 0;              // manager id, Destroy change it so the old entries miss 
+    uint32_t            family = UINT32_MAX;
+    crvkFramePool_t*    pools = nullptr;        // frameCount pools 
+} crvkPoolCacheEntry_t;
+
+static const uint32_t                       k_poolCacheSize = 4;   // families and managers used by a thread 
+static std::atomic<uint64_t>                s_managerId( 1 );
+static thread_local crvkPoolCacheEntry_t    t_poolCache[k_poolCacheSize];
+static thread_local uint32_t                t_poolCacheNext = 0;
+
+typedef struct crvkCommandPoolManagerHandle_t
+{
+    uint64_t                                    id = 0;     // unique between the managers, to key the thread caches 
+    std::atomic<uint32_t>                       frame{ 0 };
+    uint32_t                                    frameCount = 0;
+    VkDevice                                    device = nullptr;
+    std::mutex                                  lock;   // guard the pool map, the pools are only used by his thread 
+    std::map<crvkPoolKey_t, crvkFramePool_t*>   pools;  // a array of frameCount pools for each family and thread 
+} crvkCommandPoolManagerHandle_t;
+
+/*
+==============================================
+GetFramePool
+==============================================
+*/
+static crvkFramePool_t* GetFramePool( crvkCommandPoolManagerHandle_t* in_handle, const uint32_t in_family )
+{
+    VkResult result = VK_SUCCESS;
+    crvkFramePool_t* framePools = nullptr;
+    crvkPoolKey_t key( in_family, std::this_thread::get_id() );
+
+    // the pools of this thread never move until Destroy, so the cached ones don't need the lock 
+    for ( uint32_t i = 0; i < k_poolCacheSize; i++ )
+    {
+        const crvkPoolCacheEntry_t& cached = t_poolCache[i];
+        if ( cached.owner == in_handle->id && cached.family == in_family )
+            return &cached.pools[in_handle->frame];
+    }
+
+    std::lock_guard<std::mutex> lock( in_handle->lock );
+    
+    auto entry = in_handle->pools.find( key );
+    if ( entry != in_handle->pools.end() )
+    {
+        t_poolCache[t_poolCacheNext++ % k_poolCacheSize] = crvkPoolCacheEntry_t{ in_handle->id, in_family, entry->second };
+        return &entry->second[in_handle->frame];
+    }
+
+    // first use of this thread, create his pools
+    // the pools are reset as a whole, so we don't need the individual command buffer reset 
+    VkCommandPoolCreateInfo poolCI{};
+    poolCI.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolCI.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolCI.queueFamilyIndex = in_family;
+
+    framePools = new crvkFramePool_t[in_handle->frameCount];
+    for ( uint32_t i = 0; i < in_handle->frameCount; i++ )
+    {
+        result = vkCreateCommandPool( in_handle->device, &poolCI, k_allocationCallbacks, &framePools[i].pool );
+        if ( result != VK_SUCCESS )
+        {
+            for ( uint32_t j = 0; j < i; j++ )
+                vkDestroyCommandPool( in_handle->device, framePools[j].pool, k_allocationCallbacks );
+            
+            delete[] framePools;
+            crvkAppendError( "crvkCommandPoolManager::GetFramePool::vkCreateCommandPool", result );
+            return nullptr;
+        }
+    }
+
+    in_handle->pools[key] = framePools;
+    t_poolCache[t_poolCacheNext++ % k_poolCacheSize] = crvkPoolCacheEntry_t{ in_handle->id, in_family, framePools };
+    return &framePools[in_handle->frame];
+}
+
+/*
+==============================================
+crvkCommandPoolManager::crvkCommandPoolManager
+==============================================
+*/
+crvkCommandPoolManager::crvkCommandPoolManager( void ) : m_handle( nullptr )
+{
+    m_handle = new crvkCommandPoolManagerHandle_t();
+}
+
+/*
+==============================================
+crvkCommandPoolManager::~crvkCommandPoolManager
+==============================================
+*/
+crvkCommandPoolManager::~crvkCommandPoolManager( void )
+{
+    Destroy();
+
+    if ( m_handle != nullptr )
+    {
+        delete m_handle;
+        m_handle = nullptr;
+    }
+}
+
+/*
+==============================================
+crvkCommandPoolManager::Create
+==============================================
+*/
+bool crvkCommandPoolManager::Create( const crvkDevice* in_device, const uint32_t in_frames )
+{
+    m_handle->id = s_managerId++;
+    m_handle->device = in_device->Device();
+    m_handle->frameCount = std::max( in_frames, 1u );
+    m_handle->frame = 0;
+    return true;
+}
+
+/*
+==============================================
+crvkCommandPoolManager::Destroy
+==============================================
+*/
+void crvkCommandPoolManager::Destroy( void )
+{
+    if ( m_handle == nullptr )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+
+    // destroying the pool release his command buffers 
+    for ( auto & entry : m_handle->pools )
+    {
+        for ( uint32_t i = 0; i < m_handle->frameCount; i++ )
+            vkDestroyCommandPool( m_handle->device, entry.second[i].pool, k_allocationCallbacks );
+
+        delete[] entry.second;
+    }
+
+    // the threads cached pools are gone 
+    m_handle->pools.clear();
+    m_handle->id = s_managerId++;
+    m_handle->frame = 0;
+}
+
+/*
+==============================================
+crvkCommandPoolManager::Pool
+==============================================
+*/
+VkCommandPool crvkCommandPoolManager::Pool( const uint32_t in_family )
+{
+    crvkFramePool_t* framePool = GetFramePool( m_handle, in_family );
+    if ( framePool == nullptr )
+        return nullptr;
+
+    return framePool->pool;
+}
+
+/*
+==============================================
+crvkCommandPoolManager::Allocate
+==============================================
+*/
+VkCommandBuffer crvkCommandPoolManager::Allocate( const uint32_t in_family, const VkCommandBufferLevel in_level )
+{
+    VkResult result = VK_SUCCESS;
+    VkCommandBuffer commandBuffer = nullptr;
+    uint32_t level = in_level == VK_COMMAND_BUFFER_LEVEL_PRIMARY ? 0 : 1;
+    
+    crvkFramePool_t* framePool = GetFramePool( m_handle, in_family );
+    if ( framePool == nullptr )
+        return nullptr;
+
+    // recycle a buffer allocated in a previous use of this frame 
+    if ( framePool->used[level] < framePool->buffers[level].Count() )
+        return framePool->buffers[level][framePool->used[level]++];
+
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = framePool->pool;
+    allocInfo.level = in_level;
+    allocInfo.commandBufferCount = 1;
+
+    result = vkAllocateCommandBuffers( m_handle->device, &allocInfo, &commandBuffer );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkCommandPoolManager::Allocate::vkAllocateCommandBuffers", result );
+        return nullptr;
+    }
+
+    framePool->buffers[level].Append( commandBuffer );
+    framePool->used[level]++;
+    return commandBuffer;
+}
+
+/*
+==============================================
+crvkCommandPoolManager::NextFrame
+==============================================
+*/
+VkResult crvkCommandPoolManager::NextFrame( void )
+{
+    VkResult result = VK_SUCCESS;
+    VkResult resetResult = VK_SUCCESS;
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    
+    m_handle->frame = ( m_handle->frame.load() + 1 ) % m_handle->frameCount;
+
+    // one reset per pool, instead of a reset per command buffer 
+    for ( auto & entry : m_handle->pools )
+    {
+        crvkFramePool_t & framePool = entry.second[m_handle->frame];
+        
+        resetResult = vkResetCommandPool( m_handle->device, framePool.pool, 0 );
+        if ( resetResult != VK_SUCCESS && result == VK_SUCCESS )
+        {
+            crvkAppendError( "crvkCommandPoolManager::NextFrame::vkResetCommandPool", resetResult );
+            result = resetResult;
+        }
+
+        framePool.used[0] = 0;
+        framePool.used[1] = 0;
+    }
+
+    return result;
+}
+
+/*
+==============================================
+crvkCommandPoolManager::Frame
+==============================================
+*/
+uint32_t crvkCommandPoolManager::Frame( void ) const
+{
+    return m_handle->frame;
+}
+
+/*
+==============================================
+crvkCommandPoolManager::FrameCount
+==============================================
+*/
+uint32_t crvkCommandPoolManager::FrameCount( void ) const
+{
+    return m_handle->frameCount;
+}
@@ -34,6 +34,7 @@ crvkContext::crvkContext
 */
 crvkContext::crvkContext( void ) :
     m_enableValidationLayers( false ),
+    m_headless( false ),
     m_instance( nullptr ),
     m_debugMessenger( nullptr ),
     m_surface( nullptr )
@@ -93,14 +94,20 @@ bool crvkContext::Create(
     instanceCI.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
     instanceCI.pApplicationInfo = &appInfo;
     
-    // copy and enable system extensios
-    SDL3Extensions = SDL_Vulkan_GetInstanceExtensions( &SDL3ExtensionCount );
-    enabledExtensions.Resize( SDL3ExtensionCount );
-    enabledExtensions.Memcpy( const_cast<const char**>( SDL3Extensions ), 0, SDL3ExtensionCount );
+    // without a window we don't need any surface extension 
+    m_headless = in_whdn == nullptr;
+
+    if ( !m_headless )
+    {
+        // copy and enable system extensios
+        SDL3Extensions = SDL_Vulkan_GetInstanceExtensions( &SDL3ExtensionCount );
+        enabledExtensions.Resize( SDL3ExtensionCount );
+        enabledExtensions.Memcpy( const_cast<const char**>( SDL3Extensions ), 0, SDL3ExtensionCount );
 
 #if VK_VERSION_1_2
-    enabledExtensions.Append( VK_KHR_GET_SURFACE_CAPABILITIES_2_EXTENSION_NAME ); //
+        enabledExtensions.Append( VK_KHR_GET_SURFACE_CAPABILITIES_2_EXTENSION_NAME ); //
 #endif 
+    }
 
     if ( m_enableValidationLayers ) // enable debug utils extension 
         enabledExtensions.Append( VK_EXT_DEBUG_UTILS_EXTENSION_NAME );
@@ -153,7 +160,8 @@ bool crvkContext::Create(
  
     }
     
-    if ( !SDL_Vulkan_CreateSurface( const_cast<SDL_Window*>( in_whdn ), m_instance, k_allocationCallbacks, &m_surface ) )
+    // headless context, render to offscreen images only 
+    if ( !m_headless && !SDL_Vulkan_CreateSurface( const_cast<SDL_Window*>( in_whdn ), m_instance, k_allocationCallbacks, &m_surface ) )
     {            
         crvkAppendError( SDL_GetError(), VK_INCOMPLETE );
         return false;
@@ -0,0 +1,331 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+#include "crvkPrecompiled.hpp"
+#include "crvkDeletionQueue.hpp"
+
+typedef struct crvkDeletionEntry_t
+{
+    VkObjectType            type;       // VK_OBJECT_TYPE_UNKNOWN for a allocator range 
+    uint64_t                handle;
+    uint64_t                parent;     // command pool of a command buffer 
+    uint32_t                count;      // timeline values 
+    crvkTimelinePoint_t     lastUse[crvkDeletionQueue::k_maxPoints];
+    crvkMemoryAllocation_t  allocation;
+} crvkDeletionEntry_t;
+
+typedef struct crvkDeletionQueueHandle_t
+{
+    crvkDynamicVector<crvkDeletionEntry_t>  entries;
+    crvkDynamicVector<crvkTimelinePoint_t>  counters;   // semaphore values read by Collect 
+    crvkMemoryAllocator*                    allocator = nullptr;
+    VkDevice                                device = nullptr;
+    std::mutex                              lock;
+} crvkDeletionQueueHandle_t;
+
+/*
+==============================================
+DestroyEntry
+==============================================
+*/
+static void DestroyEntry( const VkDevice in_device, crvkMemoryAllocator* in_allocator, crvkDeletionEntry_t* in_entry )
+{
+    switch ( in_entry->type )
+    {
+    case VK_OBJECT_TYPE_UNKNOWN:
+        in_allocator->Free( &in_entry->allocation );
+        break;
+    case VK_OBJECT_TYPE_BUFFER:
+        vkDestroyBuffer( in_device, reinterpret_cast<VkBuffer>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_BUFFER_VIEW:
+        vkDestroyBufferView( in_device, reinterpret_cast<VkBufferView>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_IMAGE:
+        vkDestroyImage( in_device, reinterpret_cast<VkImage>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_IMAGE_VIEW:
+        vkDestroyImageView( in_device, reinterpret_cast<VkImageView>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_SEMAPHORE:
+        vkDestroySemaphore( in_device, reinterpret_cast<VkSemaphore>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_FENCE:
+        vkDestroyFence( in_device, reinterpret_cast<VkFence>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_SAMPLER:
+        vkDestroySampler( in_device, reinterpret_cast<VkSampler>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_DEVICE_MEMORY:
+        vkFreeMemory( in_device, reinterpret_cast<VkDeviceMemory>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_COMMAND_BUFFER:
+    {
+        VkCommandBuffer commandBuffer = reinterpret_cast<VkCommandBuffer>( in_entry->handle );
+        vkFreeCommandBuffers( in_device, reinterpret_cast<VkCommandPool>( in_entry->parent ), 1, &commandBuffer );
+    } break;
+    case VK_OBJECT_TYPE_COMMAND_POOL:
+        vkDestroyCommandPool( in_device, reinterpret_cast<VkCommandPool>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_PIPELINE:
+        vkDestroyPipeline( in_device, reinterpret_cast<VkPipeline>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_DESCRIPTOR_POOL:
+        vkDestroyDescriptorPool( in_device, reinterpret_cast<VkDescriptorPool>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_QUERY_POOL:
+        vkDestroyQueryPool( in_device, reinterpret_cast<VkQueryPool>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_FRAMEBUFFER:
+        vkDestroyFramebuffer( in_device, reinterpret_cast<VkFramebuffer>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_RENDER_PASS:
+        vkDestroyRenderPass( in_device, reinterpret_cast<VkRenderPass>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    case VK_OBJECT_TYPE_SWAPCHAIN_KHR:
+        vkDestroySwapchainKHR( in_device, reinterpret_cast<VkSwapchainKHR>( in_entry->handle ), k_allocationCallbacks );
+        break;
+    default:
+        SDL_assert( false && "crvkDeletionQueue: unsupported object type" );
+        break;
+    }
+}
+
+/*
+==============================================
+CopyPoints
+==============================================
+*/
+static bool CopyPoints( crvkDeletionEntry_t* in_entry, const crvkTimelinePoint_t* in_lastUse, const uint32_t in_count )
+{
+    // points without semaphore don't wait anything, the others are never dropped 
+    for ( uint32_t i = 0; i < in_count; i++ )
+    {
+        if ( in_lastUse[i].semaphore == nullptr )
+            continue;
+
+        SDL_assert( in_entry->count < crvkDeletionQueue::k_maxPoints );
+        if ( in_entry->count >= crvkDeletionQueue::k_maxPoints )
+            return false;
+
+        in_entry->lastUse[in_entry->count++] = in_lastUse[i];
+    }
+
+    return true;
+}
+
+/*
+==============================================
+crvkDeletionQueue::crvkDeletionQueue
+==============================================
+*/
+crvkDeletionQueue::crvkDeletionQueue( void ) : m_handle( nullptr )
+{
+}
+
+/*
+==============================================
+crvkDeletionQueue::~crvkDeletionQueue
+==============================================
+*/
+crvkDeletionQueue::~crvkDeletionQueue( void )
+{
+    Destroy();
+
+    if ( m_handle != nullptr )
+    {
+        delete m_handle;
+        m_handle = nullptr;
+    }
+}
+
+/*
+==============================================
+crvkDeletionQueue::Create
+==============================================
+*/
+bool crvkDeletionQueue::Create( const crvkDevice* in_device )
+{
+    if ( m_handle == nullptr )
+        m_handle = new crvkDeletionQueueHandle_t();
+
+    m_handle->device = in_device->Device();
+    m_handle->allocator = in_device->MemoryAllocator();
+    return true;
+}
+
+/*
+==============================================
+crvkDeletionQueue::Destroy
+==============================================
+*/
+void crvkDeletionQueue::Destroy( void )
+{
+    if ( m_handle == nullptr )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    for ( uint32_t i = 0; i < m_handle->entries.Count(); i++ )
+        DestroyEntry( m_handle->device, m_handle->allocator, &m_handle->entries[i] );
+
+    m_handle->entries.Clear();
+    m_handle->counters.Clear();
+}
+
+/*
+==============================================
+crvkDeletionQueue::Enqueue
+==============================================
+*/
+bool crvkDeletionQueue::Enqueue( const VkObjectType in_type, const uint64_t in_handle, const crvkTimelinePoint_t* in_lastUse, const uint32_t in_count, const uint64_t in_parent )
+{
+    crvkDeletionEntry_t entry{};
+    entry.type = in_type;
+    entry.handle = in_handle;
+    entry.parent = in_parent;
+    
+    if ( !CopyPoints( &entry, in_lastUse, in_count ) )
+    {
+        crvkAppendError( "crvkDeletionQueue::Enqueue::too many timeline points", VK_ERROR_TOO_MANY_OBJECTS );
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    m_handle->entries.Append( entry );
+    return true;
+}
+
+/*
+==============================================
+crvkDeletionQueue::EnqueueFree
+==============================================
+*/
+bool crvkDeletionQueue::EnqueueFree( const crvkMemoryAllocation_t* in_allocation, const crvkTimelinePoint_t* in_lastUse, const uint32_t in_count )
+{
+    crvkDeletionEntry_t entry{};
+    entry.type = VK_OBJECT_TYPE_UNKNOWN;
+    entry.allocation = *in_allocation;
+    
+    if ( !CopyPoints( &entry, in_lastUse, in_count ) )
+    {
+        crvkAppendError( "crvkDeletionQueue::EnqueueFree::too many timeline points", VK_ERROR_TOO_MANY_OBJECTS );
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    m_handle->entries.Append( entry );
+    return true;
+}
+
+/*
+==============================================
+crvkDeletionQueue::Collect
+==============================================
+*/
+uint32_t crvkDeletionQueue::Collect( void )
+{
+    uint32_t destroyed = 0;
+    
+    if ( m_handle == nullptr )
+        return 0;
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    crvkDynamicVector<crvkDeletionEntry_t>& entries = m_handle->entries;
+    crvkDynamicVector<crvkTimelinePoint_t>& counters = m_handle->counters;
+    
+    ///
+    /// Read each semaphore once, before any destruction, so a queued semaphore can 
+    /// be destroyed together with the objects that wait it
+    /// ==========================================================================
+    counters.Reset();
+    for ( uint32_t i = 0; i < entries.Count(); i++ )
+    {
+        for ( uint32_t j = 0; j < entries[i].count; j++ )
+        {
+            VkSemaphore semaphore = entries[i].lastUse[j].semaphore;
+            bool found = false;
+            for ( uint32_t k = 0; k < counters.Count() && !found; k++ )
+                found = ( counters[k].semaphore == semaphore );
+
+            if ( found )
+                continue;
+
+            crvkTimelinePoint_t counter{ semaphore, 0 };
+            VkResult result = vkGetSemaphoreCounterValue( m_handle->device, semaphore, &counter.value );
+            if ( result != VK_SUCCESS )
+                crvkAppendError( "crvkDeletionQueue::Collect::vkGetSemaphoreCounterValue", result );
+
+            counters.Append( counter );
+        }
+    }
+
+    ///
+    /// Destroy the finished objects and keep the others in order 
+    /// ==========================================================================
+    uint32_t kept = 0;
+    for ( uint32_t i = 0; i < entries.Count(); i++ )
+    {
+        bool done = true;
+        for ( uint32_t j = 0; j < entries[i].count && done; j++ )
+        {
+            const crvkTimelinePoint_t& point = entries[i].lastUse[j];
+            for ( uint32_t k = 0; k < counters.Count(); k++ )
+            {
+                if ( counters[k].semaphore == point.semaphore )
+                {
+                    done = ( counters[k].value >= point.value );
+                    break;
+                }
+            }
+        }
+
+        if ( done )
+        {
+            DestroyEntry( m_handle->device, m_handle->allocator, &entries[i] );
+            destroyed++;
+            continue;
+        }
+
+        if ( kept != i )
+            entries[kept] = entries[i];
+        
+        kept++;
+    }
+
+    // drop the destroyed entries, keep the memory 
+    entries.Reset();
+    entries.Resize( kept );
+    return destroyed;
+}
+
+/*
+==============================================
+crvkDeletionQueue::Pending
+==============================================
+*/
+uint32_t crvkDeletionQueue::Pending( void ) const
+{
+    if ( m_handle == nullptr )
+        return 0;
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    return m_handle->entries.Count();
+}
@@ -24,6 +24,9 @@
 #include "crvkPrecompiled.hpp"
 #include "crvkDevice.hpp"
 
+static const VkDeviceSize k_directWriteLimit = 256ull * 1024ull;   // default direct write limit, when the CPU see only a window of the device memory 
+static const VkDeviceSize k_readbackRingSize = 16ull * 1024ull * 1024ull;  // 16MB read back ring 
+
 typedef struct crvkDeviceHandle_t
 {
     VkPhysicalDeviceProperties2                     propertiesv10;
@@ -44,10 +47,54 @@ typedef struct crvkDeviceHandle_t
     crvkDynamicVector<VkQueueFamilyProperties2>     queueFamilies;
     crvkDynamicVector<crvkQueueInfo_t>              queuesList;
     glslang_resource_t*                             shaderBuiltInResources = nullptr;
+    crvkMemoryAllocator*                            memoryAllocator = nullptr;
+    crvkUploadManager*                              uploadManager = nullptr;
+    crvkUploadManager*                              readbackManager = nullptr;
+    crvkReadbackQueue*                              readbackQueue = nullptr;
+    crvkDeletionQueue*                              deletionQueue = nullptr;
+    crvkPipelineCache*                              pipelineCache = nullptr;
+    crvkShaderCache*                                shaderCache = nullptr;
+    VkDeviceSize                                    directWriteLimit = 0;       // biggest staging buffer placed in device local host visible memory 
+    bool                                            directWriteMemory = false;  // the device have device local host visible memory 
     VkPhysicalDevice                                physicalDevice = nullptr;
     VkDevice                                        logicalDevice = nullptr;
 } crvkDeviceHandle_t;
 
+/*
+==============================================
+FindDirectWriteLimit
+==============================================
+*/
+static VkDeviceSize FindDirectWriteLimit( const VkPhysicalDeviceMemoryProperties* in_memoryProperties )
+{
+    const VkMemoryPropertyFlags directFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    VkDeviceSize directHeap = 0;
+    VkDeviceSize deviceHeap = 0;
+
+    for ( uint32_t i = 0; i < in_memoryProperties->memoryTypeCount; i++ )
+    {
+        const VkMemoryType& type = in_memoryProperties->memoryTypes[i];
+        VkDeviceSize heapSize = in_memoryProperties->memoryHeaps[type.heapIndex].size;
+        
+        if ( type.propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT )
+            deviceHeap = std::max( deviceHeap, heapSize );
+
+        if ( ( type.propertyFlags & directFlags ) == directFlags )
+            directHeap = std::max( directHeap, heapSize );
+    }
+
+    // no device local memory the CPU can write 
+    if ( directHeap == 0 )
+        return 0;
+
+    // integrated, software and resizable BAR devices see the whole device memory, 
+    // a small BAR window is kept for the small buffers 
+    if ( directHeap >= deviceHeap )
+        return VK_WHOLE_SIZE;
+
+    return k_directWriteLimit;
+}
+
 
 /*
 ==============================================
@@ -73,7 +120,7 @@ crvkDevice::~crvkDevice( void )
 crvkDevice::Create
 ==============================================
 */
-bool crvkDevice::Create(const char **in_layers, const uint32_t in_layersCount, const char **in_deviceExtensions, const uint32_t in_deviceExtensionsCount)
+bool crvkDevice::Create(const char **in_layers, const uint32_t in_layersCount, const char **in_deviceExtensions, const uint32_t in_deviceExtensionsCount, const char* in_pipelineCachePath, const char* in_shaderCachePath )
 {
     VkResult result = VK_SUCCESS;
     crvkDynamicVector<VkDeviceQueueCreateInfo> queueCreateInfos;
@@ -120,6 +167,45 @@ bool crvkDevice::Create(const char **in_layers, const uint32_t in_layersCount, c
         return false;
     }
 
+    // create the device memory allocator
+    m_handle->memoryAllocator = new crvkMemoryAllocator();
+    if ( !m_handle->memoryAllocator->Create( m_handle->logicalDevice, &m_handle->memoryProperties.memoryProperties, m_handle->propertiesv10.properties.limits.nonCoherentAtomSize ) )
+        return false;
+
+    // staging buffers can skip the staging copy on device local host visible memory 
+    m_handle->directWriteLimit = FindDirectWriteLimit( &m_handle->memoryProperties.memoryProperties );
+    m_handle->directWriteMemory = m_handle->directWriteLimit != 0;
+
+    // create the deferred deletion queue 
+    m_handle->deletionQueue = new crvkDeletionQueue();
+    if ( !m_handle->deletionQueue->Create( this ) )
+        return false;
+
+    // create the shared staging ring 
+    m_handle->uploadManager = new crvkUploadManager();
+    if ( !m_handle->uploadManager->Create( this ) )
+        return false;
+
+    // create the read back ring, in CPU cached memory when the device have it 
+    m_handle->readbackManager = new crvkUploadManager();
+    if ( !m_handle->readbackManager->Create( this, k_readbackRingSize, true ) )
+        return false;
+
+    // create the asynchronous read back queue, hold ranges of the read back ring 
+    m_handle->readbackQueue = new crvkReadbackQueue();
+    if ( !m_handle->readbackQueue->Create( this ) )
+        return false;
+
+    // create the pipeline cache, warm from disk if we have a valid file 
+    m_handle->pipelineCache = new crvkPipelineCache();
+    if ( !m_handle->pipelineCache->Create( m_handle->logicalDevice, &m_handle->propertiesv10.properties, in_pipelineCachePath ) )
+        return false;
+
+    // create the SPIR-V cache 
+    m_handle->shaderCache = new crvkShaderCache();
+    if ( !m_handle->shaderCache->Create( in_shaderCachePath ) )
+        return false;
+
     return true;
 }
 
@@ -132,7 +218,59 @@ void crvkDevice::Destroy(void)
 {
     if ( m_handle == nullptr )
         return;    
+
+    // the in flight copies can still use the staging rings and the queued objects, 
+    // nothing is released before the GPU stop 
+    if ( m_handle->logicalDevice != nullptr )
+        vkDeviceWaitIdle( m_handle->logicalDevice );
     
+    if ( m_handle->shaderCache != nullptr )
+    {
+        delete m_handle->shaderCache;
+        m_handle->shaderCache = nullptr;
+    }
+
+    // write back the pipeline cache before we lose the device 
+    if ( m_handle->pipelineCache != nullptr )
+    {
+        delete m_handle->pipelineCache;
+        m_handle->pipelineCache = nullptr;
+    }
+
+    // the pending read backs hold ranges of the read back ring 
+    if ( m_handle->readbackQueue != nullptr )
+    {
+        delete m_handle->readbackQueue;
+        m_handle->readbackQueue = nullptr;
+    }
+
+    // the staging rings hold a allocator block 
+    if ( m_handle->uploadManager != nullptr )
+    {
+        delete m_handle->uploadManager;
+        m_handle->uploadManager = nullptr;
+    }
+
+    if ( m_handle->readbackManager != nullptr )
+    {
+        delete m_handle->readbackManager;
+        m_handle->readbackManager = nullptr;
+    }
+
+    // the allocator ranges of the queued objects must return before the blocks 
+    if ( m_handle->deletionQueue != nullptr )
+    {
+        delete m_handle->deletionQueue;
+        m_handle->deletionQueue = nullptr;
+    }
+
+    // release the memory blocks before the device 
+    if ( m_handle->memoryAllocator != nullptr )
+    {
+        delete m_handle->memoryAllocator;
+        m_handle->memoryAllocator = nullptr;
+    }
+
     if ( m_handle->logicalDevice != nullptr )
     {
         vkDestroyDevice( m_handle->logicalDevice, k_allocationCallbacks );
@@ -336,6 +474,137 @@ const glslang_resource_t* crvkDevice::BuiltInShaderResource( void ) const
     return m_handle->shaderBuiltInResources;
 }
 
+/*
+==============================================
+crvkDevice::MemoryAllocator
+==============================================
+*/
+crvkMemoryAllocator* crvkDevice::MemoryAllocator( void ) const
+{
+    if ( m_handle == nullptr )
+        return nullptr;
+
+    return m_handle->memoryAllocator;
+}
+
+/*
+==============================================
+crvkDevice::UploadManager
+==============================================
+*/
+crvkUploadManager* crvkDevice::UploadManager( void ) const
+{
+    if ( m_handle == nullptr )
+        return nullptr;
+
+    return m_handle->uploadManager;
+}
+
+/*
+==============================================
+crvkDevice::ReadbackManager
+==============================================
+*/
+crvkUploadManager* crvkDevice::ReadbackManager( void ) const
+{
+    if ( m_handle == nullptr )
+        return nullptr;
+
+    return m_handle->readbackManager;
+}
+
+/*
+==============================================
+crvkDevice::Limits
+==============================================
+*/
+const VkPhysicalDeviceLimits* crvkDevice::Limits( void ) const
+{
+    if ( m_handle == nullptr )
+        return nullptr;
+
+    return &m_handle->propertiesv10.properties.limits;
+}
+
+/*
+==============================================
+crvkDevice::DirectWriteLimit
+==============================================
+*/
+VkDeviceSize crvkDevice::DirectWriteLimit( void ) const
+{
+    if ( m_handle == nullptr )
+        return 0;
+
+    return m_handle->directWriteLimit;
+}
+
+/*
+==============================================
+crvkDevice::SetDirectWriteLimit
+==============================================
+*/
+void crvkDevice::SetDirectWriteLimit( const VkDeviceSize in_size )
+{
+    // without the memory type the staging copy is the only path 
+    if ( m_handle == nullptr || !m_handle->directWriteMemory )
+        return;
+
+    m_handle->directWriteLimit = in_size;
+}
+
+/*
+==============================================
+crvkDevice::ReadbackQueue
+==============================================
+*/
+crvkReadbackQueue* crvkDevice::ReadbackQueue( void ) const
+{
+    if ( m_handle == nullptr )
+        return nullptr;
+
+    return m_handle->readbackQueue;
+}
+
+/*
+==============================================
+crvkDevice::DeletionQueue
+==============================================
+*/
+crvkDeletionQueue* crvkDevice::DeletionQueue( void ) const
+{
+    if ( m_handle == nullptr )
+        return nullptr;
+
+    return m_handle->deletionQueue;
+}
+
+/*
+==============================================
+crvkDevice::PipelineCache
+==============================================
+*/
+crvkPipelineCache* crvkDevice::PipelineCache( void ) const
+{
+    if ( m_handle == nullptr )
+        return nullptr;
+
+    return m_handle->pipelineCache;
+}
+
+/*
+==============================================
+crvkDevice::ShaderCache
+==============================================
+*/
+crvkShaderCache* crvkDevice::ShaderCache( void ) const
+{
+    if ( m_handle == nullptr )
+        return nullptr;
+
+    return m_handle->shaderCache;
+}
+
 /*
 ==============================================
 crvkDevice::InitDevice
@@ -359,7 +628,8 @@ bool crvkDevice::InitDevice( const crvkContext* in_context, const VkPhysicalDevi
     //
     AquireDeviceProperties();
   
-    if( !AquireDeviceSurfaceProperties( deviceSurfaceInfo ) )
+    // headless context, we don't have a surface to query 
+    if( deviceSurfaceInfo.surface != nullptr && !AquireDeviceSurfaceProperties( deviceSurfaceInfo ) )
         return false;   
 
     if( !AquireDeviceFeatures( deviceSurfaceInfo ) )
@@ -625,6 +895,10 @@ bool crvkDevice::AquireDeviceFeatures( const VkPhysicalDeviceSurfaceInfo2KHR in_
     m_handle->featuresv10.pNext = &m_handle->featuresv11;   
     vkGetPhysicalDeviceFeatures2( m_handle->physicalDevice, &m_handle->featuresv10 );
 
+    // headless context, keep the surface capabilities zeroed 
+    if ( in_deviceSurfaceInfo.surface == nullptr )
+        return true;
+
     // query device surface  capabilities
     m_handle->surfaceCapabilities.sType = VK_STRUCTURE_TYPE_SURFACE_CAPABILITIES_2_KHR;
     m_handle->surfaceCapabilities.pNext = nullptr;
@@ -661,7 +935,10 @@ bool crvkDevice::AquireDeviceQueues( const VkPhysicalDeviceSurfaceInfo2KHR in_de
         queue.compute = family.queueFlags & VK_QUEUE_COMPUTE_BIT;
         queue.transfer = family.queueFlags & VK_QUEUE_TRANSFER_BIT;
 
-        vkGetPhysicalDeviceSurfaceSupportKHR( m_handle->physicalDevice, i, in_deviceSurfaceInfo.surface, &presentSupport );
+        // without a surface no queue can present 
+        if ( in_deviceSurfaceInfo.surface != nullptr )
+            vkGetPhysicalDeviceSurfaceSupportKHR( m_handle->physicalDevice, i, in_deviceSurfaceInfo.surface, &presentSupport );
+        
         queue.present = presentSupport == VK_TRUE;
 
         for ( uint32_t j = 0; j < family.queueCount; j++)
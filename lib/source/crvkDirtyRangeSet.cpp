@@ -0,0 +1,135 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+#include "crvkPrecompiled.hpp"
+#include "crvkDirtyRangeSet.hpp"
+
+typedef struct crvkDirtyRangeSetHandle_t
+{
+    crvkDynamicVector<crvkDirtyRange_t> ranges;     // sorted and disjoint 
+} crvkDirtyRangeSetHandle_t;
+
+/*
+==============================================
+crvkDirtyRangeSet::crvkDirtyRangeSet
+==============================================
+*/
+crvkDirtyRangeSet::crvkDirtyRangeSet( void ) : m_handle( nullptr )
+{
+    m_handle = new crvkDirtyRangeSetHandle_t();
+}
+
+/*
+==============================================
+crvkDirtyRangeSet::~crvkDirtyRangeSet
+==============================================
+*/
+crvkDirtyRangeSet::~crvkDirtyRangeSet( void )
+{
+    if ( m_handle != nullptr )
+    {
+        delete m_handle;
+        m_handle = nullptr;
+    }
+}
+
+/*
+==============================================
+crvkDirtyRangeSet::Clear
+==============================================
+*/
+void crvkDirtyRangeSet::Clear( void )
+{
+    // keep the memory, the next map track the ranges again 
+    m_handle->ranges.Reset();
+}
+
+/*
+==============================================
+crvkDirtyRangeSet::Add
+==============================================
+*/
+void crvkDirtyRangeSet::Add( const VkDeviceSize in_offset, const VkDeviceSize in_size )
+{
+    crvkDynamicVector<crvkDirtyRange_t>& ranges = m_handle->ranges;
+    crvkDirtyRange_t range{ in_offset, in_offset + in_size };
+    uint32_t count = ranges.Count();
+    uint32_t first = 0;
+    uint32_t last = 0;
+
+    if ( in_size == 0 )
+        return;
+
+    // skip the ranges that end before the new one 
+    while ( first < count && ranges[first].end < range.begin )
+        first++;
+
+    // absorb the ranges that overlap or touch the new one 
+    last = first;
+    while ( last < count && ranges[last].begin <= range.end )
+    {
+        range.begin = std::min( range.begin, ranges[last].begin );
+        range.end = std::max( range.end, ranges[last].end );
+        last++;
+    }
+
+    ///
+    /// Replace the absorbed ranges with the merged one, keeping the order 
+    /// ==========================================================================
+    if ( last == first )
+    {
+        ranges.Append( range );
+        for ( uint32_t i = count; i > first; i-- )
+            ranges[i] = ranges[i - 1];
+    }
+    else
+    {
+        uint32_t removed = last - first - 1;
+        for ( uint32_t i = last; i < count; i++ )
+            ranges[i - removed] = ranges[i];
+        
+        ranges.Reset();
+        ranges.Resize( count - removed );
+    }
+
+    ranges[first] = range;
+}
+
+/*
+==============================================
+crvkDirtyRangeSet::Count
+==============================================
+*/
+uint32_t crvkDirtyRangeSet::Count( void ) const
+{
+    return m_handle->ranges.Count();
+}
+
+/*
+==============================================
+crvkDirtyRangeSet::Ranges
+==============================================
+*/
+const crvkDirtyRange_t* crvkDirtyRangeSet::Ranges( uint32_t* out_count ) const
+{
+    *out_count = m_handle->ranges.Count();
+    return m_handle->ranges.Pointer();
+}
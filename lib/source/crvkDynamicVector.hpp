@@ -20,6 +20,10 @@
 #include <SDL3/SDL_stdinc.h>
 #include <SDL3/SDL_assert.h>
 
+///
+/// @brief Vector of POD elements, content is moved with memcpy. Up to k_localCount small
+/// elements are kept inside the object, the heap is only used when the vector grow past it.
+///
 template<typename _t>
 class crvkDynamicVector
 {
@@ -29,12 +33,26 @@ public:
     typedef _t*         pointer;
     typedef const _t*   const_pointer;
 
+    static const uint32_t k_localBytes = 256;   // max inline storage size
+    static const uint32_t k_localCount = ( sizeof( _t ) * 8 <= k_localBytes ) ? 8 : k_localBytes / sizeof( _t );
+
     crvkDynamicVector( void );
     crvkDynamicVector( const crvkDynamicVector& in_ref );
+    crvkDynamicVector( crvkDynamicVector&& in_ref );
     ~crvkDynamicVector( void );
 
+    /// @brief Release the elements and the memory 
     void    Clear( void );
+
+    /// @brief Drop the elements, but keep the memory for reuse
+    void    Reset( void ) { m_count = 0; }
+    
+    /// @brief Grow the vector to count elements, never shrink 
     void    Resize( const uint32_t count );
+
+    /// @brief Make room for count elements, without change the element count
+    void    Reserve( const uint32_t in_count );
+
     void    Memcpy( const_pointer in_source, const uint32_t in_offset, const uint32_t in_count );
     void    Memset( const int32_t in_val );
 
@@ -45,6 +63,9 @@ public:
     /// @return 
     const uint32_t  Count( void ) const { return m_count; }
 
+    /// @brief Return the number of elements that fit before a new allocation 
+    const uint32_t  Capacity( void ) const { return m_capacity; }
+
     pointer         Pointer( void ) { return m_data; } 
     const_pointer   Pointer( void ) const { return m_data; } 
 
@@ -55,24 +76,37 @@ public:
     const_reference operator[]( const uint32_t i ) const { return m_data[i]; }
 
     crvkDynamicVector& operator=( const crvkDynamicVector &in_ref );
-    const crvkDynamicVector operator=( const crvkDynamicVector &in_ref ) const;
+    crvkDynamicVector& operator=( crvkDynamicVector &&in_ref );
 
 private:
     uint32_t    m_count;
+    uint32_t    m_capacity;
     pointer     m_data;
+    alignas( _t ) uint8_t m_local[k_localCount > 0 ? sizeof( _t ) * k_localCount : 1];   // inline storage 
+
+    pointer     Local( void ) { return reinterpret_cast<pointer>( m_local ); }
+    bool        IsLocal( void ) const { return m_data == reinterpret_cast<const_pointer>( m_local ); }
+    void        Steal( crvkDynamicVector& in_ref );
 };
 
 template<typename _t>
-crvkDynamicVector<_t>::crvkDynamicVector( void ) : m_count( 0 ), m_data( nullptr )
+crvkDynamicVector<_t>::crvkDynamicVector( void ) : m_count( 0 ), m_capacity( 0 ), m_data( nullptr )
 {
 }
 
 template <typename _t>
-inline crvkDynamicVector<_t>::crvkDynamicVector(const crvkDynamicVector &in_ref )
+inline crvkDynamicVector<_t>::crvkDynamicVector(const crvkDynamicVector &in_ref ) : m_count( 0 ), m_capacity( 0 ), m_data( nullptr )
 {
     // copy the reference content
     Resize( in_ref.Count() );
-    Memcpy( &in_ref, 0, in_ref.Count() );
+    if ( m_count > 0 )
+        Memcpy( &in_ref, 0, m_count );
+}
+
+template <typename _t>
+inline crvkDynamicVector<_t>::crvkDynamicVector( crvkDynamicVector &&in_ref ) : m_count( 0 ), m_capacity( 0 ), m_data( nullptr )
+{
+    Steal( in_ref );
 }
 
 template<typename _t>
@@ -84,29 +118,52 @@ crvkDynamicVector<_t>::~crvkDynamicVector( void )
 template<typename _t>
 inline void crvkDynamicVector<_t>::Clear( void )
 {
-    if ( m_data != nullptr )
-    {
+    if ( m_data != nullptr && !IsLocal() )
         SDL_free( m_data );
-        m_data = nullptr;
-    }
 
+    m_data = nullptr;
     m_count = 0;
+    m_capacity = 0;
 }
 
 template <typename _t>
-inline void crvkDynamicVector<_t>::Resize( const uint32_t in_count )
+inline void crvkDynamicVector<_t>::Reserve( const uint32_t in_count )
 {
-    // don't resize 
-    if ( in_count < m_count || in_count == 0 )
+    if ( in_count <= m_capacity )
+        return;
+
+    // small vectors don't touch the heap
+    if ( in_count <= k_localCount )
+    {
+        m_data = Local();
+        m_capacity = k_localCount;
         return;
+    }
+
+    if ( m_data == nullptr || IsLocal() )
+    {
+        pointer data = static_cast<pointer>( SDL_malloc( sizeof( _t ) * in_count ) );
+        SDL_assert( data != nullptr );
+        if ( m_count > 0 )
+            std::memcpy( data, m_data, sizeof( _t ) * m_count );
 
-    // create a new 
-    if( m_data == nullptr )
-        m_data = static_cast<pointer>( SDL_malloc( sizeof( _t ) * in_count ) );
+        m_data = data;
+    }
     else
         m_data = static_cast<pointer>( SDL_realloc( m_data, sizeof( _t ) * in_count ) );
         
     SDL_assert( m_data != nullptr );
+    m_capacity = in_count;
+}
+
+template <typename _t>
+inline void crvkDynamicVector<_t>::Resize( const uint32_t in_count )
+{
+    // don't resize 
+    if ( in_count < m_count || in_count == 0 )
+        return;
+
+    Reserve( in_count );
     m_count = in_count;
 }
 
@@ -125,8 +182,11 @@ inline void crvkDynamicVector<_t>::Memset( const int32_t in_val )
 template<typename _t>
 inline uint32_t crvkDynamicVector<_t>::Append( const_reference in_ref )
 {
+    // grow geometrically, appending N elements cost O(N) copies
+    if ( m_count == m_capacity )
+        Reserve( m_capacity < 4 ? 4 : m_capacity * 2 );
+
     uint32_t index = m_count++;
-    m_data = static_cast<pointer>( SDL_realloc( m_data, sizeof(_t) * m_count ) );
     std::memcpy( &m_data[index], &in_ref, sizeof( _t ) );
     return index;
 }
@@ -134,17 +194,45 @@ inline uint32_t crvkDynamicVector<_t>::Append( const_reference in_ref )
 template <typename _t>
 inline crvkDynamicVector<_t> &crvkDynamicVector<_t>::operator=( const crvkDynamicVector<_t> &in_ref )
 {
-    Resize( in_ref.Count() ); // alloc array 
-    Memcpy( &in_ref, 0, in_ref.Count() ); // copy content
+    if ( m_data != nullptr && m_data == in_ref.m_data )
+        return *this;
+
+    Reserve( in_ref.Count() ); // alloc array 
+    m_count = in_ref.Count();
+    if ( m_count > 0 )
+        Memcpy( &in_ref, 0, m_count ); // copy content
+    
     return *this;
 }
 
 template <typename _t>
-inline const crvkDynamicVector<_t> crvkDynamicVector<_t>::operator=(const crvkDynamicVector<_t> &in_ref) const
+inline crvkDynamicVector<_t> &crvkDynamicVector<_t>::operator=( crvkDynamicVector<_t> &&in_ref )
 {
-    Resize( in_ref.Count() ); // alloc array 
-    Memcpy( &in_ref, 0, in_ref.Count() ); // copy content
+    if ( m_data != nullptr && m_data == in_ref.m_data )
+        return *this;
+
+    Clear();
+    Steal( in_ref );
     return *this;
 }
 
-#endif //!__CRVK_DYNAMIC_VECTOR_HPP__
\ No newline at end of file
+template <typename _t>
+inline void crvkDynamicVector<_t>::Steal( crvkDynamicVector<_t> &in_ref )
+{
+    // inline content can't be taken, copy it to our own storage
+    if ( in_ref.IsLocal() )
+    {
+        m_data = Local();
+        std::memcpy( m_data, in_ref.m_data, sizeof( _t ) * in_ref.m_count );
+    }
+    else
+        m_data = in_ref.m_data;
+
+    m_count = in_ref.m_count;
+    m_capacity = in_ref.m_capacity;
+    in_ref.m_data = nullptr;
+    in_ref.m_count = 0;
+    in_ref.m_capacity = 0;
+}
+
+#endif //!__CRVK_DYNAMIC_VECTOR_HPP__
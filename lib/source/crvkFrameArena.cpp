@@ -0,0 +1,322 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+#include "crvkPrecompiled.hpp"
+#include "crvkFrameArena.hpp"
+
+typedef struct crvkFrameRegion_t
+{
+    VkDeviceSize            base = 0;       // region begin in the arena buffer 
+    crvkTimelinePoint_t     retire;         // value signaled by the last frame that used the region 
+    bool                    submitted = false;  // the frame was submitted, the GPU is going to signal retire 
+} crvkFrameRegion_t;
+
+typedef struct crvkFrameArenaHandle_t
+{
+    uint32_t                frames = 0;         // frame regions count 
+    uint32_t                current = 0;        // current frame region 
+    VkDeviceSize            frameSize = 0;      // size of each region 
+    VkDeviceSize            alignment = 0;      // device min offset alignment 
+    VkDeviceSize            head = 0;           // next free position of the current region 
+    VkDeviceSize            end = 0;            // end of the current region 
+    VkDeviceSize            peak = 0;           // most bytes used in a frame 
+    crvkFrameRegion_t*      regions = nullptr;
+    uint8_t*                mapped = nullptr;   // persistent CPU address 
+    VkBuffer                buffer = nullptr;
+    crvkMemoryAllocation_t  allocation;
+    crvkMemoryAllocator*    allocator = nullptr;
+    VkDevice                device = nullptr;
+} crvkFrameArenaHandle_t;
+
+/*
+==============================================
+crvkFrameArena::crvkFrameArena
+==============================================
+*/
+crvkFrameArena::crvkFrameArena( void ) : m_handle( nullptr )
+{
+}
+
+/*
+==============================================
+crvkFrameArena::~crvkFrameArena
+==============================================
+*/
+crvkFrameArena::~crvkFrameArena( void )
+{
+    Destroy();
+}
+
+/*
+==============================================
+crvkFrameArena::Create
+==============================================
+*/
+bool crvkFrameArena::Create( const crvkDevice* in_device, const uint32_t in_frames, const VkDeviceSize in_frameSize, const VkBufferUsageFlags in_usage )
+{
+    VkResult result = VK_SUCCESS;
+    VkMemoryRequirements memRequirements{};
+    const VkPhysicalDeviceLimits* limits = in_device->Limits();
+
+    m_handle = new crvkFrameArenaHandle_t();
+    m_handle->device = in_device->Device();
+    m_handle->allocator = in_device->MemoryAllocator();
+    m_handle->frames = std::max( in_frames, 1u );
+
+    // every allocation can be bound as uniform, storage, vertex or index data 
+    m_handle->alignment = std::max( { limits->minUniformBufferOffsetAlignment, limits->minStorageBufferOffsetAlignment, (VkDeviceSize)4 } );
+    m_handle->frameSize = ( in_frameSize + m_handle->alignment - 1 ) & ~( m_handle->alignment - 1 );
+
+    // no frame started, allocations fail until BeginFrame
+    m_handle->current = m_handle->frames - 1;
+    m_handle->regions = new crvkFrameRegion_t[m_handle->frames];
+    for ( uint32_t i = 0; i < m_handle->frames; i++ )
+        m_handle->regions[i].base = m_handle->frameSize * i;
+
+    ///
+    /// Create the arena buffer 
+    /// ==========================================================================
+    VkBufferCreateInfo bufferCI{};
+    bufferCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCI.size = m_handle->frameSize * m_handle->frames;
+    bufferCI.usage = in_usage;
+    bufferCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    result = vkCreateBuffer( m_handle->device, &bufferCI, k_allocationCallbacks, &m_handle->buffer );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkFrameArena::Create::vkCreateBuffer", result );
+        return false;
+    }
+
+    // coherent memory, the writes don't need a flush 
+    vkGetBufferMemoryRequirements( m_handle->device, m_handle->buffer, &memRequirements );
+    if ( !m_handle->allocator->Allocate( memRequirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, true, &m_handle->allocation ) )
+        return false;
+    
+    result = vkBindBufferMemory( m_handle->device, m_handle->buffer, m_handle->allocation.memory, m_handle->allocation.offset );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkFrameArena::Create::vkBindBufferMemory", result );
+        return false;
+    }
+
+    // the arena stay mapped for his whole life 
+    m_handle->mapped = static_cast<uint8_t*>( m_handle->allocator->Map( &m_handle->allocation ) );
+    if ( m_handle->mapped == nullptr )
+        return false;
+
+    return true;
+}
+
+/*
+==============================================
+crvkFrameArena::Destroy
+==============================================
+*/
+void crvkFrameArena::Destroy( void )
+{
+    if ( m_handle == nullptr )
+        return;
+
+    // wait the frames still reading the arena, a frame never submitted would never retire 
+    if ( m_handle->regions != nullptr )
+    {
+        for ( uint32_t i = 0; i < m_handle->frames; i++ )
+        {
+            if ( m_handle->regions[i].retire.semaphore == nullptr || !m_handle->regions[i].submitted )
+                continue;
+
+            VkSemaphoreWaitInfo waitInfo{};
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &m_handle->regions[i].retire.semaphore;
+            waitInfo.pValues = &m_handle->regions[i].retire.value;
+            vkWaitSemaphores( m_handle->device, &waitInfo, UINT64_MAX );
+        }
+
+        delete[] m_handle->regions;
+        m_handle->regions = nullptr;
+    }
+
+    if ( m_handle->buffer != nullptr )
+    {
+        vkDestroyBuffer( m_handle->device, m_handle->buffer, k_allocationCallbacks );
+        m_handle->buffer = nullptr;
+    }
+
+    if ( m_handle->allocation.memory != nullptr )
+    {
+        if ( m_handle->mapped != nullptr )
+            m_handle->allocator->Unmap( &m_handle->allocation );
+
+        m_handle->allocator->Free( &m_handle->allocation );
+    }
+
+    delete m_handle;
+    m_handle = nullptr;
+}
+
+/*
+==============================================
+crvkFrameArena::BeginFrame
+==============================================
+*/
+VkResult crvkFrameArena::BeginFrame( const VkSemaphore in_semaphore, const uint64_t in_value )
+{
+    VkResult result = VK_SUCCESS;
+
+    m_handle->peak = std::max( m_handle->peak, Used() );
+
+    // the previous frame was submitted before this one start 
+    EndFrame();
+
+    m_handle->current = ( m_handle->current + 1 ) % m_handle->frames;
+    crvkFrameRegion_t* region = &m_handle->regions[m_handle->current];
+
+    // the frame pacing usually already waited it, so this don't block 
+    if ( region->retire.semaphore != nullptr && region->submitted )
+    {
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &region->retire.semaphore;
+        waitInfo.pValues = &region->retire.value;
+        result = vkWaitSemaphores( m_handle->device, &waitInfo, UINT64_MAX );
+        if ( result != VK_SUCCESS )
+        {
+            crvkAppendError( "crvkFrameArena::BeginFrame::vkWaitSemaphores", result );
+            m_handle->head = m_handle->end = 0;
+            return result;
+        }
+    }
+
+    // the whole region is free again 
+    region->retire.semaphore = in_semaphore;
+    region->retire.value = in_value;
+    region->submitted = false;
+    m_handle->head = region->base;
+    m_handle->end = region->base + m_handle->frameSize;
+    return result;
+}
+
+/*
+==============================================
+crvkFrameArena::BeginFrame
+==============================================
+*/
+VkResult crvkFrameArena::BeginFrame( const crvkSwapchain* in_swapchain )
+{
+    return BeginFrame( in_swapchain->FrameSemaphore(), in_swapchain->FrameValue() );
+}
+
+/*
+==============================================
+crvkFrameArena::EndFrame
+==============================================
+*/
+void crvkFrameArena::EndFrame( void )
+{
+    // no frame started 
+    if ( m_handle->end == 0 )
+        return;
+
+    m_handle->regions[m_handle->current].submitted = true;
+}
+
+/*
+==============================================
+crvkFrameArena::Allocate
+==============================================
+*/
+bool crvkFrameArena::Allocate( const VkDeviceSize in_size, const VkDeviceSize in_alignment, crvkFrameAllocation_t* out_allocation )
+{
+    VkDeviceSize alignment = std::max( in_alignment, m_handle->alignment );
+    VkDeviceSize offset = ( m_handle->head + alignment - 1 ) & ~( alignment - 1 );
+
+    if ( in_size == 0 || offset + in_size > m_handle->end )
+    {
+        crvkAppendError( "crvkFrameArena::Allocate::full", VK_ERROR_OUT_OF_DEVICE_MEMORY );
+        return false;
+    }
+
+    m_handle->head = offset + in_size;
+    out_allocation->buffer = m_handle->buffer;
+    out_allocation->offset = offset;
+    out_allocation->pointer = m_handle->mapped + offset;
+    return true;
+}
+
+/*
+==============================================
+crvkFrameArena::Push
+==============================================
+*/
+bool crvkFrameArena::Push( const void* in_data, const VkDeviceSize in_size, const VkDeviceSize in_alignment, crvkFrameAllocation_t* out_allocation )
+{
+    if ( !Allocate( in_size, in_alignment, out_allocation ) )
+        return false;
+
+    std::memcpy( out_allocation->pointer, in_data, in_size );
+    return true;
+}
+
+/*
+==============================================
+crvkFrameArena::Buffer
+==============================================
+*/
+VkBuffer crvkFrameArena::Buffer( void ) const
+{
+    return m_handle->buffer;
+}
+
+/*
+==============================================
+crvkFrameArena::FrameSize
+==============================================
+*/
+VkDeviceSize crvkFrameArena::FrameSize( void ) const
+{
+    return m_handle->frameSize;
+}
+
+/*
+==============================================
+crvkFrameArena::Used
+==============================================
+*/
+VkDeviceSize crvkFrameArena::Used( void ) const
+{
+    if ( m_handle->end == 0 )
+        return 0;
+
+    return m_handle->head - m_handle->regions[m_handle->current].base;
+}
+
+/*
+==============================================
+crvkFrameArena::Peak
+==============================================
+*/
+VkDeviceSize crvkFrameArena::Peak( void ) const
+{
+    return std::max( m_handle->peak, Used() );
+}
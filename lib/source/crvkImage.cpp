@@ -21,24 +21,55 @@
 #include "crvkPrecompiled.hpp"
 #include "crvkImage.hpp"
 
+/// @brief the state of a single ( mip, layer ) of the image 
+typedef struct crvkImageSubresourceState_t
+{
+    VkPipelineStageFlags2   stage = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2          access = VK_ACCESS_2_NONE;
+    VkImageLayout           layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    uint32_t                queue = VK_QUEUE_FAMILY_IGNORED;
+    bool                    owned = false;  // false until a queue use it, or after a discard, the next queue take it without a ownership transfer 
+} crvkImageSubresourceState_t;
+
+/// @brief a block of levels and layers that share the same state 
+typedef struct crvkImageSubresourceRun_t
+{
+    uint32_t                    baseLevel;
+    uint32_t                    levelCount;
+    uint32_t                    baseLayer;
+    uint32_t                    layerCount;
+    crvkImageSubresourceState_t state;
+} crvkImageSubresourceRun_t;
+
 typedef struct crvkImageHandle_t
 {
     uint16_t                levels = 1;
     uint16_t                layers = 1;
-    uint32_t                queue = VK_QUEUE_FAMILY_IGNORED;
     VkFormat                format = VK_FORMAT_UNDEFINED;
     VkImageViewType         type = VK_IMAGE_VIEW_TYPE_1D;
     VkSampleCountFlagBits   samples = VK_SAMPLE_COUNT_1_BIT;
-    VkPipelineStageFlags2   stage = VK_PIPELINE_STAGE_2_NONE;
-    VkAccessFlags2          access = VK_ACCESS_2_NONE;
     VkImageAspectFlags      aspect = VK_IMAGE_ASPECT_NONE;
-    VkImageLayout           layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    bool                    aliased = false;    // bound to memory owned by other 
+    crvkImageSubresourceState_t* states = nullptr;  // levels * layers states, level major 
     VkImage                 image = nullptr;
     VkImageView             view = nullptr;
-    VkDeviceMemory          memory = nullptr;
+    crvkMemoryAllocation_t  allocation;
+    crvkMemoryAllocator*    allocator = nullptr;
+    crvkDeletionQueue*      deletion = nullptr;     // device deferred deletion queue 
+    crvkTimelinePoint_t     lastUse;                // last use set by the application 
     VkDevice                device = nullptr;
 }crvkImageHandle_t;
 
+/*
+==============================================
+SameState
+==============================================
+*/
+static bool SameState( const crvkImageSubresourceState_t& in_a, const crvkImageSubresourceState_t& in_b )
+{
+    return in_a.stage == in_b.stage && in_a.access == in_b.access && in_a.layout == in_b.layout && in_a.queue == in_b.queue && in_a.owned == in_b.owned;
+}
+
 /*
 ==============================================
 crvkImage::crvkImage
@@ -79,12 +110,47 @@ bool crvkImage::Create(
     const uint32_t in_width,
     const uint32_t in_height,
     const uint32_t in_depth,
-    const VkSampleCountFlagBits in_samples
+    const VkSampleCountFlagBits in_samples,
+    const VkImageUsageFlags in_usage
 )
 {
-    VkResult result = VK_SUCCESS;
     VkMemoryRequirements memReq{};
     
+    if ( !CreateUnbound( in_device, in_type, in_format, in_levels, in_layers, in_width, in_height, in_depth, in_samples, in_usage ) )
+        return false;
+
+    vkGetImageMemoryRequirements( m_imageHandle->device, m_imageHandle->image, &memReq );
+    
+    ///
+    /// Allocate image for the memory 
+    /// ==========================================================================
+    // optimal tiling images are kept apart from buffers, so we don't care about bufferImageGranularity 
+    if ( !m_imageHandle->allocator->Allocate( memReq, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, false, &m_imageHandle->allocation ) )
+        return false;
+
+    return BindMemory( m_imageHandle->allocation.memory, m_imageHandle->allocation.offset );
+}
+
+/*
+==============================================
+crvkImage::CreateUnbound
+==============================================
+*/
+bool crvkImage::CreateUnbound( 
+    const crvkDevice* in_device, 
+    const VkImageViewType in_type, 
+    const VkFormat in_format,
+    const uint16_t in_levels,
+    const uint16_t in_layers,
+    const uint32_t in_width,
+    const uint32_t in_height,
+    const uint32_t in_depth,
+    const VkSampleCountFlagBits in_samples,
+    const VkImageUsageFlags in_usage
+)
+{
+    VkResult result = VK_SUCCESS;
+    
     // fail proof 
     m_imageHandle->levels = std::max( in_levels, (unsigned short)1 ); // fail proof, this are never 0, we need atleast 1 level 
     m_imageHandle->layers = std::max( in_layers, (unsigned short)1 ); // fail proof, this are never 0, we need atleast 1 layer 
@@ -92,7 +158,14 @@ bool crvkImage::Create(
     m_imageHandle->format = in_format; // pixel format 
     m_imageHandle->samples = in_samples; // samples 
     m_imageHandle->device = in_device->Device(); // device 
+    m_imageHandle->allocator = in_device->MemoryAllocator(); // device memory allocator 
+    m_imageHandle->deletion = in_device->DeletionQueue();
+    m_imageHandle->lastUse = crvkTimelinePoint_t{};
     
+    // every subresource start undefined 
+    delete[] m_imageHandle->states;
+    m_imageHandle->states = new crvkImageSubresourceState_t[m_imageHandle->levels * m_imageHandle->layers];
+
     ///
     /// Create the image handler 
     /// ==========================================================================
@@ -104,9 +177,9 @@ bool crvkImage::Create(
     imageCI.arrayLayers = in_layers;
     imageCI.samples = m_imageHandle->samples; // todo implement multisampling 
     imageCI.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imageCI.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageCI.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | in_usage;
     imageCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE; // todo:
-    imageCI.initialLayout = m_imageHandle->layout;
+    imageCI.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
     switch ( m_imageHandle->type )
     {
@@ -149,38 +222,56 @@ bool crvkImage::Create(
     result = vkCreateImage( m_imageHandle->device, &imageCI, k_allocationCallbacks, &m_imageHandle->image );
     if ( result != VK_SUCCESS )
     {
-        crvkAppendError( "crvkImage::Create::vkCreateImage", result );
+        crvkAppendError( "crvkImage::CreateUnbound::vkCreateImage", result );
         return false;
     }
-    
-    vkGetImageMemoryRequirements( m_imageHandle->device, m_imageHandle->image, &memReq );
-    
-    ///
-    /// Allocate image for the memory 
-    /// ==========================================================================
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memReq.size;
-    allocInfo.memoryTypeIndex = in_device->FindMemoryType( memReq.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
-    result = vkAllocateMemory( m_imageHandle->device, &allocInfo, nullptr, &m_imageHandle->memory ); 
+
+    return true;
+}
+
+/*
+==============================================
+crvkImage::Bind
+==============================================
+*/
+bool crvkImage::Bind( const crvkMemoryAllocation_t* in_memory, const VkDeviceSize in_offset )
+{
+    if ( m_imageHandle == nullptr || m_imageHandle->image == nullptr || m_imageHandle->allocation.memory != nullptr )
+        return false;
+
+    // the memory still belong to his owner, we only keep a copy for Memory and MemoryOffset
+    m_imageHandle->allocation = *in_memory;
+    m_imageHandle->allocation.offset += in_offset;
+    m_imageHandle->aliased = true;
+    return BindMemory( m_imageHandle->allocation.memory, m_imageHandle->allocation.offset );
+}
+
+/*
+==============================================
+crvkImage::BindMemory
+==============================================
+*/
+bool crvkImage::BindMemory( const VkDeviceMemory in_memory, const VkDeviceSize in_offset )
+{
+    VkResult result = VK_SUCCESS;
+
+    // bind image to memory 
+    result = vkBindImageMemory( m_imageHandle->device, m_imageHandle->image, in_memory, in_offset );
     if ( result != VK_SUCCESS )
     {
-        crvkAppendError( "crvkImage::Create::vkAllocateMemory", result );
+        crvkAppendError( "crvkImage::BindMemory::vkBindImageMemory", result );
         return false;
     }
 
-    // bind image to memory 
-    vkBindImageMemory( m_imageHandle->device, m_imageHandle->image, m_imageHandle->memory, 0 );
-
     ///
     /// Create the image view
     /// ==========================================================================
     VkImageSubresourceRange    subresourceRange{};
     subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     subresourceRange.baseMipLevel = 0;
-    subresourceRange.levelCount = in_levels;
+    subresourceRange.levelCount = m_imageHandle->levels;
     subresourceRange.baseArrayLayer = 0;
-    subresourceRange.layerCount = in_layers;
+    subresourceRange.layerCount = m_imageHandle->layers;
 
     VkImageViewCreateInfo viewCI{};
     viewCI.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -191,8 +282,7 @@ bool crvkImage::Create(
     result = vkCreateImageView( m_imageHandle->device, &viewCI, k_allocationCallbacks, &m_imageHandle->view );
     if( result != VK_SUCCESS )
     {
-        delete m_imageHandle;
-        crvkAppendError( "crvkImage::Create::vkCreateImageView", result );
+        crvkAppendError( "crvkImage::BindMemory::vkCreateImageView", result );
         return false;
     }
 
@@ -201,7 +291,7 @@ bool crvkImage::Create(
 
 /*
 ==============================================
-crvkImage::Create
+crvkImage::Destroy
 ==============================================
 */
 void crvkImage::Destroy(void)
@@ -210,26 +300,152 @@ void crvkImage::Destroy(void)
     if ( m_imageHandle == nullptr )
         return;
 
+    crvkTimelinePoint_t lastUse[crvkDeletionQueue::k_maxPoints];
+    Release( lastUse, LastUse( lastUse ) );
+}
+
+/*
+==============================================
+crvkImage::SetLastUse
+==============================================
+*/
+void crvkImage::SetLastUse( const VkSemaphore in_semaphore, const uint64_t in_value )
+{
+    m_imageHandle->lastUse.semaphore = in_semaphore;
+    m_imageHandle->lastUse.value = in_value;
+}
+
+/*
+==============================================
+crvkImage::LastUse
+==============================================
+*/
+uint32_t crvkImage::LastUse( crvkTimelinePoint_t* out_points ) const
+{
+    if ( m_imageHandle->lastUse.semaphore == nullptr )
+        return 0;
+
+    out_points[0] = m_imageHandle->lastUse;
+    return 1;
+}
+
+/*
+==============================================
+crvkImage::Release
+==============================================
+*/
+void crvkImage::Release( const crvkTimelinePoint_t* in_lastUse, const uint32_t in_count )
+{
+    // with a known last use the view, image and memory go to the device queue 
+    bool deferred = m_imageHandle->deletion != nullptr && in_count > 0;
+
     // release image view 
     if ( m_imageHandle->view != nullptr )
     {
-        vkDestroyImageView( m_imageHandle->device, m_imageHandle->view, k_allocationCallbacks );
+        if ( deferred )
+            m_imageHandle->deletion->Enqueue( VK_OBJECT_TYPE_IMAGE_VIEW, reinterpret_cast<uint64_t>( m_imageHandle->view ), in_lastUse, in_count );
+        else
+            vkDestroyImageView( m_imageHandle->device, m_imageHandle->view, k_allocationCallbacks );
+
         m_imageHandle->view = nullptr;
     }
 
-    // release image memory
-    if ( m_imageHandle->memory != nullptr )
-    {
-        vkFreeMemory( m_imageHandle->device, m_imageHandle->memory, k_allocationCallbacks );
-        m_imageHandle->memory = nullptr;
-    }
-    
     // release image handler
     if ( m_imageHandle->image != nullptr )
     {
-        vkDestroyImage( m_imageHandle->device, m_imageHandle->image, k_allocationCallbacks );
+        if ( deferred )
+            m_imageHandle->deletion->Enqueue( VK_OBJECT_TYPE_IMAGE, reinterpret_cast<uint64_t>( m_imageHandle->image ), in_lastUse, in_count );
+        else
+            vkDestroyImage( m_imageHandle->device, m_imageHandle->image, k_allocationCallbacks );
+
         m_imageHandle->image = nullptr;
     }
+
+    // return the image memory to the device allocator, aliased memory belong to other 
+    if ( m_imageHandle->aliased )
+        m_imageHandle->allocation = crvkMemoryAllocation_t{};
+    else if ( m_imageHandle->allocation.memory != nullptr )
+    {
+        if ( deferred )
+        {
+            m_imageHandle->deletion->EnqueueFree( &m_imageHandle->allocation, in_lastUse, in_count );
+            m_imageHandle->allocation = crvkMemoryAllocation_t{};
+        }
+        else
+            m_imageHandle->allocator->Free( &m_imageHandle->allocation );
+    }
+
+    m_imageHandle->aliased = false;
+    m_imageHandle->lastUse = crvkTimelinePoint_t{};
+
+    // the states are only used by the CPU 
+    if ( m_imageHandle->states != nullptr )
+    {
+        delete[] m_imageHandle->states;
+        m_imageHandle->states = nullptr;
+    }
+}
+
+/*
+==============================================
+crvkImage::Layout
+==============================================
+*/
+VkImageLayout crvkImage::Layout( const uint32_t in_level, const uint32_t in_layer ) const
+{
+    if ( m_imageHandle == nullptr || m_imageHandle->states == nullptr || in_level >= m_imageHandle->levels || in_layer >= m_imageHandle->layers )
+        return VK_IMAGE_LAYOUT_UNDEFINED;
+
+    return m_imageHandle->states[in_level * m_imageHandle->layers + in_layer].layout;
+}
+
+/*
+==============================================
+crvkImage::MemoryRequirements
+==============================================
+*/
+void crvkImage::MemoryRequirements( VkMemoryRequirements* out_requirements ) const
+{
+    vkGetImageMemoryRequirements( m_imageHandle->device, m_imageHandle->image, out_requirements );
+}
+
+/*
+==============================================
+crvkImage::DiscardContent
+==============================================
+*/
+void crvkImage::DiscardContent( const VkPipelineStageFlags2 in_stages, const VkAccessFlags2 in_access )
+{
+    if ( m_imageHandle == nullptr || m_imageHandle->states == nullptr )
+        return;
+
+    // the next transition start from undefined, but still wait the given work, 
+    // a discarded content have no owner, so the next queue don't need a ownership transfer 
+    for ( uint32_t i = 0; i < m_imageHandle->levels * m_imageHandle->layers; i++ )
+    {
+        m_imageHandle->states[i].stage = in_stages;
+        m_imageHandle->states[i].access = in_access;
+        m_imageHandle->states[i].layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        m_imageHandle->states[i].queue = VK_QUEUE_FAMILY_IGNORED;
+        m_imageHandle->states[i].owned = false;
+    }
+}
+
+/*
+==============================================
+crvkImage::Stages
+==============================================
+*/
+VkPipelineStageFlags2 crvkImage::Stages( void ) const
+{
+    VkPipelineStageFlags2 stages = VK_PIPELINE_STAGE_2_NONE;
+    if ( m_imageHandle == nullptr || m_imageHandle->states == nullptr )
+        return stages;
+
+    for ( uint32_t i = 0; i < m_imageHandle->levels * m_imageHandle->layers; i++ )
+        stages |= m_imageHandle->states[i].stage;
+
+    return stages;
 }
 
 /*
@@ -268,14 +484,87 @@ VkDeviceMemory crvkImage::Memory( void ) const
     if ( m_imageHandle == nullptr )
         return nullptr;
 
-    return m_imageHandle->memory;
+    return m_imageHandle->allocation.memory;
 }
 
+/*
+==============================================
+crvkImage::MemoryOffset
+==============================================
+*/
+VkDeviceSize crvkImage::MemoryOffset( void ) const
+{
+    if ( m_imageHandle == nullptr )
+        return 0;
+
+    return m_imageHandle->allocation.offset;
+}
+
+/*
+==============================================
+crvkImage::StateTransition
+==============================================
+*/
+void crvkImage::StateTransition( 
+        const VkCommandBuffer in_commandBuffer, 
+        const crvkImageState_t in_state,
+        const VkImageAspectFlags in_aspect, 
+        const uint32_t in_dstQueue )
+{
+    crvkBarrierBatch batch;
+    batch.Begin( in_commandBuffer );
+    StateTransition( &batch, in_state, in_aspect, in_dstQueue );
+    batch.Flush();
+}
+
+/*
+==============================================
+crvkImage::StateTransition
+==============================================
+*/
 void crvkImage::StateTransition( 
         const VkCommandBuffer in_commandBuffer, 
         const crvkImageState_t in_state,
+        const VkImageSubresourceRange* in_range, 
+        const uint32_t in_dstQueue )
+{
+    crvkBarrierBatch batch;
+    batch.Begin( in_commandBuffer );
+    StateTransition( &batch, in_state, in_range, in_dstQueue );
+    batch.Flush();
+}
+
+/*
+==============================================
+crvkImage::StateTransition
+==============================================
+*/
+void crvkImage::StateTransition( 
+        crvkBarrierBatch* in_batch, 
+        const crvkImageState_t in_state,
         const VkImageAspectFlags in_aspect, 
         const uint32_t in_dstQueue )
+{
+    // the whole image 
+    VkImageSubresourceRange subresourceRange{};
+    subresourceRange.aspectMask = in_aspect;
+    subresourceRange.baseMipLevel = 0;
+    subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+    subresourceRange.baseArrayLayer = 0;
+    subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+    StateTransition( in_batch, in_state, &subresourceRange, in_dstQueue );
+}
+
+/*
+==============================================
+crvkImage::StateTransition
+==============================================
+*/
+void crvkImage::StateTransition( 
+        crvkBarrierBatch* in_batch, 
+        const crvkImageState_t in_state,
+        const VkImageSubresourceRange* in_range, 
+        const uint32_t in_dstQueue )
 {
     VkPipelineStageFlags2   stage = VK_PIPELINE_STAGE_2_NONE;
     VkAccessFlags2          access = VK_ACCESS_2_NONE;
@@ -342,50 +631,117 @@ void crvkImage::StateTransition(
         // Cópia de pixels para imagem (upload → GPU)
         case CRVK_IMAGE_STATE_GPU_COPY_DST:
         {
-            stage = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
             stage = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
             access = VK_ACCESS_2_TRANSFER_WRITE_BIT;
         } break;
     }
 
-    // we update the whole image, since we map the current texture state change, we can't handle sections
-    VkImageSubresourceRange subresourceRange{};
-    subresourceRange.aspectMask = ( in_aspect == VK_IMAGE_ASPECT_NONE ) ? m_imageHandle->aspect : in_aspect; // if no aspect set, use from image
-    subresourceRange.baseMipLevel = 0;
-    subresourceRange.levelCount = m_imageHandle->levels;
-    subresourceRange.baseArrayLayer = 0;
-    subresourceRange.layerCount = m_imageHandle->layers;
+    // clamp the range to the image 
+    uint32_t baseLevel = std::min<uint32_t>( in_range->baseMipLevel, m_imageHandle->levels );
+    uint32_t baseLayer = std::min<uint32_t>( in_range->baseArrayLayer, m_imageHandle->layers );
+    uint32_t levelEnd = ( in_range->levelCount == VK_REMAINING_MIP_LEVELS ) ? m_imageHandle->levels : std::min<uint32_t>( baseLevel + in_range->levelCount, m_imageHandle->levels );
+    uint32_t layerEnd = ( in_range->layerCount == VK_REMAINING_ARRAY_LAYERS ) ? m_imageHandle->layers : std::min<uint32_t>( baseLayer + in_range->layerCount, m_imageHandle->layers );
+
+    ///
+    /// Split the range in runs of subresources with the same state
+    /// ==========================================================================
+    // a run of layers with the same state is extended over the next level when that level have the same run,
+    // so a uniform image still make a single barrier 
+    crvkDynamicVector<crvkImageSubresourceRun_t> runs;
+    for ( uint32_t level = baseLevel; level < levelEnd; level++ )
+    {
+        uint32_t layer = baseLayer;
+        while ( layer < layerEnd )
+        {
+            const crvkImageSubresourceState_t& state = m_imageHandle->states[level * m_imageHandle->layers + layer];
+            uint32_t first = layer;
+            
+            while ( layer < layerEnd && SameState( m_imageHandle->states[level * m_imageHandle->layers + layer], state ) )
+                layer++;
+
+            // look for a run that reach the previous level 
+            bool extended = false;
+            for ( uint32_t i = 0; i < runs.Count() && !extended; i++ )
+            {
+                crvkImageSubresourceRun_t& run = runs[i];
+                if (    run.baseLevel + run.levelCount == level && 
+                        run.baseLayer == first && run.layerCount == layer - first && 
+                        SameState( run.state, state ) )
+                {
+                    run.levelCount++;
+                    extended = true;
+                }
+            }
+
+            if ( extended )
+                continue;
+            
+            crvkImageSubresourceRun_t run{};
+            run.baseLevel = level;
+            run.levelCount = 1;
+            run.baseLayer = first;
+            run.layerCount = layer - first;
+            run.state = state;
+            runs.Append( run );
+        }
+    }
 
-    VkImageMemoryBarrier2 barrier{};
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
-    barrier.pNext = nullptr;
-    barrier.srcStageMask = m_imageHandle->stage;
-    barrier.srcAccessMask = m_imageHandle->access;
-    barrier.dstStageMask = stage;
-    barrier.dstAccessMask = access;
-    barrier.oldLayout = m_imageHandle->layout;
-    barrier.newLayout = layout;
-    barrier.srcQueueFamilyIndex = m_imageHandle->queue;
-    barrier.dstQueueFamilyIndex = in_dstQueue;
-    barrier.image = m_imageHandle->image;
-    barrier.subresourceRange = subresourceRange;
-
-    VkDependencyInfo depInfo{};
-    depInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
-    depInfo.pNext = nullptr;
-    depInfo.dependencyFlags = 0;
-    depInfo.memoryBarrierCount = 0;
-    depInfo.pMemoryBarriers = nullptr;
-    depInfo.bufferMemoryBarrierCount = 0;
-    depInfo.pBufferMemoryBarriers = nullptr;
-    depInfo.imageMemoryBarrierCount = 1;
-    depInfo.pImageMemoryBarriers = &barrier;
-    vkCmdPipelineBarrier2( in_commandBuffer, &depInfo );
-
-    //
-    m_imageHandle->stage = stage;
-    m_imageHandle->access = access;
-    m_imageHandle->layout = layout;  
+    ///
+    /// Send a barrier for each run and update the subresources state 
+    /// ==========================================================================
+    for ( uint32_t i = 0; i < runs.Count(); i++ )
+    {
+        const crvkImageSubresourceRun_t& run = runs[i];
+        crvkImageSubresourceState_t state{ stage, access, layout, in_dstQueue, true };
+        uint32_t srcQueue = run.state.queue;
+        uint32_t dstQueue = in_dstQueue;
+
+        // a ownership transfer only happen between two known families, a image without owner 
+        // is acquired by the new family, and a ignored destine keep the current owner 
+        if ( !run.state.owned || srcQueue == VK_QUEUE_FAMILY_IGNORED || dstQueue == VK_QUEUE_FAMILY_IGNORED || srcQueue == dstQueue )
+        {
+            if ( dstQueue == VK_QUEUE_FAMILY_IGNORED )
+            {
+                state.queue = srcQueue;
+                state.owned = run.state.owned;
+            }
+            
+            srcQueue = VK_QUEUE_FAMILY_IGNORED;
+            dstQueue = VK_QUEUE_FAMILY_IGNORED;
+        }
+
+        VkImageMemoryBarrier2 barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        barrier.pNext = nullptr;
+        barrier.srcStageMask = run.state.stage;
+        barrier.srcAccessMask = run.state.access;
+        barrier.dstStageMask = stage;
+        barrier.dstAccessMask = access;
+        barrier.oldLayout = run.state.layout;
+        barrier.newLayout = layout;
+        barrier.srcQueueFamilyIndex = srcQueue;
+        barrier.dstQueueFamilyIndex = dstQueue;
+        barrier.image = m_imageHandle->image;
+        barrier.subresourceRange.aspectMask = ( in_range->aspectMask == VK_IMAGE_ASPECT_NONE ) ? m_imageHandle->aspect : in_range->aspectMask; // if no aspect set, use from image
+        barrier.subresourceRange.baseMipLevel = run.baseLevel;
+        barrier.subresourceRange.levelCount = run.levelCount;
+        barrier.subresourceRange.baseArrayLayer = run.baseLayer;
+        barrier.subresourceRange.layerCount = run.layerCount;
+
+        // a read covered by the earlier readers don't need a barrier, but a later write must still wait all the readers
+        if ( !in_batch->Image( &barrier ) )
+        {
+            state.stage |= run.state.stage;
+            state.access |= run.state.access;
+        }
+
+        for ( uint32_t level = run.baseLevel; level < run.baseLevel + run.levelCount; level++ )
+        {
+            for ( uint32_t layer = run.baseLayer; layer < run.baseLayer + run.layerCount; layer++ )
+                m_imageHandle->states[level * m_imageHandle->layers + layer] = state;
+        }
+    }
 }
 
 //=======================================================================================================================
@@ -395,8 +751,20 @@ void crvkImage::StateTransition(
 crvkImage::crvkImageStatic
 ==============================================
 */
-crvkImageStatic::crvkImageStatic(void) : crvkImage(), m_commandBuffer( nullptr )
+crvkImageStatic::crvkImageStatic(void) : crvkImage(), 
+    m_useValue( 1 ),
+    m_copyValue( 1 ),
+    m_lastCopyValue( 1 ),
+    m_copySemaphore( nullptr ),
+    m_useSemaphore( nullptr ),
+    m_lastCopySemaphore( nullptr ),
+    m_commandPool( nullptr ),
+    m_commandBuffer( nullptr ),
+    m_copyCommand( 0 ),
+    m_device( nullptr )
 {
+    std::memset( m_copyCommandBuffers, 0, sizeof( m_copyCommandBuffers ) );
+    std::memset( m_copyCommandValues, 0, sizeof( m_copyCommandValues ) );
 }
 
 /*
@@ -421,7 +789,8 @@ bool crvkImageStatic::Create(   const crvkDevice *in_device,
                                 const uint32_t in_width, 
                                 const uint32_t in_height, 
                                 const uint32_t in_depth,
-                                const VkSampleCountFlagBits in_samples
+                                const VkSampleCountFlagBits in_samples,
+                                const VkImageUsageFlags in_usage
                             )
 {
     VkResult result = VK_SUCCESS;
@@ -437,7 +806,7 @@ bool crvkImageStatic::Create(   const crvkDevice *in_device,
     m_commandPool = queue->CommandPool();
 
     // assign the device to a queque
-    if ( !crvkImage::Create( in_device, in_type, in_format, in_levels, in_layers, in_width, in_height, in_depth, in_samples ) )
+    if ( !crvkImage::Create( in_device, in_type, in_format, in_levels, in_layers, in_width, in_height, in_depth, in_samples, in_usage ) )
         return false;
 
     ///
@@ -456,13 +825,25 @@ bool crvkImageStatic::Create(   const crvkDevice *in_device,
         return false;
     }
 
+    // the copies ring, the semaphore start at 1, so every command buffer start free 
+    allocInfo.commandBufferCount = k_copyCommandBuffers;
+    result = vkAllocateCommandBuffers( m_imageHandle->device, &allocInfo, m_copyCommandBuffers );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkImageStatic::Create::vkAllocateCommandBuffers::COPY", result );
+        return false;
+    }
+
+    std::memset( m_copyCommandValues, 0, sizeof( m_copyCommandValues ) );
+    m_copyCommand = 0;
+
     ///
     /// Create semaphores 
     /// ==========================================================================
     VkSemaphoreTypeCreateInfo timelineCreateInfo{};
     timelineCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
     timelineCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
-    timelineCreateInfo.initialValue = 0;
+    timelineCreateInfo.initialValue = 1; // m_useValue and m_copyValue start at 1 
 
     VkSemaphoreCreateInfo copySemaphoreCI{};
     copySemaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
@@ -476,6 +857,8 @@ bool crvkImageStatic::Create(   const crvkDevice *in_device,
         return false;
     }
 
+    SetLastCopy( m_copySemaphore, m_copyValue );
+
     VkSemaphoreCreateInfo drawSemaphoreCI{};
     drawSemaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
     drawSemaphoreCI.flags = 0;
@@ -498,6 +881,39 @@ crvkImage::Destroy
 */
 void crvkImageStatic::Destroy( void )
 {
+    if ( m_imageHandle == nullptr )
+        return;
+
+    crvkDeletionQueue* deletion = m_device != nullptr ? m_device->DeletionQueue() : nullptr;
+    crvkTimelinePoint_t lastUse[crvkDeletionQueue::k_maxPoints];
+    uint32_t lastUseCount = LastUse( lastUse );
+
+    // the semaphores and command buffer can still be in use by the GPU, 
+    // send them to the deletion queue with the image 
+    if ( deletion != nullptr )
+    {
+        if ( m_useSemaphore != nullptr )
+            deletion->Enqueue( VK_OBJECT_TYPE_SEMAPHORE, reinterpret_cast<uint64_t>( m_useSemaphore ), lastUse, lastUseCount );
+
+        if ( m_copySemaphore != nullptr )
+            deletion->Enqueue( VK_OBJECT_TYPE_SEMAPHORE, reinterpret_cast<uint64_t>( m_copySemaphore ), lastUse, lastUseCount );
+
+        if ( m_commandBuffer != nullptr )
+            deletion->Enqueue( VK_OBJECT_TYPE_COMMAND_BUFFER, reinterpret_cast<uint64_t>( m_commandBuffer ), lastUse, lastUseCount, reinterpret_cast<uint64_t>( m_commandPool ) );
+
+        for ( uint32_t i = 0; i < k_copyCommandBuffers; i++ )
+        {
+            if ( m_copyCommandBuffers[i] != nullptr )
+                deletion->Enqueue( VK_OBJECT_TYPE_COMMAND_BUFFER, reinterpret_cast<uint64_t>( m_copyCommandBuffers[i] ), lastUse, lastUseCount, reinterpret_cast<uint64_t>( m_commandPool ) );
+
+            m_copyCommandBuffers[i] = nullptr;
+        }
+
+        m_useSemaphore = nullptr;
+        m_copySemaphore = nullptr;
+        m_commandBuffer = nullptr;
+    }
+
     if ( m_useSemaphore != nullptr )
     {
         vkDestroySemaphore( m_imageHandle->device, m_useSemaphore, k_allocationCallbacks );
@@ -517,7 +933,62 @@ void crvkImageStatic::Destroy( void )
         m_commandBuffer = nullptr;
     }
 
-    crvkImage::Destroy();
+    if ( m_copyCommandBuffers[0] != nullptr )
+    {
+        vkFreeCommandBuffers( m_imageHandle->device, m_commandPool, k_copyCommandBuffers, m_copyCommandBuffers );
+        std::memset( m_copyCommandBuffers, 0, sizeof( m_copyCommandBuffers ) );
+    }
+
+    m_lastCopySemaphore = nullptr;
+    crvkImage::Release( lastUse, lastUseCount );
+}
+
+/*
+==============================================
+crvkImageStatic::LastUse
+==============================================
+*/
+uint32_t crvkImageStatic::LastUse( crvkTimelinePoint_t* out_points ) const
+{
+    uint32_t count = crvkImage::LastUse( out_points );
+    
+    if ( m_useSemaphore != nullptr )
+        out_points[count++] = crvkTimelinePoint_t{ m_useSemaphore, m_useValue };
+
+    if ( m_copySemaphore != nullptr )
+        out_points[count++] = crvkTimelinePoint_t{ m_copySemaphore, m_copyValue };
+    
+    // the last copy can be from a upload batch semaphore 
+    if ( m_lastCopySemaphore != nullptr && m_lastCopySemaphore != m_copySemaphore )
+        out_points[count++] = crvkTimelinePoint_t{ m_lastCopySemaphore, m_lastCopyValue };
+    
+    return count;
+}
+
+/*
+==============================================
+crvkImageStatic::NextCopyCommand
+==============================================
+*/
+VkResult crvkImageStatic::NextCopyCommand( crvkDeviceQueue* in_queue )
+{
+    uint64_t value = 0;
+    VkResult result = VK_SUCCESS;
+    m_copyCommand = ( m_copyCommand + 1 ) % k_copyCommandBuffers;
+
+    result = vkGetSemaphoreCounterValue( m_imageHandle->device, m_copySemaphore, &value );
+    if ( result != VK_SUCCESS || value >= m_copyCommandValues[m_copyCommand] )
+        return result;
+
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_copySemaphore;
+    waitInfo.pValues = &m_copyCommandValues[m_copyCommand];
+
+    // the copy can be still queued in a deferred queue 
+    in_queue->Flush();
+    return vkWaitSemaphores( m_imageHandle->device, &waitInfo, UINT64_MAX );
 }
 
 /*
@@ -528,11 +999,25 @@ crvkImage::CopyFromBuffer
 bool crvkImageStatic::CopyFromBuffer( const VkBuffer in_srcBuffer, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count )
 {
     VkResult result = VK_SUCCESS;
-    VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_NONE;
     crvkDeviceQueue* queue = nullptr;
 
+    // the copy queue, the touched subresources are acquired by his family 
+    if ( m_device->HasTransferQueue() )
+        queue = m_device->GetQueue( CRVK_DEVICE_QUEUE_TRANSFER );
+    else
+        queue = m_device->GetQueue( CRVK_DEVICE_QUEUE_GRAPHICS );       
+
+    // the command buffer can't be reset while his copy is pending, but the other copies can be 
+    result = NextCopyCommand( queue );
+    if (result != VK_SUCCESS) 
+    {
+        crvkAppendError("crvkImageStatic::CopyFromBuffer::vkWaitSemaphores", result );
+        return false;
+    }
+
     // reset the command buffer 
-    result = vkResetCommandBuffer( m_commandBuffer, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT );
+    VkCommandBuffer commandBuffer = m_copyCommandBuffers[m_copyCommand];
+    result = vkResetCommandBuffer( commandBuffer, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT );
     if (result != VK_SUCCESS) 
     {
         crvkAppendError("crvkImageStatic::CopyFromBuffer::vkResetCommandBuffer", result );
@@ -543,21 +1028,23 @@ bool crvkImageStatic::CopyFromBuffer( const VkBuffer in_srcBuffer, const VkBuffe
     VkCommandBufferBeginInfo beginInfo = {};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    result = vkBeginCommandBuffer( m_commandBuffer, &beginInfo );
+    result = vkBeginCommandBuffer( commandBuffer, &beginInfo );
     if (result != VK_SUCCESS) 
     {
         crvkAppendError("crvkImageStatic::CopyFromBuffer::vkBeginCommandBuffer", result );
         return false;
     }
 
-    // get the ranges
+    // only the subresources touched by the copy change state, the others keep the current use 
+    crvkBarrierBatch barriers;
+    barriers.Begin( commandBuffer );
     for (uint32_t i = 0; i < in_count; ++i) 
     {
-        aspectMask |= in_copyRegions[i].imageSubresource.aspectMask;
+        const VkImageSubresourceLayers& subresource = in_copyRegions[i].imageSubresource;
+        VkImageSubresourceRange range{ subresource.aspectMask, subresource.mipLevel, 1, subresource.baseArrayLayer, subresource.layerCount };
+        crvkImage::StateTransition( &barriers, CRVK_IMAGE_STATE_GPU_COPY_DST, &range, queue->Family() );
     }
-
-    // Layout transition UNDEFINED → TRANSFER_DST_OPTIMAL
-    StateTransition( m_commandBuffer, CRVK_IMAGE_STATE_GPU_COPY_DST, aspectMask, VK_QUEUE_FAMILY_IGNORED );
+    barriers.Flush();
 
     // stream from buffer to the image
     VkCopyBufferToImageInfo2 copyBufferToImage{};
@@ -565,13 +1052,13 @@ bool crvkImageStatic::CopyFromBuffer( const VkBuffer in_srcBuffer, const VkBuffe
     copyBufferToImage.pNext = nullptr;
     copyBufferToImage.srcBuffer = in_srcBuffer;
     copyBufferToImage.dstImage = m_imageHandle->image;
-    copyBufferToImage.dstImageLayout = m_imageHandle->layout;
+    copyBufferToImage.dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
     copyBufferToImage.regionCount = in_count;
     copyBufferToImage.pRegions = in_copyRegions;
-    vkCmdCopyBufferToImage2( m_commandBuffer, &copyBufferToImage );
+    vkCmdCopyBufferToImage2( commandBuffer, &copyBufferToImage );
 
     // finish state transiotion and copy commands
-    vkEndCommandBuffer( m_commandBuffer );
+    vkEndCommandBuffer( commandBuffer );
 
     // Wait for the last copy to finish, or buffer to be released  
     VkSemaphoreSubmitInfo waitInfo[2] = 
@@ -583,15 +1070,13 @@ bool crvkImageStatic::CopyFromBuffer( const VkBuffer in_srcBuffer, const VkBuffe
     // signal to GPU to wait for the copy end before use
     VkSemaphoreSubmitInfo signalInfo = SignalLastCopy();
 
+    // the command buffer is free again once this value is reached 
+    m_copyCommandValues[m_copyCommand] = m_copyValue;
+
     VkCommandBufferSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
-    submitInfo.commandBuffer = m_commandBuffer;
+    submitInfo.commandBuffer = commandBuffer;
     submitInfo.pNext = nullptr;
-    
-    if ( m_device->HasTransferQueue() )
-        queue = m_device->GetQueue( CRVK_DEVICE_QUEUE_TRANSFER );
-    else
-        queue = m_device->GetQueue( CRVK_DEVICE_QUEUE_GRAPHICS );       
 
     result = queue->Submit( waitInfo, 2, &submitInfo, 1, &signalInfo, 1, nullptr );
     if( result != VK_SUCCESS )
@@ -608,14 +1093,28 @@ bool crvkImageStatic::CopyFromBuffer( const VkBuffer in_srcBuffer, const VkBuffe
 crvkImage::CopyToBuffer
 ==============================================
 */
-bool crvkImageStatic::CopyToBuffer( const VkBuffer in_dstBuffer, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count )
+bool crvkImageStatic::CopyToBuffer( const VkBuffer in_dstBuffer, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count, crvkTimelinePoint_t* out_readback )
 {
     VkResult result = VK_SUCCESS;
-    VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_NONE;
     crvkDeviceQueue* queue = nullptr;
+
+    // the copy queue, the touched subresources are acquired by his family 
+    if ( m_device->HasTransferQueue() )
+        queue = m_device->GetQueue( CRVK_DEVICE_QUEUE_TRANSFER );
+    else
+        queue = m_device->GetQueue( CRVK_DEVICE_QUEUE_GRAPHICS );       
     
+    // the command buffer can't be reset while his copy is pending, but the other copies can be 
+    result = NextCopyCommand( queue );
+    if (result != VK_SUCCESS) 
+    {
+        crvkAppendError("crvkImageStatic::CopyToBuffer::vkWaitSemaphores", result );
+        return false;
+    }
+
     // reset the command buffer 
-    result = vkResetCommandBuffer( m_commandBuffer, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT );
+    VkCommandBuffer commandBuffer = m_copyCommandBuffers[m_copyCommand];
+    result = vkResetCommandBuffer( commandBuffer, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT );
     if (result != VK_SUCCESS) 
     {
         crvkAppendError("crvkImageStatic::CopyToBuffer::vkResetCommandBuffer", result );
@@ -626,29 +1125,53 @@ bool crvkImageStatic::CopyToBuffer( const VkBuffer in_dstBuffer, const VkBufferI
     VkCommandBufferBeginInfo beginInfo = {};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    result = vkBeginCommandBuffer( m_commandBuffer, &beginInfo );
+    result = vkBeginCommandBuffer( commandBuffer, &beginInfo );
     if (result != VK_SUCCESS) 
     {
         crvkAppendError("crvkImageStatic::CopyToBuffer::vkBeginCommandBuffer", result );
         return false;
     }
  
-    // Layout transition UNDEFINED → TRANSFER_SRC_OPTIMAL
-    StateTransition( m_commandBuffer, CRVK_IMAGE_STATE_GPU_COPY_SRC, aspectMask, VK_QUEUE_FAMILY_IGNORED );
+    // only the subresources touched by the copy change state, the others keep the current use 
+    crvkBarrierBatch barriers;
+    barriers.Begin( commandBuffer );
+    for (uint32_t i = 0; i < in_count; ++i) 
+    {
+        const VkImageSubresourceLayers& subresource = in_copyRegions[i].imageSubresource;
+        VkImageSubresourceRange range{ subresource.aspectMask, subresource.mipLevel, 1, subresource.baseArrayLayer, subresource.layerCount };
+        crvkImage::StateTransition( &barriers, CRVK_IMAGE_STATE_GPU_COPY_SRC, &range, queue->Family() );
+    }
+    barriers.Flush();
 
     // copy from image to buffer
     VkCopyImageToBufferInfo2 copyImageToBuffer{};
     copyImageToBuffer.sType = VK_STRUCTURE_TYPE_COPY_IMAGE_TO_BUFFER_INFO_2;
     copyImageToBuffer.pNext = nullptr;
     copyImageToBuffer.srcImage = m_imageHandle->image;
-    copyImageToBuffer.srcImageLayout = m_imageHandle->layout;
+    copyImageToBuffer.srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
     copyImageToBuffer.dstBuffer = in_dstBuffer;
     copyImageToBuffer.regionCount = in_count;
     copyImageToBuffer.pRegions = in_copyRegions;
-    vkCmdCopyImageToBuffer2( m_commandBuffer, &copyImageToBuffer );
+    vkCmdCopyImageToBuffer2( commandBuffer, &copyImageToBuffer );
+
+    // the buffer is read by the CPU, the timeline wait alone don't make the copy visible to the host, 
+    // the regions size depend on the texel size, so the whole buffer is made visible 
+    VkBufferMemoryBarrier2 hostBarrier{};
+    hostBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    hostBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    hostBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    hostBarrier.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+    hostBarrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+    hostBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hostBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hostBarrier.buffer = in_dstBuffer;
+    hostBarrier.offset = 0;
+    hostBarrier.size = VK_WHOLE_SIZE;
+    barriers.Buffer( &hostBarrier );
+    barriers.Flush();
 
     // finish state transiotion and copy commands
-    vkEndCommandBuffer( m_commandBuffer );
+    vkEndCommandBuffer( commandBuffer );
 
     // Wait for the last copy to finish, or buffer to be released  
     VkSemaphoreSubmitInfo waitInfo[2] = 
@@ -660,23 +1183,42 @@ bool crvkImageStatic::CopyToBuffer( const VkBuffer in_dstBuffer, const VkBufferI
     // signal to GPU to wait for the copy end before use
     VkSemaphoreSubmitInfo signalInfo = SignalLastCopy();
 
+    // the command buffer is free again once this value is reached 
+    m_copyCommandValues[m_copyCommand] = m_copyValue;
+
     VkCommandBufferSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
-    submitInfo.commandBuffer = m_commandBuffer;
+    submitInfo.commandBuffer = commandBuffer;
     submitInfo.pNext = nullptr;
-    
-    if ( m_device->HasTransferQueue() )
-        queue = m_device->GetQueue( CRVK_DEVICE_QUEUE_TRANSFER );
+
+    if ( out_readback != nullptr )
+    {
+        // the read back queue wait on the ring timeline, this image can be released before the delivery 
+        VkSubmitInfo2 submit{};
+        submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        submit.waitSemaphoreInfoCount = 2;
+        submit.pWaitSemaphoreInfos = waitInfo;
+        submit.commandBufferInfoCount = 1;
+        submit.pCommandBufferInfos = &submitInfo;
+        submit.signalSemaphoreInfoCount = 1;
+        submit.pSignalSemaphoreInfos = &signalInfo;
+        out_readback->semaphore = m_device->ReadbackManager()->Semaphore( queue );
+        result = m_device->ReadbackManager()->Submit( queue, &submit, nullptr, 0, &out_readback->value );
+    }
     else
-        queue = m_device->GetQueue( CRVK_DEVICE_QUEUE_GRAPHICS );       
+        result = queue->Submit( waitInfo, 2, &submitInfo, 1, &signalInfo, 1, nullptr );
 
-    result = queue->Submit( waitInfo, 2, &submitInfo, 1, &signalInfo, 1, nullptr );
     if( result != VK_SUCCESS )
     {
         crvkAppendError( "crvkBufferStaging::SubData::vkQueueSubmit2", result );
         return false;
     }
 
+    // a read back, the CPU is going to wait for it 
+    result = queue->Flush();
+    if( result != VK_SUCCESS )
+        return false;
+
     return true;
 }
 
@@ -690,6 +1232,62 @@ void crvkImageStatic::StateTransition( const VkCommandBuffer in_commandBuffer, c
     crvkImage::StateTransition( m_commandBuffer, in_state, in_aspect, in_dstQueue );
 }
 
+/*
+==============================================
+crvkImageStatic::SignalLastUse
+==============================================
+*/
+VkSemaphoreSubmitInfo crvkImageStatic::SignalLastUse( void )
+{
+    VkSemaphoreSubmitInfo useSignal{ VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, m_useSemaphore, ++m_useValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, 0 };
+    return useSignal;
+}
+
+/*
+==============================================
+crvkImageStatic::SignalLastCopy
+==============================================
+*/
+VkSemaphoreSubmitInfo crvkImageStatic::SignalLastCopy( void )
+{
+    VkSemaphoreSubmitInfo copySignal{ VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, m_copySemaphore, ++m_copyValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, 0 };
+    SetLastCopy( m_copySemaphore, m_copyValue );
+    return copySignal;
+}
+
+/*
+==============================================
+crvkImageStatic::WaitLastUse
+==============================================
+*/
+VkSemaphoreSubmitInfo crvkImageStatic::WaitLastUse( void )
+{
+    VkSemaphoreSubmitInfo waitUse{ VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, m_useSemaphore, m_useValue - 1, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, 0 }; // wait finish last render 
+    return waitUse;
+}
+
+/*
+==============================================
+crvkImageStatic::WaitLastCopy
+==============================================
+*/
+VkSemaphoreSubmitInfo crvkImageStatic::WaitLastCopy( void )
+{
+    VkSemaphoreSubmitInfo waitCopy{ VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, m_lastCopySemaphore, m_lastCopyValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, 0 }; // wait finish last copy
+    return waitCopy;
+}
+
+/*
+==============================================
+crvkImageStatic::SetLastCopy
+==============================================
+*/
+void crvkImageStatic::SetLastCopy( const VkSemaphore in_semaphore, const uint64_t in_value )
+{
+    m_lastCopySemaphore = in_semaphore;
+    m_lastCopyValue = in_value;
+}
+
 //=======================================================================================================================
 
 /*
@@ -758,6 +1356,24 @@ crvkImageStaging::crvkImageStaging
 */
 void crvkImageStaging::Destroy(void)
 {
+    crvkDeletionQueue* deletion = m_device != nullptr ? m_device->DeletionQueue() : nullptr;
+    crvkTimelinePoint_t lastUse[crvkDeletionQueue::k_maxPoints];
+    uint32_t lastUseCount = 0;
+    
+    // the staging buffer wait the same copies of the image 
+    if ( deletion != nullptr && m_imageHandle != nullptr )
+    {
+        lastUseCount = LastUse( lastUse );
+        if ( m_staging != nullptr )
+            deletion->Enqueue( VK_OBJECT_TYPE_BUFFER, reinterpret_cast<uint64_t>( m_staging ), lastUse, lastUseCount );
+
+        if ( m_memoryStaging != nullptr )
+            deletion->Enqueue( VK_OBJECT_TYPE_DEVICE_MEMORY, reinterpret_cast<uint64_t>( m_memoryStaging ), lastUse, lastUseCount );
+
+        m_staging = nullptr;
+        m_memoryStaging = nullptr;
+    }
+
     if( m_staging != nullptr )
     {
         vkDestroyBuffer( m_imageHandle->device, m_staging, k_allocationCallbacks );
@@ -834,43 +1450,113 @@ crvkImageStaging::GetSubData
 */
 bool crvkImageStaging::GetSubData( void* in_data, const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count )
 {
-    VkResult result = VK_SUCCESS;
-    VkDeviceSize offset = UINT64_MAX;
+    VkDeviceSize begin = 0;
+    VkDeviceSize offset = 0;
     VkDeviceSize size = 0;
-    uint64_t pixelCount = 0;
-    crvkFormat_t internalFormat = crvkFormat_t( m_imageHandle->format ); 
-    void* buff = nullptr;
+    crvkUploadManager* readback = m_device->ReadbackManager();
+    crvkStagingRange_t range{};
 
-    // we need to calc the current source size
-    for ( uint32_t i = 0; i < in_count; i++)
+    if ( !ReadbackCopy( in_copyRegions, in_count, &range, &begin, &offset, &size ) )
+        return false;
+
+    // wait for device end copy the image 
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_copySemaphore;
+    waitInfo.pValues = &m_copyValue;
+    VkResult result = vkWaitSemaphores( m_imageHandle->device, &waitInfo, UINT64_MAX );
+    if ( result != VK_SUCCESS )
     {
-        auto r = in_copyRegions[i];
-        // get the minor offset 
-        offset = std::min( r.bufferOffset, offset );
-        uint32_t w = std::min( r.imageExtent.width, 1u );
-        uint32_t h = std::min( r.imageExtent.height, 1u );
-        uint32_t d = std::min( r.imageExtent.depth, 1u );
-        pixelCount += ( w * h * d );  
+        crvkAppendError( "crvkImageStaging::GetSubData::vkWaitSemaphores", result );
+        readback->Release( &range );
+        return false;
     }
-    
+
+    // copy the content of the ring to the data pointer, non coherent memory need a invalidate 
+    readback->Invalidate( &range );
+    std::memcpy( static_cast<uint8_t*>( in_data ) + begin, static_cast<uint8_t*>( range.pointer ) + offset, size );
+    readback->Release( &range );
+    return true;
+}
+
+/*
+==============================================
+crvkImageStaging::GetSubDataAsync
+==============================================
+*/
+crvkReadbackTicket_t crvkImageStaging::GetSubDataAsync( const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count, crvkReadbackCallback_t in_callback, void* in_userData )
+{
+    VkDeviceSize begin = 0;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+    crvkStagingRange_t range{};
+    crvkTimelinePoint_t copyEnd{};
+
+    // CopyToBuffer already flushed the queue 
+    if ( !ReadbackCopy( in_copyRegions, in_count, &range, &begin, &offset, &size, &copyEnd ) )
+        return 0;
+
+    return m_device->ReadbackQueue()->Enqueue( &range, offset, size, &copyEnd, nullptr, in_callback, in_userData );
+}
+
+/*
+==============================================
+crvkImageStaging::ReadbackCopy
+==============================================
+*/
+bool crvkImageStaging::ReadbackCopy( const VkBufferImageCopy2* in_copyRegions, const uint32_t in_count, crvkStagingRange_t* out_range, VkDeviceSize* out_begin, VkDeviceSize* out_offset, VkDeviceSize* out_size, crvkTimelinePoint_t* out_readback )
+{
+    VkDeviceSize begin = UINT64_MAX;
+    VkDeviceSize end = 0;
+    crvkFormat_t internalFormat = crvkFormat_t( m_imageHandle->format ); 
+    VkDeviceSize texelSize = internalFormat.BytesPerPixel();
+    crvkUploadManager* readback = m_device->ReadbackManager();
+    crvkDynamicVector<VkBufferImageCopy2> regions;
+
     if ( internalFormat.IsCompressed() )
     {
         // TODO: get the number blocks
+        return false;
+    }
 
+    // the bytes of the data pointer touched by the copy 
+    for ( uint32_t i = 0; i < in_count; i++)
+    {
+        const VkBufferImageCopy2& r = in_copyRegions[i];
+        uint32_t rowLength = r.bufferRowLength != 0 ? r.bufferRowLength : r.imageExtent.width;
+        uint32_t imageHeight = r.bufferImageHeight != 0 ? r.bufferImageHeight : r.imageExtent.height;
+        uint64_t slices = uint64_t( r.imageExtent.depth ) * r.imageSubresource.layerCount;
+        uint64_t texels = uint64_t( rowLength ) * imageHeight * ( slices - 1 ) + uint64_t( rowLength ) * ( r.imageExtent.height - 1 ) + r.imageExtent.width;
+        begin = std::min( r.bufferOffset, begin );
+        end = std::max( r.bufferOffset + texels * texelSize, end );
     }
-    else
-        size = pixelCount * internalFormat.BytesPerPixel(); // get the uncompressed image size
-   
-    // now we copy from image to the buffer
-    if( !CopyToBuffer( m_staging, in_copyRegions, in_count ) )
+
+    if ( in_count == 0 || end <= begin )
         return false;
 
-    // wait for device end copy the image 
-    VkSemaphoreWaitInfo smWaitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO, nullptr, 0, 1, &m_copySemaphore }; 
-    vkWaitSemaphores( m_imageHandle->device, &smWaitInfo, UINT64_MAX );
+    // a CPU cached range, the buffer offsets must be a multiple of the texel size and of 4
+    VkDeviceSize block = texelSize * 4;
+    if ( !readback->Allocate( end - begin + block, 4, out_range ) )
+        return false;
 
-    // copy the content of the CPU buffer to the data pointer
-    vkMapMemory( m_imageHandle->device, m_memoryStaging, offset, size, 0, &buff );
-    std::memcpy( in_data, buff, size );
-    vkUnmapMemory( m_imageHandle->device, m_memoryStaging ); 
+    VkDeviceSize base = ( ( out_range->offset + block - 1 ) / block ) * block;
+    regions.Resize( in_count );
+    for ( uint32_t i = 0; i < in_count; i++ )
+    {
+        regions[i] = in_copyRegions[i];
+        regions[i].bufferOffset = base + ( in_copyRegions[i].bufferOffset - begin );
+    }
+
+    // now we copy from image to the read back ring
+    if( !CopyToBuffer( out_range->buffer, regions.Pointer(), in_count, out_readback ) )
+    {
+        readback->Release( out_range );
+        return false;
+    }
+
+    *out_begin = begin;
+    *out_offset = base - out_range->offset;
+    *out_size = end - begin;
+    return true;
 }
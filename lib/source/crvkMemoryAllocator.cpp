@@ -0,0 +1,451 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+#include "crvkPrecompiled.hpp"
+#include "crvkMemoryAllocator.hpp"
+
+static const VkDeviceSize   k_minAlignment = crvkRangeAllocator::k_minAlignment;   // every range start aligned to this
+static const VkDeviceSize   k_defaultBlockSize = 256ull * 1024ull * 1024ull;    // 256MB memory blocks 
+static const VkDeviceSize   k_minBlockSize = 4ull * 1024ull * 1024ull;          // small heaps don't go under 4MB blocks
+
+typedef struct crvkMemoryBlock_t
+{
+    bool                                linear = true;                  // hold buffers and linear images 
+    bool                                dedicated = false;              // hold a single allocation 
+    bool                                coherent = true;                // host coherent, or not host visible at all 
+    uint32_t                            type = UINT32_MAX;              // memory type index
+    VkDeviceSize                        size = 0;                       // block size 
+    void*                               mapped = nullptr;               // CPU memory address, mapped for the block life 
+    VkDeviceMemory                      memory = nullptr;               // device memory handle 
+    crvkMemoryBlock_t*                  next = nullptr;                 // next block in the pool 
+    crvkRangeAllocator                  ranges;                         // TLSF ranges of the block 
+} crvkMemoryBlock_t;
+
+typedef struct crvkMemoryAllocatorHandle_t
+{
+    uint64_t                            totalAllocations = 0;
+    uint64_t                            totalFrees = 0;
+    VkDeviceSize                        blockSize[VK_MAX_MEMORY_TYPES];
+    VkDeviceSize                        atomSize = 1;                   // non coherent flush alignment 
+    crvkMemoryBlock_t*                  pools[VK_MAX_MEMORY_TYPES][2];  // block lists, by [memory type][linear]
+    VkPhysicalDeviceMemoryProperties    memoryProperties;
+    VkDevice                            device = nullptr;
+    std::mutex                          lock;
+} crvkMemoryAllocatorHandle_t;
+
+static inline VkDeviceSize AlignUp( const VkDeviceSize in_value, const VkDeviceSize in_alignment )
+{
+    return ( in_value + in_alignment - 1 ) & ~( in_alignment - 1 );
+}
+
+/*
+==============================================
+crvkMemoryAllocator::crvkMemoryAllocator
+==============================================
+*/
+crvkMemoryAllocator::crvkMemoryAllocator( void ) : m_handle( nullptr )
+{
+}
+
+/*
+==============================================
+crvkMemoryAllocator::~crvkMemoryAllocator
+==============================================
+*/
+crvkMemoryAllocator::~crvkMemoryAllocator( void )
+{
+    Destroy();
+}
+
+/*
+==============================================
+crvkMemoryAllocator::Create
+==============================================
+*/
+bool crvkMemoryAllocator::Create( const VkDevice in_device, const VkPhysicalDeviceMemoryProperties* in_memoryProperties, const VkDeviceSize in_nonCoherentAtomSize, const VkDeviceSize in_blockSize )
+{
+    VkDeviceSize blockSize = ( in_blockSize != 0 ) ? in_blockSize : k_defaultBlockSize;
+    
+    m_handle = new crvkMemoryAllocatorHandle_t();
+    m_handle->device = in_device;
+    m_handle->atomSize = std::max( in_nonCoherentAtomSize, (VkDeviceSize)1 );
+    m_handle->memoryProperties = *in_memoryProperties;
+    std::memset( m_handle->pools, 0x00, sizeof( m_handle->pools ) );
+
+    // don't let a block take more than 1/8 of a small heap 
+    for ( uint32_t i = 0; i < VK_MAX_MEMORY_TYPES; i++ )
+    {
+        m_handle->blockSize[i] = blockSize;
+        if ( i >= m_handle->memoryProperties.memoryTypeCount )
+            continue;
+        
+        VkDeviceSize heapSize = m_handle->memoryProperties.memoryHeaps[m_handle->memoryProperties.memoryTypes[i].heapIndex].size;
+        m_handle->blockSize[i] = AlignUp( std::max( std::min( blockSize, heapSize / 8 ), k_minBlockSize ), k_minAlignment );
+    }
+
+    return true;
+}
+
+/*
+==============================================
+crvkMemoryAllocator::Destroy
+==============================================
+*/
+void crvkMemoryAllocator::Destroy( void )
+{
+    if ( m_handle == nullptr )
+        return;
+
+    for ( uint32_t i = 0; i < VK_MAX_MEMORY_TYPES; i++ )
+    {
+        for ( uint32_t j = 0; j < 2; j++ )
+        {
+            crvkMemoryBlock_t* block = m_handle->pools[i][j];
+            while ( block != nullptr )
+            {
+                crvkMemoryBlock_t* next = block->next;
+                if ( block->mapped != nullptr )
+                    vkUnmapMemory( m_handle->device, block->memory );
+                
+                vkFreeMemory( m_handle->device, block->memory, k_allocationCallbacks );
+                delete block;
+                block = next;
+            }
+
+            m_handle->pools[i][j] = nullptr;
+        }
+    }
+
+    delete m_handle;
+    m_handle = nullptr;
+}
+
+/*
+==============================================
+AllocateFromType
+==============================================
+*/
+static VkResult AllocateFromType( crvkMemoryAllocatorHandle_t* in_handle, const uint32_t in_type, const VkDeviceSize in_size, const VkDeviceSize in_alignment, const bool in_linear, crvkMemoryAllocation_t* out_allocation )
+{
+    VkResult result = VK_SUCCESS;
+    uint32_t node = crvkRangeAllocator::k_invalidRange;
+    crvkMemoryBlock_t* block = nullptr;
+    crvkMemoryBlock_t** pool = &in_handle->pools[in_type][in_linear ? 1 : 0];
+    bool dedicated = in_size > in_handle->blockSize[in_type] / 2; // big resources get his own block 
+
+    // try to fit in one of the current blocks
+    if ( !dedicated )
+    {
+        for ( block = *pool; block != nullptr; block = block->next )
+        {
+            if ( !block->dedicated && block->ranges.Allocate( in_size, in_alignment, &node ) )
+                break;
+        }
+    }
+
+    // create a new block 
+    if ( block == nullptr )
+    {
+        block = new crvkMemoryBlock_t();
+        block->type = in_type;
+        block->linear = in_linear;
+        block->dedicated = dedicated;
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = dedicated ? in_size : in_handle->blockSize[in_type];
+        allocInfo.memoryTypeIndex = in_type;
+        result = vkAllocateMemory( in_handle->device, &allocInfo, k_allocationCallbacks, &block->memory );
+        
+        // out of memory for a full block, try to allocate only what we need
+        if ( result != VK_SUCCESS && !dedicated )
+        {
+            block->dedicated = true;
+            allocInfo.allocationSize = in_size;
+            result = vkAllocateMemory( in_handle->device, &allocInfo, k_allocationCallbacks, &block->memory );
+        }
+        
+        // out of device memory, the caller try the other memory types 
+        if ( result != VK_SUCCESS )
+        {
+            delete block;
+            if ( result != VK_ERROR_OUT_OF_DEVICE_MEMORY )
+                crvkAppendError( "crvkMemoryAllocator::Allocate::vkAllocateMemory", result );
+
+            return result;
+        }
+
+        // host visible blocks are mapped once, and stay mapped until released 
+        VkMemoryPropertyFlags flags = in_handle->memoryProperties.memoryTypes[in_type].propertyFlags;
+        if ( flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT )
+        {
+            block->coherent = ( flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT ) != 0;
+            result = vkMapMemory( in_handle->device, block->memory, 0, VK_WHOLE_SIZE, 0, &block->mapped );
+            if ( result != VK_SUCCESS )
+            {
+                vkFreeMemory( in_handle->device, block->memory, k_allocationCallbacks );
+                delete block;
+                crvkAppendError( "crvkMemoryAllocator::Allocate::vkMapMemory", result );
+                return result;
+            }
+        }
+
+        // a empty block place the range at offset 0, that is aligned to anything, so a dedicated block always fit 
+        block->size = allocInfo.allocationSize;
+        if ( !block->ranges.Create( block->size ) || !block->ranges.Allocate( in_size, in_alignment, &node ) )
+        {
+            if ( block->mapped != nullptr )
+                vkUnmapMemory( in_handle->device, block->memory );
+
+            vkFreeMemory( in_handle->device, block->memory, k_allocationCallbacks );
+            delete block;
+            crvkAppendError( "crvkMemoryAllocator::Allocate::BlockAllocate", VK_ERROR_OUT_OF_HOST_MEMORY );
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+
+        block->next = *pool;
+        *pool = block;
+    }
+
+    in_handle->totalAllocations++;
+    out_allocation->memory = block->memory;
+    out_allocation->offset = block->ranges.Offset( node );
+    out_allocation->size = in_size;
+    out_allocation->type = in_type;
+    out_allocation->node = node;
+    out_allocation->mapped = ( block->mapped != nullptr ) ? static_cast<uint8_t*>( block->mapped ) + out_allocation->offset : nullptr;
+    out_allocation->block = block;
+    return VK_SUCCESS;
+}
+
+/*
+==============================================
+crvkMemoryAllocator::Allocate
+==============================================
+*/
+bool crvkMemoryAllocator::Allocate( const VkMemoryRequirements &in_requirements, const VkMemoryPropertyFlags in_flags, const bool in_linear, crvkMemoryAllocation_t* out_allocation )
+{
+    VkResult result = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    bool found = false;
+    VkDeviceSize size = AlignUp( in_requirements.size, k_minAlignment );
+    VkDeviceSize alignment = std::max( in_requirements.alignment, k_minAlignment );
+    
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+
+    // the types are in the driver preference order, a full heap fall back to the next matching type 
+    for ( uint32_t i = 0; i < m_handle->memoryProperties.memoryTypeCount; i++ )
+    {
+        if ( !( in_requirements.memoryTypeBits & ( 1u << i ) ) || ( m_handle->memoryProperties.memoryTypes[i].propertyFlags & in_flags ) != in_flags )
+            continue;
+
+        found = true;
+        result = AllocateFromType( m_handle, i, size, alignment, in_linear, out_allocation );
+        if ( result != VK_ERROR_OUT_OF_DEVICE_MEMORY )
+            break;
+    }
+
+    if ( !found )
+    {
+        crvkAppendError( "crvkMemoryAllocator::Allocate::FindMemoryType", VK_ERROR_OUT_OF_DEVICE_MEMORY );
+        return false;
+    }
+
+    if ( result == VK_ERROR_OUT_OF_DEVICE_MEMORY )
+        crvkAppendError( "crvkMemoryAllocator::Allocate::vkAllocateMemory", result );
+
+    return result == VK_SUCCESS;
+}
+
+/*
+==============================================
+crvkMemoryAllocator::Free
+==============================================
+*/
+void crvkMemoryAllocator::Free( crvkMemoryAllocation_t* in_allocation )
+{
+    if ( m_handle == nullptr || in_allocation == nullptr || in_allocation->block == nullptr )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    crvkMemoryBlock_t* block = in_allocation->block;
+    crvkMemoryBlock_t** pool = &m_handle->pools[block->type][block->linear ? 1 : 0];
+    
+    block->ranges.Free( in_allocation->node );
+    m_handle->totalFrees++;
+    *in_allocation = crvkMemoryAllocation_t();
+
+    // release empty blocks, but keep one around to avoid allocation thrashing 
+    if ( block->ranges.AllocationCount() == 0 && ( block->dedicated || *pool != block || block->next != nullptr ) )
+    {
+        crvkMemoryBlock_t** link = pool;
+        while ( *link != block )
+            link = &( *link )->next;
+
+        *link = block->next;
+        if ( block->mapped != nullptr )
+            vkUnmapMemory( m_handle->device, block->memory );
+
+        vkFreeMemory( m_handle->device, block->memory, k_allocationCallbacks );
+        delete block;
+    }
+}
+
+/*
+==============================================
+crvkMemoryAllocator::Map
+==============================================
+*/
+void* crvkMemoryAllocator::Map( const crvkMemoryAllocation_t* in_allocation ) const
+{
+    if ( in_allocation == nullptr )
+        return nullptr;
+    
+    // the block was mapped at creation, no need to lock or call the driver 
+    return in_allocation->mapped;
+}
+
+/*
+==============================================
+crvkMemoryAllocator::Unmap
+==============================================
+*/
+void crvkMemoryAllocator::Unmap( const crvkMemoryAllocation_t* in_allocation ) const
+{
+    // the block mapping is released with the block
+}
+
+/*
+==============================================
+crvkMemoryAllocator::Flush
+==============================================
+*/
+VkResult crvkMemoryAllocator::Flush( const crvkMemoryAllocation_t* in_allocation, const VkDeviceSize in_offset, const VkDeviceSize in_size ) const
+{
+    VkResult result = VK_SUCCESS;
+    VkMappedMemoryRange range{};
+    
+    if ( m_handle == nullptr || in_allocation == nullptr || in_allocation->block == nullptr || in_allocation->block->coherent )
+        return VK_SUCCESS;
+
+    MappedRange( in_allocation, in_offset, in_size, &range );
+    result = vkFlushMappedMemoryRanges( m_handle->device, 1, &range );
+    if ( result != VK_SUCCESS )
+        crvkAppendError( "crvkMemoryAllocator::Flush::vkFlushMappedMemoryRanges", result );
+        
+    return result;
+}
+
+/*
+==============================================
+crvkMemoryAllocator::Invalidate
+==============================================
+*/
+VkResult crvkMemoryAllocator::Invalidate( const crvkMemoryAllocation_t* in_allocation, const VkDeviceSize in_offset, const VkDeviceSize in_size ) const
+{
+    VkResult result = VK_SUCCESS;
+    VkMappedMemoryRange range{};
+    
+    if ( m_handle == nullptr || in_allocation == nullptr || in_allocation->block == nullptr || in_allocation->block->coherent )
+        return VK_SUCCESS;
+
+    MappedRange( in_allocation, in_offset, in_size, &range );
+    result = vkInvalidateMappedMemoryRanges( m_handle->device, 1, &range );
+    if ( result != VK_SUCCESS )
+        crvkAppendError( "crvkMemoryAllocator::Invalidate::vkInvalidateMappedMemoryRanges", result );
+        
+    return result;
+}
+
+/*
+==============================================
+crvkMemoryAllocator::MappedRange
+==============================================
+*/
+void crvkMemoryAllocator::MappedRange( const crvkMemoryAllocation_t* in_allocation, const VkDeviceSize in_offset, const VkDeviceSize in_size, VkMappedMemoryRange* out_range ) const
+{
+    VkDeviceSize size = ( in_size == VK_WHOLE_SIZE ) ? in_allocation->size - in_offset : in_size;
+    VkDeviceSize begin = in_allocation->offset + in_offset;
+    VkDeviceSize end = begin + size;
+
+    // non coherent ranges must be aligned to the atom size, or reach the block end 
+    begin -= begin % m_handle->atomSize;
+    end = std::min( AlignUp( end, m_handle->atomSize ), in_allocation->block->size );
+
+    out_range->sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    out_range->pNext = nullptr;
+    out_range->memory = in_allocation->memory;
+    out_range->offset = begin;
+    out_range->size = end - begin;
+}
+
+/*
+==============================================
+crvkMemoryAllocator::MemoryTypeFlags
+==============================================
+*/
+VkMemoryPropertyFlags crvkMemoryAllocator::MemoryTypeFlags( const uint32_t in_type ) const
+{
+    if ( m_handle == nullptr || in_type >= m_handle->memoryProperties.memoryTypeCount )
+        return 0;
+
+    return m_handle->memoryProperties.memoryTypes[in_type].propertyFlags;
+}
+
+/*
+==============================================
+crvkMemoryAllocator::Statistics
+==============================================
+*/
+void crvkMemoryAllocator::Statistics( crvkMemoryStatistics_t* out_statistics, const uint32_t in_type ) const
+{
+    *out_statistics = crvkMemoryStatistics_t();
+    if ( m_handle == nullptr )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    out_statistics->totalAllocations = m_handle->totalAllocations;
+    out_statistics->totalFrees = m_handle->totalFrees;
+
+    for ( uint32_t i = 0; i < VK_MAX_MEMORY_TYPES; i++ )
+    {
+        if ( in_type != UINT32_MAX && in_type != i )
+            continue;
+
+        for ( uint32_t j = 0; j < 2; j++ )
+        {
+            for ( const crvkMemoryBlock_t* block = m_handle->pools[i][j]; block != nullptr; block = block->next )
+            {
+                out_statistics->blockCount++;
+                out_statistics->blockBytes += block->size;
+                out_statistics->usedBytes += block->ranges.Used();
+                out_statistics->allocationCount += block->ranges.AllocationCount();
+                out_statistics->freeRangeCount += block->ranges.FreeRangeCount();
+                if ( block->dedicated )
+                {
+                    out_statistics->dedicatedBlockCount++;
+                    continue;
+                }
+
+                out_statistics->largestFreeRange = std::max( out_statistics->largestFreeRange, block->ranges.LargestFree() );
+            }
+        }
+    }
+}
@@ -0,0 +1,279 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#include "crvkPrecompiled.hpp"
+#include "crvkParallelRecorder.hpp"
+
+typedef struct crvkParallelRecorderHandle_t
+{
+    bool                                    quit = false;
+    uint32_t                                family = 0;
+    uint32_t                                threadCount = 0;
+    uint32_t                                active = 0;         // workers inside a record 
+    uint64_t                                generation = 0;     // bumped for each Record, wake the workers 
+    std::thread*                            threads = nullptr;
+    crvkCommandPoolManager*                 pools = nullptr;
+    std::mutex                              lock;
+    std::condition_variable                 workCond;           // signaled when a record start 
+    std::condition_variable                 doneCond;           // signaled when a worker finish 
+
+    // current record 
+    uint32_t                                drawCount = 0;
+    uint32_t                                chunkSize = 0;
+    uint32_t                                chunkCount = 0;
+    std::atomic<uint32_t>                   nextChunk{ 0 };
+    std::atomic<uint32_t>                   doneChunks{ 0 };
+    std::atomic<int32_t>                    result{ VK_SUCCESS };
+    crvkRecordChunk_t                       record = nullptr;
+    void*                                   userData = nullptr;
+    const VkCommandBufferInheritanceInfo*   inheritance = nullptr;
+    crvkDynamicVector<VkCommandBuffer>      secondaries;        // one per chunk, in draw order 
+} crvkParallelRecorderHandle_t;
+
+/*
+==============================================
+crvkParallelRecorder::crvkParallelRecorder
+==============================================
+*/
+crvkParallelRecorder::crvkParallelRecorder( void ) : m_handle( nullptr )
+{
+    m_handle = new crvkParallelRecorderHandle_t();
+}
+
+/*
+==============================================
+crvkParallelRecorder::~crvkParallelRecorder
+==============================================
+*/
+crvkParallelRecorder::~crvkParallelRecorder( void )
+{
+    Destroy();
+
+    if ( m_handle != nullptr )
+    {
+        delete m_handle;
+        m_handle = nullptr;
+    }
+}
+
+/*
+==============================================
+crvkParallelRecorder::Create
+==============================================
+*/
+bool crvkParallelRecorder::Create( crvkCommandPoolManager* in_pools, const uint32_t in_family, const uint32_t in_threads )
+{
+    m_handle->quit = false;
+    m_handle->pools = in_pools;
+    m_handle->family = in_family;
+    m_handle->threadCount = in_threads;
+    
+    // one worker per logical core, the caller thread take one of them 
+    if ( m_handle->threadCount == 0 )
+        m_handle->threadCount = std::max( std::thread::hardware_concurrency(), 2u ) - 1;
+
+    m_handle->threads = new std::thread[m_handle->threadCount];
+    for ( uint32_t i = 0; i < m_handle->threadCount; i++ )
+        m_handle->threads[i] = std::thread( &crvkParallelRecorder::Worker, this );
+
+    return true;
+}
+
+/*
+==============================================
+crvkParallelRecorder::Destroy
+==============================================
+*/
+void crvkParallelRecorder::Destroy( void )
+{
+    if ( m_handle == nullptr || m_handle->threads == nullptr )
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock( m_handle->lock );
+        m_handle->quit = true;
+    }
+    
+    m_handle->workCond.notify_all();
+
+    for ( uint32_t i = 0; i < m_handle->threadCount; i++ )
+        m_handle->threads[i].join();
+
+    delete[] m_handle->threads;
+    m_handle->threads = nullptr;
+    m_handle->threadCount = 0;
+}
+
+/*
+==============================================
+crvkParallelRecorder::Record
+==============================================
+*/
+VkResult crvkParallelRecorder::Record( 
+    const crvkCommandBuffer* in_commandBuffer,
+    const VkCommandBufferInheritanceInfo* in_inheritance,
+    const uint32_t in_drawCount,
+    crvkRecordChunk_t in_record,
+    void* in_userData,
+    const uint32_t in_minChunk )
+{
+    if ( in_drawCount == 0 )
+        return VK_SUCCESS;
+
+    /// ==================================================================
+    /// Split the draw list, one chunk per thread, unless the chunks are too small 
+    /// ==================================================================
+    uint32_t threads = m_handle->threadCount + 1;
+    uint32_t minChunk = std::max( in_minChunk, 1u );
+    uint32_t chunkCount = std::min( threads, ( in_drawCount + minChunk - 1 ) / minChunk );
+    
+    {
+        // a late worker of the last record may still be looking for chunks 
+        std::unique_lock<std::mutex> lock( m_handle->lock );
+        m_handle->doneCond.wait( lock, [this]{ return m_handle->active == 0; } );
+
+        m_handle->drawCount = in_drawCount;
+        m_handle->chunkCount = std::max( chunkCount, 1u );
+        m_handle->chunkSize = ( in_drawCount + m_handle->chunkCount - 1 ) / m_handle->chunkCount;
+        m_handle->chunkCount = ( in_drawCount + m_handle->chunkSize - 1 ) / m_handle->chunkSize; // no empty chunk at the end 
+        m_handle->record = in_record;
+        m_handle->userData = in_userData;
+        m_handle->inheritance = in_inheritance;
+        m_handle->nextChunk = 0;
+        m_handle->doneChunks = 0;
+        m_handle->result = VK_SUCCESS;
+        m_handle->secondaries.Resize( m_handle->chunkCount );
+
+        /// ==================================================================
+        /// Wake the workers and record with them 
+        /// ==================================================================
+        if ( m_handle->chunkCount > 1 )
+            m_handle->generation++;
+    }
+
+    if ( m_handle->chunkCount > 1 )
+        m_handle->workCond.notify_all();
+    
+    RecordChunks();
+
+    {
+        std::unique_lock<std::mutex> lock( m_handle->lock );
+        m_handle->doneCond.wait( lock, [this]{ return m_handle->active == 0 && m_handle->doneChunks == m_handle->chunkCount; } );
+    }
+
+    if ( m_handle->result != VK_SUCCESS )
+        return static_cast<VkResult>( m_handle->result.load() );
+
+    /// ==================================================================
+    /// Stitch in the draw list order, whatever thread recorded the chunk 
+    /// ==================================================================
+    in_commandBuffer->ExecuteCommands( m_handle->chunkCount, &m_handle->secondaries[0] );
+    return VK_SUCCESS;
+}
+
+/*
+==============================================
+crvkParallelRecorder::ThreadCount
+==============================================
+*/
+uint32_t crvkParallelRecorder::ThreadCount( void ) const
+{
+    return m_handle->threadCount;
+}
+
+/*
+==============================================
+crvkParallelRecorder::Worker
+==============================================
+*/
+void crvkParallelRecorder::Worker( void )
+{
+    uint64_t generation = 0;
+
+    while ( true )
+    {
+        {
+            std::unique_lock<std::mutex> lock( m_handle->lock );
+            m_handle->workCond.wait( lock, [this, generation]{ return m_handle->quit || m_handle->generation != generation; } );
+            
+            if ( m_handle->quit )
+                return;
+
+            generation = m_handle->generation;
+            m_handle->active++;
+        }
+
+        RecordChunks();
+
+        {
+            std::lock_guard<std::mutex> lock( m_handle->lock );
+            m_handle->active--;
+        }
+
+        m_handle->doneCond.notify_all();
+    }
+}
+
+/*
+==============================================
+crvkParallelRecorder::RecordChunks
+==============================================
+*/
+void crvkParallelRecorder::RecordChunks( void )
+{
+    VkResult result = VK_SUCCESS;
+    uint32_t chunk = 0;
+    uint32_t first = 0;
+    
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = m_handle->inheritance;
+
+    // take chunks until they are over 
+    while ( ( chunk = m_handle->nextChunk++ ) < m_handle->chunkCount )
+    {
+        // the buffer come from this thread pool, no lock needed 
+        VkCommandBuffer commandBuffer = m_handle->pools->Allocate( m_handle->family, VK_COMMAND_BUFFER_LEVEL_SECONDARY );
+        if ( commandBuffer == nullptr )
+            result = VK_ERROR_OUT_OF_HOST_MEMORY;
+        else
+            result = vkBeginCommandBuffer( commandBuffer, &beginInfo );
+
+        if ( result == VK_SUCCESS )
+        {
+            first = chunk * m_handle->chunkSize;
+            m_handle->record( commandBuffer, first, std::min( m_handle->chunkSize, m_handle->drawCount - first ), m_handle->userData );
+            result = vkEndCommandBuffer( commandBuffer );
+        }
+
+        if ( result != VK_SUCCESS )
+        {
+            int32_t expected = VK_SUCCESS;
+            m_handle->result.compare_exchange_strong( expected, result );
+            crvkAppendError( "crvkParallelRecorder::RecordChunks", result );
+        }
+
+        m_handle->secondaries[chunk] = commandBuffer;
+        m_handle->doneChunks++;
+    }
+}
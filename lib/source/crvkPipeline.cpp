@@ -60,6 +60,7 @@ bool crvkGraphicPipeline::Create(
     )
 {
     VkResult result = VK_SUCCESS;
+    m_device = const_cast<crvkDevice*>( in_device );
 
     ///
     /// create the pipeline Layout 
@@ -71,7 +72,7 @@ bool crvkGraphicPipeline::Create(
     pipelineLayoutCI.pSetLayouts = in_setLayouts;
     pipelineLayoutCI.pushConstantRangeCount = in_pushConstantRangeCount;
     pipelineLayoutCI.pPushConstantRanges = in_pushConstantRanges;
-    auto result = vkCreatePipelineLayout( m_device->Device(), &pipelineLayoutCI, k_allocationCallbacks, &m_pipelineLayout ); 
+    result = vkCreatePipelineLayout( m_device->Device(), &pipelineLayoutCI, k_allocationCallbacks, &m_pipelineLayout ); 
     if( result != VK_SUCCESS) 
     {
         crvkAppendError( "crvkGraphicPipeline::Create::vkCreatePipelineLayout", result );
@@ -97,12 +98,16 @@ bool crvkGraphicPipeline::Create(
     pipelineInfo.layout = m_pipelineLayout;
     pipelineInfo.subpass = in_subpass;
     pipelineInfo.basePipelineHandle = in_basePipelineHandle;
-    result = vkCreateGraphicsPipelines( m_device->Device(), VK_NULL_HANDLE, 1, &pipelineInfo, k_allocationCallbacks, &m_pipeline ); 
+    
+    // use the device cache, so we don't recompile the pipeline every launch
+    result = vkCreateGraphicsPipelines( m_device->Device(), m_device->PipelineCache()->Cache(), 1, &pipelineInfo, k_allocationCallbacks, &m_pipeline ); 
     if ( result != VK_SUCCESS ) 
     {
         crvkAppendError( "crvkGraphicPipeline::Create::vkCreateGraphicsPipelines", result );
         return false;
     }
+
+    return true;
 }
 
 /*
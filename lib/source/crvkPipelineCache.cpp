@@ -0,0 +1,209 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#include "crvkPrecompiled.hpp"
+#include "crvkPipelineCache.hpp"
+
+/*
+==============================================
+crvkPipelineCache::crvkPipelineCache
+==============================================
+*/
+crvkPipelineCache::crvkPipelineCache( void ) : 
+    m_loaded( false ),
+    m_vendorID( 0 ),
+    m_deviceID( 0 ),
+    m_path( nullptr ),
+    m_cache( nullptr ),
+    m_device( nullptr )
+{
+    std::memset( m_uuid, 0x00, VK_UUID_SIZE );
+}
+
+/*
+==============================================
+crvkPipelineCache::~crvkPipelineCache
+==============================================
+*/
+crvkPipelineCache::~crvkPipelineCache( void )
+{
+    Destroy();
+}
+
+/*
+==============================================
+crvkPipelineCache::Create
+==============================================
+*/
+bool crvkPipelineCache::Create( const VkDevice in_device, const VkPhysicalDeviceProperties* in_properties, const char* in_path )
+{
+    VkResult result = VK_SUCCESS;
+    size_t fileSize = 0;
+    void* fileData = nullptr;
+
+    m_device = in_device;
+    m_loaded = false;
+    m_vendorID = in_properties->vendorID;
+    m_deviceID = in_properties->deviceID;
+    std::memcpy( m_uuid, in_properties->pipelineCacheUUID, VK_UUID_SIZE );
+
+    if ( in_path != nullptr )
+    {
+        m_path = SDL_strdup( in_path );
+        
+        // a missing file is just a cold start 
+        fileData = SDL_LoadFile( m_path, &fileSize );
+    }
+
+    VkPipelineCacheCreateInfo pipelineCacheCI{};
+    pipelineCacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCI.pNext = nullptr;
+    pipelineCacheCI.flags = 0;
+    
+    // only feed the driver with data created by this same device and driver 
+    if ( fileData != nullptr && ValidateHeader( fileData, fileSize ) )
+    {
+        pipelineCacheCI.initialDataSize = fileSize;
+        pipelineCacheCI.pInitialData = fileData;
+        m_loaded = true;
+    }
+
+    result = vkCreatePipelineCache( m_device, &pipelineCacheCI, k_allocationCallbacks, &m_cache );
+    if ( result != VK_SUCCESS && m_loaded )
+    {
+        // the driver refused the data, start with a empty cache 
+        pipelineCacheCI.initialDataSize = 0;
+        pipelineCacheCI.pInitialData = nullptr;
+        m_loaded = false;
+        result = vkCreatePipelineCache( m_device, &pipelineCacheCI, k_allocationCallbacks, &m_cache );
+    }
+
+    if ( fileData != nullptr )
+        SDL_free( fileData );
+
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkPipelineCache::Create::vkCreatePipelineCache", result );
+        return false;
+    }
+
+    return true;
+}
+
+/*
+==============================================
+crvkPipelineCache::Destroy
+==============================================
+*/
+void crvkPipelineCache::Destroy( void )
+{
+    if ( m_cache != nullptr )
+    {
+        Save();
+        vkDestroyPipelineCache( m_device, m_cache, k_allocationCallbacks );
+        m_cache = nullptr;
+    }
+
+    if ( m_path != nullptr )
+    {
+        SDL_free( m_path );
+        m_path = nullptr;
+    }
+
+    m_loaded = false;
+    m_device = nullptr;
+}
+
+/*
+==============================================
+crvkPipelineCache::Save
+==============================================
+*/
+bool crvkPipelineCache::Save( void ) const
+{
+    VkResult result = VK_SUCCESS;
+    size_t dataSize = 0;
+    void* data = nullptr;
+    char* tempPath = nullptr;
+    bool saved = false;
+
+    // memory only cache 
+    if ( m_path == nullptr || m_cache == nullptr )
+        return true;
+
+    result = vkGetPipelineCacheData( m_device, m_cache, &dataSize, nullptr );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkPipelineCache::Save::vkGetPipelineCacheData", result );
+        return false;
+    }
+
+    data = SDL_malloc( dataSize );
+    result = vkGetPipelineCacheData( m_device, m_cache, &dataSize, data );
+    if ( result != VK_SUCCESS )
+    {
+        SDL_free( data );
+        crvkAppendError( "crvkPipelineCache::Save::vkGetPipelineCacheData", result );
+        return false;
+    }
+
+    // write a temporary file and replace the old one, a crash never leave a half written cache 
+    SDL_asprintf( &tempPath, "%s.tmp", m_path );
+    if ( SDL_SaveFile( tempPath, data, dataSize ) && SDL_RenamePath( tempPath, m_path ) )
+        saved = true;
+    else
+    {
+        crvkAppendError( SDL_GetError(), VK_INCOMPLETE );
+        SDL_RemovePath( tempPath );
+    }
+
+    SDL_free( tempPath );
+    SDL_free( data );
+    return saved;
+}
+
+/*
+==============================================
+crvkPipelineCache::ValidateHeader
+==============================================
+*/
+bool crvkPipelineCache::ValidateHeader( const void* in_data, const size_t in_size ) const
+{
+    VkPipelineCacheHeaderVersionOne header{};
+
+    if ( in_size < sizeof( VkPipelineCacheHeaderVersionOne ) )
+        return false;
+
+    std::memcpy( &header, in_data, sizeof( VkPipelineCacheHeaderVersionOne ) );
+    
+    if ( header.headerSize < sizeof( VkPipelineCacheHeaderVersionOne ) || header.headerSize > in_size )
+        return false;
+
+    if ( header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE )
+        return false;
+
+    // the cache was created by other GPU or driver version 
+    if ( header.vendorID != m_vendorID || header.deviceID != m_deviceID )
+        return false;
+
+    return std::memcmp( header.pipelineCacheUUID, m_uuid, VK_UUID_SIZE ) == 0;
+}
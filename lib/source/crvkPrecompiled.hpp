@@ -27,12 +27,24 @@
 #include <cstring>          // std::memcpy, std::strcmp
 #include <stdexcept>        // std::runtime_error
 #include <exception>        // std::exeption
-#include <algorithm>        // std::clamp, std::min, std::max
+#include <algorithm>        // std::clamp, std::min, std::max, std::stable_sort
+#include <functional>       // std::less
+#include <utility>          // std::move
 #include <cstdio>           // std::snprintf
 #include <limits>           // std::numeric_limits
 #include <atomic>           // std::atomic
+#include <mutex>            // std::mutex, std::lock_guard
+#include <unordered_map>    // std::unordered_map
+#include <map>              // std::map
+#include <deque>            // std::deque
+#include <thread>           // std::thread
+#include <condition_variable> // std::condition_variable
 #include <SDL3/SDL_assert.h> // SDL_assert
 #include <SDL3/SDL_stdinc.h> // SDL_malloc, SDL_realloc, SDL_free
+#include <SDL3/SDL_timer.h> // SDL_GetTicksNS
+#include <SDL3/SDL_error.h> // SDL_GetError
+#include <SDL3/SDL_iostream.h> // SDL_LoadFile, SDL_SaveFile
+#include <SDL3/SDL_filesystem.h> // SDL_RenamePath, SDL_RemovePath, SDL_CreateDirectory
 
 #include "crvkPointer.hpp"
 #include "crvkDynamicVector.hpp"
@@ -42,12 +54,26 @@
 #include "crvkContext.hpp"
 #include "crvkQueue.hpp"
 #include "crvkDevice.hpp"
+#include "crvkRangeAllocator.hpp"
+#include "crvkMemoryAllocator.hpp"
+#include "crvkDeletionQueue.hpp"
+#include "crvkUploadManager.hpp"
+#include "crvkReadbackQueue.hpp"
+#include "crvkPipelineCache.hpp"
 #include "crvkFence.hpp"
 #include "crvkSemaphore.hpp"
+#include "crvkBarrierBatch.hpp"
 #include "crvkCommandBuffer.hpp"
+#include "crvkCommandPoolManager.hpp"
+#include "crvkParallelRecorder.hpp"
 #include "crvkSwapchain.hpp"
+#include "crvkFrameArena.hpp"
+#include "crvkDirtyRangeSet.hpp"
 #include "crvkBuffer.hpp"
+#include "crvkUploadBatch.hpp"
+#include "crvkShaderCache.hpp"
 #include "crvkShaderStage.hpp"
+#include "crvkShaderCompiler.hpp"
 #include "crvkPipeline.hpp"
 
 #endif //__CRVK_PRECOMPILED_HPP__
\ No newline at end of file
@@ -22,16 +22,425 @@
 #include "crvkPrecompiled.hpp"
 #include "crvkQueue.hpp"
 
+static const uint32_t k_minSubmitEntries = 8;
+
+/// @brief a queued batch, the offsets index the shared arrays, they can grow before the flush 
+typedef struct crvkPendingSubmit_t
+{
+    VkSubmitFlags   flags = 0;
+    uint32_t        firstWait = 0;
+    uint32_t        waitCount = 0;
+    uint32_t        firstCommandBuffer = 0;
+    uint32_t        commandBufferCount = 0;
+    uint32_t        firstSignal = 0;
+    uint32_t        signalCount = 0;
+} crvkPendingSubmit_t;
+
+/// @brief copy of submit infos and his arrays 
+typedef struct crvkSubmitBatch_t
+{
+    crvkDynamicVector<crvkPendingSubmit_t>          pending;
+    crvkDynamicVector<VkSemaphoreSubmitInfo>        waits;
+    crvkDynamicVector<VkSemaphoreSubmitInfo>        signals;
+    crvkDynamicVector<VkCommandBufferSubmitInfo>    commandBuffers;
+} crvkSubmitBatch_t;
+
+typedef enum crvkQueueEntryType_e : uint8_t
+{
+    CRVK_QUEUE_ENTRY_SUBMIT = 0,
+    CRVK_QUEUE_ENTRY_SUBMIT_CHAINED,    // submits with pNext chains, sent from the producer arrays 
+    CRVK_QUEUE_ENTRY_PRESENT,
+    CRVK_QUEUE_ENTRY_FLUSH,             // send the queued submits, the producer wait it 
+    CRVK_QUEUE_ENTRY_WAIT_IDLE
+} crvkQueueEntryType_t;
+
+/// @brief a submission thread ring cell 
+typedef struct crvkQueueEntry_t
+{
+    std::atomic<uint64_t>               sequence{ 0 };      // ring position the cell is ready for 
+    crvkQueueEntryType_t                type = CRVK_QUEUE_ENTRY_SUBMIT;
+    VkFence                             fence = nullptr;
+    uint64_t                            time = 0;           // enqueue time 
+    VkResult*                           result = nullptr;   // result for a waiting producer 
+    const VkSubmitInfo2*                chained = nullptr;  // producer submits, alive until the entry complete 
+    uint32_t                            chainedCount = 0;
+    crvkSubmitBatch_t                   batch;
+    crvkDynamicVector<VkSwapchainKHR>   swapchains;
+    crvkDynamicVector<uint32_t>         imageIndices;
+    crvkDynamicVector<VkSemaphore>      semaphores;
+} crvkQueueEntry_t;
+
 typedef struct crvkQueueHandle_t
 {
-    crvkQueueType_t type;
+    crvkQueueType_t type = CRVK_DEVICE_QUEUE_NONE;
+    bool            deferred = false;
     uint32_t        family = UINT32_MAX;
     uint32_t        index = UINT32_MAX;
     VkQueue         queue = nullptr;
     VkCommandPool   commandPool = nullptr;
     VkDevice        device = nullptr;
+    
+    // deferred submits, owned by the submission thread when it run 
+    std::mutex                          submitLock;     // guard the batch and the VkQueue, without the submission thread 
+    crvkSubmitBatch_t                   batch;
+    crvkDynamicVector<VkSubmitInfo2>    submits;        // built at flush 
+    crvkDynamicVector<uint64_t>         times;          // enqueue time of the batched entries 
+
+    // submission thread 
+    bool                        quit = false;
+    uint32_t                    capacity = 0;           // ring size, power of two 
+    uint64_t                    dequeuePos = 0;         // consumer position 
+    uint64_t                    lastValue = 0;          // last timeline value sent 
+    std::thread*                thread = nullptr;
+    crvkQueueEntry_t*           entries = nullptr;
+    VkSemaphore                 timeline = nullptr;     // signaled with the submit values 
+    std::atomic<uint64_t>       enqueuePos{ 0 };        // producers position 
+    std::atomic<uint64_t>       completed{ 0 };         // entries processed 
+    std::atomic<uint32_t>       sleeping{ 0 };          // the consumer wait for work 
+    std::atomic<int32_t>        presentResult{ VK_SUCCESS };
+    std::atomic<int32_t>        submitResult{ VK_SUCCESS };     // first failed submit of the thread, until a Flush report it 
+    std::mutex                  lock;                   // only for sleep and wake 
+    std::condition_variable     workCond;
+    std::condition_variable     doneCond;
+
+    // submission thread statistics 
+    std::atomic<uint64_t>       statEntries{ 0 };
+    std::atomic<uint64_t>       statBatches{ 0 };
+    std::atomic<uint64_t>       statLastLatency{ 0 };
+    std::atomic<uint64_t>       statMaxLatency{ 0 };
+    std::atomic<uint64_t>       statTotalLatency{ 0 };
 } crvkQueueHandle_t;
 
+/*
+==============================================
+HasChain
+==============================================
+*/
+static bool HasChain( const VkSubmitInfo2* in_submits, const uint32_t in_count )
+{
+    // the extension structures are not known, they can't be copied 
+    for ( uint32_t i = 0; i < in_count; i++ )
+    {
+        const VkSubmitInfo2& submit = in_submits[i];
+        if ( submit.pNext != nullptr )
+            return true;
+
+        for ( uint32_t j = 0; j < submit.waitSemaphoreInfoCount; j++ )
+        {
+            if ( submit.pWaitSemaphoreInfos[j].pNext != nullptr )
+                return true;
+        }
+
+        for ( uint32_t j = 0; j < submit.commandBufferInfoCount; j++ )
+        {
+            if ( submit.pCommandBufferInfos[j].pNext != nullptr )
+                return true;
+        }
+
+        for ( uint32_t j = 0; j < submit.signalSemaphoreInfoCount; j++ )
+        {
+            if ( submit.pSignalSemaphoreInfos[j].pNext != nullptr )
+                return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+==============================================
+AppendSubmits
+==============================================
+*/
+static void AppendSubmits( crvkSubmitBatch_t* out_batch, const VkSubmitInfo2* in_submits, const uint32_t in_count, const VkSemaphoreSubmitInfo* in_signal )
+{
+    // a lone signal still need a submit 
+    VkSubmitInfo2 empty{};
+    const VkSubmitInfo2* submits = in_submits;
+    uint32_t count = in_count;
+    if ( count == 0 )
+    {
+        empty.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        submits = &empty;
+        count = 1;
+    }
+
+    for ( uint32_t i = 0; i < count; i++ )
+    {
+        const VkSubmitInfo2& submit = submits[i];
+        crvkPendingSubmit_t pending{};
+        pending.flags = submit.flags;
+        pending.firstWait = out_batch->waits.Count();
+        pending.waitCount = submit.waitSemaphoreInfoCount;
+        pending.firstCommandBuffer = out_batch->commandBuffers.Count();
+        pending.commandBufferCount = submit.commandBufferInfoCount;
+        pending.firstSignal = out_batch->signals.Count();
+        pending.signalCount = submit.signalSemaphoreInfoCount;
+
+        for ( uint32_t j = 0; j < submit.waitSemaphoreInfoCount; j++ )
+            out_batch->waits.Append( submit.pWaitSemaphoreInfos[j] );
+
+        for ( uint32_t j = 0; j < submit.commandBufferInfoCount; j++ )
+            out_batch->commandBuffers.Append( submit.pCommandBufferInfos[j] );
+
+        for ( uint32_t j = 0; j < submit.signalSemaphoreInfoCount; j++ )
+            out_batch->signals.Append( submit.pSignalSemaphoreInfos[j] );
+
+        // the extra signal go with the last submit, after all the work 
+        if ( in_signal != nullptr && i == count - 1 )
+        {
+            out_batch->signals.Append( *in_signal );
+            pending.signalCount++;
+        }
+
+        out_batch->pending.Append( pending );
+    }
+}
+
+/*
+==============================================
+AppendBatch
+==============================================
+*/
+static void AppendBatch( crvkSubmitBatch_t* out_batch, const crvkSubmitBatch_t* in_batch )
+{
+    for ( uint32_t i = 0; i < in_batch->pending.Count(); i++ )
+    {
+        crvkPendingSubmit_t pending = in_batch->pending[i];
+
+        for ( uint32_t j = 0; j < pending.waitCount; j++ )
+            out_batch->waits.Append( in_batch->waits[pending.firstWait + j] );
+
+        for ( uint32_t j = 0; j < pending.commandBufferCount; j++ )
+            out_batch->commandBuffers.Append( in_batch->commandBuffers[pending.firstCommandBuffer + j] );
+
+        for ( uint32_t j = 0; j < pending.signalCount; j++ )
+            out_batch->signals.Append( in_batch->signals[pending.firstSignal + j] );
+
+        // rebase in the destination arrays 
+        pending.firstWait = out_batch->waits.Count() - pending.waitCount;
+        pending.firstCommandBuffer = out_batch->commandBuffers.Count() - pending.commandBufferCount;
+        pending.firstSignal = out_batch->signals.Count() - pending.signalCount;
+        out_batch->pending.Append( pending );
+    }
+}
+
+/*
+==============================================
+ResetBatch
+==============================================
+*/
+static void ResetBatch( crvkSubmitBatch_t* in_batch )
+{
+    // keep the arrays memory for the next frame 
+    in_batch->pending.Reset();
+    in_batch->waits.Reset();
+    in_batch->signals.Reset();
+    in_batch->commandBuffers.Reset();
+}
+
+/*
+==============================================
+SendBatch
+==============================================
+*/
+static VkResult SendBatch( crvkQueueHandle_t* in_handle, const VkFence in_fence )
+{
+    VkResult result = VK_SUCCESS;
+    crvkSubmitBatch_t& batch = in_handle->batch;
+
+    if ( batch.pending.Count() == 0 )
+    {
+        // nothing queued, but the caller expect the fence signaled 
+        if ( in_fence != nullptr )
+            return vkQueueSubmit2( in_handle->queue, 0, nullptr, in_fence );
+
+        return VK_SUCCESS;
+    }
+
+    /// ==================================================================
+    /// Build the submit infos, the arrays don't move anymore 
+    /// ==================================================================
+    in_handle->submits.Reset();
+    in_handle->submits.Resize( batch.pending.Count() );
+    for ( uint32_t i = 0; i < batch.pending.Count(); i++ )
+    {
+        const crvkPendingSubmit_t& pending = batch.pending[i];
+        VkSubmitInfo2& submitInfo = in_handle->submits[i];
+        submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        submitInfo.flags = pending.flags;
+        submitInfo.waitSemaphoreInfoCount = pending.waitCount;
+        submitInfo.pWaitSemaphoreInfos = pending.waitCount > 0 ? &batch.waits[pending.firstWait] : nullptr;
+        submitInfo.commandBufferInfoCount = pending.commandBufferCount;
+        submitInfo.pCommandBufferInfos = pending.commandBufferCount > 0 ? &batch.commandBuffers[pending.firstCommandBuffer] : nullptr;
+        submitInfo.signalSemaphoreInfoCount = pending.signalCount;
+        submitInfo.pSignalSemaphoreInfos = pending.signalCount > 0 ? &batch.signals[pending.firstSignal] : nullptr;
+    }
+
+    result = vkQueueSubmit2( in_handle->queue, in_handle->submits.Count(), &in_handle->submits[0], in_fence );
+    if ( result != VK_SUCCESS )
+        crvkAppendError( "crvkDeviceQueue::Flush::vkQueueSubmit2", result );
+
+    ResetBatch( &batch );
+    return result;
+}
+
+/*
+==============================================
+RecordLatency
+==============================================
+*/
+static void RecordLatency( crvkQueueHandle_t* in_handle, const uint64_t in_time )
+{
+    uint64_t latency = SDL_GetTicksNS() - in_time;
+    uint64_t maxLatency = in_handle->statMaxLatency;
+    
+    in_handle->statEntries++;
+    in_handle->statLastLatency = latency;
+    in_handle->statTotalLatency += latency;
+    
+    // only the submission thread write it 
+    if ( latency > maxLatency )
+        in_handle->statMaxLatency = latency;
+}
+
+/*
+==============================================
+SignalFailedBatch
+==============================================
+*/
+static void SignalFailedBatch( crvkQueueHandle_t* in_handle, const VkFence in_fence )
+{
+    VkResult result = VK_SUCCESS;
+
+    // the values of the failed batch are already handed to the producers, a empty submit signal them 
+    // after the work sent before, so the waits and the deletion queue entries on them don't hang 
+    VkSemaphoreSubmitInfo signalInfo{};
+    signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    signalInfo.semaphore = in_handle->timeline;
+    signalInfo.value = in_handle->lastValue;
+    signalInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+    VkSubmitInfo2 submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+    submitInfo.signalSemaphoreInfoCount = 1;
+    submitInfo.pSignalSemaphoreInfos = &signalInfo;
+    
+    result = vkQueueSubmit2( in_handle->queue, 1, &submitInfo, in_fence );
+    if ( result == VK_SUCCESS )
+        return;
+
+    // the queue don't take work anymore, nothing sent to it will signal, so the host signal the value 
+    VkSemaphoreSignalInfo hostSignal{};
+    hostSignal.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+    hostSignal.semaphore = in_handle->timeline;
+    hostSignal.value = in_handle->lastValue;
+    result = vkSignalSemaphore( in_handle->device, &hostSignal );
+    if ( result != VK_SUCCESS )
+        crvkAppendError( "crvkDeviceQueue::SignalFailedBatch::vkSignalSemaphore", result );
+}
+
+/*
+==============================================
+SendTimedBatch
+==============================================
+*/
+static VkResult SendTimedBatch( crvkQueueHandle_t* in_handle, const VkFence in_fence )
+{
+    int32_t expected = VK_SUCCESS;
+    VkResult result = VK_SUCCESS;
+
+    if ( in_handle->batch.pending.Count() == 0 && in_fence == nullptr )
+        return VK_SUCCESS;
+
+    result = SendBatch( in_handle, in_fence );
+    in_handle->statBatches++;
+
+    // nobody wait the drain submits, keep the first error for the next Flush 
+    if ( result != VK_SUCCESS )
+    {
+        in_handle->submitResult.compare_exchange_strong( expected, result );
+        SignalFailedBatch( in_handle, in_fence );
+    }
+
+    // the latency is measured until the entry reach the driver 
+    for ( uint32_t i = 0; i < in_handle->times.Count(); i++ )
+        RecordLatency( in_handle, in_handle->times[i] );
+
+    in_handle->times.Reset();
+    return result;
+}
+
+/*
+==============================================
+ClaimEntry
+==============================================
+*/
+static crvkQueueEntry_t* ClaimEntry( crvkQueueHandle_t* in_handle, uint64_t* out_position )
+{
+    crvkQueueEntry_t* entry = nullptr;
+    uint64_t position = in_handle->enqueuePos.load( std::memory_order_relaxed );
+    
+    while ( true )
+    {
+        entry = &in_handle->entries[position & ( in_handle->capacity - 1 )];
+        int64_t diff = static_cast<int64_t>( entry->sequence.load( std::memory_order_acquire ) ) - static_cast<int64_t>( position );
+        
+        // the cell is free for this position, try to take it 
+        if ( diff == 0 )
+        {
+            if ( in_handle->enqueuePos.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+                break;
+        }
+        // ring full, let the submission thread run 
+        else if ( diff < 0 )
+        {
+            std::this_thread::yield();
+            position = in_handle->enqueuePos.load( std::memory_order_relaxed );
+        }
+        // other producer took it 
+        else
+            position = in_handle->enqueuePos.load( std::memory_order_relaxed );
+    }
+
+    entry->fence = nullptr;
+    entry->result = nullptr;
+    entry->chained = nullptr;
+    entry->chainedCount = 0;
+    entry->time = SDL_GetTicksNS();
+    *out_position = position;
+    return entry;
+}
+
+/*
+==============================================
+PublishEntry
+==============================================
+*/
+static void PublishEntry( crvkQueueHandle_t* in_handle, crvkQueueEntry_t* in_entry, const uint64_t in_position )
+{
+    // seq_cst, pair with the consumer sleeping flag 
+    in_entry->sequence.store( in_position + 1 );
+    
+    if ( in_handle->sleeping.load() != 0 )
+    {
+        std::lock_guard<std::mutex> lock( in_handle->lock );
+        in_handle->workCond.notify_one();
+    }
+}
+
+/*
+==============================================
+WaitEntry
+==============================================
+*/
+static void WaitEntry( crvkQueueHandle_t* in_handle, const uint64_t in_position )
+{
+    std::unique_lock<std::mutex> lock( in_handle->lock );
+    in_handle->doneCond.wait( lock, [in_handle, in_position]{ return in_handle->completed > in_position; } );
+}
+
 /*
 ==============================================
 crvkDeviceQueue::crvkDeviceQueue
@@ -58,7 +467,7 @@ crvkDeviceQueue::Create
 */
 bool crvkDeviceQueue::Create(const crvkDevice *in_device, const crvkQueueInfo_t *&in_deviceQueue)
 {
-    m_handle = static_cast<crvkQueueHandle_t*>( SDL_malloc( sizeof( crvkQueueHandle_t ) ) );
+    m_handle = new crvkQueueHandle_t();
     m_handle->device = in_device->Device();
     m_handle->family = in_deviceQueue->family;
     m_handle->index = in_deviceQueue->index;
@@ -103,6 +512,10 @@ void crvkDeviceQueue::Destroy( void )
     if ( m_handle == nullptr )
         return;
 
+    // don't lose the queued work 
+    StopSubmitThread();
+    Flush();
+
     if ( m_handle->commandPool != nullptr )
     {
         vkDestroyCommandPool( m_handle->device, m_handle->commandPool, k_allocationCallbacks );
@@ -114,7 +527,7 @@ void crvkDeviceQueue::Destroy( void )
         m_handle->queue = nullptr;
 
     // free handle pointer
-    SDL_free( m_handle );
+    delete m_handle;
     m_handle = nullptr;    
 }
 
@@ -141,7 +554,473 @@ VkResult crvkDeviceQueue::Submit(
     submitInfo.pCommandBufferInfos = in_CommandBufferInfos;
     submitInfo.signalSemaphoreInfoCount = in_signalSemaphoreInfoCount;
     submitInfo.pSignalSemaphoreInfos = in_SignalSemaphoreInfos;
-    return vkQueueSubmit2( m_handle->queue, 1, &submitInfo, in_fence );
+    return Submit( &submitInfo, 1, in_fence );
+}
+
+/*
+==============================================
+crvkDeviceQueue::Submit
+==============================================
+*/
+VkResult crvkDeviceQueue::Submit( const VkSubmitInfo2* in_submits, const uint32_t in_count, const VkFence in_fence )
+{
+    VkResult result = VK_SUCCESS;
+
+    // the submission thread own the queue 
+    if ( m_handle->thread != nullptr )
+        return SubmitAsync( in_submits, in_count, in_fence ) != 0 ? VK_SUCCESS : VK_ERROR_INITIALIZATION_FAILED;
+
+    std::lock_guard<std::mutex> lock( m_handle->submitLock );
+    if ( !m_handle->deferred )
+        return vkQueueSubmit2( m_handle->queue, in_count, in_submits, in_fence );
+
+    // a pNext chain can't be copied, send the queued work and then the chained batch, keeping the order 
+    if ( HasChain( in_submits, in_count ) )
+    {
+        result = SendBatch( m_handle, nullptr );
+        if ( result != VK_SUCCESS )
+            return result;
+
+        return vkQueueSubmit2( m_handle->queue, in_count, in_submits, in_fence );
+    }
+
+    // copy the batch, the caller arrays don't live until the flush 
+    if ( in_count > 0 )
+        AppendSubmits( &m_handle->batch, in_submits, in_count, nullptr );
+
+    // only one fence per vkQueueSubmit2, send it with the queued work 
+    if ( in_fence != nullptr )
+        return SendBatch( m_handle, in_fence );
+
+    return VK_SUCCESS;
+}
+
+/*
+==============================================
+crvkDeviceQueue::Flush
+==============================================
+*/
+VkResult crvkDeviceQueue::Flush( const VkFence in_fence )
+{
+    if ( m_handle == nullptr )
+        return VK_ERROR_INITIALIZATION_FAILED;
+
+    // wait the submission thread send everything pushed before, and report his failed submits 
+    if ( m_handle->thread != nullptr )
+    {
+        uint64_t position = 0;
+        crvkQueueEntry_t* entry = ClaimEntry( m_handle, &position );
+        entry->type = CRVK_QUEUE_ENTRY_FLUSH;
+        entry->fence = in_fence;
+        PublishEntry( m_handle, entry, position );
+        WaitEntry( m_handle, position );
+        return static_cast<VkResult>( m_handle->submitResult.exchange( VK_SUCCESS ) );
+    }
+
+    std::lock_guard<std::mutex> lock( m_handle->submitLock );
+    return SendBatch( m_handle, in_fence );
+}
+
+/*
+==============================================
+crvkDeviceQueue::SetDeferred
+==============================================
+*/
+void crvkDeviceQueue::SetDeferred( const bool in_deferred )
+{
+    if ( m_handle == nullptr || m_handle->queue == nullptr )
+    {
+        crvkAppendError( "crvkDeviceQueue::SetDeferred::queue not created", VK_ERROR_INITIALIZATION_FAILED );
+        return;
+    }
+
+    if ( !in_deferred )
+        Flush();
+
+    std::lock_guard<std::mutex> lock( m_handle->submitLock );
+    m_handle->deferred = in_deferred;
+}
+
+/*
+==============================================
+crvkDeviceQueue::Deferred
+==============================================
+*/
+bool crvkDeviceQueue::Deferred( void ) const
+{
+    if ( m_handle == nullptr )
+        return false;
+
+    return m_handle->deferred;
+}
+
+/*
+==============================================
+crvkDeviceQueue::PendingCount
+==============================================
+*/
+uint32_t crvkDeviceQueue::PendingCount( void ) const
+{
+    if ( m_handle == nullptr || m_handle->thread != nullptr )
+        return 0;
+
+    std::lock_guard<std::mutex> lock( m_handle->submitLock );
+    return m_handle->batch.pending.Count();
+}
+
+/*
+==============================================
+crvkDeviceQueue::StartSubmitThread
+==============================================
+*/
+bool crvkDeviceQueue::StartSubmitThread( const uint32_t in_capacity )
+{
+    VkResult result = VK_SUCCESS;
+    
+    if ( m_handle == nullptr )
+        return false;
+
+    if ( m_handle->thread != nullptr )
+        return true;
+
+    // the queued work go first 
+    Flush();
+
+    // the values handed to the producers 
+    VkSemaphoreTypeCreateInfo timelineCreateInfo{};
+    timelineCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    timelineCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    timelineCreateInfo.initialValue = m_handle->enqueuePos;
+    m_handle->lastValue = m_handle->enqueuePos;
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo{};
+    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreCreateInfo.pNext = &timelineCreateInfo;
+    result = vkCreateSemaphore( m_handle->device, &semaphoreCreateInfo, k_allocationCallbacks, &m_handle->timeline );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkDeviceQueue::StartSubmitThread::vkCreateSemaphore", result );
+        return false;
+    }
+
+    // the ring index is masked, keep it power of two 
+    m_handle->capacity = k_minSubmitEntries;
+    while ( m_handle->capacity < in_capacity )
+        m_handle->capacity <<= 1;
+
+    // a cell is free for a position when his sequence are equal to it 
+    m_handle->entries = new crvkQueueEntry_t[m_handle->capacity];
+    for ( uint32_t i = 0; i < m_handle->capacity; i++ )
+        m_handle->entries[i].sequence = m_handle->enqueuePos + i;
+
+    m_handle->quit = false;
+    m_handle->dequeuePos = m_handle->enqueuePos;
+    m_handle->completed = m_handle->enqueuePos.load();
+    m_handle->thread = new std::thread( &crvkDeviceQueue::SubmitWorker, this );
+    return true;
+}
+
+/*
+==============================================
+crvkDeviceQueue::StopSubmitThread
+==============================================
+*/
+void crvkDeviceQueue::StopSubmitThread( void )
+{
+    if ( m_handle == nullptr || m_handle->thread == nullptr )
+        return;
+
+    // the thread drain the ring before leave 
+    {
+        std::lock_guard<std::mutex> lock( m_handle->lock );
+        m_handle->quit = true;
+    }
+
+    m_handle->workCond.notify_one();
+    m_handle->thread->join();
+
+    delete m_handle->thread;
+    m_handle->thread = nullptr;
+    
+    delete[] m_handle->entries;
+    m_handle->entries = nullptr;
+
+    // wait the GPU reach the sent values before release the semaphore 
+    uint64_t value = m_handle->lastValue;
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_handle->timeline;
+    waitInfo.pValues = &value;
+    vkWaitSemaphores( m_handle->device, &waitInfo, UINT64_MAX );
+
+    vkDestroySemaphore( m_handle->device, m_handle->timeline, k_allocationCallbacks );
+    m_handle->timeline = nullptr;
+}
+
+/*
+==============================================
+crvkDeviceQueue::SubmitThread
+==============================================
+*/
+bool crvkDeviceQueue::SubmitThread( void ) const
+{
+    return m_handle != nullptr && m_handle->thread != nullptr;
+}
+
+/*
+==============================================
+crvkDeviceQueue::SubmitAsync
+==============================================
+*/
+uint64_t crvkDeviceQueue::SubmitAsync( const VkSubmitInfo2* in_submits, const uint32_t in_count, const VkFence in_fence )
+{
+    uint64_t position = 0;
+
+    if ( m_handle == nullptr || m_handle->thread == nullptr )
+        return 0;
+
+    crvkQueueEntry_t* entry = ClaimEntry( m_handle, &position );
+
+    // a pNext chain can't be copied, the thread send it from our arrays, so we wait it 
+    if ( HasChain( in_submits, in_count ) )
+    {
+        VkResult result = VK_SUCCESS;
+        entry->type = CRVK_QUEUE_ENTRY_SUBMIT_CHAINED;
+        entry->fence = in_fence;
+        entry->result = &result;
+        entry->chained = in_submits;
+        entry->chainedCount = in_count;
+        PublishEntry( m_handle, entry, position );
+        WaitEntry( m_handle, position );
+        return ( result == VK_SUCCESS ) ? position + 1 : 0;
+    }
+    
+    // the ring position give the value, the thread send the entries in order 
+    VkSemaphoreSubmitInfo signalInfo{};
+    signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    signalInfo.semaphore = m_handle->timeline;
+    signalInfo.value = position + 1;
+    signalInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+    entry->type = CRVK_QUEUE_ENTRY_SUBMIT;
+    entry->fence = in_fence;
+    ResetBatch( &entry->batch );
+    AppendSubmits( &entry->batch, in_submits, in_count, &signalInfo );
+    
+    PublishEntry( m_handle, entry, position );
+    return position + 1;
+}
+
+/*
+==============================================
+crvkDeviceQueue::PresentAsync
+==============================================
+*/
+void crvkDeviceQueue::PresentAsync( 
+        const VkSwapchainKHR* in_swapchains,
+        const uint32_t* in_imageIndices,
+        const uint32_t in_swapchainCount,
+        const VkSemaphore* in_waitSemaphores,
+        const uint32_t in_waitSemaphoresCount )
+{
+    uint64_t position = 0;
+
+    if ( m_handle == nullptr || m_handle->thread == nullptr )
+        return;
+
+    crvkQueueEntry_t* entry = ClaimEntry( m_handle, &position );
+    entry->type = CRVK_QUEUE_ENTRY_PRESENT;
+    entry->swapchains.Reset();
+    entry->imageIndices.Reset();
+    entry->semaphores.Reset();
+    
+    for ( uint32_t i = 0; i < in_swapchainCount; i++ )
+    {
+        entry->swapchains.Append( in_swapchains[i] );
+        entry->imageIndices.Append( in_imageIndices[i] );
+    }
+
+    for ( uint32_t i = 0; i < in_waitSemaphoresCount; i++ )
+        entry->semaphores.Append( in_waitSemaphores[i] );
+
+    PublishEntry( m_handle, entry, position );
+}
+
+/*
+==============================================
+crvkDeviceQueue::Timeline
+==============================================
+*/
+VkSemaphore crvkDeviceQueue::Timeline( void ) const
+{
+    if ( m_handle == nullptr )
+        return nullptr;
+
+    return m_handle->timeline;
+}
+
+/*
+==============================================
+crvkDeviceQueue::LastSubmitResult
+==============================================
+*/
+VkResult crvkDeviceQueue::LastSubmitResult( void ) const
+{
+    if ( m_handle == nullptr )
+        return VK_ERROR_INITIALIZATION_FAILED;
+
+    return static_cast<VkResult>( m_handle->submitResult.load() );
+}
+
+/*
+==============================================
+crvkDeviceQueue::LastPresentResult
+==============================================
+*/
+VkResult crvkDeviceQueue::LastPresentResult( void ) const
+{
+    if ( m_handle == nullptr )
+        return VK_ERROR_INITIALIZATION_FAILED;
+
+    return static_cast<VkResult>( m_handle->presentResult.load() );
+}
+
+/*
+==============================================
+crvkDeviceQueue::SubmitStats
+==============================================
+*/
+void crvkDeviceQueue::SubmitStats( crvkQueueSubmitStats_t* out_stats ) const
+{
+    out_stats->entries = m_handle->statEntries;
+    out_stats->batches = m_handle->statBatches;
+    out_stats->lastLatency = m_handle->statLastLatency;
+    out_stats->maxLatency = m_handle->statMaxLatency;
+    out_stats->totalLatency = m_handle->statTotalLatency;
+}
+
+/*
+==============================================
+crvkDeviceQueue::SubmitWorker
+==============================================
+*/
+void crvkDeviceQueue::SubmitWorker( void )
+{
+    VkResult result = VK_SUCCESS;
+    crvkQueueEntry_t* entry = nullptr;
+
+    while ( true )
+    {
+        entry = &m_handle->entries[m_handle->dequeuePos & ( m_handle->capacity - 1 )];
+        
+        /// ==================================================================
+        /// Sleep until a producer publish a entry 
+        /// ==================================================================
+        if ( entry->sequence.load() != m_handle->dequeuePos + 1 )
+        {
+            // seq_cst, pair with the producer publish 
+            m_handle->sleeping.store( 1 );
+            
+            std::unique_lock<std::mutex> lock( m_handle->lock );
+            m_handle->workCond.wait( lock, [this, entry]{ return m_handle->quit || entry->sequence.load() == m_handle->dequeuePos + 1; } );
+            m_handle->sleeping.store( 0 );
+            
+            // quit only with a empty ring 
+            if ( entry->sequence.load() != m_handle->dequeuePos + 1 )
+                return;
+        }
+
+        /// ==================================================================
+        /// Drain the ready entries, the consecutive submits go in a single vkQueueSubmit2 
+        /// ==================================================================
+        while ( entry->sequence.load( std::memory_order_acquire ) == m_handle->dequeuePos + 1 )
+        {
+            result = VK_SUCCESS;
+            
+            switch ( entry->type )
+            {
+            case CRVK_QUEUE_ENTRY_SUBMIT:
+                AppendBatch( &m_handle->batch, &entry->batch );
+                m_handle->times.Append( entry->time );
+                m_handle->lastValue = m_handle->dequeuePos + 1;
+                if ( entry->fence != nullptr )
+                    result = SendTimedBatch( m_handle, entry->fence );
+                break;
+
+            case CRVK_QUEUE_ENTRY_SUBMIT_CHAINED:
+            {
+                // the queued work go first, the value is signaled by a lone submit after the chained ones 
+                VkSemaphoreSubmitInfo signalInfo{};
+                signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+                signalInfo.semaphore = m_handle->timeline;
+                signalInfo.value = m_handle->dequeuePos + 1;
+                signalInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+                result = SendTimedBatch( m_handle, nullptr );
+                if ( result == VK_SUCCESS )
+                    result = vkQueueSubmit2( m_handle->queue, entry->chainedCount, entry->chained, entry->fence );
+                
+                if ( result != VK_SUCCESS )
+                {
+                    int32_t expected = VK_SUCCESS;
+                    m_handle->submitResult.compare_exchange_strong( expected, result );
+                    crvkAppendError( "crvkDeviceQueue::SubmitWorker::vkQueueSubmit2", result );
+                }
+
+                AppendSubmits( &m_handle->batch, nullptr, 0, &signalInfo );
+                m_handle->times.Append( entry->time );
+                m_handle->lastValue = m_handle->dequeuePos + 1;
+                break;
+            }
+
+            case CRVK_QUEUE_ENTRY_PRESENT:
+            {
+                // the present wait semaphores must be signaled by submitted work 
+                SendTimedBatch( m_handle, nullptr );
+
+                VkPresentInfoKHR presentInfo{};
+                presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+                presentInfo.waitSemaphoreCount = entry->semaphores.Count();
+                presentInfo.pWaitSemaphores = entry->semaphores.Pointer();
+                presentInfo.swapchainCount = entry->swapchains.Count();
+                presentInfo.pSwapchains = entry->swapchains.Pointer();
+                presentInfo.pImageIndices = entry->imageIndices.Pointer();
+                result = vkQueuePresentKHR( m_handle->queue, &presentInfo );
+                m_handle->presentResult = result;
+                RecordLatency( m_handle, entry->time );
+                break;
+            }
+
+            case CRVK_QUEUE_ENTRY_FLUSH:
+                result = SendTimedBatch( m_handle, entry->fence );
+                break;
+
+            case CRVK_QUEUE_ENTRY_WAIT_IDLE:
+                SendTimedBatch( m_handle, nullptr );
+                result = vkQueueWaitIdle( m_handle->queue );
+                break;
+            }
+
+            // the waiting producer read it after the completed update 
+            if ( entry->result != nullptr )
+                *entry->result = result;
+
+            // give the cell back, for the position one lap ahead 
+            entry->sequence.store( m_handle->dequeuePos + m_handle->capacity, std::memory_order_release );
+            m_handle->dequeuePos++;
+            entry = &m_handle->entries[m_handle->dequeuePos & ( m_handle->capacity - 1 )];
+        }
+
+        SendTimedBatch( m_handle, nullptr );
+
+        {
+            std::lock_guard<std::mutex> lock( m_handle->lock );
+            m_handle->completed = m_handle->dequeuePos;
+        }
+
+        m_handle->doneCond.notify_all();
+    }
 }
 
 /*
@@ -156,6 +1035,39 @@ VkResult crvkDeviceQueue::Present(
         const VkSemaphore* in_waitSemaphores,
         const uint32_t in_waitSemaphoresCount )
 {
+    VkResult result = VK_SUCCESS;
+
+    // the submission thread own the queue, wait it present 
+    if ( m_handle->thread != nullptr )
+    {
+        uint64_t position = 0;
+        crvkQueueEntry_t* entry = ClaimEntry( m_handle, &position );
+        entry->type = CRVK_QUEUE_ENTRY_PRESENT;
+        entry->result = &result;
+        entry->swapchains.Reset();
+        entry->imageIndices.Reset();
+        entry->semaphores.Reset();
+        
+        for ( uint32_t i = 0; i < in_swapchainCount; i++ )
+        {
+            entry->swapchains.Append( in_swapchains[i] );
+            entry->imageIndices.Append( in_imageIndices[i] );
+        }
+
+        for ( uint32_t i = 0; i < in_waitSemaphoresCount; i++ )
+            entry->semaphores.Append( in_waitSemaphores[i] );
+
+        PublishEntry( m_handle, entry, position );
+        WaitEntry( m_handle, position );
+        return result;
+    }
+
+    // the present wait semaphores must be signaled by submitted work 
+    std::lock_guard<std::mutex> lock( m_handle->submitLock );
+    result = SendBatch( m_handle, nullptr );
+    if ( result != VK_SUCCESS )
+        return result;
+
     VkPresentInfoKHR presentInfo{};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
     presentInfo.waitSemaphoreCount = in_waitSemaphoresCount;
@@ -171,11 +1083,29 @@ VkResult crvkDeviceQueue::Present(
 crvkDeviceQueue::WaitIdle
 ==============================================
 */
-VkResult crvkDeviceQueue::WaitIdle( void ) const
+VkResult crvkDeviceQueue::WaitIdle( void )
 {
     if ( m_handle == nullptr )
         return VK_ERROR_INITIALIZATION_FAILED;    
 
+    // the submission thread own the queue, wait it drain 
+    if ( m_handle->thread != nullptr )
+    {
+        VkResult result = VK_SUCCESS;
+        uint64_t position = 0;
+        crvkQueueEntry_t* entry = ClaimEntry( m_handle, &position );
+        entry->type = CRVK_QUEUE_ENTRY_WAIT_IDLE;
+        entry->result = &result;
+        PublishEntry( m_handle, entry, position );
+        WaitEntry( m_handle, position );
+        if ( result != VK_SUCCESS )
+            return result;
+
+        return static_cast<VkResult>( m_handle->submitResult.exchange( VK_SUCCESS ) );
+    }
+
+    std::lock_guard<std::mutex> lock( m_handle->submitLock );
+    SendBatch( m_handle, nullptr );
     return vkQueueWaitIdle( m_handle->queue );
 }
 
@@ -230,4 +1160,4 @@ VkCommandPool crvkDeviceQueue::CommandPool( void ) const
         return nullptr;
 
     return m_handle->commandPool;
-}
\ No newline at end of file
+}
@@ -0,0 +1,603 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+#include "crvkPrecompiled.hpp"
+#include "crvkRangeAllocator.hpp"
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+static const uint32_t       k_slIndexCountLog2 = 5;                             // second level subdivisions ( log2 )
+static const uint32_t       k_slIndexCount = 1 << k_slIndexCountLog2;           // second level lists per first level 
+static const uint32_t       k_flIndexCount = 64 - k_slIndexCountLog2 + 1;       // first level lists to cover 64 bits sizes 
+static const uint32_t       k_nullNode = crvkRangeAllocator::k_invalidRange;    // invalid node index
+
+typedef struct crvkRangeNode_t
+{
+    bool            free;           // true if range are in a free list 
+    uint32_t        prevPhysical;   // range before this in the space 
+    uint32_t        nextPhysical;   // range after this in the space 
+    uint32_t        prevFree;       // free list links, also used to chain unused nodes  
+    uint32_t        nextFree;       
+    VkDeviceSize    offset;         // range offset 
+    VkDeviceSize    size;           // range size 
+} crvkRangeNode_t;
+
+typedef struct crvkRangeAllocatorHandle_t
+{
+    uint32_t                            allocationCount = 0;            // live ranges 
+    uint32_t                            freeCount = 0;                  // ranges on the free lists 
+    uint32_t                            unusedNode = k_nullNode;        // recycled node chain 
+    uint32_t                            slBitmap[k_flIndexCount];       // second level free lists bitmap 
+    uint32_t                            freeHeads[k_flIndexCount][k_slIndexCount]; // free lists heads 
+    uint64_t                            flBitmap = 0;                   // first level free lists bitmap
+    VkDeviceSize                        size = 0;                       // space size 
+    VkDeviceSize                        used = 0;                       // allocated bytes
+    crvkDynamicVector<crvkRangeNode_t>  nodes;                          // range nodes 
+} crvkRangeAllocatorHandle_t;
+
+///
+/// TLSF helpers 
+/// ==========================================================================
+
+static inline uint32_t FindFirstSet( const uint64_t in_value )
+{
+#if defined( _MSC_VER )
+    unsigned long index = 0;
+    _BitScanForward64( &index, in_value );
+    return static_cast<uint32_t>( index );
+#else
+    return static_cast<uint32_t>( __builtin_ctzll( in_value ) );
+#endif
+}
+
+static inline uint32_t FindLastSet( const uint64_t in_value )
+{
+#if defined( _MSC_VER )
+    unsigned long index = 0;
+    _BitScanReverse64( &index, in_value );
+    return static_cast<uint32_t>( index );
+#else
+    return 63u - static_cast<uint32_t>( __builtin_clzll( in_value ) );
+#endif
+}
+
+static inline VkDeviceSize AlignUp( const VkDeviceSize in_value, const VkDeviceSize in_alignment )
+{
+    return ( in_value + in_alignment - 1 ) & ~( in_alignment - 1 );
+}
+
+// find the list where a range of this size is stored 
+static inline void MappingInsert( const VkDeviceSize in_size, uint32_t &out_fl, uint32_t &out_sl )
+{
+    if ( in_size < k_slIndexCount )
+    {
+        out_fl = 0;
+        out_sl = static_cast<uint32_t>( in_size );
+    }
+    else
+    {
+        uint32_t fls = FindLastSet( in_size );
+        out_sl = static_cast<uint32_t>( in_size >> ( fls - k_slIndexCountLog2 ) ) ^ k_slIndexCount;
+        out_fl = fls - k_slIndexCountLog2 + 1;
+    }
+}
+
+// find the first list where any range fit the size 
+static inline void MappingSearch( const VkDeviceSize in_size, uint32_t &out_fl, uint32_t &out_sl )
+{
+    VkDeviceSize size = in_size;
+    if ( size >= k_slIndexCount )
+        size += ( 1ull << ( FindLastSet( size ) - k_slIndexCountLog2 ) ) - 1;
+
+    MappingInsert( size, out_fl, out_sl );
+}
+
+/*
+==============================================
+crvkRangeAllocator::crvkRangeAllocator
+==============================================
+*/
+crvkRangeAllocator::crvkRangeAllocator( void ) : m_handle( nullptr )
+{
+}
+
+/*
+==============================================
+crvkRangeAllocator::~crvkRangeAllocator
+==============================================
+*/
+crvkRangeAllocator::~crvkRangeAllocator( void )
+{
+    Destroy();
+}
+
+/*
+==============================================
+crvkRangeAllocator::Create
+==============================================
+*/
+bool crvkRangeAllocator::Create( const VkDeviceSize in_size )
+{
+    if ( in_size < k_minAlignment )
+        return false;
+
+    if ( m_handle == nullptr )
+        m_handle = new crvkRangeAllocatorHandle_t();
+
+    m_handle->size = in_size;
+    m_handle->used = 0;
+    m_handle->allocationCount = 0;
+    m_handle->freeCount = 0;
+    m_handle->unusedNode = k_nullNode;
+    m_handle->flBitmap = 0;
+    m_handle->nodes.Reset();
+    std::memset( m_handle->slBitmap, 0x00, sizeof( m_handle->slBitmap ) );
+    std::memset( m_handle->freeHeads, 0xFF, sizeof( m_handle->freeHeads ) ); // k_nullNode 
+
+    // a single free range cover the whole space 
+    uint32_t index = NewNode();
+    crvkRangeNode_t& node = m_handle->nodes[index];
+    node.offset = 0;
+    node.size = in_size;
+    node.prevPhysical = k_nullNode;
+    node.nextPhysical = k_nullNode;
+    InsertFree( index );
+    return true;
+}
+
+/*
+==============================================
+crvkRangeAllocator::Destroy
+==============================================
+*/
+void crvkRangeAllocator::Destroy( void )
+{
+    if ( m_handle == nullptr )
+        return;
+
+    delete m_handle;
+    m_handle = nullptr;
+}
+
+/*
+==============================================
+crvkRangeAllocator::Allocate
+==============================================
+*/
+bool crvkRangeAllocator::Allocate( const VkDeviceSize in_size, const VkDeviceSize in_alignment, uint32_t* out_range )
+{
+    uint32_t fl = 0;
+    uint32_t sl = 0;
+    uint32_t index = k_nullNode;
+    VkDeviceSize size = AlignUp( std::max( in_size, (VkDeviceSize)1 ), k_minAlignment );
+    VkDeviceSize alignment = std::max( in_alignment, k_minAlignment );
+    VkDeviceSize searchSize = size;
+
+    *out_range = k_nullNode;
+    if ( m_handle == nullptr || m_handle->flBitmap == 0 )
+        return false;
+
+    if ( m_handle->allocationCount == 0 )
+    {
+        // empty, the only free range start at offset 0 that is aligned to anything, no need of the
+        // padding or the size class round up, so a space made for a single allocation can hold it 
+        if ( size > m_handle->size )
+            return false;
+
+        fl = FindLastSet( m_handle->flBitmap );
+        sl = FindLastSet( m_handle->slBitmap[fl] );
+    }
+    else
+    {
+        // ranges start at k_minAlignment, reserve space for the worst case padding 
+        if ( alignment > k_minAlignment )
+            searchSize += alignment - k_minAlignment;
+
+        if ( searchSize > m_handle->size )
+            return false;
+
+        MappingSearch( searchSize, fl, sl );
+        if ( fl >= k_flIndexCount )
+            return false;
+
+        // find a non empty list, on the same first level, or on the next one 
+        uint32_t slMap = m_handle->slBitmap[fl] & ( ~0u << sl );
+        if ( slMap == 0 )
+        {
+            uint64_t flMap = ( fl + 1 < k_flIndexCount ) ? m_handle->flBitmap & ( ~0ull << ( fl + 1 ) ) : 0;
+            if ( flMap == 0 )
+                return false;
+
+            fl = FindFirstSet( flMap );
+            slMap = m_handle->slBitmap[fl];
+        }
+
+        sl = FindFirstSet( slMap );
+    }
+
+    index = m_handle->freeHeads[fl][sl];
+    RemoveFree( index );
+
+    // split the front padding in a new free range 
+    VkDeviceSize padding = AlignUp( m_handle->nodes[index].offset, alignment ) - m_handle->nodes[index].offset;
+    if ( padding > 0 )
+    {
+        uint32_t front = NewNode(); // can move the node array
+        crvkRangeNode_t& node = m_handle->nodes[index];
+        crvkRangeNode_t& frontNode = m_handle->nodes[front];
+        frontNode.offset = node.offset;
+        frontNode.size = padding;
+        frontNode.prevPhysical = node.prevPhysical;
+        frontNode.nextPhysical = index;
+        if ( node.prevPhysical != k_nullNode )
+            m_handle->nodes[node.prevPhysical].nextPhysical = front;
+
+        node.prevPhysical = front;
+        node.offset += padding;
+        node.size -= padding;
+        InsertFree( front );
+    }
+
+    // return the remaining space to the free lists
+    if ( m_handle->nodes[index].size - size >= k_minAlignment )
+    {
+        uint32_t back = NewNode();
+        crvkRangeNode_t& node = m_handle->nodes[index];
+        crvkRangeNode_t& backNode = m_handle->nodes[back];
+        backNode.offset = node.offset + size;
+        backNode.size = node.size - size;
+        backNode.prevPhysical = index;
+        backNode.nextPhysical = node.nextPhysical;
+        if ( node.nextPhysical != k_nullNode )
+            m_handle->nodes[node.nextPhysical].prevPhysical = back;
+
+        node.nextPhysical = back;
+        node.size = size;
+        InsertFree( back );
+    }
+
+    m_handle->used += m_handle->nodes[index].size;
+    m_handle->allocationCount++;
+    *out_range = index;
+    return true;
+}
+
+/*
+==============================================
+crvkRangeAllocator::Free
+==============================================
+*/
+void crvkRangeAllocator::Free( const uint32_t in_range )
+{
+    uint32_t index = in_range;
+
+    if ( m_handle == nullptr || in_range >= m_handle->nodes.Count() )
+        return;
+
+    SDL_assert( !m_handle->nodes[index].free );
+    m_handle->used -= m_handle->nodes[index].size;
+    m_handle->allocationCount--;
+
+    // merge with the next range 
+    uint32_t next = m_handle->nodes[index].nextPhysical;
+    if ( next != k_nullNode && m_handle->nodes[next].free )
+    {
+        RemoveFree( next );
+        m_handle->nodes[index].size += m_handle->nodes[next].size;
+        m_handle->nodes[index].nextPhysical = m_handle->nodes[next].nextPhysical;
+        if ( m_handle->nodes[next].nextPhysical != k_nullNode )
+            m_handle->nodes[m_handle->nodes[next].nextPhysical].prevPhysical = index;
+        
+        ReleaseNode( next );
+    }
+
+    // merge with the previous range 
+    uint32_t prev = m_handle->nodes[index].prevPhysical;
+    if ( prev != k_nullNode && m_handle->nodes[prev].free )
+    {
+        RemoveFree( prev );
+        m_handle->nodes[prev].size += m_handle->nodes[index].size;
+        m_handle->nodes[prev].nextPhysical = m_handle->nodes[index].nextPhysical;
+        if ( m_handle->nodes[index].nextPhysical != k_nullNode )
+            m_handle->nodes[m_handle->nodes[index].nextPhysical].prevPhysical = prev;
+
+        ReleaseNode( index );
+        index = prev;
+    }
+
+    InsertFree( index );
+}
+
+/*
+==============================================
+crvkRangeAllocator::Offset
+==============================================
+*/
+VkDeviceSize crvkRangeAllocator::Offset( const uint32_t in_range ) const
+{
+    return m_handle->nodes[in_range].offset;
+}
+
+/*
+==============================================
+crvkRangeAllocator::Size
+==============================================
+*/
+VkDeviceSize crvkRangeAllocator::Size( const uint32_t in_range ) const
+{
+    return m_handle->nodes[in_range].size;
+}
+
+/*
+==============================================
+crvkRangeAllocator::Capacity
+==============================================
+*/
+VkDeviceSize crvkRangeAllocator::Capacity( void ) const
+{
+    if ( m_handle == nullptr )
+        return 0;
+
+    return m_handle->size;
+}
+
+/*
+==============================================
+crvkRangeAllocator::Used
+==============================================
+*/
+VkDeviceSize crvkRangeAllocator::Used( void ) const
+{
+    if ( m_handle == nullptr )
+        return 0;
+
+    return m_handle->used;
+}
+
+/*
+==============================================
+crvkRangeAllocator::AllocationCount
+==============================================
+*/
+uint32_t crvkRangeAllocator::AllocationCount( void ) const
+{
+    if ( m_handle == nullptr )
+        return 0;
+
+    return m_handle->allocationCount;
+}
+
+/*
+==============================================
+crvkRangeAllocator::FreeRangeCount
+==============================================
+*/
+uint32_t crvkRangeAllocator::FreeRangeCount( void ) const
+{
+    if ( m_handle == nullptr )
+        return 0;
+
+    return m_handle->freeCount;
+}
+
+/*
+==============================================
+crvkRangeAllocator::LargestFree
+==============================================
+*/
+VkDeviceSize crvkRangeAllocator::LargestFree( void ) const
+{
+    VkDeviceSize largest = 0;
+    if ( m_handle == nullptr || m_handle->flBitmap == 0 )
+        return 0;
+
+    // the biggest ranges are in the last non empty list
+    uint32_t fl = FindLastSet( m_handle->flBitmap );
+    uint32_t sl = FindLastSet( m_handle->slBitmap[fl] );
+    for ( uint32_t i = m_handle->freeHeads[fl][sl]; i != k_nullNode; i = m_handle->nodes[i].nextFree )
+        largest = std::max( largest, m_handle->nodes[i].size );
+
+    return largest;
+}
+
+/*
+==============================================
+crvkRangeAllocator::Validate
+==============================================
+*/
+bool crvkRangeAllocator::Validate( void ) const
+{
+    uint32_t first = k_nullNode;
+    uint32_t allocations = 0;
+    uint32_t freeRanges = 0;
+    uint32_t listed = 0;
+    VkDeviceSize used = 0;
+    VkDeviceSize offset = 0;
+
+    if ( m_handle == nullptr )
+        return true;
+
+    // the unused nodes are out of the space 
+    crvkDynamicVector<bool> unused;
+    unused.Resize( m_handle->nodes.Count() );
+    unused.Memset( 0 );
+    for ( uint32_t i = m_handle->unusedNode; i != k_nullNode; i = m_handle->nodes[i].nextFree )
+        unused[i] = true;
+
+    for ( uint32_t i = 0; i < m_handle->nodes.Count() && first == k_nullNode; i++ )
+    {
+        if ( !unused[i] && m_handle->nodes[i].prevPhysical == k_nullNode )
+            first = i;
+    }
+
+    ///
+    /// The physical chain must cover the space without holes, and never have two free neighbors 
+    /// ==========================================================================
+    uint32_t prev = k_nullNode;
+    for ( uint32_t i = first; i != k_nullNode; i = m_handle->nodes[i].nextPhysical )
+    {
+        const crvkRangeNode_t& node = m_handle->nodes[i];
+        if ( unused[i] || node.prevPhysical != prev || node.offset != offset || node.size == 0 )
+            return false;
+
+        if ( node.free )
+        {
+            if ( prev != k_nullNode && m_handle->nodes[prev].free )
+                return false;
+            
+            freeRanges++;
+        }
+        else
+        {
+            allocations++;
+            used += node.size;
+        }
+
+        offset += node.size;
+        prev = i;
+    }
+
+    if ( offset != m_handle->size || allocations != m_handle->allocationCount || freeRanges != m_handle->freeCount || used != m_handle->used )
+        return false;
+
+    ///
+    /// Every free range must be in the list of his size, and the bitmaps match the lists 
+    /// ==========================================================================
+    for ( uint32_t fl = 0; fl < k_flIndexCount; fl++ )
+    {
+        for ( uint32_t sl = 0; sl < k_slIndexCount; sl++ )
+        {
+            uint32_t head = m_handle->freeHeads[fl][sl];
+            bool bit = ( m_handle->slBitmap[fl] & ( 1u << sl ) ) != 0;
+            if ( bit != ( head != k_nullNode ) )
+                return false;
+
+            for ( uint32_t i = head; i != k_nullNode; i = m_handle->nodes[i].nextFree )
+            {
+                uint32_t nodeFl = 0;
+                uint32_t nodeSl = 0;
+                MappingInsert( m_handle->nodes[i].size, nodeFl, nodeSl );
+                if ( !m_handle->nodes[i].free || nodeFl != fl || nodeSl != sl || ++listed > freeRanges )
+                    return false;
+            }
+        }
+
+        if ( ( ( m_handle->flBitmap >> fl ) & 1 ) != ( m_handle->slBitmap[fl] != 0 ) )
+            return false;
+    }
+
+    return listed == freeRanges;
+}
+
+/*
+==============================================
+crvkRangeAllocator::NewNode
+==============================================
+*/
+uint32_t crvkRangeAllocator::NewNode( void )
+{
+    crvkRangeNode_t node{};
+
+    // reuse a released node 
+    if ( m_handle->unusedNode != k_nullNode )
+    {
+        uint32_t index = m_handle->unusedNode;
+        m_handle->unusedNode = m_handle->nodes[index].nextFree;
+        m_handle->nodes[index] = node;
+        return index;
+    }
+
+    return m_handle->nodes.Append( node );
+}
+
+/*
+==============================================
+crvkRangeAllocator::ReleaseNode
+==============================================
+*/
+void crvkRangeAllocator::ReleaseNode( const uint32_t in_node )
+{
+    m_handle->nodes[in_node].free = false;
+    m_handle->nodes[in_node].nextFree = m_handle->unusedNode;
+    m_handle->unusedNode = in_node;
+}
+
+/*
+==============================================
+crvkRangeAllocator::InsertFree
+==============================================
+*/
+void crvkRangeAllocator::InsertFree( const uint32_t in_node )
+{
+    uint32_t fl = 0;
+    uint32_t sl = 0;
+    crvkRangeNode_t& node = m_handle->nodes[in_node];
+    MappingInsert( node.size, fl, sl );
+
+    uint32_t head = m_handle->freeHeads[fl][sl];
+    node.free = true;
+    node.prevFree = k_nullNode;
+    node.nextFree = head;
+    if ( head != k_nullNode )
+        m_handle->nodes[head].prevFree = in_node;
+
+    m_handle->freeHeads[fl][sl] = in_node;
+    m_handle->flBitmap |= 1ull << fl;
+    m_handle->slBitmap[fl] |= 1u << sl;
+    m_handle->freeCount++;
+}
+
+/*
+==============================================
+crvkRangeAllocator::RemoveFree
+==============================================
+*/
+void crvkRangeAllocator::RemoveFree( const uint32_t in_node )
+{
+    uint32_t fl = 0;
+    uint32_t sl = 0;
+    crvkRangeNode_t& node = m_handle->nodes[in_node];
+    MappingInsert( node.size, fl, sl );
+
+    if ( node.prevFree != k_nullNode )
+        m_handle->nodes[node.prevFree].nextFree = node.nextFree;
+    if ( node.nextFree != k_nullNode )
+        m_handle->nodes[node.nextFree].prevFree = node.prevFree;
+
+    // list head, update the bitmaps if the list get empty 
+    if ( m_handle->freeHeads[fl][sl] == in_node )
+    {
+        m_handle->freeHeads[fl][sl] = node.nextFree;
+        if ( node.nextFree == k_nullNode )
+        {
+            m_handle->slBitmap[fl] &= ~( 1u << sl );
+            if ( m_handle->slBitmap[fl] == 0 )
+                m_handle->flBitmap &= ~( 1ull << fl );
+        }
+    }
+
+    node.free = false;
+    node.prevFree = k_nullNode;
+    node.nextFree = k_nullNode;
+    m_handle->freeCount--;
+}
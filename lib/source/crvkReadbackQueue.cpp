@@ -0,0 +1,343 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+#include "crvkPrecompiled.hpp"
+#include "crvkReadbackQueue.hpp"
+
+typedef struct crvkReadbackEntry_t
+{
+    crvkReadbackTicket_t    ticket;
+    crvkStagingRange_t      range;
+    VkDeviceSize            offset;     // content offset in the range 
+    VkDeviceSize            size;
+    crvkTimelinePoint_t     copy;       // the copy end 
+    crvkDeviceQueue*        queue;      // flushed before wait 
+    crvkReadbackCallback_t  callback;
+    void*                   userData;
+} crvkReadbackEntry_t;
+
+typedef struct crvkReadbackQueueHandle_t
+{
+    crvkReadbackTicket_t                    nextTicket = 1;
+    crvkDynamicVector<crvkReadbackEntry_t>  entries;    // in ticket order 
+    crvkDynamicVector<crvkTimelinePoint_t>  counters;   // semaphore values read by Poll 
+    crvkUploadManager*                      readback = nullptr;
+    VkDevice                                device = nullptr;
+    mutable std::mutex                      lock;
+} crvkReadbackQueueHandle_t;
+
+/*
+==============================================
+Deliver
+==============================================
+*/
+static void Deliver( crvkUploadManager* in_readback, const crvkReadbackEntry_t* in_entry, void* out_data )
+{
+    const uint8_t* data = static_cast<const uint8_t*>( in_entry->range.pointer ) + in_entry->offset;
+
+    // non coherent memory need a invalidate before the CPU read 
+    in_readback->Invalidate( &in_entry->range );
+    
+    if ( out_data != nullptr )
+        std::memcpy( out_data, data, in_entry->size );
+
+    if ( in_entry->callback != nullptr )
+        in_entry->callback( data, in_entry->size, in_entry->userData );
+
+    in_readback->Release( &in_entry->range );
+}
+
+/*
+==============================================
+crvkReadbackQueue::crvkReadbackQueue
+==============================================
+*/
+crvkReadbackQueue::crvkReadbackQueue( void ) : m_handle( nullptr )
+{
+}
+
+/*
+==============================================
+crvkReadbackQueue::~crvkReadbackQueue
+==============================================
+*/
+crvkReadbackQueue::~crvkReadbackQueue( void )
+{
+    Destroy();
+
+    if ( m_handle != nullptr )
+    {
+        delete m_handle;
+        m_handle = nullptr;
+    }
+}
+
+/*
+==============================================
+crvkReadbackQueue::Create
+==============================================
+*/
+bool crvkReadbackQueue::Create( const crvkDevice* in_device )
+{
+    if ( m_handle == nullptr )
+        m_handle = new crvkReadbackQueueHandle_t();
+
+    m_handle->device = in_device->Device();
+    m_handle->readback = in_device->ReadbackManager();
+    return m_handle->readback != nullptr;
+}
+
+/*
+==============================================
+crvkReadbackQueue::Destroy
+==============================================
+*/
+void crvkReadbackQueue::Destroy( void )
+{
+    if ( m_handle == nullptr )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    crvkDynamicVector<crvkReadbackEntry_t>& entries = m_handle->entries;
+    for ( uint32_t i = 0; i < entries.Count(); i++ )
+    {
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &entries[i].copy.semaphore;
+        waitInfo.pValues = &entries[i].copy.value;
+
+        // the ring can't get back a range the GPU still write 
+        if ( entries[i].queue != nullptr )
+            entries[i].queue->Flush();
+
+        vkWaitSemaphores( m_handle->device, &waitInfo, UINT64_MAX );
+        m_handle->readback->Release( &entries[i].range );
+    }
+
+    entries.Clear();
+    m_handle->counters.Clear();
+}
+
+/*
+==============================================
+crvkReadbackQueue::Enqueue
+==============================================
+*/
+crvkReadbackTicket_t crvkReadbackQueue::Enqueue( 
+        const crvkStagingRange_t* in_range, 
+        const VkDeviceSize in_offset, 
+        const VkDeviceSize in_size, 
+        const crvkTimelinePoint_t* in_copy, 
+        crvkDeviceQueue* in_queue, 
+        crvkReadbackCallback_t in_callback, 
+        void* in_userData )
+{
+    crvkReadbackEntry_t entry{};
+    entry.range = *in_range;
+    entry.offset = in_offset;
+    entry.size = in_size;
+    entry.copy = *in_copy;
+    entry.queue = in_queue;
+    entry.callback = in_callback;
+    entry.userData = in_userData;
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    entry.ticket = m_handle->nextTicket++;
+    m_handle->entries.Append( entry );
+    return entry.ticket;
+}
+
+/*
+==============================================
+crvkReadbackQueue::Poll
+==============================================
+*/
+uint32_t crvkReadbackQueue::Poll( void )
+{
+    crvkDynamicVector<crvkReadbackEntry_t> finished;
+
+    if ( m_handle == nullptr )
+        return 0;
+
+    {
+        std::lock_guard<std::mutex> lock( m_handle->lock );
+        crvkDynamicVector<crvkReadbackEntry_t>& entries = m_handle->entries;
+        crvkDynamicVector<crvkTimelinePoint_t>& counters = m_handle->counters;
+    
+        ///
+        /// Read each semaphore once, the copies of a object share his semaphore 
+        /// ==========================================================================
+        counters.Reset();
+        for ( uint32_t i = 0; i < entries.Count(); i++ )
+        {
+            VkSemaphore semaphore = entries[i].copy.semaphore;
+            bool found = false;
+            for ( uint32_t k = 0; k < counters.Count() && !found; k++ )
+                found = ( counters[k].semaphore == semaphore );
+
+            if ( found )
+                continue;
+
+            // a copy still in a deferred queue never finish
+            if ( entries[i].queue != nullptr && entries[i].queue->PendingCount() > 0 )
+                entries[i].queue->Flush();
+
+            crvkTimelinePoint_t counter{ semaphore, 0 };
+            VkResult result = vkGetSemaphoreCounterValue( m_handle->device, semaphore, &counter.value );
+            if ( result != VK_SUCCESS )
+                crvkAppendError( "crvkReadbackQueue::Poll::vkGetSemaphoreCounterValue", result );
+
+            counters.Append( counter );
+        }
+
+        ///
+        /// Take the finished read backs and keep the others in order 
+        /// ==========================================================================
+        uint32_t kept = 0;
+        for ( uint32_t i = 0; i < entries.Count(); i++ )
+        {
+            bool done = false;
+            for ( uint32_t k = 0; k < counters.Count(); k++ )
+            {
+                if ( counters[k].semaphore == entries[i].copy.semaphore )
+                {
+                    done = ( counters[k].value >= entries[i].copy.value );
+                    break;
+                }
+            }
+
+            if ( done )
+            {
+                finished.Append( entries[i] );
+                continue;
+            }
+
+            if ( kept != i )
+                entries[kept] = entries[i];
+        
+            kept++;
+        }
+
+        entries.Reset();
+        entries.Resize( kept );
+    }
+
+    // the callbacks run without the lock, they can start new read backs 
+    for ( uint32_t i = 0; i < finished.Count(); i++ )
+        Deliver( m_handle->readback, &finished[i], nullptr );
+
+    return finished.Count();
+}
+
+/*
+==============================================
+crvkReadbackQueue::IsReady
+==============================================
+*/
+bool crvkReadbackQueue::IsReady( const crvkReadbackTicket_t in_ticket ) const
+{
+    crvkTimelinePoint_t copy{};
+
+    {
+        std::lock_guard<std::mutex> lock( m_handle->lock );
+        const crvkDynamicVector<crvkReadbackEntry_t>& entries = m_handle->entries;
+        uint32_t i = 0;
+        while ( i < entries.Count() && entries[i].ticket != in_ticket )
+            i++;
+
+        // already delivered 
+        if ( i == entries.Count() )
+            return true;
+
+        copy = entries[i].copy;
+    }
+
+    uint64_t value = 0;
+    vkGetSemaphoreCounterValue( m_handle->device, copy.semaphore, &value );
+    return value >= copy.value;
+}
+
+/*
+==============================================
+crvkReadbackQueue::Wait
+==============================================
+*/
+bool crvkReadbackQueue::Wait( const crvkReadbackTicket_t in_ticket, void* out_data )
+{
+    crvkReadbackEntry_t entry{};
+
+    ///
+    /// Take the read back out of the queue, so a Poll from other thread don't deliver it 
+    /// ==========================================================================
+    {
+        std::lock_guard<std::mutex> lock( m_handle->lock );
+        crvkDynamicVector<crvkReadbackEntry_t>& entries = m_handle->entries;
+        uint32_t i = 0;
+        while ( i < entries.Count() && entries[i].ticket != in_ticket )
+            i++;
+
+        if ( i == entries.Count() )
+            return false;
+
+        entry = entries[i];
+        uint32_t count = entries.Count() - 1;
+        for ( ; i < count; i++ )
+            entries[i] = entries[i + 1];
+
+        entries.Reset();
+        entries.Resize( count );
+    }
+
+    // the copy can be still queued in a deferred queue 
+    if ( entry.queue != nullptr )
+        entry.queue->Flush();
+
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &entry.copy.semaphore;
+    waitInfo.pValues = &entry.copy.value;
+    VkResult result = vkWaitSemaphores( m_handle->device, &waitInfo, UINT64_MAX );
+    if ( result != VK_SUCCESS )
+    {
+        // the GPU can still write the range, never give it back 
+        crvkAppendError( "crvkReadbackQueue::Wait::vkWaitSemaphores", result );
+        return false;
+    }
+
+    Deliver( m_handle->readback, &entry, out_data );
+    return true;
+}
+
+/*
+==============================================
+crvkReadbackQueue::Pending
+==============================================
+*/
+uint32_t crvkReadbackQueue::Pending( void ) const
+{
+    if ( m_handle == nullptr )
+        return 0;
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    return m_handle->entries.Count();
+}
@@ -0,0 +1,1213 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+#include "crvkPrecompiled.hpp"
+#include "crvkImage.hpp"
+#include "crvkRenderGraph.hpp"
+
+enum crvkRenderGraphResourceType_t : uint8_t
+{
+    CRVK_RENDER_GRAPH_RESOURCE_IMAGE = 0,
+    CRVK_RENDER_GRAPH_RESOURCE_BUFFER
+};
+
+typedef struct crvkRenderGraphResource_t
+{
+    char                            name[32];
+    crvkRenderGraphResourceType_t   type;
+    bool                            imported;   // owned by the application 
+    bool                            exclusive;  // need queue ownership transfers 
+    bool                            output;     // the writers are never culled 
+    bool                            live;       // already used in the current Execute 
+    uint32_t                        first;      // first pass in the compiled order that use the resource 
+    uint32_t                        last;       // last pass in the compiled order that use the resource 
+    uint32_t                        bucket;     // memory shared with other transient resources 
+    crvkImage*                      image;
+    crvkBuffer*                     buffer;
+    crvkRenderGraphImageDesc_t      imageDesc;
+    crvkRenderGraphBufferDesc_t     bufferDesc;
+    VkMemoryRequirements            requirements;
+} crvkRenderGraphResource_t;
+
+typedef struct crvkRenderGraphPass_t
+{
+    char                    name[32];
+    uint32_t                family;
+    uint32_t                order;      // position in the compiled order, k_invalid if culled 
+    bool                    kept;
+    crvkRenderPassRecord_t  record;
+    void*                   userData;
+} crvkRenderGraphPass_t;
+
+typedef struct crvkRenderGraphAccess_t
+{
+    uint32_t                pass;
+    uint32_t                resource;
+    uint8_t                 state;      // crvkImageState_t or crvkBufferState_t 
+    bool                    write;
+    bool                    whole;      // the whole image 
+    VkImageSubresourceRange range;
+    VkDeviceSize            offset;
+    VkDeviceSize            size;
+} crvkRenderGraphAccess_t;
+
+typedef struct crvkRenderGraphEdge_t
+{
+    uint32_t    from;
+    uint32_t    to;
+} crvkRenderGraphEdge_t;
+
+/// @brief a memory allocation shared by transient resources with lifetimes that don't overlap 
+typedef struct crvkRenderGraphBucket_t
+{
+    VkMemoryRequirements    requirements;
+    bool                    linear;     // buffers, kept apart from the optimal images 
+    uint32_t                last;       // the last resource in the frame, the first one wait it 
+    uint32_t                current;    // resource using the memory while executing 
+    crvkMemoryAllocation_t  allocation;
+} crvkRenderGraphBucket_t;
+
+/// @brief the passes of a run of the same queue family, recorded in a command buffer 
+typedef struct crvkRenderGraphBatch_t
+{
+    uint32_t                family;
+    uint32_t                queue;      // index in the Execute queues 
+    uint32_t                position;   // submit order, a release only batch go just before the batch that need it 
+    VkCommandBuffer         commandBuffer;
+} crvkRenderGraphBatch_t;
+
+typedef struct crvkRenderGraphHandle_t
+{
+    bool                                        compiled = false;
+    uint32_t                                    family = 0;         // family of the passes without one
+    uint64_t                                    value = 0;          // timeline value of the last submitted batch 
+    VkSemaphore                                 semaphore = nullptr;    // the batches timeline 
+    const crvkDevice*                           device = nullptr;
+    const crvkDeviceQueue*                      queue = nullptr;
+    crvkMemoryAllocator*                        allocator = nullptr;
+    crvkDeletionQueue*                          deletion = nullptr;
+    crvkDynamicVector<crvkRenderGraphResource_t> resources;
+    crvkDynamicVector<crvkRenderGraphPass_t>    passes;
+    crvkDynamicVector<crvkRenderGraphAccess_t>  accesses;
+    crvkDynamicVector<crvkRenderGraphEdge_t>    edges;
+    crvkDynamicVector<crvkRenderGraphBucket_t>  buckets;
+    crvkDynamicVector<crvkRenderGraphBatch_t>   batches;
+    crvkDynamicVector<uint32_t>                 order;      // the kept passes in execution order 
+    crvkDynamicVector<uint32_t>                 scratch;
+    crvkBarrierBatch                            batch;      // the pass barriers 
+    crvkBarrierBatch                            transition; // the barriers of a single resource transition 
+    crvkBarrierBatch                            release;    // queue ownership release barriers 
+} crvkRenderGraphHandle_t;
+
+/*
+==============================================
+IsImageWrite
+==============================================
+*/
+static bool IsImageWrite( const crvkImageState_t in_state )
+{
+    switch ( in_state )
+    {
+    case CRVK_IMAGE_STATE_GRAPHIC_SHADER_BINDING:
+    case CRVK_IMAGE_STATE_GRAPHIC_RENDER_TARGET:
+    case CRVK_IMAGE_STAGE_GRAPHIC_RENDER_DEPTH:
+    case CRVK_IMAGE_STAGE_GRAPHIC_RENDER_DEPTH_STENCIL:
+    case CRVK_IMAGE_STATE_COMPUTE_WRITE:
+    case CRVK_IMAGE_STATE_GPU_COPY_DST:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+==============================================
+IsBufferWrite
+==============================================
+*/
+static bool IsBufferWrite( const crvkBufferState_t in_state )
+{
+    switch ( in_state )
+    {
+    case CRVK_BUFFER_STATE_GRAPHIC_WRITE:
+    case CRVK_BUFFER_STATE_COMPUTE_WRITE:
+    case CRVK_BUFFER_STATE_GPU_COPY_DST:
+    case CRVK_BUFFER_STATE_CPU_COPY_DST:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+==============================================
+FindQueue
+==============================================
+*/
+static uint32_t FindQueue( const uint32_t in_family, crvkDeviceQueue* const* in_queues, const uint32_t in_count )
+{
+    for ( uint32_t i = 0; i < in_count; i++ )
+    {
+        if ( in_queues[i]->Family() == in_family )
+            return i;
+    }
+
+    return crvkRenderGraph::k_invalid;
+}
+
+/*
+==============================================
+crvkRenderGraph::crvkRenderGraph
+==============================================
+*/
+crvkRenderGraph::crvkRenderGraph( void ) : m_handle( nullptr )
+{
+}
+
+/*
+==============================================
+crvkRenderGraph::~crvkRenderGraph
+==============================================
+*/
+crvkRenderGraph::~crvkRenderGraph( void )
+{
+    Destroy();
+}
+
+/*
+==============================================
+crvkRenderGraph::Create
+==============================================
+*/
+bool crvkRenderGraph::Create( const crvkDevice* in_device, const crvkDeviceQueue* in_queue )
+{
+    if ( m_handle == nullptr )
+        m_handle = new crvkRenderGraphHandle_t();
+
+    m_handle->device = in_device;
+    m_handle->queue = in_queue;
+    m_handle->family = in_queue->Family();
+    m_handle->allocator = in_device->MemoryAllocator();
+    m_handle->deletion = in_device->DeletionQueue();
+
+    if ( m_handle->semaphore != nullptr )
+        return true;
+
+    // the batches timeline, each batch wait the previous value 
+    VkSemaphoreTypeCreateInfo timelineCreateInfo{};
+    timelineCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    timelineCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    timelineCreateInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreCI{};
+    semaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreCI.flags = 0;
+    semaphoreCI.pNext = &timelineCreateInfo;
+
+    VkResult result = vkCreateSemaphore( in_device->Device(), &semaphoreCI, k_allocationCallbacks, &m_handle->semaphore );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkRenderGraph::Create::vkCreateSemaphore", result );
+        return false;
+    }
+
+    m_handle->value = 0;
+    return true;
+}
+
+/*
+==============================================
+crvkRenderGraph::Destroy
+==============================================
+*/
+void crvkRenderGraph::Destroy( void )
+{
+    if ( m_handle == nullptr )
+        return;
+
+    Reset();
+
+    // the timeline is released with his last value, the deletion queue read it before destroy 
+    if ( m_handle->semaphore != nullptr )
+    {
+        crvkTimelinePoint_t lastUse{ m_handle->semaphore, m_handle->value };
+        if ( m_handle->deletion != nullptr )
+            m_handle->deletion->Enqueue( VK_OBJECT_TYPE_SEMAPHORE, reinterpret_cast<uint64_t>( m_handle->semaphore ), &lastUse, 1 );
+        else
+        {
+            VkSemaphoreWaitInfo waitInfo{};
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &lastUse.semaphore;
+            waitInfo.pValues = &lastUse.value;
+            vkWaitSemaphores( m_handle->device->Device(), &waitInfo, UINT64_MAX );
+            vkDestroySemaphore( m_handle->device->Device(), m_handle->semaphore, k_allocationCallbacks );
+        }
+
+        m_handle->semaphore = nullptr;
+    }
+
+    delete m_handle;
+    m_handle = nullptr;
+}
+
+/*
+==============================================
+crvkRenderGraph::Reset
+==============================================
+*/
+void crvkRenderGraph::Reset( void )
+{
+    if ( m_handle == nullptr )
+        return;
+
+    ReleaseTransients();
+    m_handle->resources.Reset();
+    m_handle->passes.Reset();
+    m_handle->accesses.Reset();
+    m_handle->edges.Reset();
+    m_handle->order.Reset();
+    m_handle->compiled = false;
+}
+
+/*
+==============================================
+crvkRenderGraph::ImportImage
+==============================================
+*/
+uint32_t crvkRenderGraph::ImportImage( crvkImage* in_image, const bool in_exclusive )
+{
+    crvkRenderGraphResource_t resource{};
+    SDL_strlcpy( resource.name, "imported", sizeof( resource.name ) );
+    resource.type = CRVK_RENDER_GRAPH_RESOURCE_IMAGE;
+    resource.imported = true;
+    resource.exclusive = in_exclusive;
+    resource.output = true;
+    resource.image = in_image;
+    m_handle->compiled = false;
+    return m_handle->resources.Append( resource );
+}
+
+/*
+==============================================
+crvkRenderGraph::ImportBuffer
+==============================================
+*/
+uint32_t crvkRenderGraph::ImportBuffer( crvkBuffer* in_buffer, const bool in_exclusive )
+{
+    crvkRenderGraphResource_t resource{};
+    SDL_strlcpy( resource.name, "imported", sizeof( resource.name ) );
+    resource.type = CRVK_RENDER_GRAPH_RESOURCE_BUFFER;
+    resource.imported = true;
+    resource.exclusive = in_exclusive;
+    resource.output = true;
+    resource.buffer = in_buffer;
+    m_handle->compiled = false;
+    return m_handle->resources.Append( resource );
+}
+
+/*
+==============================================
+crvkRenderGraph::CreateImage
+==============================================
+*/
+uint32_t crvkRenderGraph::CreateImage( const char* in_name, const crvkRenderGraphImageDesc_t* in_desc )
+{
+    crvkRenderGraphResource_t resource{};
+    SDL_strlcpy( resource.name, in_name, sizeof( resource.name ) );
+    resource.type = CRVK_RENDER_GRAPH_RESOURCE_IMAGE;
+    resource.exclusive = true; // created with exclusive sharing 
+    resource.imageDesc = *in_desc;
+    m_handle->compiled = false;
+    return m_handle->resources.Append( resource );
+}
+
+/*
+==============================================
+crvkRenderGraph::CreateBuffer
+==============================================
+*/
+uint32_t crvkRenderGraph::CreateBuffer( const char* in_name, const crvkRenderGraphBufferDesc_t* in_desc )
+{
+    crvkRenderGraphResource_t resource{};
+    SDL_strlcpy( resource.name, in_name, sizeof( resource.name ) );
+    resource.type = CRVK_RENDER_GRAPH_RESOURCE_BUFFER;
+    resource.exclusive = true; // created with exclusive sharing 
+    resource.bufferDesc = *in_desc;
+    m_handle->compiled = false;
+    return m_handle->resources.Append( resource );
+}
+
+/*
+==============================================
+crvkRenderGraph::AddPass
+==============================================
+*/
+uint32_t crvkRenderGraph::AddPass( const char* in_name, const uint32_t in_family, crvkRenderPassRecord_t in_record, void* in_userData )
+{
+    crvkRenderGraphPass_t pass{};
+    SDL_strlcpy( pass.name, in_name, sizeof( pass.name ) );
+    pass.family = ( in_family == k_invalid ) ? m_handle->family : in_family;
+    pass.order = k_invalid;
+    pass.record = in_record;
+    pass.userData = in_userData;
+    m_handle->compiled = false;
+    return m_handle->passes.Append( pass );
+}
+
+/*
+==============================================
+crvkRenderGraph::UseImage
+==============================================
+*/
+void crvkRenderGraph::UseImage( const uint32_t in_pass, const uint32_t in_image, const crvkImageState_t in_state, const VkImageSubresourceRange* in_range )
+{
+    if ( in_pass >= m_handle->passes.Count() || in_image >= m_handle->resources.Count() )
+        return;
+
+    if ( m_handle->resources[in_image].type != CRVK_RENDER_GRAPH_RESOURCE_IMAGE )
+        return;
+
+    crvkRenderGraphAccess_t access{};
+    access.pass = in_pass;
+    access.resource = in_image;
+    access.state = in_state;
+    access.write = IsImageWrite( in_state );
+    access.whole = ( in_range == nullptr );
+    if ( in_range != nullptr )
+        access.range = *in_range;
+    
+    m_handle->accesses.Append( access );
+    m_handle->compiled = false;
+}
+
+/*
+==============================================
+crvkRenderGraph::UseBuffer
+==============================================
+*/
+void crvkRenderGraph::UseBuffer( const uint32_t in_pass, const uint32_t in_buffer, const crvkBufferState_t in_state, const VkDeviceSize in_offset, const VkDeviceSize in_size )
+{
+    if ( in_pass >= m_handle->passes.Count() || in_buffer >= m_handle->resources.Count() )
+        return;
+
+    if ( m_handle->resources[in_buffer].type != CRVK_RENDER_GRAPH_RESOURCE_BUFFER )
+        return;
+
+    crvkRenderGraphAccess_t access{};
+    access.pass = in_pass;
+    access.resource = in_buffer;
+    access.state = in_state;
+    access.write = IsBufferWrite( in_state );
+    access.offset = in_offset;
+    access.size = in_size;
+    
+    m_handle->accesses.Append( access );
+    m_handle->compiled = false;
+}
+
+/*
+==============================================
+crvkRenderGraph::SetOutput
+==============================================
+*/
+void crvkRenderGraph::SetOutput( const uint32_t in_resource )
+{
+    if ( in_resource >= m_handle->resources.Count() )
+        return;
+
+    m_handle->resources[in_resource].output = true;
+    m_handle->compiled = false;
+}
+
+/*
+==============================================
+crvkRenderGraph::Compile
+==============================================
+*/
+bool crvkRenderGraph::Compile( void )
+{
+    Cull();
+    Sort();
+
+    ///
+    /// Find the transient resources lifetimes in the compiled order 
+    /// ==========================================================================
+    for ( uint32_t i = 0; i < m_handle->resources.Count(); i++ )
+    {
+        m_handle->resources[i].first = k_invalid;
+        m_handle->resources[i].last = k_invalid;
+    }
+
+    for ( uint32_t i = 0; i < m_handle->accesses.Count(); i++ )
+    {
+        const crvkRenderGraphAccess_t& access = m_handle->accesses[i];
+        const crvkRenderGraphPass_t& pass = m_handle->passes[access.pass];
+        if ( !pass.kept )
+            continue;
+
+        crvkRenderGraphResource_t& resource = m_handle->resources[access.resource];
+        if ( resource.first == k_invalid || pass.order < resource.first )
+            resource.first = pass.order;
+
+        if ( resource.last == k_invalid || pass.order > resource.last )
+            resource.last = pass.order;
+    }
+
+    if ( !Alias() )
+        return false;
+
+    m_handle->compiled = true;
+    return true;
+}
+
+/*
+==============================================
+crvkRenderGraph::Execute
+==============================================
+*/
+bool crvkRenderGraph::Execute( crvkCommandPoolManager* in_pools, const uint32_t in_count, crvkDeviceQueue* const* in_queues, const crvkTimelinePoint_t* in_wait, crvkTimelinePoint_t* out_done )
+{
+    uint32_t current = k_invalid;
+
+    if ( m_handle == nullptr || !m_handle->compiled )
+        return false;
+
+    // the memory of each bucket is in use by his last resource of the previous frame 
+    for ( uint32_t i = 0; i < m_handle->buckets.Count(); i++ )
+        m_handle->buckets[i].current = m_handle->buckets[i].last;
+
+    for ( uint32_t i = 0; i < m_handle->resources.Count(); i++ )
+        m_handle->resources[i].live = false;
+
+    m_handle->batches.Reset();
+    for ( uint32_t i = 0; i < m_handle->order.Count(); i++ )
+    {
+        const crvkRenderGraphPass_t& pass = m_handle->passes[m_handle->order[i]];
+        
+        // a new batch at each change of family, the release only batches go between them 
+        if ( current == k_invalid || m_handle->batches[current].family != pass.family )
+        {
+            uint32_t position = ( current == k_invalid ) ? 1 : m_handle->batches[current].position + 2;
+            current = OpenBatch( in_pools, in_queues, in_count, pass.family, position );
+            if ( current == k_invalid )
+                return false;
+        }
+
+        VkCommandBuffer commandBuffer = m_handle->batches[current].commandBuffer;
+        m_handle->batch.Begin( commandBuffer );
+
+        for ( uint32_t j = 0; j < m_handle->accesses.Count(); j++ )
+        {
+            const crvkRenderGraphAccess_t& access = m_handle->accesses[j];
+            if ( access.pass != m_handle->order[i] )
+                continue;
+
+            ///
+            /// The first use of a transient in the frame, the content is undefined and the memory
+            /// must wait the resource that used it before 
+            /// ==========================================================================
+            crvkRenderGraphResource_t& resource = m_handle->resources[access.resource];
+            if ( resource.bucket != k_invalid && !resource.live )
+            {
+                crvkRenderGraphBucket_t& bucket = m_handle->buckets[resource.bucket];
+                const crvkRenderGraphResource_t& previous = m_handle->resources[bucket.current];
+                VkPipelineStageFlags2 stages = ( previous.type == CRVK_RENDER_GRAPH_RESOURCE_IMAGE ) ? previous.image->Stages() : previous.buffer->Stages();
+                
+                if ( resource.type == CRVK_RENDER_GRAPH_RESOURCE_IMAGE )
+                    resource.image->DiscardContent( stages, VK_ACCESS_2_MEMORY_WRITE_BIT );
+                else
+                    resource.buffer->DiscardContent( stages, VK_ACCESS_2_MEMORY_WRITE_BIT );
+                
+                bucket.current = access.resource;
+                resource.live = true;
+            }
+
+            Transition( j, current, in_pools, in_queues, in_count );
+        }
+
+        // a single barrier before the pass commands 
+        m_handle->batch.Flush();
+        
+        if ( pass.record != nullptr )
+            pass.record( commandBuffer, pass.userData );
+    }
+
+    if ( !SubmitBatches( in_queues, in_wait ) )
+        return false;
+
+    if ( out_done != nullptr )
+        *out_done = crvkTimelinePoint_t{ m_handle->semaphore, m_handle->value };
+
+    return true;
+}
+
+/*
+==============================================
+crvkRenderGraph::Image
+==============================================
+*/
+crvkImage* crvkRenderGraph::Image( const uint32_t in_resource ) const
+{
+    if ( in_resource >= m_handle->resources.Count() )
+        return nullptr;
+
+    return m_handle->resources[in_resource].image;
+}
+
+/*
+==============================================
+crvkRenderGraph::Buffer
+==============================================
+*/
+crvkBuffer* crvkRenderGraph::Buffer( const uint32_t in_resource ) const
+{
+    if ( in_resource >= m_handle->resources.Count() )
+        return nullptr;
+
+    return m_handle->resources[in_resource].buffer;
+}
+
+/*
+==============================================
+crvkRenderGraph::Dump
+==============================================
+*/
+void crvkRenderGraph::Dump( void ) const
+{
+    uint32_t culled = m_handle->passes.Count() - m_handle->order.Count();
+    std::printf( "crvkRenderGraph: %u passes, %u culled, %u resources\n", m_handle->passes.Count(), culled, m_handle->resources.Count() );
+    
+    std::printf( "  order:\n" );
+    for ( uint32_t i = 0; i < m_handle->order.Count(); i++ )
+    {
+        const crvkRenderGraphPass_t& pass = m_handle->passes[m_handle->order[i]];
+        std::printf( "    [%u] %s (family %u)\n", i, pass.name, pass.family );
+        
+        for ( uint32_t j = 0; j < m_handle->accesses.Count(); j++ )
+        {
+            const crvkRenderGraphAccess_t& access = m_handle->accesses[j];
+            if ( access.pass != m_handle->order[i] )
+                continue;
+
+            std::printf( "        %s %s state %u\n", access.write ? "write" : "read ", m_handle->resources[access.resource].name, access.state );
+        }
+    }
+
+    if ( culled > 0 )
+    {
+        std::printf( "  culled:\n" );
+        for ( uint32_t i = 0; i < m_handle->passes.Count(); i++ )
+        {
+            if ( !m_handle->passes[i].kept )
+                std::printf( "    %s\n", m_handle->passes[i].name );
+        }
+    }
+
+    ///
+    /// Transient memory 
+    /// ==========================================================================
+    VkDeviceSize unaliased = 0;
+    VkDeviceSize aliased = 0;
+    std::printf( "  transients:\n" );
+    for ( uint32_t i = 0; i < m_handle->resources.Count(); i++ )
+    {
+        const crvkRenderGraphResource_t& resource = m_handle->resources[i];
+        if ( resource.imported )
+            continue;
+
+        if ( resource.first == k_invalid )
+        {
+            std::printf( "    %s unused\n", resource.name );
+            continue;
+        }
+
+        unaliased += resource.requirements.size;
+        std::printf( "    %s %llu bytes, passes [%u, %u], bucket %u\n", 
+                        resource.name, 
+                        static_cast<unsigned long long>( resource.requirements.size ), 
+                        resource.first, 
+                        resource.last, 
+                        resource.bucket );
+    }
+
+    for ( uint32_t i = 0; i < m_handle->buckets.Count(); i++ )
+        aliased += m_handle->buckets[i].requirements.size;
+
+    std::printf( "  memory: %u buckets, %llu bytes, %llu bytes without aliasing\n", 
+                    m_handle->buckets.Count(),
+                    static_cast<unsigned long long>( aliased ), 
+                    static_cast<unsigned long long>( unaliased ) );
+
+    std::printf( "  batches: %u\n", m_handle->batches.Count() );
+
+    crvkBarrierBatchStats_t stats{};
+    m_handle->batch.Stats( &stats );
+    std::printf( "  barriers: %llu requested, %llu dropped, %llu merged, %llu flushes\n",
+                    static_cast<unsigned long long>( stats.requested ),
+                    static_cast<unsigned long long>( stats.dropped ),
+                    static_cast<unsigned long long>( stats.merged ),
+                    static_cast<unsigned long long>( stats.flushes ) );
+}
+
+/*
+==============================================
+crvkRenderGraph::Cull
+==============================================
+*/
+void crvkRenderGraph::Cull( void )
+{
+    crvkDynamicVector<uint32_t>& work = m_handle->scratch;
+    work.Reset();
+
+    // the passes that write a output are the roots 
+    for ( uint32_t i = 0; i < m_handle->passes.Count(); i++ )
+        m_handle->passes[i].kept = false;
+
+    for ( uint32_t i = 0; i < m_handle->accesses.Count(); i++ )
+    {
+        const crvkRenderGraphAccess_t& access = m_handle->accesses[i];
+        crvkRenderGraphPass_t& pass = m_handle->passes[access.pass];
+        if ( access.write && m_handle->resources[access.resource].output && !pass.kept )
+        {
+            pass.kept = true;
+            work.Append( access.pass );
+        }
+    }
+
+    // keep the writers declared before a kept pass of each resource it use 
+    uint32_t next = 0;
+    while ( next < work.Count() )
+    {
+        uint32_t user = work[next++];
+        for ( uint32_t i = 0; i < m_handle->accesses.Count(); i++ )
+        {
+            const crvkRenderGraphAccess_t& access = m_handle->accesses[i];
+            if ( access.pass != user )
+                continue;
+
+            for ( uint32_t j = 0; j < m_handle->accesses.Count(); j++ )
+            {
+                const crvkRenderGraphAccess_t& writer = m_handle->accesses[j];
+                if ( writer.resource != access.resource || !writer.write || writer.pass >= user )
+                    continue;
+                
+                crvkRenderGraphPass_t& pass = m_handle->passes[writer.pass];
+                if ( pass.kept )
+                    continue;
+
+                pass.kept = true;
+                work.Append( writer.pass );
+            }
+        }
+    }
+}
+
+/*
+==============================================
+crvkRenderGraph::Sort
+==============================================
+*/
+void crvkRenderGraph::Sort( void )
+{
+    crvkDynamicVector<uint32_t>& readers = m_handle->scratch;
+    m_handle->edges.Reset();
+    m_handle->order.Reset();
+
+    ///
+    /// Dependencies in the declaration order: read after write, write after write and write after read
+    /// ==========================================================================
+    for ( uint32_t r = 0; r < m_handle->resources.Count(); r++ )
+    {
+        uint32_t writer = k_invalid;
+        readers.Reset();
+
+        for ( uint32_t p = 0; p < m_handle->passes.Count(); p++ )
+        {
+            if ( !m_handle->passes[p].kept )
+                continue;
+
+            bool use = false;
+            bool write = false;
+            for ( uint32_t i = 0; i < m_handle->accesses.Count(); i++ )
+            {
+                const crvkRenderGraphAccess_t& access = m_handle->accesses[i];
+                if ( access.pass == p && access.resource == r )
+                {
+                    use = true;
+                    write |= access.write;
+                }
+            }
+
+            if ( !use )
+                continue;
+
+            if ( writer != k_invalid )
+                m_handle->edges.Append( crvkRenderGraphEdge_t{ writer, p } );
+
+            if ( write )
+            {
+                for ( uint32_t i = 0; i < readers.Count(); i++ )
+                    m_handle->edges.Append( crvkRenderGraphEdge_t{ readers[i], p } );
+
+                writer = p;
+                readers.Reset();
+            }
+            else
+            {
+                readers.Append( p );
+            }
+        }
+    }
+
+    ///
+    /// Topological order, keep the passes of the same family together, then the declaration order
+    /// ==========================================================================
+    crvkDynamicVector<uint32_t>& incoming = m_handle->scratch;
+    incoming.Reset();
+    incoming.Resize( m_handle->passes.Count() );
+    incoming.Memset( 0 );
+
+    for ( uint32_t i = 0; i < m_handle->edges.Count(); i++ )
+        incoming[m_handle->edges[i].to]++;
+
+    for ( uint32_t p = 0; p < m_handle->passes.Count(); p++ )
+        m_handle->passes[p].order = k_invalid;
+
+    uint32_t family = m_handle->family;
+    while ( true )
+    {
+        uint32_t next = k_invalid;
+        for ( uint32_t p = 0; p < m_handle->passes.Count(); p++ )
+        {
+            const crvkRenderGraphPass_t& pass = m_handle->passes[p];
+            if ( !pass.kept || pass.order != k_invalid || incoming[p] > 0 )
+                continue;
+
+            if ( next == k_invalid )
+                next = p;
+            
+            if ( pass.family == family )
+            {
+                next = p;
+                break;
+            }
+        }
+
+        if ( next == k_invalid )
+            break;
+
+        crvkRenderGraphPass_t& pass = m_handle->passes[next];
+        pass.order = m_handle->order.Append( next );
+        family = pass.family;
+
+        for ( uint32_t i = 0; i < m_handle->edges.Count(); i++ )
+        {
+            if ( m_handle->edges[i].from == next )
+                incoming[m_handle->edges[i].to]--;
+        }
+    }
+}
+
+/*
+==============================================
+crvkRenderGraph::Alias
+==============================================
+*/
+bool crvkRenderGraph::Alias( void )
+{
+    ReleaseTransients();
+
+    ///
+    /// Create the used transient resources without memory 
+    /// ==========================================================================
+    crvkDynamicVector<uint32_t>& transients = m_handle->scratch;
+    transients.Reset();
+
+    for ( uint32_t i = 0; i < m_handle->resources.Count(); i++ )
+    {
+        crvkRenderGraphResource_t& resource = m_handle->resources[i];
+        resource.bucket = k_invalid;
+        if ( resource.imported || resource.first == k_invalid )
+            continue;
+
+        if ( resource.type == CRVK_RENDER_GRAPH_RESOURCE_IMAGE )
+        {
+            const crvkRenderGraphImageDesc_t& desc = resource.imageDesc;
+            resource.image = new crvkImage();
+            if ( !resource.image->CreateUnbound( m_handle->device, desc.type, desc.format, desc.levels, desc.layers, desc.width, desc.height, desc.depth, desc.samples, desc.usage ) )
+                return false;
+            
+            resource.image->MemoryRequirements( &resource.requirements );
+        }
+        else
+        {
+            const crvkRenderGraphBufferDesc_t& desc = resource.bufferDesc;
+            resource.buffer = new crvkBuffer();
+            if ( !resource.buffer->CreateUnbound( m_handle->device, m_handle->queue, nullptr, desc.size, desc.usage ) )
+                return false;
+            
+            resource.buffer->MemoryRequirements( &resource.requirements );
+        }
+
+        transients.Append( i );
+    }
+
+    // place the biggest first, the small ones fill the buckets 
+    const crvkRenderGraphResource_t* resources = m_handle->resources.Pointer();
+    std::stable_sort( transients.Pointer(), transients.Pointer() + transients.Count(), [resources]( const uint32_t a, const uint32_t b )
+    {
+        return resources[a].requirements.size > resources[b].requirements.size;
+    });
+
+    ///
+    /// Put each resource in the first bucket with a compatible memory and without lifetime overlap 
+    /// ==========================================================================
+    for ( uint32_t i = 0; i < transients.Count(); i++ )
+    {
+        crvkRenderGraphResource_t& resource = m_handle->resources[transients[i]];
+        bool linear = ( resource.type == CRVK_RENDER_GRAPH_RESOURCE_BUFFER );
+        
+        for ( uint32_t b = 0; b < m_handle->buckets.Count() && resource.bucket == k_invalid; b++ )
+        {
+            const crvkRenderGraphBucket_t& bucket = m_handle->buckets[b];
+            if ( bucket.linear != linear || ( bucket.requirements.memoryTypeBits & resource.requirements.memoryTypeBits ) == 0 )
+                continue;
+
+            bool overlap = false;
+            for ( uint32_t j = 0; j < i && !overlap; j++ )
+            {
+                const crvkRenderGraphResource_t& other = m_handle->resources[transients[j]];
+                if ( other.bucket == b )
+                    overlap = resource.first <= other.last && other.first <= resource.last;
+            }
+
+            if ( !overlap )
+                resource.bucket = b;
+        }
+
+        if ( resource.bucket == k_invalid )
+        {
+            crvkRenderGraphBucket_t bucket{};
+            bucket.requirements = resource.requirements;
+            bucket.linear = linear;
+            bucket.last = transients[i];
+            resource.bucket = m_handle->buckets.Append( bucket );
+            continue;
+        }
+
+        crvkRenderGraphBucket_t& bucket = m_handle->buckets[resource.bucket];
+        bucket.requirements.size = std::max( bucket.requirements.size, resource.requirements.size );
+        bucket.requirements.alignment = std::max( bucket.requirements.alignment, resource.requirements.alignment );
+        bucket.requirements.memoryTypeBits &= resource.requirements.memoryTypeBits;
+        if ( resource.first > m_handle->resources[bucket.last].first )
+            bucket.last = transients[i];
+    }
+
+    ///
+    /// Allocate the buckets and bind the resources at the begin of his bucket 
+    /// ==========================================================================
+    for ( uint32_t b = 0; b < m_handle->buckets.Count(); b++ )
+    {
+        crvkRenderGraphBucket_t& bucket = m_handle->buckets[b];
+        if ( !m_handle->allocator->Allocate( bucket.requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bucket.linear, &bucket.allocation ) )
+            return false;
+    }
+
+    for ( uint32_t i = 0; i < transients.Count(); i++ )
+    {
+        crvkRenderGraphResource_t& resource = m_handle->resources[transients[i]];
+        const crvkMemoryAllocation_t* allocation = &m_handle->buckets[resource.bucket].allocation;
+        
+        bool bound = ( resource.type == CRVK_RENDER_GRAPH_RESOURCE_IMAGE ) ? resource.image->Bind( allocation, 0 ) : resource.buffer->Bind( allocation, 0 );
+        if ( !bound )
+            return false;
+    }
+
+    return true;
+}
+
+/*
+==============================================
+crvkRenderGraph::ReleaseTransients
+==============================================
+*/
+void crvkRenderGraph::ReleaseTransients( void )
+{
+    // the GPU can still use the transients, they are released after the last submitted batch 
+    crvkTimelinePoint_t lastUse{ m_handle->semaphore, m_handle->value };
+
+    for ( uint32_t i = 0; i < m_handle->resources.Count(); i++ )
+    {
+        crvkRenderGraphResource_t& resource = m_handle->resources[i];
+        if ( resource.imported )
+            continue;
+
+        if ( resource.image != nullptr )
+        {
+            resource.image->SetLastUse( lastUse.semaphore, lastUse.value );
+            resource.image->Destroy();
+            delete resource.image;
+            resource.image = nullptr;
+        }
+
+        if ( resource.buffer != nullptr )
+        {
+            resource.buffer->SetLastUse( lastUse.semaphore, lastUse.value );
+            resource.buffer->Destroy();
+            delete resource.buffer;
+            resource.buffer = nullptr;
+        }
+
+        resource.bucket = k_invalid;
+    }
+
+    for ( uint32_t i = 0; i < m_handle->buckets.Count(); i++ )
+    {
+        if ( m_handle->buckets[i].allocation.memory == nullptr )
+            continue;
+
+        if ( m_handle->deletion != nullptr )
+            m_handle->deletion->EnqueueFree( &m_handle->buckets[i].allocation, &lastUse, 1 );
+        else
+            m_handle->allocator->Free( &m_handle->buckets[i].allocation );
+    }
+
+    m_handle->buckets.Reset();
+    m_handle->compiled = false;
+}
+
+/*
+==============================================
+crvkRenderGraph::OpenBatch
+==============================================
+*/
+uint32_t crvkRenderGraph::OpenBatch( crvkCommandPoolManager* in_pools, crvkDeviceQueue* const* in_queues, const uint32_t in_count, const uint32_t in_family, const uint32_t in_position )
+{
+    crvkRenderGraphBatch_t batch{};
+    batch.family = in_family;
+    batch.position = in_position;
+    batch.queue = FindQueue( in_family, in_queues, in_count );
+    if ( batch.queue == k_invalid )
+        return k_invalid;
+
+    batch.commandBuffer = in_pools->Allocate( in_family, VK_COMMAND_BUFFER_LEVEL_PRIMARY );
+    if ( batch.commandBuffer == nullptr )
+        return k_invalid;
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    VkResult result = vkBeginCommandBuffer( batch.commandBuffer, &beginInfo );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkRenderGraph::OpenBatch::vkBeginCommandBuffer", result );
+        return k_invalid;
+    }
+
+    return m_handle->batches.Append( batch );
+}
+
+/*
+==============================================
+crvkRenderGraph::ReleaseBatch
+==============================================
+*/
+uint32_t crvkRenderGraph::ReleaseBatch( crvkCommandPoolManager* in_pools, crvkDeviceQueue* const* in_queues, const uint32_t in_count, const uint32_t in_family, const uint32_t in_batch )
+{
+    uint32_t position = m_handle->batches[in_batch].position;
+    uint32_t owner = k_invalid;
+
+    // the last batch of the old family before the pass, it is still recording 
+    for ( uint32_t i = 0; i < m_handle->batches.Count(); i++ )
+    {
+        const crvkRenderGraphBatch_t& batch = m_handle->batches[i];
+        if ( batch.family != in_family || batch.position >= position )
+            continue;
+
+        if ( owner == k_invalid || batch.position > m_handle->batches[owner].position )
+            owner = i;
+    }
+
+    if ( owner != k_invalid )
+        return owner;
+
+    // the old family was used by a previous Execute, the release get his own batch just before the pass batch 
+    return OpenBatch( in_pools, in_queues, in_count, in_family, position - 1 );
+}
+
+/*
+==============================================
+crvkRenderGraph::SubmitBatches
+==============================================
+*/
+bool crvkRenderGraph::SubmitBatches( crvkDeviceQueue* const* in_queues, const crvkTimelinePoint_t* in_wait )
+{
+    VkResult result = VK_SUCCESS;
+    crvkDynamicVector<uint32_t>& sorted = m_handle->scratch;
+    sorted.Reset();
+    
+    for ( uint32_t i = 0; i < m_handle->batches.Count(); i++ )
+        sorted.Append( i );
+
+    const crvkRenderGraphBatch_t* batches = m_handle->batches.Pointer();
+    std::stable_sort( sorted.Pointer(), sorted.Pointer() + sorted.Count(), [batches]( const uint32_t a, const uint32_t b )
+    {
+        return batches[a].position < batches[b].position;
+    });
+
+    ///
+    /// Chain the batches on the graph timeline, a family change wait the work of the old family, 
+    /// so the acquire barriers always run after his release 
+    /// ==========================================================================
+    for ( uint32_t i = 0; i < sorted.Count(); i++ )
+    {
+        const crvkRenderGraphBatch_t& batch = m_handle->batches[sorted[i]];
+        result = vkEndCommandBuffer( batch.commandBuffer );
+        if ( result != VK_SUCCESS )
+        {
+            crvkAppendError( "crvkRenderGraph::SubmitBatches::vkEndCommandBuffer", result );
+            return false;
+        }
+
+        uint32_t waitCount = 1;
+        VkSemaphoreSubmitInfo waitInfo[2]{};
+        waitInfo[0] = { VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, m_handle->semaphore, m_handle->value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, 0 };
+        if ( i == 0 && in_wait != nullptr && in_wait->semaphore != nullptr )
+            waitInfo[waitCount++] = { VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, in_wait->semaphore, in_wait->value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, 0 };
+
+        VkSemaphoreSubmitInfo signalInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, m_handle->semaphore, m_handle->value + 1, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, 0 };
+
+        VkCommandBufferSubmitInfo commandBufferInfo{};
+        commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+        commandBufferInfo.pNext = nullptr;
+        commandBufferInfo.commandBuffer = batch.commandBuffer;
+
+        result = in_queues[batch.queue]->Submit( waitInfo, waitCount, &commandBufferInfo, 1, &signalInfo, 1, nullptr );
+        if ( result != VK_SUCCESS )
+        {
+            crvkAppendError( "crvkRenderGraph::SubmitBatches::vkQueueSubmit2", result );
+            return false;
+        }
+
+        m_handle->value++;
+    }
+
+    return true;
+}
+
+/*
+==============================================
+crvkRenderGraph::Transition
+==============================================
+*/
+void crvkRenderGraph::Transition( const uint32_t in_access, const uint32_t in_batch, crvkCommandPoolManager* in_pools, crvkDeviceQueue* const* in_queues, const uint32_t in_count )
+{
+    const crvkRenderGraphAccess_t& access = m_handle->accesses[in_access];
+    const crvkRenderGraphResource_t& resource = m_handle->resources[access.resource];
+    
+    // shared resources don't change of owner 
+    uint32_t family = resource.exclusive ? m_handle->batches[in_batch].family : VK_QUEUE_FAMILY_IGNORED;
+
+    // record the resource barriers alone, so we can split the ownership transfers 
+    m_handle->transition.Begin( nullptr );
+    if ( resource.type == CRVK_RENDER_GRAPH_RESOURCE_IMAGE )
+    {
+        if ( access.whole )
+            resource.image->StateTransition( &m_handle->transition, static_cast<crvkImageState_t>( access.state ), VK_IMAGE_ASPECT_NONE, family );
+        else
+            resource.image->StateTransition( &m_handle->transition, static_cast<crvkImageState_t>( access.state ), &access.range, family );
+    }
+    else
+    {
+        resource.buffer->StateTransition( &m_handle->transition, static_cast<crvkBufferState_t>( access.state ), access.offset, access.size, family );
+    }
+
+    uint32_t bufferCount = 0;
+    uint32_t imageCount = 0;
+    const VkBufferMemoryBarrier2* buffers = m_handle->transition.BufferBarriers( &bufferCount );
+    const VkImageMemoryBarrier2* images = m_handle->transition.ImageBarriers( &imageCount );
+
+    ///
+    /// Send the barriers to the pass, a change of queue family become a release at the end of the 
+    /// last batch of the old family and a acquire in the pass batch 
+    /// ==========================================================================
+    for ( uint32_t i = 0; i < bufferCount; i++ )
+    {
+        VkBufferMemoryBarrier2 barrier = buffers[i];
+        uint32_t owner = k_invalid;
+        if ( barrier.srcQueueFamilyIndex != barrier.dstQueueFamilyIndex && barrier.srcQueueFamilyIndex != VK_QUEUE_FAMILY_IGNORED && barrier.dstQueueFamilyIndex != VK_QUEUE_FAMILY_IGNORED )
+            owner = ReleaseBatch( in_pools, in_queues, in_count, barrier.srcQueueFamilyIndex, in_batch );
+
+        if ( barrier.srcQueueFamilyIndex != barrier.dstQueueFamilyIndex && owner == k_invalid )
+        {
+            // no owner to release, the content is discarded or shared 
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        }
+        else if ( barrier.srcQueueFamilyIndex != barrier.dstQueueFamilyIndex )
+        {
+            VkBufferMemoryBarrier2 release = barrier;
+            release.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+            release.dstAccessMask = VK_ACCESS_2_NONE;
+            m_handle->release.Begin( m_handle->batches[owner].commandBuffer );
+            m_handle->release.Buffer( &release );
+            m_handle->release.Flush();
+
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+            barrier.srcAccessMask = VK_ACCESS_2_NONE;
+        }
+
+        m_handle->batch.Buffer( &barrier );
+    }
+
+    for ( uint32_t i = 0; i < imageCount; i++ )
+    {
+        VkImageMemoryBarrier2 barrier = images[i];
+        uint32_t owner = k_invalid;
+        if ( barrier.srcQueueFamilyIndex != barrier.dstQueueFamilyIndex && barrier.srcQueueFamilyIndex != VK_QUEUE_FAMILY_IGNORED && barrier.dstQueueFamilyIndex != VK_QUEUE_FAMILY_IGNORED )
+            owner = ReleaseBatch( in_pools, in_queues, in_count, barrier.srcQueueFamilyIndex, in_batch );
+
+        if ( barrier.srcQueueFamilyIndex != barrier.dstQueueFamilyIndex && owner == k_invalid )
+        {
+            // no owner to release, the content is discarded or shared 
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        }
+        else if ( barrier.srcQueueFamilyIndex != barrier.dstQueueFamilyIndex )
+        {
+            // the layout change is made by both barriers, the acquire only wait the release 
+            VkImageMemoryBarrier2 release = barrier;
+            release.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+            release.dstAccessMask = VK_ACCESS_2_NONE;
+            m_handle->release.Begin( m_handle->batches[owner].commandBuffer );
+            m_handle->release.Image( &release );
+            m_handle->release.Flush();
+
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+            barrier.srcAccessMask = VK_ACCESS_2_NONE;
+        }
+
+        m_handle->batch.Image( &barrier );
+    }
+
+    m_handle->transition.Begin( nullptr );
+}
@@ -0,0 +1,234 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#include "crvkPrecompiled.hpp"
+#include "crvkShaderCache.hpp"
+
+static const uint32_t k_SPIRV_MAGIC = 0x07230203;
+
+typedef struct crvkShaderCacheHandle_t
+{
+    std::atomic<uint64_t>                                       hits{ 0 };
+    std::atomic<uint64_t>                                       misses{ 0 };
+    char*                                                       path = nullptr;     // cache directory 
+    std::mutex                                                  lock;               // guard the memory entries, the compiler workers share the cache  
+    std::unordered_map<uint64_t, crvkDynamicVector<uint32_t>>   entries;            // memory entries 
+} crvkShaderCacheHandle_t;
+
+/*
+==============================================
+crvkShaderCache::crvkShaderCache
+==============================================
+*/
+crvkShaderCache::crvkShaderCache( void ) : m_handle( nullptr )
+{
+    m_handle = new crvkShaderCacheHandle_t();
+}
+
+/*
+==============================================
+crvkShaderCache::~crvkShaderCache
+==============================================
+*/
+crvkShaderCache::~crvkShaderCache( void )
+{
+    Destroy();
+
+    if ( m_handle != nullptr )
+    {
+        delete m_handle;
+        m_handle = nullptr;
+    }
+}
+
+/*
+==============================================
+crvkShaderCache::Create
+==============================================
+*/
+bool crvkShaderCache::Create( const char* in_path )
+{
+    m_handle->hits = 0;
+    m_handle->misses = 0;
+
+    // memory only cache 
+    if ( in_path == nullptr )
+        return true;
+
+    if ( !SDL_CreateDirectory( in_path ) )
+    {
+        crvkAppendError( SDL_GetError(), VK_INCOMPLETE );
+        return false;
+    }
+
+    m_handle->path = SDL_strdup( in_path );
+    return true;
+}
+
+/*
+==============================================
+crvkShaderCache::Destroy
+==============================================
+*/
+void crvkShaderCache::Destroy( void )
+{
+    if ( m_handle == nullptr )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    m_handle->entries.clear();
+
+    if ( m_handle->path != nullptr )
+    {
+        SDL_free( m_handle->path );
+        m_handle->path = nullptr;
+    }
+}
+
+/*
+==============================================
+crvkShaderCache::Find
+==============================================
+*/
+bool crvkShaderCache::Find( const uint64_t in_key, crvkDynamicVector<uint32_t> &out_code )
+{
+    size_t fileSize = 0;
+    void* fileData = nullptr;
+    char* filePath = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock( m_handle->lock );
+        auto entry = m_handle->entries.find( in_key );
+        if ( entry != m_handle->entries.end() )
+        {
+            out_code = entry->second;
+            m_handle->hits++;
+            return true;
+        }
+    }
+
+    if ( m_handle->path != nullptr )
+    {
+        SDL_asprintf( &filePath, "%s/%016llx.spv", m_handle->path, static_cast<unsigned long long>( in_key ) );
+        fileData = SDL_LoadFile( filePath, &fileSize );
+        SDL_free( filePath );
+    }
+
+    // ignore missing, truncated or not SPIR-V files 
+    if ( fileData == nullptr || fileSize < sizeof( uint32_t ) || fileSize % sizeof( uint32_t ) != 0 || *static_cast<uint32_t*>( fileData ) != k_SPIRV_MAGIC )
+    {
+        if ( fileData != nullptr )
+            SDL_free( fileData );
+
+        m_handle->misses++;
+        return false;
+    }
+
+    out_code.Resize( static_cast<uint32_t>( fileSize / sizeof( uint32_t ) ) );
+    out_code.Memcpy( static_cast<uint32_t*>( fileData ), 0, out_code.Count() );
+    SDL_free( fileData );
+
+    // keep it in memory for the next lookup 
+    {
+        std::lock_guard<std::mutex> lock( m_handle->lock );
+        m_handle->entries[in_key] = out_code;
+    }
+    
+    m_handle->hits++;
+    return true;
+}
+
+/*
+==============================================
+crvkShaderCache::Store
+==============================================
+*/
+void crvkShaderCache::Store( const uint64_t in_key, const uint32_t* in_code, const uint32_t in_count )
+{
+    char* filePath = nullptr;
+    char* tempPath = nullptr;
+    crvkDynamicVector<uint32_t> code;
+
+    code.Resize( in_count );
+    code.Memcpy( in_code, 0, in_count );
+    
+    {
+        std::lock_guard<std::mutex> lock( m_handle->lock );
+        m_handle->entries[in_key] = std::move( code );
+    }
+
+    // memory only cache 
+    if ( m_handle->path == nullptr )
+        return;
+
+    // write a temporary file and rename it, a reader never see a half written entry, 
+    // the thread id keep two workers storing the same key apart 
+    SDL_asprintf( &filePath, "%s/%016llx.spv", m_handle->path, static_cast<unsigned long long>( in_key ) );
+    SDL_asprintf( &tempPath, "%s.%llu.tmp", filePath, static_cast<unsigned long long>( std::hash<std::thread::id>{}( std::this_thread::get_id() ) ) );
+    if ( !SDL_SaveFile( tempPath, in_code, sizeof( uint32_t ) * in_count ) || !SDL_RenamePath( tempPath, filePath ) )
+    {
+        crvkAppendError( SDL_GetError(), VK_INCOMPLETE );
+        SDL_RemovePath( tempPath );
+    }
+
+    SDL_free( tempPath );
+    SDL_free( filePath );
+}
+
+/*
+==============================================
+crvkShaderCache::Hits
+==============================================
+*/
+uint64_t crvkShaderCache::Hits( void ) const
+{
+    return m_handle->hits;
+}
+
+/*
+==============================================
+crvkShaderCache::Misses
+==============================================
+*/
+uint64_t crvkShaderCache::Misses( void ) const
+{
+    return m_handle->misses;
+}
+
+/*
+==============================================
+crvkShaderCache::Hash
+==============================================
+*/
+uint64_t crvkShaderCache::Hash( const void* in_data, const size_t in_size, const uint64_t in_seed )
+{
+    uint64_t hash = in_seed;
+    const uint8_t* bytes = static_cast<const uint8_t*>( in_data );
+    
+    for ( size_t i = 0; i < in_size; i++ )
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull; // FNV prime 
+    }
+
+    return hash;
+}
@@ -0,0 +1,215 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#include "crvkPrecompiled.hpp"
+#include "crvkShaderCompiler.hpp"
+
+/// @brief a worker job, parse a shader of the program, or link the program when shader is nullptr  
+typedef struct crvkShaderJob_t
+{
+    crvkGLSLShader*     shader = nullptr;
+    crvkGLSLProgram*    program = nullptr;
+} crvkShaderJob_t;
+
+typedef struct crvkShaderCompilerHandle_t
+{
+    bool                        quit = false;
+    uint32_t                    threadCount = 0;
+    std::thread*                threads = nullptr;
+    std::mutex                  lock;           // guard the job queue and the programs status 
+    std::condition_variable     workCond;       // signaled when a job is queued 
+    std::condition_variable     doneCond;       // signaled when a program finish 
+    std::deque<crvkShaderJob_t> jobs;
+} crvkShaderCompilerHandle_t;
+
+/*
+==============================================
+crvkShaderCompiler::crvkShaderCompiler
+==============================================
+*/
+crvkShaderCompiler::crvkShaderCompiler( void ) : m_handle( nullptr )
+{
+    m_handle = new crvkShaderCompilerHandle_t();
+}
+
+/*
+==============================================
+crvkShaderCompiler::~crvkShaderCompiler
+==============================================
+*/
+crvkShaderCompiler::~crvkShaderCompiler( void )
+{
+    Destroy();
+
+    if ( m_handle != nullptr )
+    {
+        delete m_handle;
+        m_handle = nullptr;
+    }
+}
+
+/*
+==============================================
+crvkShaderCompiler::Create
+==============================================
+*/
+bool crvkShaderCompiler::Create( const uint32_t in_threads )
+{
+    m_handle->quit = false;
+    m_handle->threadCount = in_threads;
+    
+    // one worker per logical core 
+    if ( m_handle->threadCount == 0 )
+        m_handle->threadCount = std::max( std::thread::hardware_concurrency(), 1u );
+
+    m_handle->threads = new std::thread[m_handle->threadCount];
+    for ( uint32_t i = 0; i < m_handle->threadCount; i++ )
+        m_handle->threads[i] = std::thread( &crvkShaderCompiler::Worker, this );
+
+    return true;
+}
+
+/*
+==============================================
+crvkShaderCompiler::Destroy
+==============================================
+*/
+void crvkShaderCompiler::Destroy( void )
+{
+    if ( m_handle == nullptr || m_handle->threads == nullptr )
+        return;
+
+    // the workers drain the queue before they leave 
+    {
+        std::lock_guard<std::mutex> lock( m_handle->lock );
+        m_handle->quit = true;
+    }
+    
+    m_handle->workCond.notify_all();
+
+    for ( uint32_t i = 0; i < m_handle->threadCount; i++ )
+        m_handle->threads[i].join();
+
+    delete[] m_handle->threads;
+    m_handle->threads = nullptr;
+    m_handle->threadCount = 0;
+}
+
+/*
+==============================================
+crvkShaderCompiler::ThreadCount
+==============================================
+*/
+uint32_t crvkShaderCompiler::ThreadCount( void ) const
+{
+    return m_handle->threadCount;
+}
+
+/*
+==============================================
+crvkShaderCompiler::Enqueue
+==============================================
+*/
+void crvkShaderCompiler::Enqueue( crvkGLSLProgram* in_program )
+{
+    crvkShaderJob_t job{};
+    job.program = in_program;
+
+    in_program->m_pending = in_program->m_shaders.Count();
+
+    {
+        std::lock_guard<std::mutex> lock( m_handle->lock );
+        for ( uint32_t i = 0; i < in_program->m_shaders.Count(); i++ )
+        {
+            job.shader = in_program->m_shaders[i];
+            m_handle->jobs.push_back( job );
+        }
+    }
+
+    m_handle->workCond.notify_all();
+}
+
+/*
+==============================================
+crvkShaderCompiler::Wait
+==============================================
+*/
+void crvkShaderCompiler::Wait( const crvkGLSLProgram* in_program )
+{
+    std::unique_lock<std::mutex> lock( m_handle->lock );
+    m_handle->doneCond.wait( lock, [in_program]{ return in_program->m_status != CRVK_SHADER_COMPILE_STATUS_PENDING; } );
+}
+
+/*
+==============================================
+crvkShaderCompiler::Worker
+==============================================
+*/
+void crvkShaderCompiler::Worker( void )
+{
+    crvkShaderJob_t job{};
+
+    while ( true )
+    {
+        {
+            std::unique_lock<std::mutex> lock( m_handle->lock );
+            m_handle->workCond.wait( lock, [this]{ return m_handle->quit || !m_handle->jobs.empty(); } );
+            
+            // quit only with a empty queue
+            if ( m_handle->jobs.empty() )
+                return;
+
+            job = m_handle->jobs.front();
+            m_handle->jobs.pop_front();
+        }
+
+        if ( job.shader != nullptr )
+        {
+            // a failed parse is reported by the link 
+            job.shader->Parse();
+
+            // the last parse queue the program link 
+            if ( --job.program->m_pending == 0 )
+            {
+                job.shader = nullptr;
+                
+                {
+                    std::lock_guard<std::mutex> lock( m_handle->lock );
+                    m_handle->jobs.push_back( job );
+                }
+
+                m_handle->workCond.notify_one();
+            }
+        }
+        else
+        {
+            bool linked = job.program->Compile();
+            
+            {
+                std::lock_guard<std::mutex> lock( m_handle->lock );
+                job.program->m_status = linked ? CRVK_SHADER_COMPILE_STATUS_READY : CRVK_SHADER_COMPILE_STATUS_FAILED;
+            }
+
+            m_handle->doneCond.notify_all();
+        }
+    }
+}
@@ -31,6 +31,7 @@
 #include "crvkShaderStage.hpp"
 
 static const char* k_GLSL_SHADER_ENTRY_POINT = "main";
+static const uint32_t k_shaderCacheVersion = 1; // bump to invalidate the SPIR-V cache entries 
 
 static const glslang_stage_t VulkanStageToGlslangStage( const VkShaderStageFlagBits in_stage )
 {
@@ -86,7 +87,14 @@ static const glslang_stage_t VulkanStageToGlslangStage( const VkShaderStageFlagB
     return stage;
 }
 
-crvkGLSLShader::crvkGLSLShader( void ) : m_shdhnd( nullptr )
+crvkGLSLShader::crvkGLSLShader( void ) : 
+    m_parsed( false ),
+    m_stage( VK_SHADER_STAGE_VERTEX_BIT ),
+    m_key( 0 ),
+    m_source( nullptr ),
+    m_defines( nullptr ),
+    m_device( nullptr ),
+    m_shdhnd( nullptr )
 {
 }
 
@@ -95,10 +103,16 @@ crvkGLSLShader::~crvkGLSLShader(void)
     Destroy();
 }
 
-bool crvkGLSLShader::Create( const crvkDevice *in_device, const VkShaderStageFlagBits in_stage, const char * in_sources )
+bool crvkGLSLShader::Create( const crvkDevice *in_device, const VkShaderStageFlagBits in_stage, const char * in_sources, const char* in_defines )
 {
     m_stage = in_stage;
     m_device = const_cast<crvkDevice*>( in_device );
+
+    // keep our copy, the source is only parsed if we miss the cache 
+    m_source = SDL_strdup( in_sources );
+    if ( in_defines != nullptr )
+        m_defines = SDL_strdup( in_defines );
+
     m_shaderCI.Alloc( 1 );
     m_shaderCI->language = GLSLANG_SOURCE_GLSL;
     m_shaderCI->client = GLSLANG_CLIENT_VULKAN; 
@@ -111,31 +125,53 @@ bool crvkGLSLShader::Create( const crvkDevice *in_device, const VkShaderStageFla
     m_shaderCI->default_version = 450; // GLSL 4.5
     m_shaderCI->force_default_version_and_profile = false;
     m_shaderCI->forward_compatible = false;
-    m_shaderCI->code = in_sources;
+    m_shaderCI->code = m_source;
     m_shaderCI->stage = VulkanStageToGlslangStage( in_stage );
-    
+
+    // hash everything that change the compiler output 
+    m_key = crvkShaderCache::Hash( &k_shaderCacheVersion, sizeof( k_shaderCacheVersion ) );
+    m_key = crvkShaderCache::Hash( m_source, std::strlen( m_source ), m_key );
+    m_key = crvkShaderCache::Hash( &m_stage, sizeof( m_stage ), m_key );
+    m_key = crvkShaderCache::Hash( &m_shaderCI->client_version, sizeof( m_shaderCI->client_version ), m_key );
+    m_key = crvkShaderCache::Hash( &m_shaderCI->target_language_version, sizeof( m_shaderCI->target_language_version ), m_key );
+    m_key = crvkShaderCache::Hash( &m_shaderCI->default_version, sizeof( m_shaderCI->default_version ), m_key );
+    if ( m_defines != nullptr )
+        m_key = crvkShaderCache::Hash( m_defines, std::strlen( m_defines ), m_key );
+
+    return true;
+}
+
+bool crvkGLSLShader::Parse( void )
+{
+    // already parsed, keep the result of a failed parse too 
+    if ( m_shdhnd != nullptr )
+        return m_parsed;
+
     m_shdhnd = glslang_shader_create( &m_shaderCI );
     if ( !m_shdhnd )
     {
         return false;
     }
     
+    if ( m_defines != nullptr )
+        glslang_shader_set_preamble( m_shdhnd, m_defines );
+
+    // the parse can run in a compiler worker, the logs go to the library error output 
     if ( glslang_shader_preprocess( m_shdhnd, &m_shaderCI ) == 0 )	
     {
-        printf("%s\n", glslang_shader_get_info_log( m_shdhnd ) );
-        printf("%s\n", glslang_shader_get_info_debug_log( m_shdhnd ) );
-        //printf("%s\n", input.code);
+        crvkAppendError( glslang_shader_get_info_log( m_shdhnd ), VK_ERROR_INITIALIZATION_FAILED );
+        crvkAppendError( glslang_shader_get_info_debug_log( m_shdhnd ), VK_ERROR_INITIALIZATION_FAILED );
         return false;
     }
 
     if ( glslang_shader_parse( m_shdhnd, &m_shaderCI) == 0 ) 
     {
-        printf( "%s\n", glslang_shader_get_info_log( m_shdhnd ) );
-        printf( "%s\n", glslang_shader_get_info_debug_log( m_shdhnd ) );
-        printf( "%s\n", glslang_shader_get_preprocessed_code( m_shdhnd ) );
+        crvkAppendError( glslang_shader_get_info_log( m_shdhnd ), VK_ERROR_INITIALIZATION_FAILED );
+        crvkAppendError( glslang_shader_get_info_debug_log( m_shdhnd ), VK_ERROR_INITIALIZATION_FAILED );
         return false;
     }
 
+    m_parsed = true;
     return true;
 }
 
@@ -147,12 +183,30 @@ void crvkGLSLShader::Destroy( void )
         m_shdhnd = nullptr;
     }
     
+    m_parsed = false;
+
+    if ( m_source != nullptr )
+    {
+        SDL_free( m_source );
+        m_source = nullptr;
+    }
+
+    if ( m_defines != nullptr )
+    {
+        SDL_free( m_defines );
+        m_defines = nullptr;
+    }
+
     m_device = nullptr;
 }
 
 crvkGLSLProgram::crvkGLSLProgram(void) : 
+    m_status( CRVK_SHADER_COMPILE_STATUS_PENDING ),
+    m_pending( 0 ),
     m_program( nullptr ),
-    m_device( nullptr )
+    m_device( nullptr ),
+    m_cache( nullptr ),
+    m_compiler( nullptr )
 {
 }
 
@@ -164,16 +218,20 @@ void crvkGLSLProgram::Create( const crvkDevice *in_device )
 {
     // get the device 
     m_device = in_device->Device();
+    m_cache = in_device->ShaderCache();
 
-    // create the program handle
-    m_program = glslang_program_create();
+    // the glslang program is only created if we miss the cache
+    m_program = nullptr;
 }
 
 void crvkGLSLProgram::Destroy( void )
 {   
+    // the workers can't be using the program when we release it 
+    Wait();
+
     for ( uint32_t i = 0; i < m_stages.Count(); i++)
     {
-        auto stage = m_stages[i];
+        auto &stage = m_stages[i];
         if ( stage.module == nullptr )
             continue;
         
@@ -181,15 +239,24 @@ void crvkGLSLProgram::Destroy( void )
         stage.module = nullptr;
     }
     
+    if ( m_program != nullptr )
+    {
+        glslang_program_delete( m_program );
+        m_program = nullptr;
+    }
+
     m_stages.Clear();
+    m_shaders.Clear();
+    m_stageKeys.Clear();
+    m_compiler = nullptr;
 }
 
 void crvkGLSLProgram::AttachShader(const crvkGLSLShader *in_shader)
 {
     VkPipelineShaderStageCreateInfo pipelineShaderStageCI{};
 
-    // append shader stage
-    glslang_program_add_shader( m_program, in_shader->Shader() );
+    // the shader are added to the glslang program at link, if we need to compile 
+    m_shaders.Append( const_cast<crvkGLSLShader*>( in_shader ) );
 
     pipelineShaderStageCI.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     pipelineShaderStageCI.stage = in_shader->ShaderStageFlag();
@@ -201,17 +268,134 @@ void crvkGLSLProgram::AttachShader(const crvkGLSLShader *in_shader)
 
 bool crvkGLSLProgram::LinkProgram(void)
 {
-    // link shaders stages 
+    uint32_t missing = 0;
+    
+    m_status = CRVK_SHADER_COMPILE_STATUS_PENDING;
+
+    // create the stages that we have in the cache 
+    if ( !LoadCached( &missing ) )
+    {
+        m_status = CRVK_SHADER_COMPILE_STATUS_FAILED;
+        return false;
+    }
+
+    // cache hit, we don't need glslang 
+    if ( missing > 0 && !Compile() )
+    {
+        m_status = CRVK_SHADER_COMPILE_STATUS_FAILED;
+        return false;
+    }
+
+    m_status = CRVK_SHADER_COMPILE_STATUS_READY;
+    return true;
+}
+
+bool crvkGLSLProgram::LinkProgramAsync( crvkShaderCompiler* in_compiler )
+{
+    uint32_t missing = 0;
+    
+    m_compiler = in_compiler;
+    m_status = CRVK_SHADER_COMPILE_STATUS_PENDING;
+
+    // the cache lookup is cheap, do it here 
+    if ( !LoadCached( &missing ) )
+    {
+        m_status = CRVK_SHADER_COMPILE_STATUS_FAILED;
+        return false;
+    }
+
+    if ( missing == 0 )
+    {
+        m_status = CRVK_SHADER_COMPILE_STATUS_READY;
+        return true;
+    }
+
+    // fan out the shaders parse, the last parse will queue the link 
+    m_compiler->Enqueue( this );
+    return true;
+}
+
+bool crvkGLSLProgram::IsReady( void ) const
+{
+    return m_status != CRVK_SHADER_COMPILE_STATUS_PENDING;
+}
+
+bool crvkGLSLProgram::Wait( void )
+{
+    if ( m_status == CRVK_SHADER_COMPILE_STATUS_PENDING && m_compiler != nullptr )
+        m_compiler->Wait( this );
+
+    return m_status == CRVK_SHADER_COMPILE_STATUS_READY;
+}
+
+bool crvkGLSLProgram::LoadCached( uint32_t* out_missing )
+{
+    uint32_t i = 0;
+    uint64_t programKey = crvkShaderCache::Hash( nullptr, 0 );
+    crvkDynamicVector<uint32_t> code;
+
+    *out_missing = 0;
+
+    // the stages are linked together, so the program key cover all the attached shaders 
+    for ( i = 0; i < m_shaders.Count(); i++ )
+    {
+        uint64_t shaderKey = m_shaders[i]->Key();
+        programKey = crvkShaderCache::Hash( &shaderKey, sizeof( shaderKey ), programKey );
+    }
+
+    m_stageKeys.Resize( m_stages.Count() );
+    for ( i = 0; i < m_stages.Count(); i++ )
+    {
+        m_stageKeys[i] = crvkShaderCache::Hash( &m_stages[i].stage, sizeof( m_stages[i].stage ), programKey );
+        
+        if ( m_cache == nullptr || !m_cache->Find( m_stageKeys[i], code ) )
+        {
+            (*out_missing)++;
+            continue;
+        }
+
+        if ( !CreateModule( i, &code, code.Count() ) )
+            return false;
+    }
+
+    return true;
+}
+
+bool crvkGLSLProgram::Compile( void )
+{
+    uint32_t i = 0;
+    crvkDynamicVector<uint32_t> code;
+
+    // parse and link shaders stages, a no-op for the shaders that the workers already parsed  
+    m_program = glslang_program_create();
+    for ( i = 0; i < m_shaders.Count(); i++ )
+    {
+        if ( !m_shaders[i]->Parse() )
+        {
+            glslang_program_delete( m_program );
+            m_program = nullptr;
+            return false;
+        }
+
+        glslang_program_add_shader( m_program, m_shaders[i]->Shader() );
+    }
+
     if ( !glslang_program_link( m_program, GLSLANG_MSG_DEFAULT_BIT /*GLSLANG_MSG_SPV_RULES_BIT | GLSLANG_MSG_VULKAN_RULES_BIT*/ ) ) 
     {
-        printf("%s\n", glslang_program_get_info_log( m_program ));
-        printf("%s\n", glslang_program_get_info_debug_log( m_program ));
+        crvkAppendError( glslang_program_get_info_log( m_program ), VK_ERROR_INITIALIZATION_FAILED );
+        crvkAppendError( glslang_program_get_info_debug_log( m_program ), VK_ERROR_INITIALIZATION_FAILED );
+        glslang_program_delete( m_program );
+        m_program = nullptr;
         return false;
     }
 
-    // create the vulkan stages 
-    for ( uint32_t i = 0; i < m_stages.Count(); i++)
+    // create the vulkan stages, the glslang program hold a single SPIR-V output, so the stages are generated in sequence 
+    for ( i = 0; i < m_stages.Count(); i++)
     {
+        // loaded from the cache 
+        if ( m_stages[i].module != nullptr )
+            continue;
+
 #if 0
         // aquire spirV shader source
         glslang_spv_options_t spvOptions{};        
@@ -237,28 +421,43 @@ bool crvkGLSLProgram::LinkProgram(void)
         glslang_program_SPIRV_generate( m_program, VulkanStageToGlslangStage( m_stages[i].stage ) );
 #endif
 
-        crvkPointer<uint32_t> code;
-        code.Alloc( glslang_program_SPIRV_get_size( m_program ), 0x00 );
+        // aquire the SPIR-V words 
+        code.Resize( static_cast<uint32_t>( glslang_program_SPIRV_get_size( m_program ) ) );
+        glslang_program_SPIRV_get( m_program, &code );
 
-        // create the shader module
-        VkShaderModuleCreateInfo shaderModuleCI{};
-        shaderModuleCI.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        shaderModuleCI.codeSize = code.Size();
-        shaderModuleCI.pCode = &code;
-        shaderModuleCI.pNext = nullptr;
+        if ( m_cache != nullptr )
+            m_cache->Store( m_stageKeys[i], &code, code.Count() );
 
-        auto result = vkCreateShaderModule( m_device, &shaderModuleCI, k_allocationCallbacks, &m_stages[i].module ); 
-        if ( result != VK_SUCCESS ) 
-        {    
-            crvkAppendError( "crvkGLSLShader::Create::vkCreateShaderModule", VK_ERROR_UNKNOWN );
+        if ( !CreateModule( i, &code, code.Count() ) )
+        {
+            glslang_program_delete( m_program );
+            m_program = nullptr;
             return false;
         }
-
-        code.Free(); // release source
     }
     
     // clear program
     glslang_program_delete( m_program );
+    m_program = nullptr;
+
+    return true;
+}
+
+bool crvkGLSLProgram::CreateModule( const uint32_t in_stage, const uint32_t* in_code, const uint32_t in_count )
+{
+    // create the shader module
+    VkShaderModuleCreateInfo shaderModuleCI{};
+    shaderModuleCI.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    shaderModuleCI.codeSize = sizeof( uint32_t ) * in_count;
+    shaderModuleCI.pCode = in_code;
+    shaderModuleCI.pNext = nullptr;
+
+    auto result = vkCreateShaderModule( m_device, &shaderModuleCI, k_allocationCallbacks, &m_stages[in_stage].module ); 
+    if ( result != VK_SUCCESS ) 
+    {    
+        crvkAppendError( "crvkGLSLProgram::CreateModule::vkCreateShaderModule", result );
+        return false;
+    }
 
     return true;
 }
@@ -21,23 +21,75 @@
 
 #include "crvkPrecompiled.hpp"
 #include "crvkSwapchain.hpp"
+#include "crvkImage.hpp"
 
 typedef struct crvkSwapchainHandle_t
 {
     uint32_t                        numFrames = 0;              // available frames to render 
     uint32_t                        numImages = 0;              // availabe swapchain images
     uint32_t                        currentImage = 0;           // current frame buffer
-    uint64_t                        frame = 0;                  // our internal frame count
+    uint32_t                        framesInFlight = 0;         // frames the CPU can record ahead of the GPU 
+    uint64_t                        frame = 0;                  // our internal frame count, the frames presented 
+    uint64_t                        waitTime = 0;               // CPU time of the last frame pacing wait, in nanoseconds 
     VkExtent2D                      extent;                     // swapchain image size ( screen frame buffer size )
     VkImage*                        imageArray = nullptr;       // images from the swapchain 
     VkImageView*                    viewArray = nullptr;        // image view from swapchain
     VkSemaphore*                    imageAvailable = nullptr;   // semaphore images
-    VkFence*                        frameFences = nullptr;
+    VkSemaphore                     frameTimeline = nullptr;    // timeline semaphore, frame N signal N 
     VkSwapchainKHR                  swapchain = nullptr;        // swapchain handle 
-    VkQueue                         presentQueue = nullptr;     // device present queue
+    crvkDeviceQueue*                presentQueue = nullptr;     // device present queue
+    crvkDeviceQueue*                graphicQueue = nullptr;     // queue that signal the frame timeline 
+    crvkDeletionQueue*              deletion = nullptr;         // device deferred deletion queue 
     VkDevice                        device = nullptr;           // device handle
 } crvkSwapchainHandle_t;
 
+/*
+==============================================
+CreateFrameTimeline
+==============================================
+*/
+static bool CreateFrameTimeline( crvkSwapchainHandle_t* in_handle, const char* in_error )
+{
+    VkSemaphoreTypeCreateInfo timelineCreateInfo{};
+    timelineCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    timelineCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    timelineCreateInfo.initialValue = in_handle->frame; // the frames already presented are done 
+
+    VkSemaphoreCreateInfo semaphoreCI{};
+    semaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreCI.flags = 0;
+    semaphoreCI.pNext = &timelineCreateInfo;
+
+    VkResult result = vkCreateSemaphore( in_handle->device, &semaphoreCI, k_allocationCallbacks, &in_handle->frameTimeline );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( in_error, result );
+        return false;
+    }
+
+    return true;
+}
+
+/*
+==============================================
+WaitFrame
+==============================================
+*/
+static VkResult WaitFrame( crvkSwapchainHandle_t* in_handle, const uint64_t in_value )
+{
+    uint64_t start = SDL_GetTicksNS();
+
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &in_handle->frameTimeline;
+    waitInfo.pValues = &in_value;
+    VkResult result = vkWaitSemaphores( in_handle->device, &waitInfo, UINT64_MAX );
+
+    in_handle->waitTime = SDL_GetTicksNS() - start;
+    return result;
+}
+
 crvkSwapchain::crvkSwapchain( void ) : m_handle( nullptr )
 {
     m_handle = new crvkSwapchainHandle_t();
@@ -64,16 +116,26 @@ bool crvkSwapchain::Create(
                     const VkSurfaceFormatKHR in_surfaceformat, 
                     const VkPresentModeKHR in_presentMode,
                     const VkSurfaceTransformFlagBitsKHR in_surfaceTransformFlag,
-                    const bool in_recreate = false )
+                    const bool in_recreate )
 {
     uint32_t i = 0;
     VkResult result = VK_SUCCESS;
     uint32_t queueFamilyIndices[2] { UINT32_MAX, UINT32_MAX };
     VkSwapchainKHR oldSwapchain = nullptr;
+    uint32_t oldImageCount = 0;
+    VkImage* oldImages = nullptr;
+    VkImageView* oldViews = nullptr;
     
-    m_handle->numFrames = in_frames;
+    // the frame sync survive a recreation, keep his size 
+    if ( !in_recreate || m_handle->imageAvailable == nullptr )
+    {
+        m_handle->numFrames = std::max( in_frames, 1u );
+        m_handle->framesInFlight = m_handle->numFrames;
+    }
+
     m_handle->extent = in_extent;
     m_handle->device = in_device->Device();
+    m_handle->deletion = in_device->DeletionQueue();
 
     if ( in_present == nullptr )
     {
@@ -89,14 +151,21 @@ bool crvkSwapchain::Create(
 
     queueFamilyIndices[0] = in_present->Family();
     queueFamilyIndices[1] = in_graphic->Family();
-    m_handle->presentQueue = in_present->Queue();
+    m_handle->presentQueue = const_cast<crvkDeviceQueue*>( in_present );
+    m_handle->graphicQueue = const_cast<crvkDeviceQueue*>( in_graphic );
 
     if ( in_recreate )
     {
         oldSwapchain = m_handle->swapchain;
+        oldImageCount = m_handle->numImages;
+        oldImages = m_handle->imageArray;
+        oldViews = m_handle->viewArray;
+        m_handle->imageArray = nullptr;
+        m_handle->viewArray = nullptr;
 
-        // wait we for finish evetirthing before we recreate the swap chain
-        vkDeviceWaitIdle( m_handle->device );
+        // without a deletion queue we wait for finish evetirthing before we recreate the swap chain
+        if ( m_handle->deletion == nullptr || m_handle->frameTimeline == nullptr )
+            vkDeviceWaitIdle( m_handle->device );
     }
     
     ///
@@ -140,9 +209,35 @@ bool crvkSwapchain::Create(
         return false;
     }
 
-    // Agora sim pode destruir a antiga
-    if ( in_recreate && oldSwapchain != VK_NULL_HANDLE )
-        vkDestroySwapchainKHR( m_handle->device, oldSwapchain, k_allocationCallbacks );
+    // Agora sim pode destruir a antiga, the old views and swapchain are released 
+    // when the GPU finish the frames already submitted 
+    if ( in_recreate )
+    {
+        crvkTimelinePoint_t lastFrame{ m_handle->frameTimeline, m_handle->frame };
+        bool deferred = m_handle->deletion != nullptr && m_handle->frameTimeline != nullptr;
+
+        for ( i = 0; i < oldImageCount; i++ )
+        {
+            if ( oldViews == nullptr || oldViews[i] == nullptr )
+                continue;
+
+            if ( deferred )
+                m_handle->deletion->Enqueue( VK_OBJECT_TYPE_IMAGE_VIEW, reinterpret_cast<uint64_t>( oldViews[i] ), &lastFrame, 1 );
+            else
+                vkDestroyImageView( m_handle->device, oldViews[i], k_allocationCallbacks );
+        }
+
+        if ( oldSwapchain != VK_NULL_HANDLE )
+        {
+            if ( deferred )
+                m_handle->deletion->Enqueue( VK_OBJECT_TYPE_SWAPCHAIN_KHR, reinterpret_cast<uint64_t>( oldSwapchain ), &lastFrame, 1 );
+            else
+                vkDestroySwapchainKHR( m_handle->device, oldSwapchain, k_allocationCallbacks );
+        }
+
+        SDL_free( oldViews );
+        SDL_free( oldImages );
+    }
 
     // Get the available image count 
     vkGetSwapchainImagesKHR( m_handle->device, m_handle->swapchain, &m_handle->numImages, nullptr );
@@ -169,11 +264,6 @@ bool crvkSwapchain::Create(
     // create the swap chain views
     for ( i = 0; i < m_handle->numImages; i++) 
     {
-    
-        // destroy old view 
-        if ( in_recreate )
-            vkDestroyImageView( m_handle->device, m_handle->viewArray[i], k_allocationCallbacks );
-    
         createInfo.image = m_handle->imageArray[i];    
         result = vkCreateImageView( m_handle->device, &createInfo, k_allocationCallbacks, &m_handle->viewArray[i] ); 
         if ( result != VK_SUCCESS ) 
@@ -183,8 +273,8 @@ bool crvkSwapchain::Create(
         }
     }
 
-    // if we are just recreating the swap chain we don't recreate fences and semaphores 
-    if ( in_recreate && ( m_handle->imageAvailable != nullptr ) && ( m_handle->frameFences != nullptr) )
+    // if we are just recreating the swap chain we don't recreate the semaphores 
+    if ( in_recreate && ( m_handle->imageAvailable != nullptr ) && ( m_handle->frameTimeline != nullptr ) )
         return true;    
 
     //
@@ -197,15 +287,8 @@ bool crvkSwapchain::Create(
     semaphoreInfo.pNext = nullptr;
     semaphoreInfo.flags = 0;
 
-    // Fence configuration
-    VkFenceCreateInfo fenceCI{};
-    fenceCI.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fenceCI.pNext = nullptr;
-    fenceCI.flags = 0;
-
     // alloc the structures arrays 
-    m_handle->imageAvailable = static_cast<VkSemaphore*>( SDL_malloc( sizeof( VkSemaphore ) * m_handle->numFrames ) );
-    m_handle->frameFences = static_cast<VkFence*>( SDL_malloc( sizeof( VkFence ) * m_handle->numFrames ) );
+    m_handle->imageAvailable = static_cast<VkSemaphore*>( SDL_calloc( m_handle->numFrames, sizeof( VkSemaphore ) ) );
     for ( i = 0; i < m_handle->numFrames; i++)
     {
         // create the semaphore object
@@ -215,16 +298,11 @@ bool crvkSwapchain::Create(
             crvkAppendError( "crvkSwapchain::Create::vkCreateSemaphore", result );
             return false;
         }
-
-        // create the fence object
-        result = vkCreateFence( m_handle->device, &fenceCI, k_allocationCallbacks, &m_handle->frameFences[i] );
-        if( result != VK_SUCCESS )
-        {
-            crvkAppendError( "crvkSwapchain::Create::vkCreateFence", result );
-            return false;
-        }
-
     }
+
+    // the frame pacing timeline 
+    if ( !CreateFrameTimeline( m_handle, "crvkSwapchain::Create::vkCreateSemaphore::FRAME" ) )
+        return false;
     
     return true;
 }
@@ -238,21 +316,38 @@ void crvkSwapchain::Destroy( void )
 {
     uint32_t i = 0;
     
-    if ( m_handle == nullptr )
+    if ( m_handle == nullptr || m_handle->device == nullptr )
         return;
 
+    // wait the GPU finish the last frame, and release what wait for it 
+    if ( m_handle->frameTimeline != nullptr )
+    {
+        WaitFrame( m_handle, m_handle->frame );
+        if ( m_handle->deletion != nullptr )
+            m_handle->deletion->Collect();
+
+        vkDestroySemaphore( m_handle->device, m_handle->frameTimeline, k_allocationCallbacks );
+        m_handle->frameTimeline = nullptr;
+    }
+
     // release the semaphores
-    for ( i = 0; i < m_handle->numFrames; i++)
+    if ( m_handle->imageAvailable != nullptr )
     {
-        vkDestroySemaphore( m_handle->device, m_handle->imageAvailable[i], k_allocationCallbacks );
-        m_handle->imageArray[i] = nullptr;
+        for ( i = 0; i < m_handle->numFrames; i++)
+            vkDestroySemaphore( m_handle->device, m_handle->imageAvailable[i], k_allocationCallbacks );
+
+        SDL_free( m_handle->imageAvailable );
+        m_handle->imageAvailable = nullptr;
     }
     
     // release image views
-    for ( i = 0; i < m_handle->numImages; i++)
+    if ( m_handle->viewArray != nullptr )
     {
-        vkDestroyImageView( m_handle->device, m_handle->viewArray[i], k_allocationCallbacks );
-        m_handle->viewArray[i] = nullptr;
+        for ( i = 0; i < m_handle->numImages; i++)
+        {
+            vkDestroyImageView( m_handle->device, m_handle->viewArray[i], k_allocationCallbacks );
+            m_handle->viewArray[i] = nullptr;
+        }
     }
 
     // release swapchain 
@@ -275,6 +370,10 @@ void crvkSwapchain::Destroy( void )
         SDL_free( m_handle->imageArray );
         m_handle->imageArray = nullptr;
     }    
+
+    m_handle->numFrames = 0;
+    m_handle->numImages = 0;
+    m_handle->device = nullptr;
 }
 
 /*
@@ -286,15 +385,21 @@ VkResult crvkSwapchain::AcquireImage( void )
 {
     VkResult result = VK_SUCCESS;
     uint32_t frameID = m_handle->frame % m_handle->numFrames;
+    uint64_t frameValue = m_handle->frame + 1;
 
     //
-    // Wait for the device finish last render in previous match frame
+    // Wait for the device finish the frame N - frames in flight, the acquire semaphore 
+    // of the slot was consumed by it, since we never have more frames in flight than slots
     // 
-    result = vkWaitForFences( m_handle->device, 1, &m_handle->frameFences[frameID], VK_TRUE, UINT64_MAX );
-    if ( result != VK_SUCCESS )
+    m_handle->waitTime = 0;
+    if ( frameValue > m_handle->framesInFlight )
     {
-        crvkAppendError( "crvkSwapchain::AcquireImage::vkWaitForFences", result );
-        return result;
+        result = WaitFrame( m_handle, frameValue - m_handle->framesInFlight );
+        if ( result != VK_SUCCESS )
+        {
+            crvkAppendError( "crvkSwapchain::AcquireImage::vkWaitSemaphores", result );
+            return result;
+        }
     }
 
     //
@@ -315,8 +420,7 @@ VkResult crvkSwapchain::AcquireImage( void )
         return result;
     }
 
-    // reset the fence only if we don't fid a problem in aquire the image  
-    vkResetFences( m_handle->device, 1, &m_handle->frameFences[frameID] );
+    return result;
 }
 
 /*
@@ -328,18 +432,94 @@ VkResult crvkSwapchain::PresentImage( const VkSemaphore* in_waitSemaphores, cons
 {
     VkResult result = VK_SUCCESS;
 
-    // present to the window
-    VkPresentInfoKHR presentInfo{};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = in_waitSemaphoresCount;
-    presentInfo.pWaitSemaphores = in_waitSemaphores;
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = &m_handle->swapchain;
-    presentInfo.pImageIndices = &m_handle->currentImage;
-    vkQueuePresentKHR( m_handle->presentQueue, &presentInfo );
+    // signal the frame value after all the work of the frame, the signal 
+    // wait every command submited before it in the queue 
+    VkSemaphoreSubmitInfo frameSignal{};
+    frameSignal.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    frameSignal.semaphore = m_handle->frameTimeline;
+    frameSignal.value = m_handle->frame + 1;
+    frameSignal.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    result = m_handle->graphicQueue->Submit( nullptr, 0, nullptr, 0, &frameSignal, 1, nullptr );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkSwapchain::PresentImage::Submit", result );
+        return result;
+    }
 
-    // increment frame count
+    // the present wait semaphores must be signaled by submitted work, the present queue 
+    // flush his own batches, but a other graphic queue must have sent the work first 
+    if ( m_handle->graphicQueue != m_handle->presentQueue )
+    {
+        result = m_handle->graphicQueue->Flush();
+        if ( result != VK_SUCCESS )
+        {
+            crvkAppendError( "crvkSwapchain::PresentImage::Flush", result );
+            return result;
+        }
+    }
+
+    // present to the window, go through the queue, it can be owned by the submission thread 
+    result = m_handle->presentQueue->Present( &m_handle->swapchain, &m_handle->currentImage, 1, in_waitSemaphores, in_waitSemaphoresCount );
+    
+    // the frame signal was submitted, the frame is consumed even if the present fail 
     m_handle->frame++; 
+
+    // out of date and suboptimal are left to the caller, that recreate the swapchain 
+    if ( result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR && result != VK_ERROR_OUT_OF_DATE_KHR )
+        crvkAppendError( "crvkSwapchain::PresentImage::Present", result );
+
+    return result;
+}
+
+/*
+==============================================
+crvkSwapchain::SetFramesInFlight
+==============================================
+*/
+void crvkSwapchain::SetFramesInFlight( const uint32_t in_frames )
+{
+    // more frames than acquire semaphores would reuse one still waited 
+    m_handle->framesInFlight = std::clamp( in_frames, 1u, std::max( m_handle->numFrames, 1u ) );
+}
+
+/*
+==============================================
+crvkSwapchain::FramesInFlight
+==============================================
+*/
+uint32_t crvkSwapchain::FramesInFlight( void ) const
+{
+    return m_handle->framesInFlight;
+}
+
+/*
+==============================================
+crvkSwapchain::FrameSemaphore
+==============================================
+*/
+VkSemaphore crvkSwapchain::FrameSemaphore( void ) const
+{
+    return m_handle->frameTimeline;
+}
+
+/*
+==============================================
+crvkSwapchain::FrameValue
+==============================================
+*/
+uint64_t crvkSwapchain::FrameValue( void ) const
+{
+    return m_handle->frame + 1;
+}
+
+/*
+==============================================
+crvkSwapchain::FrameWaitTime
+==============================================
+*/
+uint64_t crvkSwapchain::FrameWaitTime( void ) const
+{
+    return m_handle->waitTime;
 }
 
 /*
@@ -400,4 +580,302 @@ crvkSwapchain::Extent
 VkExtent2D crvkSwapchain::Extent( void ) const
 {
     return m_handle->extent;
-}
\ No newline at end of file
+}
+
+/*
+==============================================
+crvkSwapchain::CurrentImage
+==============================================
+*/
+const VkImage crvkSwapchain::CurrentImage( void ) const
+{
+    return m_handle->imageArray[m_handle->currentImage];
+}
+
+/*
+==============================================
+crvkSwapchain::CurrentImageView
+==============================================
+*/
+const VkImageView crvkSwapchain::CurrentImageView( void ) const
+{
+    return m_handle->viewArray[m_handle->currentImage];
+}
+
+/*
+==============================================
+crvkSwapchain::CurrentSemaphore
+==============================================
+*/
+const VkSemaphore crvkSwapchain::CurrentSemaphore( void ) const
+{
+    return m_handle->imageAvailable[m_handle->frame % m_handle->numFrames];
+}
+
+/*
+==============================================
+crvkSwapchain::Swapchain
+==============================================
+*/
+VkSwapchainKHR crvkSwapchain::Swapchain( void ) const
+{
+    return m_handle->swapchain;
+}
+
+/*
+==============================================
+crvkSwapchainOffscreen::crvkSwapchainOffscreen
+==============================================
+*/
+crvkSwapchainOffscreen::crvkSwapchainOffscreen( void ) : 
+    crvkSwapchain(),
+    m_presentValue( 0 ),
+    m_targets( nullptr )
+{
+}
+
+/*
+==============================================
+crvkSwapchainOffscreen::~crvkSwapchainOffscreen
+==============================================
+*/
+crvkSwapchainOffscreen::~crvkSwapchainOffscreen( void )
+{
+    // release our resources before the base swapchain try to 
+    Destroy();
+}
+
+/*
+==============================================
+crvkSwapchainOffscreen::Create
+==============================================
+*/
+bool crvkSwapchainOffscreen::Create( 
+                    const crvkDevice* in_device,
+                    const crvkDeviceQueue* in_graphic,
+                    const uint32_t in_frames, 
+                    const VkExtent2D in_extent, 
+                    const VkFormat in_format )
+{
+    uint32_t i = 0;
+    VkResult result = VK_SUCCESS;
+
+    if ( in_graphic == nullptr )
+    {
+        crvkAppendError( "crvkSwapchainOffscreen::Create::NO GRAPHIC QUEUE FOUND", VK_INCOMPLETE );
+        return false;
+    }
+
+    m_handle->graphicQueue = const_cast<crvkDeviceQueue*>( in_graphic );
+    m_handle->numFrames = std::max( in_frames, 1u );
+    m_handle->numImages = m_handle->numFrames; // one render target per frame 
+    m_handle->framesInFlight = m_handle->numFrames;
+    m_handle->currentImage = 0;
+    m_handle->frame = 0;
+    m_handle->extent = in_extent;
+    m_handle->device = in_device->Device();
+    m_handle->deletion = in_device->DeletionQueue();
+
+    ///
+    /// Create the render targets ring
+    /// ==========================================================================
+    m_targets = new crvkImage[m_handle->numImages];
+    m_handle->imageArray = static_cast<VkImage*>( SDL_malloc( sizeof( VkImage ) * m_handle->numImages ) );
+    m_handle->viewArray = static_cast<VkImageView*>( SDL_malloc( sizeof( VkImageView ) * m_handle->numImages ) );
+
+    for ( i = 0; i < m_handle->numImages; i++ )
+    {
+        // transfer source so we can read back the rendered frames 
+        if ( !m_targets[i].Create( in_device, VK_IMAGE_VIEW_TYPE_2D, in_format, 1, 1, in_extent.width, in_extent.height, 1, VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT ) )
+            return false;
+
+        m_handle->imageArray[i] = m_targets[i].Handle();
+        m_handle->viewArray[i] = m_targets[i].View();
+    }
+
+    ///
+    /// Create the sync structures 
+    /// ==========================================================================
+    
+    // the present signal the frame timeline 
+    if ( !CreateFrameTimeline( m_handle, "crvkSwapchainOffscreen::Create::vkCreateSemaphore::PRESENT" ) )
+        return false;
+
+    // binary semaphores, the same the swapchain image acquire signal 
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = nullptr;
+    semaphoreInfo.flags = 0;
+
+    m_handle->imageAvailable = static_cast<VkSemaphore*>( SDL_calloc( m_handle->numFrames, sizeof( VkSemaphore ) ) );
+    for ( i = 0; i < m_handle->numFrames; i++ )
+    {
+        result = vkCreateSemaphore( m_handle->device, &semaphoreInfo, k_allocationCallbacks, &m_handle->imageAvailable[i] ); 
+        if( result != VK_SUCCESS )
+        {
+            crvkAppendError( "crvkSwapchainOffscreen::Create::vkCreateSemaphore", result );
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+==============================================
+crvkSwapchainOffscreen::Destroy
+==============================================
+*/
+void crvkSwapchainOffscreen::Destroy( void )
+{
+    uint32_t i = 0;
+
+    if ( m_handle == nullptr || m_handle->device == nullptr )
+        return;
+
+    // wait the last present to release the render targets 
+    if ( m_handle->frameTimeline != nullptr )
+    {
+        WaitFrame( m_handle, m_presentValue );
+        vkDestroySemaphore( m_handle->device, m_handle->frameTimeline, k_allocationCallbacks );
+        m_handle->frameTimeline = nullptr;
+    }
+
+    // release the acquire semaphores
+    if ( m_handle->imageAvailable != nullptr )
+    {
+        for ( i = 0; i < m_handle->numFrames; i++ )
+            vkDestroySemaphore( m_handle->device, m_handle->imageAvailable[i], k_allocationCallbacks );
+        
+        SDL_free( m_handle->imageAvailable );
+        m_handle->imageAvailable = nullptr;
+    }
+
+    // the views are owned by the render targets 
+    if ( m_targets != nullptr )
+    {
+        delete[] m_targets;
+        m_targets = nullptr;
+    }
+
+    if ( m_handle->viewArray != nullptr )
+    {
+        SDL_free( m_handle->viewArray );
+        m_handle->viewArray = nullptr;
+    }
+
+    if ( m_handle->imageArray != nullptr )
+    {
+        SDL_free( m_handle->imageArray );
+        m_handle->imageArray = nullptr;
+    }
+
+    // nothing left for the base swapchain to release 
+    m_handle->numFrames = 0;
+    m_handle->numImages = 0;
+    m_handle->device = nullptr;
+    m_presentValue = 0;
+    m_handle->graphicQueue = nullptr;
+}
+
+/*
+==============================================
+crvkSwapchainOffscreen::AcquireImage
+==============================================
+*/
+VkResult crvkSwapchainOffscreen::AcquireImage( void )
+{
+    VkResult result = VK_SUCCESS;
+    uint32_t frameID = m_handle->frame % m_handle->numFrames;
+    uint32_t imageID = m_handle->frame % m_handle->numImages;
+    uint64_t frameValue = m_handle->frame + 1;
+
+    //
+    // Wait for the present of the frame N - frames in flight, the ring are rolled in order, 
+    // so the render target was last used by the frame N - FrameCount, already done
+    // 
+    m_handle->waitTime = 0;
+    if ( frameValue > m_handle->framesInFlight )
+    {
+        result = WaitFrame( m_handle, frameValue - m_handle->framesInFlight );
+        if ( result != VK_SUCCESS )
+        {
+            crvkAppendError( "crvkSwapchainOffscreen::AcquireImage::vkWaitSemaphores", result );
+            return result;
+        }
+    }
+
+    m_handle->currentImage = imageID;
+
+    //
+    // Signal the acquire semaphore, the render submit wait on it like in a real swapchain
+    //
+    VkSemaphoreSubmitInfo signalInfo{};
+    signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    signalInfo.semaphore = m_handle->imageAvailable[frameID];
+    signalInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    result = m_handle->graphicQueue->Submit( nullptr, 0, nullptr, 0, &signalInfo, 1, nullptr );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkSwapchainOffscreen::AcquireImage::Submit", result );
+        return result;
+    }
+
+    return result;
+}
+
+/*
+==============================================
+crvkSwapchainOffscreen::PresentImage
+==============================================
+*/
+VkResult crvkSwapchainOffscreen::PresentImage( const VkSemaphore* in_waitSemaphores, const uint32_t in_waitSemaphoresCount )
+{
+    uint32_t i = 0;
+    VkResult result = VK_SUCCESS;
+    crvkDynamicVector<VkSemaphoreSubmitInfo> waitInfos;
+
+    // consume the render finish semaphores, as the presentation engine does
+    waitInfos.Resize( in_waitSemaphoresCount );
+    for ( i = 0; i < in_waitSemaphoresCount; i++ )
+    {
+        waitInfos[i] = VkSemaphoreSubmitInfo{};
+        waitInfos[i].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        waitInfos[i].semaphore = in_waitSemaphores[i];
+        waitInfos[i].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    }
+
+    // release the render target when the GPU reach it 
+    VkSemaphoreSubmitInfo signalInfo{};
+    signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    signalInfo.semaphore = m_handle->frameTimeline;
+    signalInfo.value = m_presentValue + 1;
+    signalInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    result = m_handle->graphicQueue->Submit( &waitInfos, waitInfos.Count(), nullptr, 0, &signalInfo, 1, nullptr );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkSwapchainOffscreen::PresentImage::Submit", result );
+        return result;
+    }
+
+    // the present is a flush point, like crvkDeviceQueue::Present 
+    result = m_handle->graphicQueue->Flush();
+    if ( result != VK_SUCCESS )
+        return result;
+
+    m_presentValue++;
+
+    // increment frame count
+    m_handle->frame++; 
+    return result;
+}
+
+/*
+==============================================
+crvkSwapchainOffscreen::CurrentTarget
+==============================================
+*/
+const crvkImage* crvkSwapchainOffscreen::CurrentTarget( void ) const
+{
+    return &m_targets[m_handle->currentImage];
+}
@@ -0,0 +1,606 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+
+#include "crvkPrecompiled.hpp"
+#include "crvkImage.hpp"
+#include "crvkUploadBatch.hpp"
+
+static const uint32_t       k_batchFrames = 2;  // batches recorded while the last one are in flight 
+
+typedef struct crvkUploadBufferCopy_t
+{
+    crvkBufferStatic*   buffer;     // destine buffer 
+    VkBuffer            staging;    // staging ring buffer 
+    VkBufferCopy2       region;
+} crvkUploadBufferCopy_t;
+
+typedef struct crvkUploadImageCopy_t
+{
+    crvkImageStatic*    image;      // destine image 
+    VkBuffer            staging;    // staging ring buffer 
+    VkBufferImageCopy2  region;
+} crvkUploadImageCopy_t;
+
+typedef struct crvkUploadBatchFrame_t
+{
+    uint64_t            value = 0;  // ring value signaled by the last submit of this frame 
+    VkCommandPool       commandPool = nullptr;
+    VkCommandBuffer     commandBuffer = nullptr;
+} crvkUploadBatchFrame_t;
+
+typedef struct crvkUploadBatchHandle_t
+{
+    uint32_t                                    frame = 0;
+    crvkDeviceQueue*                            queue = nullptr;
+    VkDevice                                    device = nullptr;
+    crvkUploadManager*                          uploadManager = nullptr;
+    crvkUploadBatchFrame_t                      frames[k_batchFrames];
+    crvkDynamicVector<crvkUploadBufferCopy_t>   bufferCopies;   // queued buffer copies
+    crvkDynamicVector<crvkUploadImageCopy_t>    imageCopies;    // queued image copies 
+    crvkDynamicVector<crvkStagingRange_t>       ranges;         // staging ranges used by the queued copies 
+    crvkDynamicVector<VkSemaphoreSubmitInfo>    waits;          // touched resources last copy and use 
+    crvkDynamicVector<VkBufferCopy2>            bufferRegions;  // regions of a single copy command 
+    crvkDynamicVector<VkBufferImageCopy2>       imageRegions;   // regions of a single copy command 
+    crvkBarrierBatch                            barriers;       // state transitions of the touched resources 
+} crvkUploadBatchHandle_t;
+
+/*
+==============================================
+RecordBufferCopy
+==============================================
+*/
+static void RecordBufferCopy( const VkCommandBuffer in_commandBuffer, const VkBuffer in_src, const VkBuffer in_dst, crvkDynamicVector<VkBufferCopy2>& in_regions )
+{
+    if ( in_regions.Count() == 0 )
+        return;
+
+    VkCopyBufferInfo2 copyBufferInfo{};
+    copyBufferInfo.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2;
+    copyBufferInfo.pNext = nullptr;
+    copyBufferInfo.srcBuffer = in_src;
+    copyBufferInfo.dstBuffer = in_dst;
+    copyBufferInfo.regionCount = in_regions.Count();
+    copyBufferInfo.pRegions = &in_regions;
+    vkCmdCopyBuffer2( in_commandBuffer, &copyBufferInfo );
+    in_regions.Reset();
+}
+
+/*
+==============================================
+RecordImageCopy
+==============================================
+*/
+static void RecordImageCopy( const VkCommandBuffer in_commandBuffer, const VkBuffer in_src, const VkImage in_dst, crvkDynamicVector<VkBufferImageCopy2>& in_regions )
+{
+    if ( in_regions.Count() == 0 )
+        return;
+
+    VkCopyBufferToImageInfo2 copyBufferToImage{};
+    copyBufferToImage.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_TO_IMAGE_INFO_2;
+    copyBufferToImage.pNext = nullptr;
+    copyBufferToImage.srcBuffer = in_src;
+    copyBufferToImage.dstImage = in_dst;
+    copyBufferToImage.dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    copyBufferToImage.regionCount = in_regions.Count();
+    copyBufferToImage.pRegions = &in_regions;
+    vkCmdCopyBufferToImage2( in_commandBuffer, &copyBufferToImage );
+    in_regions.Reset();
+}
+
+/*
+==============================================
+RecordWriteAfterWrite
+==============================================
+*/
+static void RecordWriteAfterWrite( const VkCommandBuffer in_commandBuffer )
+{
+    VkMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+    VkDependencyInfo depInfo{};
+    depInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    depInfo.memoryBarrierCount = 1;
+    depInfo.pMemoryBarriers = &barrier;
+    vkCmdPipelineBarrier2( in_commandBuffer, &depInfo );
+}
+
+/*
+==============================================
+ImageRegionsOverlap
+==============================================
+*/
+static bool ImageRegionsOverlap( const VkBufferImageCopy2& in_a, const VkBufferImageCopy2& in_b )
+{
+    const VkImageSubresourceLayers& a = in_a.imageSubresource;
+    const VkImageSubresourceLayers& b = in_b.imageSubresource;
+
+    // other aspect, level or layers 
+    if ( ( a.aspectMask & b.aspectMask ) == 0 || a.mipLevel != b.mipLevel )
+        return false;
+
+    if ( a.baseArrayLayer + a.layerCount <= b.baseArrayLayer || b.baseArrayLayer + b.layerCount <= a.baseArrayLayer )
+        return false;
+
+    // the texel boxes 
+    return  in_a.imageOffset.x < in_b.imageOffset.x + static_cast<int32_t>( in_b.imageExtent.width ) &&
+            in_b.imageOffset.x < in_a.imageOffset.x + static_cast<int32_t>( in_a.imageExtent.width ) &&
+            in_a.imageOffset.y < in_b.imageOffset.y + static_cast<int32_t>( in_b.imageExtent.height ) &&
+            in_b.imageOffset.y < in_a.imageOffset.y + static_cast<int32_t>( in_a.imageExtent.height ) &&
+            in_a.imageOffset.z < in_b.imageOffset.z + static_cast<int32_t>( in_b.imageExtent.depth ) &&
+            in_b.imageOffset.z < in_a.imageOffset.z + static_cast<int32_t>( in_a.imageExtent.depth );
+}
+
+/*
+==============================================
+crvkUploadBatch::crvkUploadBatch
+==============================================
+*/
+crvkUploadBatch::crvkUploadBatch( void ) : m_handle( nullptr )
+{
+}
+
+/*
+==============================================
+crvkUploadBatch::~crvkUploadBatch
+==============================================
+*/
+crvkUploadBatch::~crvkUploadBatch( void )
+{
+    Destroy();
+}
+
+/*
+==============================================
+crvkUploadBatch::Create
+==============================================
+*/
+bool crvkUploadBatch::Create( const crvkDevice* in_device, const crvkDeviceQueue* in_queue )
+{
+    VkResult result = VK_SUCCESS;
+
+    m_handle = new crvkUploadBatchHandle_t();
+    m_handle->device = in_device->Device();
+    m_handle->uploadManager = in_device->UploadManager();
+    m_handle->queue = const_cast<crvkDeviceQueue*>( in_queue );
+
+    for ( uint32_t i = 0; i < k_batchFrames; i++ )
+    {
+        crvkUploadBatchFrame_t& frame = m_handle->frames[i];
+
+        // the whole pool is reset before record a batch
+        VkCommandPoolCreateInfo poolCI{};
+        poolCI.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolCI.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolCI.queueFamilyIndex = in_queue->Family();
+        result = vkCreateCommandPool( m_handle->device, &poolCI, k_allocationCallbacks, &frame.commandPool );
+        if ( result != VK_SUCCESS )
+        {
+            crvkAppendError( "crvkUploadBatch::Create::vkCreateCommandPool", result );
+            return false;
+        }
+
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+        allocInfo.commandPool = frame.commandPool;
+        result = vkAllocateCommandBuffers( m_handle->device, &allocInfo, &frame.commandBuffer );
+        if ( result != VK_SUCCESS )
+        {
+            crvkAppendError( "crvkUploadBatch::Create::vkAllocateCommandBuffers", result );
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+==============================================
+crvkUploadBatch::Destroy
+==============================================
+*/
+void crvkUploadBatch::Destroy( void )
+{
+    if ( m_handle == nullptr )
+        return;
+
+    // give back the ranges of the copies never submitted
+    Discard();
+
+    for ( uint32_t i = 0; i < k_batchFrames; i++ )
+    {
+        crvkUploadBatchFrame_t& frame = m_handle->frames[i];
+        
+        // wait the GPU release the command buffer 
+        Wait( frame.value );
+
+        if ( frame.commandPool != nullptr )
+        {
+            vkDestroyCommandPool( m_handle->device, frame.commandPool, k_allocationCallbacks );
+            frame.commandPool = nullptr;
+            frame.commandBuffer = nullptr;
+        }
+    }
+
+    delete m_handle;
+    m_handle = nullptr;
+}
+
+/*
+==============================================
+crvkUploadBatch::BufferSubData
+==============================================
+*/
+bool crvkUploadBatch::BufferSubData( crvkBufferStatic* in_buffer, const void* in_data, const uintptr_t in_offset, const size_t in_size )
+{
+    const uint8_t* data = static_cast<const uint8_t*>( in_data );
+    VkDeviceSize chunkSize = m_handle->uploadManager->Capacity() / 4; // don't let a single upload hold the whole ring 
+
+    for ( VkDeviceSize done = 0; done < in_size; done += chunkSize )
+    {
+        crvkStagingRange_t range{};
+        VkDeviceSize size = std::min<VkDeviceSize>( chunkSize, in_size - done );
+
+        // the ring is full of our own ranges, send what we have and try again
+        if ( !m_handle->uploadManager->Allocate( size, 4, &range ) )
+        {
+            if ( PendingCount() == 0 || Submit() == 0 || !m_handle->uploadManager->Allocate( size, 4, &range ) )
+                return false;
+        }
+
+        std::memcpy( range.pointer, data + done, size );
+        
+        crvkUploadBufferCopy_t copy{};
+        copy.buffer = in_buffer;
+        copy.staging = range.buffer;
+        copy.region.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
+        copy.region.pNext = nullptr;
+        copy.region.srcOffset = range.offset;
+        copy.region.dstOffset = in_offset + done;
+        copy.region.size = size;
+        m_handle->bufferCopies.Append( copy );
+        m_handle->ranges.Append( range );
+    }
+
+    return true;
+}
+
+/*
+==============================================
+crvkUploadBatch::ImageSubData
+==============================================
+*/
+bool crvkUploadBatch::ImageSubData( crvkImageStatic* in_image, const void* in_data, const size_t in_size, const VkBufferImageCopy2* in_regions, const uint32_t in_count )
+{
+    crvkStagingRange_t range{};
+
+    // image copies can't be splited, the whole content must fit in the ring
+    if ( !m_handle->uploadManager->Allocate( in_size, 16, &range ) )
+    {
+        if ( PendingCount() == 0 || Submit() == 0 || !m_handle->uploadManager->Allocate( in_size, 16, &range ) )
+            return false;
+    }
+
+    std::memcpy( range.pointer, in_data, in_size );
+
+    for ( uint32_t i = 0; i < in_count; i++ )
+    {
+        crvkUploadImageCopy_t copy{};
+        copy.image = in_image;
+        copy.staging = range.buffer;
+        copy.region = in_regions[i];
+        copy.region.bufferOffset += range.offset; // move to the staging ring range 
+        m_handle->imageCopies.Append( copy );
+    }
+
+    m_handle->ranges.Append( range );
+    return true;
+}
+
+/*
+==============================================
+crvkUploadBatch::Submit
+==============================================
+*/
+uint64_t crvkUploadBatch::Submit( void )
+{
+    VkResult result = VK_SUCCESS;
+    uint64_t value = 0;
+    
+    if ( PendingCount() == 0 )
+        return 0;
+
+    crvkUploadBatchFrame_t& frame = m_handle->frames[m_handle->frame];
+
+    // wait the GPU release the frame command buffer
+    result = Wait( frame.value );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkUploadBatch::Submit::vkWaitSemaphores", result );
+        Discard();
+        return 0;
+    }
+
+    result = vkResetCommandPool( m_handle->device, frame.commandPool, 0 );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkUploadBatch::Submit::vkResetCommandPool", result );
+        Discard();
+        return 0;
+    }
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    result = vkBeginCommandBuffer( frame.commandBuffer, &beginInfo );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkUploadBatch::Submit::vkBeginCommandBuffer", result );
+        Discard();
+        return 0;
+    }
+
+    // record all the copies, the waits of every touched resource are gathered 
+    m_handle->waits.Reset();
+    m_handle->barriers.Begin( frame.commandBuffer );
+    RecordBuffers( frame.commandBuffer );
+    RecordImages( frame.commandBuffer );
+
+    result = vkEndCommandBuffer( frame.commandBuffer );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkUploadBatch::Submit::vkEndCommandBuffer", result );
+        Discard();
+        return 0;
+    }
+
+    VkCommandBufferSubmitInfo commandBufferSubmitInfo{};
+    commandBufferSubmitInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    commandBufferSubmitInfo.commandBuffer = frame.commandBuffer;
+
+    VkSubmitInfo2 submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+    submitInfo.waitSemaphoreInfoCount = m_handle->waits.Count();
+    submitInfo.pWaitSemaphoreInfos = &m_handle->waits;
+    submitInfo.commandBufferInfoCount = 1;
+    submitInfo.pCommandBufferInfos = &commandBufferSubmitInfo;
+    submitInfo.signalSemaphoreInfoCount = 0;
+    submitInfo.pSignalSemaphoreInfos = nullptr;
+
+    // a single ring value signal the end of the whole batch, and release the staging ranges
+    result = m_handle->uploadManager->Submit( m_handle->queue, &submitInfo, &m_handle->ranges, m_handle->ranges.Count(), &value );
+    if ( result != VK_SUCCESS )
+    {
+        Discard();
+        return 0;
+    }
+
+    // every touched resource now wait for the batch 
+    VkSemaphore semaphore = m_handle->uploadManager->Semaphore( m_handle->queue );
+    for ( uint32_t i = 0; i < m_handle->bufferCopies.Count(); i++ )
+        m_handle->bufferCopies[i].buffer->SetLastCopy( semaphore, value );
+
+    for ( uint32_t i = 0; i < m_handle->imageCopies.Count(); i++ )
+        m_handle->imageCopies[i].image->SetLastCopy( semaphore, value );
+    
+    frame.value = value;
+    m_handle->frame = ( m_handle->frame + 1 ) % k_batchFrames;
+    m_handle->bufferCopies.Reset();
+    m_handle->imageCopies.Reset();
+    m_handle->ranges.Reset();
+    return value;
+}
+
+/*
+==============================================
+crvkUploadBatch::Wait
+==============================================
+*/
+VkResult crvkUploadBatch::Wait( const uint64_t in_value ) const
+{
+    VkSemaphore semaphore = m_handle->uploadManager->Semaphore( m_handle->queue );
+
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &semaphore;
+    waitInfo.pValues = &in_value;
+
+    // the batch can be still queued in a deferred queue 
+    if ( in_value > 0 )
+        m_handle->queue->Flush();
+
+    return vkWaitSemaphores( m_handle->device, &waitInfo, UINT64_MAX );
+}
+
+/*
+==============================================
+crvkUploadBatch::Semaphore
+==============================================
+*/
+VkSemaphore crvkUploadBatch::Semaphore( void ) const
+{
+    if ( m_handle == nullptr )
+        return nullptr;
+
+    return m_handle->uploadManager->Semaphore( m_handle->queue );
+}
+
+/*
+==============================================
+crvkUploadBatch::PendingCount
+==============================================
+*/
+uint32_t crvkUploadBatch::PendingCount( void ) const
+{
+    if ( m_handle == nullptr )
+        return 0;
+
+    return m_handle->bufferCopies.Count() + m_handle->imageCopies.Count();
+}
+
+/*
+==============================================
+crvkUploadBatch::RecordBuffers
+==============================================
+*/
+void crvkUploadBatch::RecordBuffers( const VkCommandBuffer in_commandBuffer )
+{
+    crvkUploadBufferCopy_t* copies = &m_handle->bufferCopies;
+    uint32_t count = m_handle->bufferCopies.Count();
+    
+    // group the copies by buffer, keeping the order of the copies of the same buffer
+    std::stable_sort( copies, copies + count, []( const crvkUploadBufferCopy_t& a, const crvkUploadBufferCopy_t& b )
+    {
+        return std::less<crvkBufferStatic*>()( a.buffer, b.buffer );
+    } );
+    
+    // wait the buffers be released, and change the copied ranges to recive content 
+    for ( uint32_t i = 0; i < count; i++ )
+    {
+        crvkBufferStatic* buffer = copies[i].buffer;
+        if ( i == 0 || copies[i - 1].buffer != buffer )
+        {
+            m_handle->waits.Append( buffer->WaitLastCopy() );
+            m_handle->waits.Append( buffer->WaitLastUse() );
+        }
+
+        buffer->crvkBuffer::StateTransition( &m_handle->barriers, CRVK_BUFFER_STATE_GPU_COPY_DST, copies[i].region.dstOffset, copies[i].region.size, buffer->m_transferFamily );
+    }
+
+    // a single barrier for all the buffers
+    m_handle->barriers.Flush();
+
+    // a single copy command per buffer, unless the regions overlap 
+    uint32_t first = 0;
+    for ( uint32_t i = 0; i < count; i++ )
+    {
+        const VkBufferCopy2& region = copies[i].region;
+        bool overlap = false;
+        
+        for ( uint32_t j = first; j < i && !overlap; j++ )
+        {
+            const VkBufferCopy2& other = copies[j].region;
+            overlap = region.dstOffset < other.dstOffset + other.size && other.dstOffset < region.dstOffset + region.size;
+        }
+
+        // the last write must land after, send the previous regions and wait then
+        if ( overlap )
+        {
+            RecordBufferCopy( in_commandBuffer, copies[i - 1].staging, copies[i - 1].buffer->Handle(), m_handle->bufferRegions );
+            RecordWriteAfterWrite( in_commandBuffer );
+            first = i;
+        }
+
+        m_handle->bufferRegions.Append( region );
+
+        // last region of the buffer 
+        if ( i + 1 == count || copies[i + 1].buffer != copies[i].buffer || copies[i + 1].staging != copies[i].staging )
+        {
+            RecordBufferCopy( in_commandBuffer, copies[i].staging, copies[i].buffer->Handle(), m_handle->bufferRegions );
+            first = i + 1;
+        }
+    }
+}
+
+/*
+==============================================
+crvkUploadBatch::RecordImages
+==============================================
+*/
+void crvkUploadBatch::RecordImages( const VkCommandBuffer in_commandBuffer )
+{
+    crvkUploadImageCopy_t* copies = &m_handle->imageCopies;
+    uint32_t count = m_handle->imageCopies.Count();
+    
+    // group the copies by image
+    std::stable_sort( copies, copies + count, []( const crvkUploadImageCopy_t& a, const crvkUploadImageCopy_t& b )
+    {
+        return std::less<crvkImageStatic*>()( a.image, b.image );
+    } );
+
+    // wait the images be released, and change then to recive content 
+    for ( uint32_t i = 0; i < count; )
+    {
+        crvkImageStatic* image = copies[i].image;
+        VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_NONE;
+        uint32_t last = i;
+        
+        for ( ; last < count && copies[last].image == image; last++ )
+            aspectMask |= copies[last].region.imageSubresource.aspectMask;
+
+        m_handle->waits.Append( image->WaitLastCopy() );
+        m_handle->waits.Append( image->WaitLastUse() );
+        image->crvkImage::StateTransition( &m_handle->barriers, CRVK_IMAGE_STATE_GPU_COPY_DST, aspectMask, m_handle->queue->Family() );
+        i = last;
+    }
+
+    // a single barrier for all the images
+    m_handle->barriers.Flush();
+
+    // a single copy command per image, unless the regions overlap 
+    uint32_t first = 0;
+    for ( uint32_t i = 0; i < count; i++ )
+    {
+        bool overlap = false;
+        for ( uint32_t j = first; j < i && !overlap; j++ )
+            overlap = ImageRegionsOverlap( copies[i].region, copies[j].region );
+
+        // the last write must land after, send the previous regions and wait then
+        if ( overlap )
+        {
+            RecordImageCopy( in_commandBuffer, copies[i - 1].staging, copies[i - 1].image->Handle(), m_handle->imageRegions );
+            RecordWriteAfterWrite( in_commandBuffer );
+            first = i;
+        }
+
+        m_handle->imageRegions.Append( copies[i].region );
+        
+        // last region of the image  
+        if ( i + 1 == count || copies[i + 1].image != copies[i].image || copies[i + 1].staging != copies[i].staging )
+        {
+            RecordImageCopy( in_commandBuffer, copies[i].staging, copies[i].image->Handle(), m_handle->imageRegions );
+            first = i + 1;
+        }
+    }
+}
+
+/*
+==============================================
+crvkUploadBatch::Discard
+==============================================
+*/
+void crvkUploadBatch::Discard( void )
+{
+    // the GPU never saw these ranges 
+    for ( uint32_t i = 0; i < m_handle->ranges.Count(); i++ )
+        m_handle->uploadManager->Release( &m_handle->ranges[i] );
+
+    m_handle->bufferCopies.Reset();
+    m_handle->imageCopies.Reset();
+    m_handle->ranges.Reset();
+}
@@ -0,0 +1,484 @@
+/*
+===========================================================================================
+    This file is part of crvkLib Vulkan + SDL minimal framework.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+
+ This file is part of the crvkLib library and is licensed under the
+ MIT License with Attribution Requirement.
+
+ You are free to use, modify, and distribute this file (even commercially),
+ as long as you give credit to the original author:
+
+     “Based on crvkCore by Cristiano Beato – https://github.com/CristianoBeato/crvkLib”
+
+ For full license terms, see the LICENSE file in the root of this repository.
+===============================================================================================
+*/
+
+#include "crvkPrecompiled.hpp"
+#include "crvkUploadManager.hpp"
+
+static const VkDeviceSize   k_defaultRingSize = 64ull * 1024ull * 1024ull;  // 64MB staging ring 
+static const VkDeviceSize   k_ringAlignment = 4096;                         // ring size granularity 
+static const uint64_t       k_pendingValue = UINT64_MAX;                    // range not submitted yet
+static const uint32_t       k_initialEntries = 256;
+static const uint32_t       k_maxSignals = 8;
+static const uint32_t       k_noTimeline = UINT32_MAX;
+
+typedef struct crvkStagingEntry_t
+{
+    VkDeviceSize    end;        // ring position after the range 
+    uint64_t        value;      // timeline value that release the range 
+    uint32_t        timeline;   // timeline of the queue that carry the value 
+} crvkStagingEntry_t;
+
+/// @brief the ranges consumed by a queue are released by his own timeline, the values of 
+/// a single timeline signaled by different queues could complete out of order
+typedef struct crvkRingTimeline_t
+{
+    crvkDeviceQueue*    queue;      // it can be holding the value in deferred mode 
+    VkSemaphore         semaphore;
+    uint64_t            value;      // last value handed 
+    uint64_t            completed;  // value read by the last reclaim 
+} crvkRingTimeline_t;
+
+typedef struct crvkUploadManagerHandle_t
+{
+    VkDeviceSize                            capacity = 0;       // ring size 
+    VkDeviceSize                            head = 0;           // next free position ( monotonic )
+    VkDeviceSize                            tail = 0;           // oldest position in use ( monotonic )
+    uint64_t                                firstEntry = 0;     // sequence of the oldest entry
+    uint32_t                                first = 0;          // oldest entry index 
+    uint32_t                                count = 0;          // live entries 
+    crvkDynamicVector<crvkStagingEntry_t>   entries;            // circular entries queue
+    crvkDynamicVector<crvkRingTimeline_t>   timelines;          // one by submit queue 
+    uint8_t*                                mapped = nullptr;   // persistent CPU address 
+    VkBuffer                                buffer = nullptr;
+    crvkMemoryAllocation_t                  allocation;
+    crvkMemoryAllocator*                    allocator = nullptr;
+    VkDevice                                device = nullptr;
+    std::mutex                              lock;
+} crvkUploadManagerHandle_t;
+
+/*
+==============================================
+crvkUploadManager::crvkUploadManager
+==============================================
+*/
+crvkUploadManager::crvkUploadManager( void ) : m_handle( nullptr )
+{
+}
+
+/*
+==============================================
+crvkUploadManager::~crvkUploadManager
+==============================================
+*/
+crvkUploadManager::~crvkUploadManager( void )
+{
+    Destroy();
+}
+
+/*
+==============================================
+crvkUploadManager::Create
+==============================================
+*/
+bool crvkUploadManager::Create( const crvkDevice* in_device, const VkDeviceSize in_size, const bool in_readback )
+{
+    VkResult result = VK_SUCCESS;
+    VkMemoryRequirements memRequirements{};
+    VkMemoryPropertyFlags memoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    VkDeviceSize size = ( in_size != 0 ) ? in_size : k_defaultRingSize;
+
+    m_handle = new crvkUploadManagerHandle_t();
+    m_handle->device = in_device->Device();
+    m_handle->allocator = in_device->MemoryAllocator();
+    m_handle->capacity = ( size + k_ringAlignment - 1 ) & ~( k_ringAlignment - 1 );
+    m_handle->entries.Resize( k_initialEntries );
+
+    ///
+    /// Create the ring buffer 
+    /// ==========================================================================
+    VkBufferCreateInfo bufferCI{};
+    bufferCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCI.size = m_handle->capacity;
+    bufferCI.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    result = vkCreateBuffer( m_handle->device, &bufferCI, k_allocationCallbacks, &m_handle->buffer );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkUploadManager::Create::vkCreateBuffer", result );
+        return false;
+    }
+
+    vkGetBufferMemoryRequirements( m_handle->device, m_handle->buffer, &memRequirements );
+
+    // the CPU read from uncached memory is very slow, a cached one can be non coherent, see Invalidate 
+    if ( in_readback && in_device->FindMemoryType( memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT ) != UINT32_MAX )
+        memoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+
+    if ( !m_handle->allocator->Allocate( memRequirements, memoryFlags, true, &m_handle->allocation ) )
+        return false;
+    
+    result = vkBindBufferMemory( m_handle->device, m_handle->buffer, m_handle->allocation.memory, m_handle->allocation.offset );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkUploadManager::Create::vkBindBufferMemory", result );
+        return false;
+    }
+
+    // the ring stay mapped for his whole life, the queue timelines are made by the first submit of each queue 
+    m_handle->mapped = static_cast<uint8_t*>( m_handle->allocator->Map( &m_handle->allocation ) );
+    if ( m_handle->mapped == nullptr )
+        return false;
+
+    return true;
+}
+
+/*
+==============================================
+crvkUploadManager::Destroy
+==============================================
+*/
+void crvkUploadManager::Destroy( void )
+{
+    if ( m_handle == nullptr )
+        return;
+
+    for ( uint32_t i = 0; i < m_handle->timelines.Count(); i++ )
+        vkDestroySemaphore( m_handle->device, m_handle->timelines[i].semaphore, k_allocationCallbacks );
+
+    m_handle->timelines.Clear();
+
+    if ( m_handle->buffer != nullptr )
+    {
+        vkDestroyBuffer( m_handle->device, m_handle->buffer, k_allocationCallbacks );
+        m_handle->buffer = nullptr;
+    }
+
+    if ( m_handle->allocation.memory != nullptr )
+    {
+        if ( m_handle->mapped != nullptr )
+            m_handle->allocator->Unmap( &m_handle->allocation );
+
+        m_handle->allocator->Free( &m_handle->allocation );
+    }
+
+    m_handle->entries.Clear();
+    delete m_handle;
+    m_handle = nullptr;
+}
+
+/*
+==============================================
+crvkUploadManager::Allocate
+==============================================
+*/
+bool crvkUploadManager::Allocate( const VkDeviceSize in_size, const VkDeviceSize in_alignment, crvkStagingRange_t* out_range )
+{
+    VkDeviceSize alignment = std::max( in_alignment, (VkDeviceSize)4 ); // copy offsets are 4 bytes aligned 
+    VkDeviceSize position = 0;
+    VkDeviceSize offset = 0;
+
+    if ( in_size == 0 || in_size > m_handle->capacity )
+    {
+        crvkAppendError( "crvkUploadManager::Allocate::size", VK_ERROR_OUT_OF_DEVICE_MEMORY );
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock( m_handle->lock );
+    while ( true )
+    {
+        position = ( m_handle->head + alignment - 1 ) & ~( alignment - 1 );
+        offset = position % m_handle->capacity;
+        
+        // don't split the range at the ring end, skip to the begin
+        if ( offset + in_size > m_handle->capacity )
+        {
+            position += m_handle->capacity - offset;
+            offset = 0;
+        }
+
+        if ( position + in_size - m_handle->tail <= m_handle->capacity )
+            break;
+
+        // give back what the GPU have consumed
+        uint32_t count = m_handle->count;
+        ReclaimLocked();
+        if ( m_handle->count != count )
+            continue;
+        
+        // the oldest range was never submitted, waiting for it would never end 
+        if ( m_handle->count == 0 || m_handle->entries[m_handle->first].value == k_pendingValue )
+        {
+            crvkAppendError( "crvkUploadManager::Allocate::full", VK_ERROR_OUT_OF_DEVICE_MEMORY );
+            return false;
+        }
+
+        // ring full, wait the GPU release the oldest range 
+        uint64_t value = m_handle->entries[m_handle->first].value;
+        const crvkRingTimeline_t& timeline = m_handle->timelines[m_handle->entries[m_handle->first].timeline];
+        crvkDeviceQueue* queue = timeline.queue;
+        VkSemaphore semaphore = timeline.semaphore;
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &semaphore;
+        waitInfo.pValues = &value;
+        
+        lock.unlock();
+        
+        // a deferred queue may not have sent the value yet 
+        if ( queue != nullptr )
+            queue->Flush();
+
+        VkResult result = vkWaitSemaphores( m_handle->device, &waitInfo, UINT64_MAX );
+        lock.lock();
+        if ( result != VK_SUCCESS )
+        {
+            crvkAppendError( "crvkUploadManager::Allocate::vkWaitSemaphores", result );
+            return false;
+        }
+    }
+
+    // grow the entries queue, keeping the order
+    if ( m_handle->count == m_handle->entries.Count() )
+    {
+        crvkDynamicVector<crvkStagingEntry_t> entries;
+        entries.Resize( m_handle->entries.Count() * 2 );
+        for ( uint32_t i = 0; i < m_handle->count; i++ )
+            entries[i] = m_handle->entries[( m_handle->first + i ) % m_handle->entries.Count()];
+        
+        m_handle->entries = std::move( entries );
+        m_handle->first = 0;
+    }
+
+    uint32_t index = ( m_handle->first + m_handle->count ) % m_handle->entries.Count();
+    m_handle->head = position + in_size;
+    m_handle->entries[index].end = m_handle->head;
+    m_handle->entries[index].value = k_pendingValue;
+    m_handle->entries[index].timeline = k_noTimeline;
+
+    out_range->buffer = m_handle->buffer;
+    out_range->offset = offset;
+    out_range->size = in_size;
+    out_range->entry = m_handle->firstEntry + m_handle->count;
+    out_range->pointer = m_handle->mapped + offset;
+    m_handle->count++;
+    return true;
+}
+
+/*
+==============================================
+crvkUploadManager::Submit
+==============================================
+*/
+VkResult crvkUploadManager::Submit( crvkDeviceQueue* in_queue, const VkSubmitInfo2* in_submit, const crvkStagingRange_t* in_ranges, const uint32_t in_count, uint64_t* out_value )
+{
+    VkResult result = VK_SUCCESS;
+    VkSemaphoreSubmitInfo signals[k_maxSignals]{};
+    
+    SDL_assert( in_submit->signalSemaphoreInfoCount < k_maxSignals );
+    
+    // values must reach the queue in order, so we keep the lock until the submit 
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    uint32_t timeline = FindTimelineLocked( in_queue );
+    if ( timeline == k_noTimeline )
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    uint64_t value = m_handle->timelines[timeline].value + 1;
+
+    // append the queue timeline signal 
+    std::memcpy( signals, in_submit->pSignalSemaphoreInfos, sizeof( VkSemaphoreSubmitInfo ) * in_submit->signalSemaphoreInfoCount );
+    signals[in_submit->signalSemaphoreInfoCount] = { VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, m_handle->timelines[timeline].semaphore, value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, 0 };
+
+    VkSubmitInfo2 submitInfo = *in_submit;
+    submitInfo.signalSemaphoreInfoCount = in_submit->signalSemaphoreInfoCount + 1;
+    submitInfo.pSignalSemaphoreInfos = signals;
+    result = in_queue->Submit( &submitInfo, 1 );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkUploadManager::Submit::vkQueueSubmit2", result );
+        return result;
+    }
+
+    // ranges go back to the ring when the GPU reach the value 
+    m_handle->timelines[timeline].value = value;
+    if ( out_value != nullptr )
+        *out_value = value;
+
+    for ( uint32_t i = 0; i < in_count; i++ )
+    {
+        uint64_t entry = in_ranges[i].entry - m_handle->firstEntry;
+        SDL_assert( entry < m_handle->count );
+        crvkStagingEntry_t& stagingEntry = m_handle->entries[( m_handle->first + entry ) % m_handle->entries.Count()];
+        stagingEntry.value = value;
+        stagingEntry.timeline = timeline;
+    }
+
+    return result;
+}
+
+/*
+==============================================
+crvkUploadManager::Release
+==============================================
+*/
+void crvkUploadManager::Release( const crvkStagingRange_t* in_range )
+{
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    uint64_t entry = in_range->entry - m_handle->firstEntry;
+    SDL_assert( entry < m_handle->count );
+    m_handle->entries[( m_handle->first + entry ) % m_handle->entries.Count()].value = 0; // always reached
+    ReclaimLocked();
+}
+
+/*
+==============================================
+crvkUploadManager::Reclaim
+==============================================
+*/
+void crvkUploadManager::Reclaim( void )
+{
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    ReclaimLocked();
+}
+
+/*
+==============================================
+crvkUploadManager::ReclaimLocked
+==============================================
+*/
+void crvkUploadManager::ReclaimLocked( void )
+{
+    if ( m_handle->count == 0 )
+        return;
+
+    // one counter query by queue 
+    for ( uint32_t i = 0; i < m_handle->timelines.Count(); i++ )
+        vkGetSemaphoreCounterValue( m_handle->device, m_handle->timelines[i].semaphore, &m_handle->timelines[i].completed );
+
+    // ranges are released in order, stop on the first one in use, a released range have value 0 
+    while ( m_handle->count > 0 )
+    {
+        const crvkStagingEntry_t& entry = m_handle->entries[m_handle->first];
+        if ( entry.value == k_pendingValue )
+            break;
+        
+        if ( entry.value != 0 && entry.value > m_handle->timelines[entry.timeline].completed )
+            break;
+
+        m_handle->tail = entry.end;
+        m_handle->first = ( m_handle->first + 1 ) % m_handle->entries.Count();
+        m_handle->firstEntry++;
+        m_handle->count--;
+    }
+
+    // ring empty, restart from the begin
+    if ( m_handle->count == 0 )
+        m_handle->tail = m_handle->head;
+}
+
+/*
+==============================================
+crvkUploadManager::Invalidate
+==============================================
+*/
+void crvkUploadManager::Invalidate( const crvkStagingRange_t* in_range ) const
+{
+    // the ring buffer start at the allocation begin 
+    m_handle->allocator->Invalidate( &m_handle->allocation, in_range->offset, in_range->size );
+}
+
+/*
+==============================================
+crvkUploadManager::Semaphore
+==============================================
+*/
+VkSemaphore crvkUploadManager::Semaphore( crvkDeviceQueue* in_queue )
+{
+    if ( m_handle == nullptr )
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    uint32_t timeline = FindTimelineLocked( in_queue );
+    if ( timeline == k_noTimeline )
+        return nullptr;
+
+    return m_handle->timelines[timeline].semaphore;
+}
+
+/*
+==============================================
+crvkUploadManager::LastValue
+==============================================
+*/
+uint64_t crvkUploadManager::LastValue( const crvkDeviceQueue* in_queue ) const
+{
+    if ( m_handle == nullptr )
+        return 0;
+
+    std::lock_guard<std::mutex> lock( m_handle->lock );
+    for ( uint32_t i = 0; i < m_handle->timelines.Count(); i++ )
+    {
+        if ( m_handle->timelines[i].queue == in_queue )
+            return m_handle->timelines[i].value;
+    }
+
+    return 0;
+}
+
+/*
+==============================================
+crvkUploadManager::FindTimelineLocked
+==============================================
+*/
+uint32_t crvkUploadManager::FindTimelineLocked( crvkDeviceQueue* in_queue )
+{
+    for ( uint32_t i = 0; i < m_handle->timelines.Count(); i++ )
+    {
+        if ( m_handle->timelines[i].queue == in_queue )
+            return i;
+    }
+
+    ///
+    /// First submit of the queue, create his timeline 
+    /// ==========================================================================
+    VkSemaphoreTypeCreateInfo timelineCreateInfo{};
+    timelineCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    timelineCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    timelineCreateInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreCI{};
+    semaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreCI.flags = 0;
+    semaphoreCI.pNext = &timelineCreateInfo;
+
+    crvkRingTimeline_t timeline{ in_queue, nullptr, 0, 0 };
+    VkResult result = vkCreateSemaphore( m_handle->device, &semaphoreCI, k_allocationCallbacks, &timeline.semaphore );
+    if ( result != VK_SUCCESS )
+    {
+        crvkAppendError( "crvkUploadManager::FindTimelineLocked::vkCreateSemaphore", result );
+        return k_noTimeline;
+    }
+
+    return m_handle->timelines.Append( timeline );
+}
+
+/*
+==============================================
+crvkUploadManager::Capacity
+==============================================
+*/
+VkDeviceSize crvkUploadManager::Capacity( void ) const
+{
+    if ( m_handle == nullptr )
+        return 0;
+
+    return m_handle->capacity;
+}
@@ -0,0 +1,322 @@
+// ===============================================================================================
+// crvkCore - Vulkan + SDL minimal framework
+// Copyright (c) 2025 Beato
+//
+// This file is part of the crvkCore library and is licensed under the
+// MIT License with Attribution Requirement.
+//
+// You are free to use, modify, and distribute this file (even commercially),
+// as long as you give credit to the original author:
+//
+//     “Based on crvkCore by Beato – https://github.com/seuusuario/crvkCore”
+//
+// For full license terms, see the LICENSE file in the root of this repository.
+// ===============================================================================================
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <SDL3/SDL.h>
+
+#include "crvkCore.hpp"
+#include "crvkDynamicVector.hpp"
+#include "crvkBenchmark.hpp"
+
+typedef std::chrono::steady_clock benchClock_t;
+
+typedef struct crvkBenchmark_t
+{
+    const char* name;
+    bool        device;     // need a GPU 
+    bool        (*function)( crvkDevice* in_device );
+} crvkBenchmark_t;
+
+// nanoseconds by iteration since begin 
+static double ElapsedNs( const benchClock_t::time_point in_begin, const uint32_t in_iterations )
+{
+    std::chrono::duration<double, std::nano> elapsed = benchClock_t::now() - in_begin;
+    return elapsed.count() / in_iterations;
+}
+
+static void Report( const char* in_benchmark, const char* in_case, const double in_ns )
+{
+    std::cout << "  " << in_benchmark << " " << in_case << ": " << in_ns << " ns" << std::endl;
+}
+
+// the benchmarks own a queue of the first graphic family, the test queues are made by the application 
+static bool CreateQueue( const crvkDevice* in_device, crvkDeviceQueue* out_queue )
+{
+    uint32_t count = 0;
+    crvkQueueInfo_t* queues = in_device->GetQueueInfo( &count );
+
+    for ( uint32_t i = 0; i < count; i++ )
+    {
+        const crvkQueueInfo_t* info = &queues[i];
+        if ( info->graphic )
+            return out_queue->Create( in_device, info );
+    }
+
+    return false;
+}
+
+///
+/// Buffer map, per call vkMapMemory against the persistent mapping 
+/// ==========================================================================
+
+// a per frame uniform update, a small write at a rotating offset 
+static bool BenchmarkBufferMap( crvkDevice* in_device )
+{
+    const uint32_t k_iterations = 100000;
+    const VkDeviceSize k_size = 64 << 10;
+    const VkDeviceSize k_write = 256;
+    const VkMemoryPropertyFlags k_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    uint8_t data[k_write];
+    VkDevice device = in_device->Device();
+    VkDeviceMemory memory = nullptr;
+    crvkDeviceQueue queue;
+    crvkBuffer buffer;
+
+    std::memset( data, 0x5a, sizeof( data ) );
+    if ( !CreateQueue( in_device, &queue ) )
+        return false;
+
+    ///
+    /// Map and unmap the memory on every write 
+    /// ==========================================================================
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.pNext = nullptr;
+    allocInfo.allocationSize = k_size;
+    allocInfo.memoryTypeIndex = in_device->FindMemoryType( UINT32_MAX, k_flags );
+    if ( vkAllocateMemory( device, &allocInfo, nullptr, &memory ) != VK_SUCCESS )
+    {
+        queue.Destroy();
+        return false;
+    }
+
+    benchClock_t::time_point begin = benchClock_t::now();
+    for ( uint32_t i = 0; i < k_iterations; i++ )
+    {
+        void* pointer = nullptr;
+        VkDeviceSize offset = ( i * k_write ) % k_size;
+        if ( vkMapMemory( device, memory, offset, k_write, 0, &pointer ) != VK_SUCCESS )
+            break;
+        
+        std::memcpy( pointer, data, k_write );
+        vkUnmapMemory( device, memory );
+    }
+    
+    Report( "bufferMap", "vkMapMemory per call", ElapsedNs( begin, k_iterations ) );
+    vkFreeMemory( device, memory, nullptr );
+
+    ///
+    /// The buffer block stay mapped, Map only offset the pointer 
+    /// ==========================================================================
+    if ( !buffer.Create( in_device, &queue, nullptr, k_size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, k_flags ) )
+    {
+        queue.Destroy();
+        return false;
+    }
+
+    begin = benchClock_t::now();
+    for ( uint32_t i = 0; i < k_iterations; i++ )
+    {
+        VkDeviceSize offset = ( i * k_write ) % k_size;
+        void* pointer = buffer.Map( offset, k_write, CRVK_BUFFER_MAP_ACCESS_WRITE );
+        if ( pointer == nullptr )
+            break;
+
+        std::memcpy( pointer, data, k_write );
+        buffer.Unmap();
+    }
+    
+    Report( "bufferMap", "persistent mapping", ElapsedNs( begin, k_iterations ) );
+    buffer.Destroy();
+    queue.Destroy();
+    return true;
+}
+
+///
+/// crvkBufferStaging, direct write against the staging ring copy 
+/// ==========================================================================
+
+// small writes at a rotating offset, the final read back wait all of then reach the buffer 
+static bool StagingLoop( crvkDevice* in_device, crvkDeviceQueue* in_queue, const char* in_case )
+{
+    const uint32_t k_iterations = 10000;
+    const VkDeviceSize k_size = 64 << 10;
+    const VkDeviceSize k_write = 256;
+    uint8_t data[k_write];
+    uint8_t check[k_write];
+    crvkBufferStaging buffer;
+
+    if ( !buffer.Create( in_device, in_queue, nullptr, k_size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, 0 ) )
+        return false;
+
+    benchClock_t::time_point begin = benchClock_t::now();
+    for ( uint32_t i = 0; i < k_iterations; i++ )
+    {
+        std::memset( data, static_cast<int>( i & 0xff ), sizeof( data ) );
+        buffer.SubData( data, ( i * k_write ) % k_size, k_write );
+    }
+
+    buffer.GetSubData( check, ( ( k_iterations - 1 ) * k_write ) % k_size, k_write );
+    Report( "stagingDirect", in_case, ElapsedNs( begin, k_iterations ) );
+
+    bool valid = std::memcmp( data, check, k_write ) == 0;
+    buffer.Destroy();
+    return valid;
+}
+
+static bool BenchmarkStagingDirect( crvkDevice* in_device )
+{
+    VkDeviceSize limit = in_device->DirectWriteLimit();
+    crvkDeviceQueue queue;
+    bool result = true;
+
+    if ( !CreateQueue( in_device, &queue ) )
+        return false;
+
+    // without device local host visible memory there is only the staging path 
+    if ( limit > 0 )
+        result = StagingLoop( in_device, &queue, "direct write" );
+    else
+        std::cout << "  stagingDirect direct write: no device local host visible memory" << std::endl;
+
+    in_device->SetDirectWriteLimit( 0 );
+    result = StagingLoop( in_device, &queue, "staging ring" ) && result;
+    in_device->SetDirectWriteLimit( limit );
+
+    queue.Destroy();
+    return result;
+}
+
+///
+/// crvkDynamicVector against std::vector 
+/// ==========================================================================
+
+// a barrier sized element 
+typedef struct benchElement_t
+{
+    uint64_t    values[6];
+} benchElement_t;
+
+static void SetKey( uint32_t& out_element, const uint32_t in_key ) { out_element = in_key; }
+static void SetKey( benchElement_t& out_element, const uint32_t in_key ) { out_element.values[0] = in_key; }
+static uint64_t Key( const uint32_t& in_element ) { return in_element; }
+static uint64_t Key( const benchElement_t& in_element ) { return in_element.values[0]; }
+
+template<typename _t>
+static void AppendElement( crvkDynamicVector<_t>& in_vector, const _t& in_element )
+{
+    in_vector.Append( in_element );
+}
+
+template<typename _t>
+static void AppendElement( std::vector<_t>& in_vector, const _t& in_element )
+{
+    in_vector.push_back( in_element );
+}
+
+// build and drop a vector of count elements, the way the recorders use the scratch lists 
+template<typename _vector, typename _t>
+static double AppendLoop( const uint32_t in_count, const uint32_t in_repeat, uint64_t* out_sink )
+{
+    benchClock_t::time_point begin = benchClock_t::now();
+    for ( uint32_t r = 0; r < in_repeat; r++ )
+    {
+        _vector vector;
+        _t element{};
+        for ( uint32_t i = 0; i < in_count; i++ )
+        {
+            SetKey( element, i );
+            AppendElement( vector, element );
+        }
+
+        *out_sink += Key( vector[in_count - 1] );
+    }
+
+    return ElapsedNs( begin, in_count * in_repeat );
+}
+
+// nanoseconds by appended element, the small counts use the inline storage 
+static bool BenchmarkDynamicVector( crvkDevice* in_device )
+{
+    const uint32_t k_counts[] = { 4, 8, 64, 1024, 1 << 20 };
+    uint64_t sink = 0;
+
+    for ( uint32_t count : k_counts )
+    {
+        uint32_t repeat = std::max<uint32_t>( 1, ( 16u << 20 ) / count );
+        std::string name = std::to_string( count ) + " x ";
+
+        Report( "dynamicVector", ( name + "uint32_t crvkDynamicVector" ).c_str(), AppendLoop<crvkDynamicVector<uint32_t>, uint32_t>( count, repeat, &sink ) );
+        Report( "dynamicVector", ( name + "uint32_t std::vector" ).c_str(), AppendLoop<std::vector<uint32_t>, uint32_t>( count, repeat, &sink ) );
+        Report( "dynamicVector", ( name + "48 bytes crvkDynamicVector" ).c_str(), AppendLoop<crvkDynamicVector<benchElement_t>, benchElement_t>( count, repeat / 4, &sink ) );
+        Report( "dynamicVector", ( name + "48 bytes std::vector" ).c_str(), AppendLoop<std::vector<benchElement_t>, benchElement_t>( count, repeat / 4, &sink ) );
+    }
+
+    // keep the loops from being optimized out 
+    return sink != 0;
+}
+
+static const crvkBenchmark_t k_benchmarks[] = 
+{
+    { "bufferMap", true, BenchmarkBufferMap },
+    { "stagingDirect", true, BenchmarkStagingDirect },
+    { "dynamicVector", false, BenchmarkDynamicVector },
+};
+
+/*
+==============================================
+crvkBenchmarkNeedDevice
+==============================================
+*/
+bool crvkBenchmarkNeedDevice( const char* in_filter )
+{
+    for ( const crvkBenchmark_t& benchmark : k_benchmarks )
+    {
+        if ( in_filter != nullptr && std::strcmp( in_filter, benchmark.name ) != 0 )
+            continue;
+
+        if ( benchmark.device )
+            return true;
+    }
+
+    return false;
+}
+
+/*
+==============================================
+crvkRunBenchmarks
+==============================================
+*/
+int crvkRunBenchmarks( crvkDevice* in_device, const char* in_filter )
+{
+    uint32_t failed = 0;
+    
+    for ( const crvkBenchmark_t& benchmark : k_benchmarks )
+    {
+        if ( in_filter != nullptr && std::strcmp( in_filter, benchmark.name ) != 0 )
+            continue;
+
+        if ( benchmark.device && in_device == nullptr )
+        {
+            std::cout << "[SKIP] " << benchmark.name << " need a device" << std::endl;
+            continue;
+        }
+
+        std::cout << "[BENCH] " << benchmark.name << std::endl;
+        if ( !benchmark.function( in_device ) )
+        {
+            std::cout << "[FAIL] " << benchmark.name << std::endl;
+            failed++;
+        }
+    }
+
+    return ( failed == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
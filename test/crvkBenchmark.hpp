@@ -0,0 +1,29 @@
+// ===============================================================================================
+// crvkCore - Vulkan + SDL minimal framework
+// Copyright (c) 2025 Beato
+//
+// This file is part of the crvkCore library and is licensed under the
+// MIT License with Attribution Requirement.
+//
+// You are free to use, modify, and distribute this file (even commercially),
+// as long as you give credit to the original author:
+//
+//     “Based on crvkCore by Beato – https://github.com/seuusuario/crvkCore”
+//
+// For full license terms, see the LICENSE file in the root of this repository.
+// ===============================================================================================
+
+#ifndef __CRVK_BENCHMARK_HPP__
+#define __CRVK_BENCHMARK_HPP__
+
+/// @brief True if one of the benchmarks selected by the filter need a device 
+/// @param in_filter benchmark name, nullptr for all 
+bool crvkBenchmarkNeedDevice( const char* in_filter );
+
+/// @brief Run the library microbenchmarks and print the timings, from crvkTest --bench [name]
+/// @param in_device the device, nullptr to run only the benchmarks that don't need one 
+/// @param in_filter run only the benchmark with this name, nullptr to run all 
+/// @return EXIT_SUCCESS if all the benchmarks run 
+int crvkRunBenchmarks( crvkDevice* in_device, const char* in_filter );
+
+#endif //!__CRVK_BENCHMARK_HPP__
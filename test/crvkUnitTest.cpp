@@ -0,0 +1,336 @@
+// ===============================================================================================
+// crvkCore - Vulkan + SDL minimal framework
+// Copyright (c) 2025 Beato
+//
+// This file is part of the crvkCore library and is licensed under the
+// MIT License with Attribution Requirement.
+//
+// You are free to use, modify, and distribute this file (even commercially),
+// as long as you give credit to the original author:
+//
+//     “Based on crvkCore by Beato – https://github.com/seuusuario/crvkCore”
+//
+// For full license terms, see the LICENSE file in the root of this repository.
+// ===============================================================================================
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <SDL3/SDL.h>
+
+#include "crvkCore.hpp"
+#include "crvkUnitTest.hpp"
+
+#define TEST_CHECK( x )                                                                 \
+    if ( !( x ) )                                                                       \
+    {                                                                                   \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #x << std::endl; \
+        return false;                                                                   \
+    }
+
+typedef struct crvkUnitTest_t
+{
+    const char* name;
+    bool        (*function)( void );
+} crvkUnitTest_t;
+
+///
+/// crvkRangeAllocator
+/// ==========================================================================
+
+typedef struct testRange_t
+{
+    uint32_t        range;
+    VkDeviceSize    offset;
+    VkDeviceSize    size;
+} testRange_t;
+
+// live ranges must be inside the space and never overlap 
+static bool CheckRanges( const crvkRangeAllocator& in_allocator, std::vector<testRange_t> in_live )
+{
+    std::sort( in_live.begin(), in_live.end(), []( const testRange_t& a, const testRange_t& b ) { return a.offset < b.offset; } );
+    for ( size_t i = 0; i < in_live.size(); i++ )
+    {
+        TEST_CHECK( in_live[i].offset + in_live[i].size <= in_allocator.Capacity() );
+        if ( i > 0 )
+            TEST_CHECK( in_live[i - 1].offset + in_live[i - 1].size <= in_live[i].offset );
+    }
+
+    return true;
+}
+
+// a space made for a single allocation must hold it at any alignment, like a dedicated memory block 
+static bool TestRangeAllocatorSingle( void )
+{
+    const VkDeviceSize sizes[] = { 16, 4096, 20ull << 20, 130ull << 20, 200ull << 20 };
+    const VkDeviceSize alignments[] = { 16, 256, 4096, 65536 };
+    
+    for ( VkDeviceSize size : sizes )
+    {
+        for ( VkDeviceSize alignment : alignments )
+        {
+            crvkRangeAllocator allocator;
+            uint32_t range = crvkRangeAllocator::k_invalidRange;
+            TEST_CHECK( allocator.Create( size ) );
+            TEST_CHECK( allocator.Allocate( size, alignment, &range ) );
+            TEST_CHECK( allocator.Offset( range ) == 0 );
+            TEST_CHECK( allocator.Size( range ) == size );
+            TEST_CHECK( allocator.FreeRangeCount() == 0 );
+            TEST_CHECK( !allocator.Allocate( 16, 16, &range ) );
+            TEST_CHECK( allocator.Validate() );
+        }
+    }
+
+    // bigger than the space 
+    crvkRangeAllocator allocator;
+    uint32_t range = crvkRangeAllocator::k_invalidRange;
+    TEST_CHECK( allocator.Create( 1 << 20 ) );
+    TEST_CHECK( !allocator.Allocate( ( 1 << 20 ) + 16, 16, &range ) );
+    TEST_CHECK( range == crvkRangeAllocator::k_invalidRange );
+    return true;
+}
+
+// random alloc and free churn, checking the alignment, overlaps and the free list consistency 
+static bool TestRangeAllocatorChurn( void )
+{
+    const VkDeviceSize capacity = 64ull << 20;
+    std::mt19937 random( 1234 );
+    std::vector<testRange_t> live;
+    crvkRangeAllocator allocator;
+    VkDeviceSize used = 0;
+    
+    TEST_CHECK( allocator.Create( capacity ) );
+    for ( uint32_t i = 0; i < 20000; i++ )
+    {
+        // keep around half of the space in use 
+        if ( live.size() > 0 && ( used > capacity / 2 || random() % 3 == 0 ) )
+        {
+            size_t index = random() % live.size();
+            allocator.Free( live[index].range );
+            used -= live[index].size;
+            live[index] = live.back();
+            live.pop_back();
+        }
+        else
+        {
+            testRange_t entry{};
+            VkDeviceSize size = 1 + random() % ( ( random() % 4 == 0 ) ? ( 1u << 20 ) : 4096u );
+            VkDeviceSize alignment = 1ull << ( random() % 17 );
+            if ( !allocator.Allocate( size, alignment, &entry.range ) )
+                continue;
+
+            entry.offset = allocator.Offset( entry.range );
+            entry.size = allocator.Size( entry.range );
+            TEST_CHECK( entry.offset % std::max<VkDeviceSize>( alignment, crvkRangeAllocator::k_minAlignment ) == 0 );
+            TEST_CHECK( entry.size >= size );
+            used += entry.size;
+            live.push_back( entry );
+        }
+
+        if ( i % 500 == 0 )
+        {
+            TEST_CHECK( allocator.Validate() );
+            TEST_CHECK( CheckRanges( allocator, live ) );
+        }
+
+        TEST_CHECK( allocator.AllocationCount() == live.size() );
+        TEST_CHECK( allocator.Used() == used );
+    }
+
+    TEST_CHECK( allocator.Validate() );
+    TEST_CHECK( CheckRanges( allocator, live ) );
+
+    // all released, the space merge back in a single range 
+    for ( const testRange_t& entry : live )
+        allocator.Free( entry.range );
+
+    TEST_CHECK( allocator.Validate() );
+    TEST_CHECK( allocator.AllocationCount() == 0 );
+    TEST_CHECK( allocator.Used() == 0 );
+    TEST_CHECK( allocator.FreeRangeCount() == 1 );
+    TEST_CHECK( allocator.LargestFree() == capacity );
+    return true;
+}
+
+///
+/// crvkBarrierBatch
+/// ==========================================================================
+
+static VkBufferMemoryBarrier2 BufferBarrier( const VkPipelineStageFlags2 in_srcStage, const VkAccessFlags2 in_srcAccess, const VkPipelineStageFlags2 in_dstStage, const VkAccessFlags2 in_dstAccess, const VkDeviceSize in_offset, const VkDeviceSize in_size )
+{
+    VkBufferMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    barrier.srcStageMask = in_srcStage;
+    barrier.srcAccessMask = in_srcAccess;
+    barrier.dstStageMask = in_dstStage;
+    barrier.dstAccessMask = in_dstAccess;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = reinterpret_cast<VkBuffer>( 0x1000 );
+    barrier.offset = in_offset;
+    barrier.size = in_size;
+    return barrier;
+}
+
+// a read to read is dropped only when the earlier readers cover it, and the same transition of touching ranges grow one barrier 
+static bool TestBarrierBatchMerge( void )
+{
+    crvkBarrierBatch batch;
+    uint32_t count = 0;
+    const VkBufferMemoryBarrier2* pending = nullptr;
+    batch.Begin( nullptr );
+
+    // the fragment shader never saw the writes made visible to the vertex input 
+    VkBufferMemoryBarrier2 barrier = BufferBarrier( VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, 0, 256 );
+    TEST_CHECK( batch.Buffer( &barrier ) );
+
+    // covered by the earlier readers 
+    barrier = BufferBarrier( VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT, VK_ACCESS_2_SHADER_READ_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, 0, 256 );
+    TEST_CHECK( !batch.Buffer( &barrier ) );
+    barrier = BufferBarrier( VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT, VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT, VK_ACCESS_2_UNIFORM_READ_BIT, 0, 256 );
+    TEST_CHECK( !batch.Buffer( &barrier ) );
+
+    // adjacent and overlapping ranges of the same transition 
+    batch.Begin( nullptr );
+    barrier = BufferBarrier( VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT, 0, 256 );
+    TEST_CHECK( batch.Buffer( &barrier ) );
+    barrier.offset = 256;
+    TEST_CHECK( batch.Buffer( &barrier ) );
+    barrier.offset = 128;
+    barrier.size = 512;
+    TEST_CHECK( batch.Buffer( &barrier ) );
+    pending = batch.BufferBarriers( &count );
+    TEST_CHECK( count == 1 );
+    TEST_CHECK( pending[0].offset == 0 && pending[0].size == 640 );
+
+    // a gap keep two barriers 
+    barrier.offset = 1024;
+    barrier.size = 64;
+    TEST_CHECK( batch.Buffer( &barrier ) );
+    pending = batch.BufferBarriers( &count );
+    TEST_CHECK( count == 2 );
+
+    // the readers of the pending barrier stay visible after a read to read fold 
+    barrier = BufferBarrier( VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT, 1024, 64 );
+    TEST_CHECK( batch.Buffer( &barrier ) );
+    pending = batch.BufferBarriers( &count );
+    TEST_CHECK( count == 2 );
+    TEST_CHECK( pending[1].dstStageMask == ( VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT ) );
+    return true;
+}
+
+///
+/// crvkDirtyRangeSet
+/// ==========================================================================
+
+// the ranges must be sorted, disjoint and never touch 
+static bool CheckDirtyRanges( const crvkDirtyRangeSet& in_set )
+{
+    uint32_t count = 0;
+    const crvkDirtyRange_t* ranges = in_set.Ranges( &count );
+    for ( uint32_t i = 0; i < count; i++ )
+    {
+        TEST_CHECK( ranges[i].begin < ranges[i].end );
+        if ( i > 0 )
+            TEST_CHECK( ranges[i - 1].end < ranges[i].begin );
+    }
+
+    return true;
+}
+
+// overlapping and touching writes are copied as one range, the bytes nobody wrote are never copied 
+static bool TestDirtyRangeCoalesce( void )
+{
+    crvkDirtyRangeSet dirty;
+    uint32_t count = 0;
+    const crvkDirtyRange_t* ranges = nullptr;
+
+    // a small write on a big buffer copy only the written bytes 
+    dirty.Add( 32 << 20, 64 );
+    ranges = dirty.Ranges( &count );
+    TEST_CHECK( count == 1 );
+    TEST_CHECK( ranges[0].begin == ( 32 << 20 ) && ranges[0].end == ( 32 << 20 ) + 64 );
+
+    // touching and overlapping writes, a empty write is ignored 
+    dirty.Clear();
+    dirty.Add( 0, 64 );
+    dirty.Add( 64, 64 );
+    dirty.Add( 32, 64 );
+    dirty.Add( 1000, 0 );
+    ranges = dirty.Ranges( &count );
+    TEST_CHECK( count == 1 );
+    TEST_CHECK( ranges[0].begin == 0 && ranges[0].end == 128 );
+
+    // a one byte gap keep two ranges 
+    dirty.Add( 129, 16 );
+    ranges = dirty.Ranges( &count );
+    TEST_CHECK( count == 2 );
+    TEST_CHECK( ranges[1].begin == 129 && ranges[1].end == 145 );
+
+    // the writes are kept sorted, a write over the gap join them, a bigger write absorb them all 
+    dirty.Add( 8192, 64 );
+    dirty.Add( 4096, 64 );
+    ranges = dirty.Ranges( &count );
+    TEST_CHECK( count == 4 );
+    TEST_CHECK( ranges[2].begin == 4096 && ranges[3].begin == 8192 );
+    TEST_CHECK( CheckDirtyRanges( dirty ) );
+    dirty.Add( 128, 1 );
+    ranges = dirty.Ranges( &count );
+    TEST_CHECK( count == 3 );
+    TEST_CHECK( ranges[0].begin == 0 && ranges[0].end == 145 );
+    dirty.Add( 0, 10000 );
+    ranges = dirty.Ranges( &count );
+    TEST_CHECK( count == 1 );
+    TEST_CHECK( ranges[0].begin == 0 && ranges[0].end == 10000 );
+
+    // many far writes are all kept, in order, whatever the count 
+    dirty.Clear();
+    for ( uint32_t i = 0; i < 100; i++ )
+        dirty.Add( ( 99 - i ) * 4096, 64 );
+    
+    ranges = dirty.Ranges( &count );
+    TEST_CHECK( count == 100 );
+    TEST_CHECK( CheckDirtyRanges( dirty ) );
+    for ( uint32_t i = 0; i < count; i++ )
+        TEST_CHECK( ranges[i].begin == i * 4096 && ranges[i].end == i * 4096 + 64 );
+
+    dirty.Clear();
+    TEST_CHECK( dirty.Count() == 0 );
+    return true;
+}
+
+static const crvkUnitTest_t k_unitTests[] = 
+{
+    { "rangeAllocatorSingle", TestRangeAllocatorSingle },
+    { "rangeAllocatorChurn", TestRangeAllocatorChurn },
+    { "barrierBatchMerge", TestBarrierBatchMerge },
+    { "dirtyRangeCoalesce", TestDirtyRangeCoalesce },
+};
+
+/*
+==============================================
+crvkRunUnitTests
+==============================================
+*/
+int crvkRunUnitTests( const char* in_filter )
+{
+    uint32_t failed = 0;
+    uint32_t count = 0;
+    
+    for ( const crvkUnitTest_t& test : k_unitTests )
+    {
+        if ( in_filter != nullptr && std::strcmp( in_filter, test.name ) != 0 )
+            continue;
+
+        bool passed = test.function();
+        std::cout << ( passed ? "[PASS] " : "[FAIL] " ) << test.name << std::endl;
+        failed += passed ? 0 : 1;
+        count++;
+    }
+
+    std::cout << count - failed << "/" << count << " tests passed" << std::endl;
+    return ( failed == 0 && count > 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,24 @@
+// ===============================================================================================
+// crvkCore - Vulkan + SDL minimal framework
+// Copyright (c) 2025 Beato
+//
+// This file is part of the crvkCore library and is licensed under the
+// MIT License with Attribution Requirement.
+//
+// You are free to use, modify, and distribute this file (even commercially),
+// as long as you give credit to the original author:
+//
+//     “Based on crvkCore by Beato – https://github.com/seuusuario/crvkCore”
+//
+// For full license terms, see the LICENSE file in the root of this repository.
+// ===============================================================================================
+
+#ifndef __CRVK_UNIT_TEST_HPP__
+#define __CRVK_UNIT_TEST_HPP__
+
+/// @brief Run the unit tests that don't need a GPU, from crvkTest --unit [name]
+/// @param in_filter run only the test with this name, nullptr to run all 
+/// @return EXIT_SUCCESS if all the tests pass 
+int crvkRunUnitTests( const char* in_filter );
+
+#endif //!__CRVK_UNIT_TEST_HPP__
@@ -18,6 +18,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <chrono>
 #include <stdexcept>
 #include <cstring>
 #include <SDL3/SDL.h>
@@ -25,6 +26,8 @@
 #include <SDL3/SDL_vulkan.h>
 
 #include "crvkCore.hpp"
+#include "crvkUnitTest.hpp"
+#include "crvkBenchmark.hpp"
 
 static const char* validationLayers[1] = { "VK_LAYER_KHRONOS_validation" };
 static const char* deviceExtensions[1] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
@@ -71,6 +74,7 @@ const crVertex vertices[4] =
 };
 
 crvkTest::crvkTest( void ) : 
+    m_pipelineCachePath( nullptr ),
     m_window( nullptr ),
     m_context( nullptr ),
     m_device( nullptr ),
@@ -86,15 +90,85 @@ crvkTest::~crvkTest( void )
 
 void crvkTest::Run(void)
 {
-    InitSDL();
+    InitSDL( true );
     InitVulkan();
     RunLoop();
     FinishVulkan();
     FinishSDL();
 }
 
-void crvkTest::InitSDL(void)
+int crvkTest::Benchmark( const char* in_filter )
 {
+    int result = EXIT_SUCCESS;
+    bool pipelineCache = in_filter == nullptr || std::strcmp( in_filter, "pipelineCache" ) == 0;
+    bool device = crvkBenchmarkNeedDevice( in_filter );
+
+    // GPU-less benchmarks only 
+    if ( !pipelineCache && !device )
+        return crvkRunBenchmarks( nullptr, in_filter );
+
+    // headless, the benchmarks don't present and can run without a display 
+    InitSDL( false );
+
+    // it recreate the device, so it run before the others 
+    if ( pipelineCache )
+        result = BenchmarkPipelineCache();
+
+    if ( device || in_filter == nullptr )
+    {
+        InitVulkan();
+        if ( crvkRunBenchmarks( m_device, in_filter ) != EXIT_SUCCESS )
+            result = EXIT_FAILURE;
+        
+        FinishVulkan();
+    }
+    
+    FinishSDL();
+    return result;
+}
+
+// startup time with a cold pipeline cache, then with the cache file written by the first run 
+int crvkTest::BenchmarkPipelineCache( void )
+{
+    const char* k_cachePath = "crvkTest.pipelinecache";
+    const char* k_passes[2] = { "cold", "warm" };
+    bool loaded[2] = { false, false };
+
+    m_pipelineCachePath = k_cachePath;
+    SDL_RemovePath( k_cachePath );
+    
+    std::cout << "[BENCH] pipelineCache" << std::endl;
+    for ( uint32_t i = 0; i < 2; i++ )
+    {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        InitVulkan();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+        loaded[i] = m_device->PipelineCache()->Loaded();
+        
+        // the device write the cache file on destroy 
+        FinishVulkan();
+        std::cout << "  pipelineCache " << k_passes[i] << " startup: " << elapsed.count() << " ms" << ( loaded[i] ? ", cache loaded" : "" ) << std::endl;
+    }
+    
+    m_pipelineCachePath = nullptr;
+    SDL_RemovePath( k_cachePath );
+
+    // the warm run must have found the file 
+    if ( loaded[0] || !loaded[1] )
+    {
+        std::cout << "[FAIL] pipelineCache" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void crvkTest::InitSDL( const bool in_window )
+{
+    // the offscreen video driver load the Vulkan library without a display 
+    if ( !in_window )
+        SDL_SetHint( SDL_HINT_VIDEO_DRIVER, "offscreen" );
+
     // Initialize SDL3 lib
     if( !SDL_Init( SDL_INIT_VIDEO | SDL_INIT_EVENTS ) )
         throw std::runtime_error( SDL_GetError() );
@@ -102,6 +176,10 @@ void crvkTest::InitSDL(void)
     if ( !SDL_Vulkan_LoadLibrary( nullptr ) )
         throw std::runtime_error( SDL_GetError() );
 
+    // a headless context, only the interactive test present 
+    if ( !in_window )
+        return;
+
     // Create the window 
     m_window = SDL_CreateWindow( "crVkLib-Test", 800, 600, SDL_WINDOW_VULKAN );
     if ( !m_window )
@@ -127,26 +205,30 @@ void crvkTest::InitVulkan(void)
     // TODO: find the best device 
     // just pic the first 
     m_device = devices[0];
-    m_device->Create( validationLayers, 1, deviceExtensions, 1 );
-
-    // aquire window surface size 
-    SDL_GetWindowSizeInPixels( m_window, &width, &height );
-
-    auto surfaceCapabilities = m_device->SurfaceCapabilities();
-
-    // create the swapchain 
-    m_swapchain = new crvkSwapchain();
-    if( !m_swapchain->Create( 
-        m_context,      // the context for error handling 
-        m_device,       // aquire the device 
-        m_device->FindBestImageCount( k_FRAME_COUNT ),
-        // try find if device suport the requested swapchain properties 
-        m_device->FindExtent( width, height ),
-        m_device->FindSurfaceFormat( VK_FORMAT_B8G8R8A8_SRGB, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR ),
-        m_device->FindPresentMode( VK_PRESENT_MODE_MAILBOX_KHR ),
-        surfaceCapabilities.currentTransform
-    ) )
-        throw std::runtime_error( "can't create device!" );
+    m_device->Create( validationLayers, 1, deviceExtensions, 1, m_pipelineCachePath );
+
+    // a headless context don't have a surface to present 
+    if ( m_window != nullptr )
+    {
+        // aquire window surface size 
+        SDL_GetWindowSizeInPixels( m_window, &width, &height );
+
+        auto surfaceCapabilities = m_device->SurfaceCapabilities();
+
+        // create the swapchain 
+        m_swapchain = new crvkSwapchain();
+        if( !m_swapchain->Create( 
+            m_context,      // the context for error handling 
+            m_device,       // aquire the device 
+            m_device->FindBestImageCount( k_FRAME_COUNT ),
+            // try find if device suport the requested swapchain properties 
+            m_device->FindExtent( width, height ),
+            m_device->FindSurfaceFormat( VK_FORMAT_B8G8R8A8_SRGB, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR ),
+            m_device->FindPresentMode( VK_PRESENT_MODE_MAILBOX_KHR ),
+            surfaceCapabilities.currentTransform
+        ) )
+            throw std::runtime_error( "can't create device!" );
+    }
 
     // Create the element buffer 
     m_elementBuffer = new crvkBufferStaging();
@@ -521,9 +603,17 @@ void crvkTest::RunLoop(void)
 // main entry point
 int main(int argc, char *argv[] )
 {
+    // GPU-less unit tests 
+    if ( argc > 1 && std::strcmp( argv[1], "--unit" ) == 0 )
+        return crvkRunUnitTests( argc > 2 ? argv[2] : nullptr );
+
     crvkTest app = crvkTest();   
     try
     {
+        // timings of the library paths 
+        if ( argc > 1 && std::strcmp( argv[1], "--bench" ) == 0 )
+            return app.Benchmark( argc > 2 ? argv[2] : nullptr );
+
         app.Run();
     }
     catch( const std::exception& e )
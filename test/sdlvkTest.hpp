@@ -24,7 +24,11 @@ public:
 
     void    Run( void );
 
+    /// @brief Run the microbenchmarks, the device is only made if a selected benchmark need it 
+    int     Benchmark( const char* in_filter );
+
 private:
+    const char*                     m_pipelineCachePath;    // device pipeline cache file, nullptr to keep it in memory 
     SDL_Window*                     m_window;
     crvkContext*                    m_context;
     crvkDevice*                     m_device;
@@ -35,13 +39,14 @@ private:
     crvkBuffer*                     m_elementBuffer;
     crvkProgram*                    m_shaderProgram;
 
-    void    InitSDL( void );
+    void    InitSDL( const bool in_window );
     void    InitVulkan( void );
     void    InitShaders( void );
     void    InitPipeline( const uint32_t in_samples  );   
     void    FinishSDL( void );
     void    FinishVulkan( void );
     void    RunLoop( void );
+    int     BenchmarkPipelineCache( void );
 };
 
 #endif //!__SDLVH_TEST_HPP__
\ No newline at end of file